@@ -54,7 +54,7 @@ ConservationAnalysisTask::process() {
   setState(Task::RUNNING); setProgress(0.0);
 
   // Create & perform analysis:
-  _analysis = new Models::ConservedQuantities(_config.getModelDocument()->getModel());
+  _analysis = new Models::ConservedQuantities(*_config.getModelSnapshot());
   // Now, get result...
   Trafo::InitialValueFolder folder(*_analysis);
 
@@ -80,6 +80,16 @@ DocumentItem::getModel() const {
 }
 
 
+iNA::Ast::ModelSnapshot
+DocumentItem::getSnapshot() {
+  // Copy the model only once per modification:
+  if (_snapshot.isNull()) {
+    _snapshot = iNA::Ast::ModelSnapshot(_model->getModel());
+  }
+  return _snapshot;
+}
+
+
 AnalysesItem *
 DocumentItem::analysesItem() {
   return _analyses;
@@ -120,6 +130,8 @@ DocumentItem::isModified() const {
 
 void
 DocumentItem::setIsModified(bool is_modified) {
+  // The model was modified -> drop snapshot, running tasks keep their own reference:
+  if (is_modified) { _snapshot.reset(); }
   if (_isModified == is_modified) { return; }
   _isModified = is_modified;
   updateItemData();
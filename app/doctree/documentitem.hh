@@ -5,6 +5,7 @@
 
 #include "documenttreeitem.hh"
 #include "ast/model.hh"
+#include "ast/modelsnapshot.hh"
 #include <QMenu>
 #include <QAction>
 
@@ -49,6 +50,10 @@ public:
   /** Returns the @c Ast::Model instance associated with this document. */
   const iNA::Ast::Model &getModel() const;
 
+  /** Returns a read-only snapshot of the current model. All snapshots taken between two
+   * modifications of the model share the same copy of it. */
+  iNA::Ast::ModelSnapshot getSnapshot();
+
   AnalysesItem *analysesItem();
   ReactionsItem *reactionsItem();
   size_t numAnalyses() const;
@@ -65,7 +70,8 @@ public:
   /** Returns true if the model was modified since its import or last export. */
   bool isModified() const;
 
-  /** (Re-)Sets the @c isModified flag. */
+  /** (Re-)Sets the @c isModified flag. Setting the flag also invalidates the current snapshot
+   * of the model, hence it must be set on every modification of the model. */
   void setIsModified(bool is_modified);
 
   /** Returns the label for this item. */
@@ -93,6 +99,8 @@ protected:
   /** If true, the model was modified. The used will be asked to export the model before it gets
    * closed. */
   bool _isModified;
+  /** Holds the snapshot of the current model, created on demand by @c getSnapshot. */
+  iNA::Ast::ModelSnapshot _snapshot;
 
 private:
   QAction *_closeAct;
@@ -3,6 +3,9 @@
 #include "doctree/documenttree.hh"
 #include "doctree/documentitem.hh"
 #include "utils/logger.hh"
+#include <models/compiledmodelcache.hh>
+#include <QDesktopServices>
+#include <QDir>
 
 
 using namespace std;
@@ -35,6 +38,13 @@ int main(int argc, char *argv[])
   // Instantiate a QApplication
   QApplication qapp(argc, argv);
 
+  // Keep compiled models between sessions:
+  QDir cache_dir(QDesktopServices::storageLocation(QDesktopServices::CacheLocation));
+  if (cache_dir.mkpath("compiled")) {
+    iNA::Models::CompiledModelCache::get().setDirectory(
+          cache_dir.absoluteFilePath("compiled").toLocal8Bit().constData());
+  }
+
   // Instantiate our own application model, holds all the data of the running application
   Application *app = Application::getApp();
 
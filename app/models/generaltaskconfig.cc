@@ -23,13 +23,13 @@ GeneralTaskConfig::~GeneralTaskConfig()
  * Implementation of ModelSelectionTaskConfig
  * ******************************************************************************************** */
 ModelSelectionTaskConfig::ModelSelectionTaskConfig()
-  : document(0)
+  : document(0), _model()
 {
   // Pass...
 }
 
 ModelSelectionTaskConfig::ModelSelectionTaskConfig(const ModelSelectionTaskConfig &other)
-  : document(other.document)
+  : document(other.document), _model(other._model)
 {
   // Pass...
 }
@@ -43,6 +43,8 @@ void
 ModelSelectionTaskConfig::setModelDocument(DocumentItem *document)
 {
   this->document = document;
+  // Share the snapshot of the current revision of the model:
+  this->_model = document->getSnapshot();
 }
 
 DocumentItem *
@@ -51,6 +53,18 @@ ModelSelectionTaskConfig::getModelDocument()
   return this->document;
 }
 
+const iNA::Ast::ModelSnapshot &
+ModelSelectionTaskConfig::getModelSnapshot() const
+{
+  return this->_model;
+}
+
+iNA::Ast::Model &
+ModelSelectionTaskConfig::modifyModel()
+{
+  return this->_model.modify();
+}
+
 
 /* ******************************************************************************************** *
  * Implementation of SpeciesSelectionTaskConfig
@@ -158,7 +172,7 @@ EngineTaskConfig::setNumEvalThreads(size_t num)
  * ******************************************************************************************** */
 ODEIntTaskConfig::ODEIntTaskConfig()
   : integrator((Integrator)0), integration_range(0,0,0), intermediate_steps(0),
-     epsilon_abs(0), epsilon_rel(0)
+     epsilon_abs(0), epsilon_rel(0), stop_at_steady_state(false)
 {
   // Pass...
 }
@@ -166,7 +180,8 @@ ODEIntTaskConfig::ODEIntTaskConfig()
 ODEIntTaskConfig::ODEIntTaskConfig(const ODEIntTaskConfig &other)
   : integrator(other.integrator), integration_range(other.integration_range),
     intermediate_steps(other.intermediate_steps),
-    epsilon_abs(other.epsilon_abs), epsilon_rel(other.epsilon_rel)
+    epsilon_abs(other.epsilon_abs), epsilon_rel(other.epsilon_rel),
+    stop_at_steady_state(other.stop_at_steady_state)
 {
   // Pass...
 }
@@ -249,3 +264,15 @@ ODEIntTaskConfig::setEpsilon(double abs, double rel)
   this->epsilon_rel = rel;
 }
 
+bool
+ODEIntTaskConfig::getStopAtSteadyState() const
+{
+  return this->stop_at_steady_state;
+}
+
+void
+ODEIntTaskConfig::setStopAtSteadyState(bool enabled)
+{
+  this->stop_at_steady_state = enabled;
+}
+
@@ -39,15 +39,26 @@ public:
   /** Destructor. */
   virtual ~ModelSelectionTaskConfig();
 
-  /** (Re-) Sets the document item of the model being selected for analysis. */
+  /** (Re-) Sets the document item of the model being selected for analysis and takes a snapshot
+   * of its current model. */
   virtual void setModelDocument(DocumentItem *document);
   /** Returns the currently selected document item of the model to be analyzed. */
   virtual DocumentItem *getModelDocument();
 
+  /** Returns the snapshot of the selected model. The snapshot is shared with all configurations
+   * and copies of this configuration made on the same revision of the document. */
+  const iNA::Ast::ModelSnapshot &getModelSnapshot() const;
+  /** Returns the model of this configuration for modification. The model gets detached from the
+   * snapshot of the document first, hence other configurations and the document are not
+   * affected. */
+  iNA::Ast::Model &modifyModel();
+
 protected:
   /** Will hold a weak reference to the selected document, will be @c null, if no document is
    * selected. */
   DocumentItem *document;
+  /** Holds the snapshot of the selected model. */
+  iNA::Ast::ModelSnapshot _model;
 };
 
 
@@ -69,7 +80,7 @@ public:
   virtual ~SpeciesSelectionTaskConfig();
 
   /** Needs to be implemented by the actual task config to return the previously selected model. */
-  virtual iNA::Ast::Model *getModel() const = 0 ;
+  virtual const iNA::Ast::Model *getModel() const = 0 ;
   /** Returns the list of selected species. */
   virtual const QStringList &getSelectedSpecies() const;
   /** Just returns the number of selected species. */
@@ -143,7 +154,9 @@ public:
     RungeKuttaFehlberg45,  ///< The adaptive RKF45 integrator.
     LSODA,                 ///< Lsoda integrator.
     DormandPrince5,        ///< Precise Dopri integrator.
-    Rosenbrock4            ///< Implicit integrator for stiff systems.
+    Rosenbrock4,           ///< Implicit integrator for stiff systems.
+    BDF,                   ///< Variable-order BDF integrator for large, very stiff systems.
+    BDFKrylov              ///< Jacobian-free BDF integrator (GMRES) for very large systems.
   } Integrator;
 
 
@@ -158,6 +171,8 @@ protected:
   double epsilon_abs;
   /** Holds the relative error for adaptive integrators. */
   double epsilon_rel;
+  /** If true, the integration stops once the system reached a steady state. */
+  bool stop_at_steady_state;
 
 public:
   /** Default constructor. */
@@ -191,6 +206,10 @@ public:
   virtual void setEpsilonRel(double epsilon);
   /** (Re-) Sets absolute and relative error. */
   virtual void setEpsilon(double abs, double rel);
+  /** Returns true if the integration stops once the system reached a steady state. */
+  virtual bool getStopAtSteadyState() const;
+  /** Enables or disables the early termination at the steady state. */
+  virtual void setStopAtSteadyState(bool enabled);
 };
 
 
@@ -2,7 +2,7 @@
 #include <ast/model.hh>
 #include "../tinytex/tinytex.hh"
 
-SpeciesSelectionModel::SpeciesSelectionModel(iNA::Ast::Model *model, QObject *parent) :
+SpeciesSelectionModel::SpeciesSelectionModel(const iNA::Ast::Model *model, QObject *parent) :
   QAbstractTableModel(parent), _model(model), _selection(_model->numSpecies(), false)
 {
   // Pass...
@@ -16,7 +16,7 @@ class SpeciesSelectionModel : public QAbstractTableModel
 
 public:
   /** Constructor. */
-  explicit SpeciesSelectionModel(iNA::Ast::Model *model, QObject *parent = 0);
+  explicit SpeciesSelectionModel(const iNA::Ast::Model *model, QObject *parent = 0);
 
   /** Returns a list of species identifiers that are selected. */
   QStringList selectedSpecies();
@@ -46,7 +46,7 @@ public slots:
 
 protected:
   /** Holds a weak reference to the model. */
-  iNA::Ast::Model *_model;
+  const iNA::Ast::Model *_model;
   /** The set of selected species. */
   QVector<bool> _selection;
 };
@@ -0,0 +1,260 @@
+#include "tablestorage.hh"
+
+
+/* ********************************************************************************************* *
+ * Implementation of TableStorage::Chunk
+ * ********************************************************************************************* */
+TableStorage::Chunk::Chunk()
+  : data(), mapped(0)
+{
+  // Pass...
+}
+
+
+
+/* ********************************************************************************************* *
+ * Implementation of TableStorage
+ * ********************************************************************************************* */
+const size_t TableStorage::_chunk_bytes = 4*1024*1024;
+size_t TableStorage::_memory_limit = 256*1024*1024;
+
+
+TableStorage::TableStorage(size_t rows, size_t columns)
+  : QSharedData(), _rows(0), _columns(0), _chunk_rows(1), _chunks(), _memory(0), _file(0)
+{
+  resize(rows, columns);
+}
+
+
+TableStorage::TableStorage(const TableStorage &other)
+  : QSharedData(other), _rows(other._rows), _columns(other._columns),
+    _chunk_rows(other._chunk_rows), _chunks(other._chunks.size()), _memory(0), _file(0)
+{
+  for (int c=0; c<_chunks.size(); c++) {
+    const double *data = other._chunk_data(c);
+    if (0 == data) { continue; }
+
+    size_t n = _chunk_size(c);
+    _chunks[c].data = Eigen::Map<const Eigen::MatrixXd>(data, n, _columns);
+    _memory += n*_columns*sizeof(double);
+    // Keep spilled chunks on disk:
+    if (other.isSpilled(c)) { _spill(c); }
+  }
+}
+
+
+TableStorage::~TableStorage()
+{
+  _release();
+}
+
+
+void
+TableStorage::resize(size_t rows, size_t columns)
+{
+  _release();
+
+  _rows = rows; _columns = columns;
+  _chunk_rows = std::max(size_t(1), _chunk_bytes/(sizeof(double)*std::max(size_t(1), columns)));
+  if (0 < rows) { _chunk_rows = std::min(_chunk_rows, rows); }
+  _chunks.resize((_rows+_chunk_rows-1)/_chunk_rows);
+}
+
+
+size_t
+TableStorage::rows() const {
+  return _rows;
+}
+
+size_t
+TableStorage::columns() const {
+  return _columns;
+}
+
+
+const double &
+TableStorage::value(size_t i, size_t j) const
+{
+  static const double zero = 0;
+
+  size_t c = i/_chunk_rows;
+  const double *data = _chunk_data(c);
+  if (0 == data) { return zero; }
+  return data[(i%_chunk_rows) + j*_chunk_size(c)];
+}
+
+double &
+TableStorage::value(size_t i, size_t j)
+{
+  size_t c = i/_chunk_rows;
+  return _chunk_data(c)[(i%_chunk_rows) + j*_chunk_size(c)];
+}
+
+
+void
+TableStorage::setRow(size_t i, const Eigen::VectorXd &values)
+{
+  size_t c = i/_chunk_rows, r = i%_chunk_rows, n = _chunk_size(c);
+  double *data = _chunk_data(c);
+  for (size_t j=0; j<_columns; j++) {
+    data[r+j*n] = values(j);
+  }
+
+  // Spill completed chunk if the memory limit is exceeded:
+  if ((r+1 == n) && (_memory > _memory_limit)) {
+    _spill(c);
+  }
+}
+
+
+void
+TableStorage::getRow(size_t i, Eigen::VectorXd &values) const
+{
+  values.resize(_columns);
+
+  size_t c = i/_chunk_rows, r = i%_chunk_rows, n = _chunk_size(c);
+  const double *data = _chunk_data(c);
+  if (0 == data) { values.setZero(); return; }
+  for (size_t j=0; j<_columns; j++) {
+    values(j) = data[r+j*n];
+  }
+}
+
+
+void
+TableStorage::getColumns(const std::vector<size_t> &columns, Eigen::MatrixXd &values) const
+{
+  values.resize(_rows, columns.size());
+
+  for (int c=0; c<_chunks.size(); c++) {
+    size_t n = _chunk_size(c), offset = c*_chunk_rows;
+    const double *data = _chunk_data(c);
+    for (size_t k=0; k<columns.size(); k++) {
+      if (0 == data) {
+        values.block(offset, k, n, 1).setZero();
+      } else {
+        values.block(offset, k, n, 1) = Eigen::Map<const Eigen::VectorXd>(data + columns[k]*n, n);
+      }
+    }
+  }
+}
+
+
+Eigen::MatrixXd &
+TableStorage::dense()
+{
+  // Gather all chunks into a single one:
+  if ((1 < _chunks.size()) || ((1 == _chunks.size()) && isSpilled(0))) {
+    std::vector<size_t> columns(_columns);
+    for (size_t j=0; j<_columns; j++) { columns[j] = j; }
+    Eigen::MatrixXd matrix; getColumns(columns, matrix);
+
+    _release();
+    _chunk_rows = std::max(size_t(1), _rows); _chunks.resize(1);
+    _chunks[0].data.swap(matrix);
+    _memory = _rows*_columns*sizeof(double);
+  } else if (0 == _chunks.size()) {
+    _chunks.resize(1); _chunks[0].data.resize(0, _columns);
+  }
+
+  _chunk_data(0);
+  return _chunks[0].data;
+}
+
+
+size_t
+TableStorage::chunkRows() const {
+  return _chunk_rows;
+}
+
+size_t
+TableStorage::numChunks() const {
+  return _chunks.size();
+}
+
+bool
+TableStorage::isSpilled(size_t chunk) const {
+  return 0 != _chunks[chunk].mapped;
+}
+
+
+size_t
+TableStorage::memoryLimit() {
+  return _memory_limit;
+}
+
+void
+TableStorage::setMemoryLimit(size_t bytes) {
+  _memory_limit = bytes;
+}
+
+
+size_t
+TableStorage::_chunk_size(size_t chunk) const {
+  return std::min(_chunk_rows, _rows - chunk*_chunk_rows);
+}
+
+
+const double *
+TableStorage::_chunk_data(size_t chunk) const
+{
+  const Chunk &item = _chunks[chunk];
+  if (0 != item.mapped) { return item.mapped; }
+  if (0 == item.data.size()) { return 0; }
+  return item.data.data();
+}
+
+double *
+TableStorage::_chunk_data(size_t chunk)
+{
+  const double *data = static_cast<const TableStorage *>(this)->_chunk_data(chunk);
+  if (0 != data) { return const_cast<double *>(data); }
+
+  // Allocate chunk on first access:
+  size_t n = _chunk_size(chunk);
+  _chunks[chunk].data = Eigen::MatrixXd::Zero(n, _columns);
+  _memory += n*_columns*sizeof(double);
+  return _chunks[chunk].data.data();
+}
+
+
+bool
+TableStorage::_spill(size_t chunk)
+{
+  // Create temporary file on demand:
+  if (0 == _file) {
+    _file = new QTemporaryFile();
+    if (! _file->open()) {
+      delete _file; _file = 0; return false;
+    }
+  }
+
+  Chunk &item = _chunks[chunk];
+  qint64 bytes  = _chunk_size(chunk)*_columns*sizeof(double);
+  qint64 offset = qint64(chunk)*_chunk_rows*_columns*sizeof(double);
+  if ((! _file->seek(offset)) ||
+      (bytes != _file->write(reinterpret_cast<const char *>(item.data.data()), bytes)) ||
+      (! _file->flush())) {
+    return false;
+  }
+
+  // Map chunk back into memory:
+  uchar *mapped = _file->map(offset, bytes);
+  if (0 == mapped) { return false; }
+  item.mapped = reinterpret_cast<double *>(mapped);
+  item.data.resize(0,0);
+  _memory -= bytes;
+  return true;
+}
+
+
+void
+TableStorage::_release()
+{
+  _chunks.clear();
+  _memory = 0;
+  // Closing the file unmaps all spilled chunks:
+  if (0 != _file) {
+    delete _file; _file = 0;
+  }
+}
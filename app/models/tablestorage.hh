@@ -0,0 +1,126 @@
+#ifndef __INA_APP_MODELS_TABLESTORAGE_HH__
+#define __INA_APP_MODELS_TABLESTORAGE_HH__
+
+#include <QSharedData>
+#include <QTemporaryFile>
+#include <QVector>
+#include <vector>
+#include <algorithm>
+
+#include <ginacsupportforeigen.hh>
+
+
+/**
+ * Chunked, column-major storage of the data of a @c Table.
+ *
+ * The rows of the table are divided into chunks of equal size, each chunk stores its values
+ * column-major. The memory of a chunk is allocated once a value of it gets written, hence a large
+ * table does not occupy any memory before it gets filled. Once a chunk is completed by
+ * @c setRow and the chunks held in memory exceed the @c memoryLimit, the chunk is spilled into a
+ * temporary file, which is then mapped into memory. Hence the operating system loads the data of
+ * spilled chunks on demand. As the values are stored column-major, reading a subset of columns by
+ * @c getColumns only touches the pages holding these columns.
+ *
+ * The storage is implicitly shared by @c QSharedDataPointer, copies of a @c Table share the
+ * storage until one of them gets modified.
+ *
+ * The storage is not synchronized. The tasks fill their tables by @c setRow from the worker
+ * thread, which allocates and spills chunks. Hence a table must not be read while the task filling
+ * it is running. The application reads the results only once the task is done (see
+ * @c TaskView::taskStateChanged).
+ *
+ * @ingroup gui
+ */
+class TableStorage : public QSharedData
+{
+public:
+  /** Constructs a storage for the given number of rows and columns. */
+  TableStorage(size_t rows=0, size_t columns=0);
+  /** Copy constructor, performs a deep copy. */
+  TableStorage(const TableStorage &other);
+  /** Destructor. */
+  ~TableStorage();
+
+  /** Resizes the storage, all values are lost. */
+  void resize(size_t rows, size_t columns);
+
+  /** Returns the number of rows. */
+  size_t rows() const;
+  /** Returns the number of columns. */
+  size_t columns() const;
+
+  /** Returns the value at the @c i -th row and @c j -th column. */
+  const double &value(size_t i, size_t j) const;
+  /** Returns a reference to the value at the @c i -th row and @c j -th column. */
+  double &value(size_t i, size_t j);
+
+  /** Sets the @c i -th row, completed chunks may get spilled to disk. The storage must not be
+   * read concurrently. */
+  void setRow(size_t i, const Eigen::VectorXd &values);
+  /** Reads the @c i -th row. */
+  void getRow(size_t i, Eigen::VectorXd &values) const;
+  /** Reads the specified columns into the columns of @c values. */
+  void getColumns(const std::vector<size_t> &columns, Eigen::MatrixXd &values) const;
+
+  /** Gathers all chunks into a single dense matrix held in memory and returns it. The storage
+   * keeps using this matrix until it gets resized. */
+  Eigen::MatrixXd &dense();
+
+  /** Returns the number of rows per chunk. */
+  size_t chunkRows() const;
+  /** Returns the number of chunks. */
+  size_t numChunks() const;
+  /** Returns true if the given chunk was spilled to disk. */
+  bool isSpilled(size_t chunk) const;
+
+  /** Returns the maximum number of bytes, the chunks of a storage may occupy in memory. */
+  static size_t memoryLimit();
+  /** (Re-) Sets the maximum number of bytes, the chunks of a storage may occupy in memory. */
+  static void setMemoryLimit(size_t bytes);
+
+protected:
+  /** Holds the values of a chunk, either in memory or mapped from the temporary file. */
+  class Chunk {
+  public:
+    /** Empty constructor. */
+    Chunk();
+    /** Holds the values if the chunk is held in memory. */
+    Eigen::MatrixXd data;
+    /** Points to the mapped values if the chunk was spilled. */
+    double *mapped;
+  };
+
+protected:
+  /** Returns the number of rows of the given chunk. */
+  size_t _chunk_size(size_t chunk) const;
+  /** Returns the values of the given chunk or 0 if the chunk was not allocated yet. */
+  const double *_chunk_data(size_t chunk) const;
+  /** Returns the values of the given chunk, allocates the chunk if needed. */
+  double *_chunk_data(size_t chunk);
+  /** Spills the given chunk into the temporary file. */
+  bool _spill(size_t chunk);
+  /** Releases all chunks and the temporary file. */
+  void _release();
+
+protected:
+  /** The number of rows. */
+  size_t _rows;
+  /** The number of columns. */
+  size_t _columns;
+  /** The number of rows per chunk. */
+  size_t _chunk_rows;
+  /** The chunks. */
+  QVector<Chunk> _chunks;
+  /** The number of bytes of all chunks held in memory. */
+  size_t _memory;
+  /** The temporary file holding the spilled chunks, created on demand. */
+  QTemporaryFile *_file;
+
+  /** The size of a chunk in bytes. */
+  static const size_t _chunk_bytes;
+  /** The maximum number of bytes, the chunks of a storage may occupy in memory. */
+  static size_t _memory_limit;
+};
+
+
+#endif // __INA_APP_MODELS_TABLESTORAGE_HH__
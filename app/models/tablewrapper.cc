@@ -32,7 +32,9 @@ TableWrapper::data(const QModelIndex &index, int role) const
     return QVariant();
   }
 
-  return QVariant((*(this->table))(index.row(), index.column()));
+  // Use const access, this does not detach the shared storage of the table:
+  const Table &table = *(this->table);
+  return QVariant(table(index.row(), index.column()));
 }
 
 
@@ -5,22 +5,25 @@
  * Implementation of Table (fixed size array with column names)
  * ********************************************************************************************* */
 Table::Table(size_t columns, size_t rows, QObject *parent)
-  : QObject(parent), _header(columns), _data(rows, columns), _current_insert_index(0)
+  : QObject(parent), _header(columns), _data(new TableStorage(rows, columns)),
+    _current_insert_index(0)
 {
   // Pass...
 }
 
 
 Table::Table(const QVector<QString> &columns, size_t rows, QObject *parent)
-  : QObject(parent), _header(columns), _data(rows, columns.size()), _current_insert_index(0)
+  : QObject(parent), _header(columns), _data(new TableStorage(rows, columns.size())),
+    _current_insert_index(0)
 {
   // Pass...
 }
 
 Table::Table(const Eigen::MatrixXd &data, QObject *parent)
-  : QObject(parent), _header(data.cols()), _data(data), _current_insert_index(data.rows())
+  : QObject(parent), _header(data.cols()), _data(new TableStorage(data.rows(), data.cols())),
+    _current_insert_index(data.rows())
 {
-  // Pass...
+  _data->dense() = data;
 }
 
 Table::Table(const Table &other)
@@ -34,7 +37,7 @@ Table::Table(const Table &other)
 void
 Table::resize(size_t columns,size_t rows) {
   _header.resize(columns);
-  matrix().resize(rows,columns);
+  _data->resize(rows, columns);
 }
 
 size_t
@@ -45,7 +48,7 @@ Table::getNumColumns() const {
 
 size_t
 Table::getNumRows() const {
-  return this->_data.rows();
+  return this->_data->rows();
 }
 
 
@@ -63,40 +66,61 @@ Table::getColumnName(size_t idx) const {
 
 void
 Table::append(Eigen::VectorXd &values) {
-  this->_data.row(this->_current_insert_index) = values;
+  this->_data->setRow(this->_current_insert_index, values);
   this->_current_insert_index++;
 }
 
 
 const double &
 Table::operator ()(size_t i, size_t j) const {
-  return this->_data(i,j);
+  return this->_data->value(i,j);
 }
 
 double &
 Table::operator ()(size_t i, size_t j) {
-  return this->_data(i,j);
+  return this->_data->value(i,j);
 }
 
 Eigen::MatrixXd &
 Table::matrix() {
-  return this->_data;
+  return this->_data->dense();
+}
+
+Eigen::MatrixXd
+Table::toMatrix() const {
+  std::vector<size_t> columns(this->_data->columns());
+  for (size_t j=0; j<columns.size(); j++) { columns[j] = j; }
+  Eigen::MatrixXd values; this->_data->getColumns(columns, values);
+  return values;
 }
 
 Eigen::VectorXd
-Table::getRow(size_t i) {
-  return this->_data.row(i);
+Table::getRow(size_t i) const {
+  Eigen::VectorXd row; this->_data.constData()->getRow(i, row);
+  return row;
 }
 
 Eigen::VectorXd
-Table::getColumn(size_t i) {
-  return this->_data.col(i);
+Table::getColumn(size_t i) const {
+  return getColumns(std::vector<size_t>(1, i)).col(0);
 }
 
+Eigen::MatrixXd
+Table::getColumns(const std::vector<size_t> &columns) const {
+  Eigen::MatrixXd values; getColumns(columns, values);
+  return values;
+}
 
 void
-Table::saveAsText(QFile &file) {
-  if (!file.isOpen() || !file.isWritable() || 0 == this->_data.cols()) {
+Table::getColumns(const std::vector<size_t> &columns, Eigen::MatrixXd &values) const {
+  this->_data.constData()->getColumns(columns, values);
+}
+
+
+void
+Table::saveAsText(QFile &file) const {
+  const TableStorage *data = this->_data.constData();
+  if (!file.isOpen() || !file.isWritable() || 0 == data->columns()) {
     return;
   }
 
@@ -104,21 +128,50 @@ Table::saveAsText(QFile &file) {
 
   // Write header:
   str << "# ";
-  for (int i=0; i<this->_data.cols(); i++) {
+  for (size_t i=0; i<data->columns(); i++) {
     str << this->getColumnName(i).toStdString() << "\t";
   }
   str << std::endl;
   file.write(str.str().c_str());
 
   // Write data:
-  for (int i=0; i<this->_data.rows(); i++) {
-    str.str("");
+  Eigen::VectorXd row;
+  for (size_t i=0; i<data->rows(); i++) {
+    str.str(""); data->getRow(i, row);
 
-    for (int j=0; j<this->_data.cols()-1; j++) {
-      str << this->_data(i,j) << "\t";
+    for (int j=0; j<row.size()-1; j++) {
+      str << row(j) << "\t";
     }
-    str << this->_data(i,this->_data.cols()-1) << std::endl;
+    str << row(row.size()-1) << std::endl;
 
     file.write(str.str().c_str());
   }
 }
+
+
+
+/* ********************************************************************************************* *
+ * Implementation of TableMatrixSource (MAT file export of tables)
+ * ********************************************************************************************* */
+TableMatrixSource::TableMatrixSource(const Table &table)
+  : _table(table), _columns()
+{
+  // Pass...
+}
+
+size_t
+TableMatrixSource::rows() const {
+  return _table.getNumRows();
+}
+
+size_t
+TableMatrixSource::cols() const {
+  return _table.getNumColumns();
+}
+
+void
+TableMatrixSource::getColumns(size_t first, size_t num, Eigen::MatrixXd &values) const {
+  _columns.resize(num);
+  for (size_t j=0; j<num; j++) { _columns[j] = first+j; }
+  _table.getColumns(_columns, values);
+}
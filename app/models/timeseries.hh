@@ -8,10 +8,17 @@
 #include <QMutex>
 #include <QMutexLocker>
 #include <QFile>
+#include <QSharedDataPointer>
 
 #include <ginacsupportforeigen.hh>
+#include "utils/matexport.hh"
+#include "tablestorage.hh"
 
 /** Represents a table of data (ie. a time-series) of some covariates with column names.
+ *
+ * The data is held by a chunked @c TableStorage, which spills large tables to a temporary file.
+ * Copies of a table share the storage until one of them gets modified. The table is not
+ * synchronized, it must not be read while a task appends to it.
  * @ingroup gui */
 class Table : public QObject
 {
@@ -48,24 +55,56 @@ public:
   double &operator() (size_t i, size_t j);
 
   /** Saves the table as text-file. */
-  void saveAsText(QFile &file);
+  void saveAsText(QFile &file) const;
 
-  /** Returns the matrix, holding the data. */
+  /** Returns the matrix, holding the data.
+   * @note This loads the complete table into memory, prefer @c getColumns for large tables. */
   Eigen::MatrixXd &matrix();
+  /** Returns a copy of the data, unlike @c matrix this does not convert the storage. */
+  Eigen::MatrixXd toMatrix() const;
   /** Returns a certain row as a @c Eigen::VectorXd. */
-  Eigen::VectorXd getRow(size_t i);
+  Eigen::VectorXd getRow(size_t i) const;
   /** Returns a certain column as a @c Eigen::VectorXd. */
-  Eigen::VectorXd getColumn(size_t i);
+  Eigen::VectorXd getColumn(size_t i) const;
+  /** Returns the specified columns as the columns of a @c Eigen::MatrixXd. Only the data of these
+   * columns is read from the storage. */
+  Eigen::MatrixXd getColumns(const std::vector<size_t> &columns) const;
+  /** Stores the specified columns into the columns of @c values. */
+  void getColumns(const std::vector<size_t> &columns, Eigen::MatrixXd &values) const;
 
 
 protected:
   /** Holds the column-names. */
   QVector<QString> _header;
   /** Holds the actual data. */
-  Eigen::MatrixXd _data;
+  QSharedDataPointer<TableStorage> _data;
   /** Index of the next, empty row in the table. */
   size_t _current_insert_index;
 };
 
 
+/** Exports a table into a MAT file block of columns by block of columns, hence the complete table
+ * is never copied into memory (see @c iNA::Utils::MatFile::add).
+ * @ingroup gui */
+class TableMatrixSource : public iNA::Utils::MatFileMatrixSource
+{
+public:
+  /** Constructor, the table must exist until the MAT file got serialized. */
+  explicit TableMatrixSource(const Table &table);
+
+  /** Returns the number of rows of the table. */
+  virtual size_t rows() const;
+  /** Returns the number of columns of the table. */
+  virtual size_t cols() const;
+  /** Reads the @c num columns starting with column @c first from the table. */
+  virtual void getColumns(size_t first, size_t num, Eigen::MatrixXd &values) const;
+
+protected:
+  /** Holds a weak reference to the table. */
+  const Table &_table;
+  /** Holds the indices of the requested columns. */
+  mutable std::vector<size_t> _columns;
+};
+
+
 #endif // TIMESERIES_HH
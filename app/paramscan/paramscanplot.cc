@@ -10,7 +10,7 @@ Plot::PlotConfig *
 createParameterScanREPlotConfig(const QStringList &selected_species, ParamScanTask *task)
 {
   // Get parameter scan table:
-  Table &data = task->getParameterScan();
+  const Table &data = task->getParameterScan();
   Plot::PlotConfig *config = new Plot::PlotConfig(data);
 
   // Number of selected species
@@ -45,7 +45,7 @@ Plot::PlotConfig *
 createParameterScanLNAPlotConfig(const QStringList &selected_species, ParamScanTask *task)
 {
   // Get parameter scan table:
-  Table &data = task->getParameterScan();
+  const Table &data = task->getParameterScan();
   Plot::PlotConfig *config = new Plot::PlotConfig(data);
 
   // Get species units:
@@ -91,7 +91,7 @@ Plot::PlotConfig *
 createParameterScanIOSPlotConfig(const QStringList &selected_species, ParamScanTask *task)
 {
   // Get parameter scan table:
-  Table &data = task->getParameterScan();
+  const Table &data = task->getParameterScan();
   Plot::PlotConfig *config = new Plot::PlotConfig(data);
 
   // Get species units:
@@ -137,7 +137,7 @@ Plot::PlotConfig *
 createParameterScanLNACVPlotConfig(const QStringList &selected_species, ParamScanTask *task)
 {
   // Get parameter scan table:
-  Table &data = task->getParameterScan();
+  const Table &data = task->getParameterScan();
   Plot::PlotConfig *config = new Plot::PlotConfig(data);
 
   // Number of species in model
@@ -181,8 +181,8 @@ Plot::PlotConfig *
 createParameterScanLNAFanoPlotConfig(const QStringList &selected_species, ParamScanTask *task)
 {
   // Get parameter scan table etc...
-  Table &data = task->getParameterScan();
-  iNA::Ast::Model *model = task->getConfig().getModel();
+  const Table &data = task->getParameterScan();
+  const iNA::Ast::Model *model = task->getConfig().getModel();
   Plot::PlotConfig *config = new Plot::PlotConfig(data);
   size_t Ntot = task->getConfig().getModel()->numSpecies();
   size_t Nsel = selected_species.size();
@@ -251,7 +251,7 @@ Plot::PlotConfig *
 createParameterScanIOSCVPlotConfig(const QStringList &selected_species, ParamScanTask *task)
 {
   // Get parameter scan table:
-  Table &data = task->getParameterScan();
+  const Table &data = task->getParameterScan();
   Plot::PlotConfig *config = new Plot::PlotConfig(data);
 
   // Number of species in model
@@ -289,7 +289,7 @@ Plot::PlotConfig *
 createParameterScanIOSFanoPlotConfig(const QStringList &selected_species, ParamScanTask *task)
 {
   // Get parameter scan table:
-  Table &data = task->getParameterScan();
+  const Table &data = task->getParameterScan();
   Plot::PlotConfig *config = new Plot::PlotConfig(data);
 
   // Number of species in model
@@ -302,7 +302,7 @@ createParameterScanIOSFanoPlotConfig(const QStringList &selected_species, ParamS
   config->setXLabel(QObject::tr("%1").arg(data.getColumnName(0)));
   config->setYLabel(QObject::tr("$F_Fano$"));
 
-  iNA::Ast::Model *model = task->getConfig().getModel();
+  const iNA::Ast::Model *model = task->getConfig().getModel();
 
   // Assemble a constant folder, that excludes the paramter we scan over:
   GiNaC::exmap excludeFromICFold;
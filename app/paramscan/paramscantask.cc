@@ -6,7 +6,7 @@
  * ******************************************************************************************* */
 ParamScanTask::Config::Config()
   : GeneralTaskConfig(), ModelSelectionTaskConfig(), EngineTaskConfig(),
-    _model(0), num_threads(0), max_iterations(0), max_time_step(0), epsilon(0),
+    selected_method(UNDEFINED_ANALYSIS), num_threads(0), max_iterations(0), max_time_step(0), epsilon(0),
     parameter(), start_value(0), end_value(1),
     steps(1)
 {
@@ -15,71 +15,17 @@ ParamScanTask::Config::Config()
 
 ParamScanTask::Config::Config(const Config &other)
   : GeneralTaskConfig(), ModelSelectionTaskConfig(other), EngineTaskConfig(other),
-    _model(other._model), selected_method(other.selected_method), num_threads(other.num_threads), max_iterations(other.max_iterations), max_time_step(other.max_time_step),
+    selected_method(other.selected_method), num_threads(other.num_threads), max_iterations(other.max_iterations), max_time_step(other.max_time_step),
     epsilon(other.epsilon),
-    parameter(other.parameter), start_value(other.start_value), end_value(other.end_value),     steps(other.steps),
-    re_model(other.re_model), lna_model(other.lna_model), ios_model(other.ios_model)
+    parameter(other.parameter), start_value(other.start_value), end_value(other.end_value),     steps(other.steps)
 {
   // Pass...
 }
 
-void
-ParamScanTask::Config::setModelDocument(DocumentItem *document)
+const iNA::Ast::Model *
+ParamScanTask::Config::getModel() const
 {
-  ModelSelectionTaskConfig::setModelDocument(document);
-
-  // Construct IOS model from SBML model associated with the selected document
-  this->_model = new iNA::Models::IOSmodel(document->getModel());
-
-  ModelSelectionTaskConfig::setModelDocument(document);
-
-  // Construct analysis model depending on the selected method:
-  switch (selected_method) {
-  case RE_ANALYSIS:
-    this->re_model = new iNA::Models::REmodel(document->getModel());
-    this->lna_model = 0;
-    this->ios_model = 0;
-    break;
-
-  case LNA_ANALYSIS:
-    this->re_model = 0;
-    this->lna_model = new iNA::Models::LNAmodel(document->getModel());
-    this->ios_model = 0;
-    break;
-
-  case IOS_ANALYSIS:
-    this->re_model = 0;
-    this->lna_model = 0;
-    this->ios_model = new iNA::Models::IOSmodel(document->getModel());
-    break;
-
-  case UNDEFINED_ANALYSIS:
-    this->re_model = 0;
-    this->lna_model = 0;
-    this->ios_model = 0;
-    break;
-  }
-
-
-}
-
-iNA::Models::REmodel *ParamScanTask::Config::getModel() const
-{
-  switch (selected_method) {
-  case RE_ANALYSIS:
-    return this->re_model;
-
-  case LNA_ANALYSIS:
-    return this->lna_model;
-
-  case IOS_ANALYSIS:
-    return this->ios_model;
-
-  default:
-    break;
-  }
-
-  return 0;
+  return &(*_model);
 }
 
 
@@ -145,19 +91,23 @@ ParamScanTask::Config::setEpsilon(double eps)
  * Implementation of ParamScanTask::Config, the task configuration.
  * ******************************************************************************************* */
 ParamScanTask::ParamScanTask(const Config &config, QObject *parent)
-    : Task(parent), config(config), _Ns(config.getModel()->numSpecies()), parameterScan(1,1)
+    : Task(parent), config(config), _Ns(config.getModel()->numSpecies()), _sseModel(0),
+      parameterScan(1,1)
 {
 
     std::vector<QString> species_name(_Ns);
-    // Make space
+    // Construct the analysis model from the snapshot and make space
 
     switch(config.getMethod())
     {
         case Config::RE_ANALYSIS:
+            _sseModel = new iNA::Models::REmodel(*config.getModel());
             parameterScan.resize(1+_Ns, config.getSteps()+1); break;
         case Config::LNA_ANALYSIS:
+            _sseModel = new iNA::Models::LNAmodel(*config.getModel());
             parameterScan.resize(1+_Ns+_Ns*(_Ns+1)/2, config.getSteps()+1); break;
         case Config::IOS_ANALYSIS:
+            _sseModel = new iNA::Models::IOSmodel(*config.getModel());
             parameterScan.resize(1+3*_Ns+_Ns*(_Ns+1), config.getSteps()+1); break;
         default:
             break;
@@ -209,6 +159,12 @@ ParamScanTask::ParamScanTask(const Config &config, QObject *parent)
 }
 
 
+ParamScanTask::~ParamScanTask()
+{
+  if (0 != _sseModel) { delete _sseModel; }
+}
+
+
 void
 ParamScanTask::process()
 {
@@ -234,14 +190,14 @@ ParamScanTask::process()
     if(config.getEngine()==EngineTaskConfig::JIT_ENGINE)
     {
       iNA::Models::ParameterScan<iNA::Models::REmodel, iNA::Eval::jit::Engine<Eigen::VectorXd>, iNA::Eval::jit::Engine<Eigen::VectorXd,Eigen::MatrixXd> >
-          pscan(dynamic_cast<iNA::Models::REmodel &>(*config.getModel()),
+          pscan(*_sseModel,
                 config.getMaxIterations(), config.getEpsilon(), config.getMaxTimeStep(),0.1,config.getOptLevel());
       pscan.parameterScan(parameterSets,scanResult);
     }
     else
     {
       iNA::Models::ParameterScan<iNA::Models::REmodel>
-          pscan(dynamic_cast<iNA::Models::REmodel &>(*config.getModel()),
+          pscan(*_sseModel,
                 config.getMaxIterations(), config.getEpsilon(), config.getMaxTimeStep(),0.1,config.getOptLevel());
       pscan.parameterScan(parameterSets,scanResult);
     }
@@ -252,14 +208,14 @@ ParamScanTask::process()
     if(config.getEngine()==EngineTaskConfig::JIT_ENGINE)
     {
       iNA::Models::ParameterScan<iNA::Models::LNAmodel, iNA::Eval::jit::Engine<Eigen::VectorXd>, iNA::Eval::jit::Engine<Eigen::VectorXd,Eigen::MatrixXd> >
-          pscan(dynamic_cast<iNA::Models::LNAmodel &>(*config.getModel()),
+          pscan(dynamic_cast<iNA::Models::LNAmodel &>(*_sseModel),
                 config.getMaxIterations(), config.getEpsilon(), config.getMaxTimeStep(),0.1,config.getOptLevel());
       pscan.parameterScan(parameterSets,scanResult);
     }
     else
     {
       iNA::Models::ParameterScan<iNA::Models::LNAmodel>
-          pscan(dynamic_cast<iNA::Models::LNAmodel &>(*config.getModel()),
+          pscan(dynamic_cast<iNA::Models::LNAmodel &>(*_sseModel),
                 config.getMaxIterations(), config.getEpsilon(), config.getMaxTimeStep(),0.1,config.getOptLevel());
       pscan.parameterScan(parameterSets,scanResult);
     }
@@ -269,14 +225,14 @@ ParamScanTask::process()
     if(config.getEngine()==EngineTaskConfig::JIT_ENGINE)
     {
       iNA::Models::ParameterScan<iNA::Models::IOSmodel, iNA::Eval::jit::Engine<Eigen::VectorXd>, iNA::Eval::jit::Engine<Eigen::VectorXd,Eigen::MatrixXd> >
-          pscan(dynamic_cast<iNA::Models::IOSmodel &>(*config.getModel()),
+          pscan(dynamic_cast<iNA::Models::IOSmodel &>(*_sseModel),
                 config.getMaxIterations(), config.getEpsilon(), config.getMaxTimeStep(),0.1,config.getOptLevel());
       pscan.parameterScan(parameterSets,scanResult);
     }
     else
     {
       iNA::Models::ParameterScan<iNA::Models::IOSmodel>
-          pscan(dynamic_cast<iNA::Models::IOSmodel &>(*config.getModel()),
+          pscan(dynamic_cast<iNA::Models::IOSmodel &>(*_sseModel),
                 config.getMaxIterations(), config.getEpsilon(), config.getMaxTimeStep(),0.1,config.getOptLevel());
       pscan.parameterScan(parameterSets,scanResult);
     }
@@ -303,19 +259,19 @@ ParamScanTask::process()
       Eigen::VectorXd thirdOrder(config.getModel()->numSpecies());
 
       // Get information on initial conditions
-      iNA::Trafo::excludeType ptab = config.getModel()->makeExclusionTable(parameterSets[pid]);
-      iNA::Models::InitialConditions ICs(*config.getModel(),ptab);
+      iNA::Trafo::excludeType ptab = _sseModel->makeExclusionTable(parameterSets[pid]);
+      iNA::Models::InitialConditions ICs(*_sseModel,ptab);
 
       switch(config.getMethod())
       {
          case Config::RE_ANALYSIS:
-             dynamic_cast<iNA::Models::REmodel *>(config.getModel())->fullState(ICs,scanResult[pid], concentrations);
+             _sseModel->fullState(ICs,scanResult[pid], concentrations);
              break;
          case Config::LNA_ANALYSIS:
-             dynamic_cast<iNA::Models::LNAmodel *>(config.getModel())->fullState(ICs, scanResult[pid], concentrations, lna_covariances);
+             dynamic_cast<iNA::Models::LNAmodel *>(_sseModel)->fullState(ICs, scanResult[pid], concentrations, lna_covariances);
              break;
          case Config::IOS_ANALYSIS:
-            dynamic_cast<iNA::Models::IOSmodel *>(config.getModel())->fullState(ICs, scanResult[pid], concentrations, lna_covariances, emre_corrections,
+            dynamic_cast<iNA::Models::IOSmodel *>(_sseModel)->fullState(ICs, scanResult[pid], concentrations, lna_covariances, emre_corrections,
                            ios_covariances, thirdOrder, iosemre_corrections);
             break;
       default:
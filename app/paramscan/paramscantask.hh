@@ -32,8 +32,6 @@ public:
     } SSEMethod;
 
   protected:
-    iNA::Models::IOSmodel *_model;
-
     SSEMethod selected_method;
 
     size_t num_threads;
@@ -42,7 +40,7 @@ public:
     double max_time_step;
     double epsilon;
 
-    iNA::Ast::Parameter * parameter;
+    const iNA::Ast::Parameter * parameter;
     double start_value;
     double end_value;
     size_t steps;
@@ -54,16 +52,12 @@ public:
     /** Copy constructor. */
     Config(const Config &other);
 
-    /** Overrides the default implenentation of @c ModelSelectionTaskConfig and checks if
-     * the selected model can be used to instantiate a LNAModel. The LNA model instance is then
-     * stored in model. */
-    virtual void setModelDocument(DocumentItem *document);
-
-    /** Implements the @c SpeciesSelectionTaskConfig interface, and returns the LNA model instance. */
-    virtual iNA::Models::REmodel *getModel() const;
+    /** Implements the @c SpeciesSelectionTaskConfig interface, and returns the snapshot of the
+     * model. The analysis model is constructed from it by the task. */
+    virtual const iNA::Ast::Model *getModel() const;
 
     /** Sets the selected analysis method. This determines, which kind of analysis will be
-     * instantiated when @c setModelDocument is called. */
+     * instantiated by the task. */
     void setMethod(SSEMethod method);
     /** Returns the selected method. */
     SSEMethod getMethod() const;
@@ -86,7 +80,7 @@ public:
     void setEpsilon(double eps);
 
     inline const iNA::Ast::Parameter &getParameter() const { return *parameter; }
-    inline void setParameter(iNA::Ast::Parameter *id) { parameter = id; }
+    inline void setParameter(const iNA::Ast::Parameter *id) { parameter = id; }
     inline double getStartValue() const { return start_value; }
     inline void setStartValue(double value) { start_value = value; }
     inline double getEndValue() const { return end_value; }
@@ -94,14 +88,6 @@ public:
     size_t getSteps() const { return steps; }
     void setSteps(size_t value) { steps = value; }
     double getInterval() const { return (end_value-start_value)/steps; }
-
-  public:
-    /** The model to be analyzed. */
-    iNA::Models::REmodel *re_model;
-    /** The model to be analyzed. */
-    iNA::Models::LNAmodel *lna_model;
-    /** The model to be analyzed. */
-    iNA::Models::IOSmodel *ios_model;
   };
 
 
@@ -110,12 +96,16 @@ protected:
   Config config;
   /** Holds the number of species defined in the selected model. */
   size_t _Ns;
+  /** Holds the analysis model of the selected method, constructed from the snapshot of the
+   * model. */
+  iNA::Models::REmodel *_sseModel;
   /** Will hold the results. */
   Table parameterScan;
 
 
 public:
   explicit ParamScanTask(const Config &config, QObject *parent=0);
+  virtual ~ParamScanTask();
 
   Table &getParameterScan();
 
@@ -200,8 +200,10 @@ ParamScanResultWidget::saveAsMAT(const QString &filename) {
     return;
   }
 
+  // The table is read block-wise during serialization:
+  TableMatrixSource result(paramscan_task_wrapper->getParamScanTask()->getParameterScan());
   iNA::Utils::MatFile mat_file;
-  mat_file.add("ParamScan", paramscan_task_wrapper->getParamScanTask()->getParameterScan().matrix());
+  mat_file.add("ParamScan", result);
   mat_file.serialize(file);
   file.close();
 }
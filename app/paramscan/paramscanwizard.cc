@@ -198,7 +198,7 @@ ParameterScanConfigPage::refreshParamRange(int)
   // Get parameter
   QString idp = p_select->currentText();
   if (! config.getModel()->hasParameter(idp.toStdString())) { return; }
-  iNA::Ast::Parameter * parameter = config.getModel()->getParameter(idp.toStdString());
+  const iNA::Ast::Parameter *parameter = config.getModel()->getParameter(idp.toStdString());
 
   // Set range (if parameter has an initial value assigned)
   if(parameter->hasValue())
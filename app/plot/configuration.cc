@@ -106,7 +106,7 @@ Plot::ConfigScheme::defaultPen() const {
 /* ********************************************************************************************* *
  * Implementation of PlotConfig
  * ********************************************************************************************* */
-PlotConfig::PlotConfig(Table &data)
+PlotConfig::PlotConfig(const Table &data)
   : _title(""), _xlabel(""), _ylabel(""), _show_legend(true),
     _xRangePolicy(RangePolicy::AUTOMATIC, RangePolicy::AUTOMATIC), _xRange(0,1),
     _yRangePolicy(RangePolicy::AUTOMATIC, RangePolicy::AUTOMATIC), _yRange(0,1), _graphs(),
@@ -165,8 +165,8 @@ PlotConfig::createFigure() {
 }
 
 
-Table *
-PlotConfig::data() {
+const Table *
+PlotConfig::data() const {
   return &_data;
 }
 
@@ -371,7 +371,7 @@ QList<QColor> AbstractGraphConfig::defaultColors = QList<QColor>()
 /* ********************************************************************************************* *
  * Implementation of LineGraphConfig
  * ********************************************************************************************* */
-LineGraphConfig::LineGraphConfig(Table *data, size_t colorIdx)
+LineGraphConfig::LineGraphConfig(const Table *data, size_t colorIdx)
   : AbstractGraphConfig(), _data(data), _columnNames(), _parserContext(_data), _symbolTable(),
     _xExpression(0), _xCode(), _xInterpreter(),
     _yExpression(0), _yCode(), _yInterpreter(), _linePen()
@@ -393,7 +393,7 @@ LineGraphConfig::LineGraphConfig(Table *data, size_t colorIdx)
   LineGraphConfig::compileExpressions();
 }
 
-LineGraphConfig::LineGraphConfig(const LineGraphConfig &other, Table *data)
+LineGraphConfig::LineGraphConfig(const LineGraphConfig &other, const Table *data)
   : AbstractGraphConfig(other), _data(data), _columnNames(other._columnNames),
     _parserContext(_data), _symbolTable(), _xExpression(0), _yExpression(0),
     _linePen(other._linePen)
@@ -434,6 +434,23 @@ LineGraphConfig::compileExpressions() {
   compiler.finalize(0); _yInterpreter.setCode(&_yCode);
 }
 
+void
+LineGraphConfig::collectColumns(std::set<size_t> &columns) const {
+  std::map<GiNaC::symbol, size_t>::const_iterator item = _symbolTable.begin();
+  for (; item!=_symbolTable.end(); item++) {
+    if (_xExpression.has(item->first) || _yExpression.has(item->first)) {
+      columns.insert(item->second);
+    }
+  }
+}
+
+void
+LineGraphConfig::readColumns(std::vector<size_t> &columns, Eigen::MatrixXd &values) const {
+  std::set<size_t> referred; collectColumns(referred);
+  columns.assign(referred.begin(), referred.end());
+  values = _data->getColumns(columns);
+}
+
 AbstractGraphConfig *
 LineGraphConfig::copy(PlotConfig *config) const {
   return new LineGraphConfig(*this, config->data());
@@ -491,13 +508,17 @@ LineGraphConfig::createGraph() {
   GraphStyle style(_linePen.style(), _linePen.brush().color(), _linePen.width());
   LineGraph *graph = new LineGraph(style);
 
-  /// @bug This implementation is f***ing slow!!!
-  Eigen::VectorXd output(1);
+  // Read referred columns only:
+  std::vector<size_t> columns; Eigen::MatrixXd values;
+  readColumns(columns, values);
+
   // Evaluate y & x expressions on data:
+  Eigen::VectorXd row = Eigen::VectorXd::Zero(_data->getNumColumns()), output(1);
   double x,y;
-  for (size_t i=0; i<_data->getNumRows(); i++) {
-    _xInterpreter.run(_data->getRow(i), output); x = output(0);
-    _yInterpreter.run(_data->getRow(i), output); y = output(0);
+  for (int i=0; i<values.rows(); i++) {
+    for (size_t j=0; j<columns.size(); j++) { row(columns[j]) = values(i,j); }
+    _xInterpreter.run(row, output); x = output(0);
+    _yInterpreter.run(row, output); y = output(0);
     graph->addPoint(x,y);
   }
   graph->commit();
@@ -527,7 +548,7 @@ LineGraphConfig::linePen() const {
 /* ********************************************************************************************* *
  * Implementation of VarianceLineGraphConfig
  * ********************************************************************************************* */
-VarianceLineGraphConfig::VarianceLineGraphConfig(Table *data, size_t colorIdx)
+VarianceLineGraphConfig::VarianceLineGraphConfig(const Table *data, size_t colorIdx)
   : LineGraphConfig(data, colorIdx), _varExpression(0), _fillPen()
 {
   QColor fill_color = _linePen.brush().color(); fill_color.setAlpha(32);
@@ -535,7 +556,7 @@ VarianceLineGraphConfig::VarianceLineGraphConfig(Table *data, size_t colorIdx)
   VarianceLineGraphConfig::compileExpressions();
 }
 
-VarianceLineGraphConfig::VarianceLineGraphConfig(const VarianceLineGraphConfig &other, Table *data)
+VarianceLineGraphConfig::VarianceLineGraphConfig(const VarianceLineGraphConfig &other, const Table *data)
   : LineGraphConfig(other, data), _varExpression(0), _fillPen(other._fillPen)
 {
   GiNaC::exmap substTable;
@@ -564,6 +585,15 @@ VarianceLineGraphConfig::compileExpressions() {
   compiler.finalize(0); _varInterpreter.setCode(&_varCode);
 }
 
+void
+VarianceLineGraphConfig::collectColumns(std::set<size_t> &columns) const {
+  LineGraphConfig::collectColumns(columns);
+  std::map<GiNaC::symbol, size_t>::const_iterator item = _symbolTable.begin();
+  for (; item!=_symbolTable.end(); item++) {
+    if (_varExpression.has(item->first)) { columns.insert(item->second); }
+  }
+}
+
 AbstractGraphConfig *
 VarianceLineGraphConfig::copy(PlotConfig *config) const {
   return new VarianceLineGraphConfig(*this);
@@ -574,12 +604,18 @@ VarianceLineGraphConfig::createGraph() {
   GraphStyle style(_linePen.style(), _linePen.brush().color(), _linePen.width());
   VarianceLineGraph *graph = new VarianceLineGraph(style);
 
+  // Read referred columns only:
+  std::vector<size_t> columns; Eigen::MatrixXd values;
+  readColumns(columns, values);
+
   // Evaluate y, x and var expressions on data:
-  double x,y,v; Eigen::VectorXd output(1);
-  for (size_t i=0; i<_data->getNumRows(); i++) {
-    _xInterpreter.run(_data->getRow(i), output); x = output(0);
-    _yInterpreter.run(_data->getRow(i), output); y = output(0);
-    _varInterpreter.run(_data->getRow(i), output); v = output(0);
+  Eigen::VectorXd row = Eigen::VectorXd::Zero(_data->getNumColumns()), output(1);
+  double x,y,v;
+  for (int i=0; i<values.rows(); i++) {
+    for (size_t j=0; j<columns.size(); j++) { row(columns[j]) = values(i,j); }
+    _xInterpreter.run(row, output); x = output(0);
+    _yInterpreter.run(row, output); y = output(0);
+    _varInterpreter.run(row, output); v = output(0);
     graph->addPoint(x,y, std::sqrt(v));
   }
   graph->commit();
@@ -6,6 +6,8 @@
 #include "../models/timeseries.hh"
 #include "formulaparser.hh"
 #include <ginac/ginac.h>
+#include <set>
+#include <vector>
 #include <eval/bci/bci.hh>
 #include <parser/exception.hh>
 #include "mapping.hh"
@@ -140,7 +142,7 @@ public:
 
 public:
   /** Constructs a default plot config. */
-  PlotConfig(Table &data);
+  PlotConfig(const Table &data);
   /** Copy constructor. */
   PlotConfig(const PlotConfig &other);
   /** Destroys the plot config an all graphs. */
@@ -150,7 +152,7 @@ public:
   Figure *createFigure();
 
   /** Returns a weak reference to the data. */
-  Table *data();
+  const Table *data() const;
 
   /** Returns true if a plot title is set. */
   bool hasTitle() const;
@@ -243,9 +245,9 @@ class LineGraphConfig : public AbstractGraphConfig
 {
 public:
   /** Empty constructor. */
-  LineGraphConfig(Table *data, size_t colorIdx);
+  LineGraphConfig(const Table *data, size_t colorIdx);
   /** Copy constructor. */
-  LineGraphConfig(const LineGraphConfig &other, Table *data);
+  LineGraphConfig(const LineGraphConfig &other, const Table *data);
   /** Destructor. */
   ~LineGraphConfig();
 
@@ -288,10 +290,14 @@ public:
 protected:
   /** Internal used method to compile the stored expressions. */
   virtual void compileExpressions();
+  /** Collects the indices of the columns referred by the expressions. */
+  virtual void collectColumns(std::set<size_t> &columns) const;
+  /** Reads only the columns referred by the expressions from the data table. */
+  void readColumns(std::vector<size_t> &columns, Eigen::MatrixXd &values) const;
 
 protected:
   /** Holds a weak reference to the data to be used for plotting. */
-  Table *_data;
+  const Table *_data;
   /** Holds the list of column names. */
   QStringList _columnNames;
   /** Holds the parser context for plot formulas. */
@@ -321,9 +327,9 @@ class VarianceLineGraphConfig: public LineGraphConfig
 {
 public:
   /** Default constructor. */
-  VarianceLineGraphConfig(Table *data, size_t colorIdx);
+  VarianceLineGraphConfig(const Table *data, size_t colorIdx);
   /** Copy constructor. */
-  VarianceLineGraphConfig(const VarianceLineGraphConfig &other, Table *data);
+  VarianceLineGraphConfig(const VarianceLineGraphConfig &other, const Table *data);
   /** Destructor. */
   virtual ~VarianceLineGraphConfig();
 
@@ -349,6 +355,8 @@ public:
 protected:
   /** Internal used method to compile plot formulas. */
   virtual void compileExpressions();
+  /** Collects the indices of the columns referred by the expressions. */
+  virtual void collectColumns(std::set<size_t> &columns) const;
 
 protected:
   /** Holds the variance expression. */
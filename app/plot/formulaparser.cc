@@ -32,7 +32,7 @@ public:
 /* ******************************************************************************************** *
  * Implementation of PlotFormulaParser::Context
  * ******************************************************************************************** */
-FormulaParser::Context::Context(Table *table)
+FormulaParser::Context::Context(const Table *table)
   : _table(table)
 {
   // Assign for each column a symbol.
@@ -20,7 +20,7 @@ public:
   class Context: public iNA::Parser::Expr::Context {
   public:
     /** Constructor. */
-    Context(Table *table);
+    Context(const Table *table);
     /** Copy constructor. */
     Context(const Context &other);
     /** Implements the Context interface, resolves the given identifier to a @c GiNaC::symbol */
@@ -36,7 +36,7 @@ public:
 
   private:
     /** Holds the data table. */
-    Table *_table;
+    const Table *_table;
     /** Holds a vector of GiNaC::symbols for each column of the data table. */
     std::vector<GiNaC::symbol> _symbols;
     /** Maps symbols to column indices. */
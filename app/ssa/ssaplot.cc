@@ -8,7 +8,7 @@
 Plot::PlotConfig *
 createSSAPlotConfig(const QStringList &selected_species, SSATask *task)
 {
-  Table &series = task->getTimeSeries();
+  const Table &series = task->getTimeSeries();
   Plot::PlotConfig *config = new Plot::PlotConfig(series);
 
   size_t Ntot = task->getModel()->numSpecies();
@@ -55,7 +55,7 @@ createSSAPlotConfig(const QStringList &selected_species, SSATask *task)
 Plot::PlotConfig *
 createSSACorrelationPlotConfig(const QStringList &selected_species, SSATask *task)
 {
-  Table &series = task->getTimeSeries();
+  const Table &series = task->getTimeSeries();
   Plot::PlotConfig *config = new Plot::PlotConfig(series);
 
   // Serialize unit of species:
@@ -17,7 +17,8 @@ SSATaskConfig::SSATaskConfig()
 SSATaskConfig::SSATaskConfig(const SSATaskConfig &other)
   : GeneralTaskConfig(), ModelSelectionTaskConfig(other),
     EngineTaskConfig(other), _method(other._method), _ensemble_size(other._ensemble_size),
-    _final_time(other._final_time), _steps(other._steps), _simulator(other._simulator)
+    _final_time(other._final_time), _steps(other._steps),
+    _simulator(other._simulator)
 {
   // Pass...
 }
@@ -30,19 +31,10 @@ SSATaskConfig::getSimulator() const
 }
 
 
-void
-SSATaskConfig::setModelDocument(DocumentItem *document)
-{
-  ModelSelectionTaskConfig::setModelDocument(document);
-  // create copy of model:
-  _model = new iNA::Ast::Model(getModelDocument()->getModel());
-}
-
-
-Ast::Model *
+const Ast::Model *
 SSATaskConfig::getModel() const
 {
-  return _model;
+  return &(*_model);
 }
 
 
@@ -32,8 +32,9 @@ public:
   iNA::Models::StochasticSimulator *getSimulator() const;
   void setSimulator(iNA::Models::StochasticSimulator *sim);
 
-  virtual void setModelDocument(DocumentItem *document);
-  virtual iNA::Ast::Model *getModel() const;
+  /** Returns the snapshot of the model, shared with all tasks configured on the same revision of
+   * the document. */
+  virtual const iNA::Ast::Model *getModel() const;
 
   SSAMethod getMethod() const;
   void setMethod(SSAMethod meth);
@@ -53,7 +54,6 @@ protected:
   size_t      _ensemble_size;
   double      _final_time;
   size_t      _steps;
-  iNA::Ast::Model *_model;
   iNA::Models::StochasticSimulator *_simulator;
 };
 
@@ -151,8 +151,10 @@ SSAResultWidget::saveAsMAT(const QString &filename) {
     return;
   }
 
+  // The table is read block-wise during serialization:
+  TableMatrixSource result(this->ssa_task_wrapper->getSSATask()->getTimeSeries());
   iNA::Utils::MatFile mat_file;
-  mat_file.add("SSA_result", this->ssa_task_wrapper->getSSATask()->getTimeSeries().matrix());
+  mat_file.add("SSA_result", result);
   mat_file.serialize(file);
   file.close();
 }
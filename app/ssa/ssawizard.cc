@@ -240,13 +240,13 @@ SSASummaryPage::validatePage()
       switch (config.getMethod()) {
       case SSATaskConfig::DIRECT_SSA:
         simulator = new Models::GenericGillespieSSA< Eval::direct::Engine<Eigen::VectorXd> >(
-              config.getModelDocument()->getModel(), config.getEnsembleSize(), time(0),
+              *config.getModel(), config.getEnsembleSize(), time(0),
               config.getOptLevel(), config.getNumEvalThreads());
         break;
 
       case SSATaskConfig::OPTIMIZED_SSA:
         simulator = new Models::GenericOptimizedSSA< Eval::direct::Engine<Eigen::VectorXd> >(
-              config.getModelDocument()->getModel(), config.getEnsembleSize(), time(0),
+              *config.getModel(), config.getEnsembleSize(), time(0),
               config.getOptLevel(), config.getNumEvalThreads());
         break;
 
@@ -258,13 +258,13 @@ SSASummaryPage::validatePage()
       switch (config.getMethod()) {
       case SSATaskConfig::DIRECT_SSA:
         simulator = new Models::GenericGillespieSSA< Eval::bci::Engine<Eigen::VectorXd> >(
-              config.getModelDocument()->getModel(), config.getEnsembleSize(), time(0),
+              *config.getModel(), config.getEnsembleSize(), time(0),
               config.getOptLevel(), config.getNumEvalThreads());
         break;
 
       case SSATaskConfig::OPTIMIZED_SSA:
         simulator = new Models::GenericOptimizedSSA< Eval::bci::Engine<Eigen::VectorXd> >(
-              config.getModelDocument()->getModel(), config.getEnsembleSize(), time(0),
+              *config.getModel(), config.getEnsembleSize(), time(0),
               config.getOptLevel(), config.getNumEvalThreads());
         break;
 
@@ -274,13 +274,13 @@ SSASummaryPage::validatePage()
       switch (config.getMethod()) {
       case SSATaskConfig::DIRECT_SSA:
         simulator = new Models::GenericGillespieSSA< Eval::jit::Engine<Eigen::VectorXd> >(
-              config.getModelDocument()->getModel(), config.getEnsembleSize(), time(0),
+              *config.getModel(), config.getEnsembleSize(), time(0),
               config.getOptLevel(), config.getNumEvalThreads());
         break;
 
       case SSATaskConfig::OPTIMIZED_SSA:
         simulator = new Models::GenericOptimizedSSA< Eval::jit::Engine<Eigen::VectorXd> >(
-              config.getModelDocument()->getModel(), config.getEnsembleSize(), time(0),
+              *config.getModel(), config.getEnsembleSize(), time(0),
               config.getOptLevel(), config.getNumEvalThreads());
         break;
 
@@ -14,7 +14,7 @@ Plot::PlotConfig *
 createSSAParameterScanPlotConfig(const QStringList &selected_species, SSAParamScanTask *task)
 {
   // Get parameter scan table & create config
-  Table &data = task->getParameterScan();
+  const Table &data = task->getParameterScan();
   Plot::PlotConfig *config = new Plot::PlotConfig(data);
 
   // Get species units:
@@ -66,7 +66,7 @@ Plot::PlotConfig *
 createSSAParameterScanCVPlotConfig(const QStringList &selected_species, SSAParamScanTask *task)
 {
   // Get parameter scan table and config
-  Table &data = task->getParameterScan();
+  const Table &data = task->getParameterScan();
   Plot::PlotConfig *config = new Plot::PlotConfig(data);
 
   // Number of species in model
@@ -114,7 +114,7 @@ Plot::PlotConfig *
 createSSAParameterScanFanoPlotConfig(const QStringList &selected_species, SSAParamScanTask *task)
 {
   // Get parameter scan table & config
-  Table &data = task->getParameterScan();
+  const Table &data = task->getParameterScan();
   Plot::PlotConfig *config = new Plot::PlotConfig(data);
 
   // Number of species in model
@@ -126,7 +126,7 @@ createSSAParameterScanFanoPlotConfig(const QStringList &selected_species, SSAPar
   config->setXLabel(QObject::tr("%1").arg(data.getColumnName(0)));
   config->setYLabel(QObject::tr("$F_Fano$"));
 
-  iNA::Ast::Model *model = task->getConfig().getModel();
+  const iNA::Ast::Model *model = task->getConfig().getModel();
   // Assemble a constant folder, that excludes the paramter we scan over:
   GiNaC::exmap excludeFromICFold;
   GiNaC::ex parameterSymbol = task->getConfig().getParameter().getSymbol();
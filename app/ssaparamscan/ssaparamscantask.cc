@@ -7,7 +7,6 @@
  * ******************************************************************************************* */
 SSAParamScanTask::Config::Config()
   : GeneralTaskConfig(), ModelSelectionTaskConfig(), EngineTaskConfig(),
-    _model(0),
     parameter(), start_value(0), end_value(1), steps(1),
     t_transient(0), t_max(0), timestep(0),
     num_threads(0)
@@ -17,7 +16,6 @@ SSAParamScanTask::Config::Config()
 
 SSAParamScanTask::Config::Config(const Config &other)
   : GeneralTaskConfig(), ModelSelectionTaskConfig(other), EngineTaskConfig(other),
-    _model(other._model),
     parameter(other.parameter), start_value(other.start_value), end_value(other.end_value), steps(other.steps),
     t_transient(other.t_transient), t_max(other.t_max), timestep(other.timestep),
     num_threads(other.num_threads)
@@ -30,20 +28,13 @@ SSAParamScanTask::Config::setModelDocument(DocumentItem *document)
 {
   ModelSelectionTaskConfig::setModelDocument(document);
 
-  // Try to construct SSA model from SBML model associated with the selected document
-  iNA::Models::OptimizedSSA *test_ssa
-      = new iNA::Models::OptimizedSSA(document->getModel(),1, 1024);
-  delete test_ssa;
-
-  this->_model = &(document->getModel());
-
-  ModelSelectionTaskConfig::setModelDocument(document);
-
+  // Try to construct SSA model from the snapshot of the selected model
+  iNA::Models::OptimizedSSA test_ssa(*_model, 1, 1024);
 }
 
-iNA::Ast::Model *SSAParamScanTask::Config::getModel() const
+const iNA::Ast::Model *SSAParamScanTask::Config::getModel() const
 {
-    return this->_model;
+    return &(*_model);
 }
 
 void
@@ -174,12 +165,12 @@ SSAParamScanTask::process()
   {
      case EngineTaskConfig::JIT_ENGINE:
         _pscan = new iNA::Models::SSAparamScan< iNA::Eval::jit::Engine<Eigen::VectorXd> >
-                      (dynamic_cast<iNA::Ast::Model &>(*config.getModel()),
+                      (config.getModelSnapshot(),
                       _parameterSets, config.getTransientTime(), config.getNumThreads(),config.getOptLevel());
         break;
      default:
         _pscan = new iNA::Models::SSAparamScan< iNA::Eval::bci::Engine<Eigen::VectorXd> >
-                      (dynamic_cast<iNA::Ast::Model &>(*config.getModel()),
+                      (config.getModelSnapshot(),
                       _parameterSets, config.getTransientTime(), config.getNumThreads(),config.getOptLevel());
         break;
   }
@@ -26,10 +26,8 @@ public:
   {
 
   protected:
-    /** The model to scan. */
-    iNA::Ast::Model *_model;
     /** The parameter we scan. */
-    iNA::Ast::Parameter * parameter;
+    const iNA::Ast::Parameter * parameter;
     /** Start value of the parameter. */
     double start_value;
     /** End value of the parameter. */
@@ -50,12 +48,12 @@ public:
     Config(const Config &other);
 
     /** Overrides the default implenentation of @c ModelSelectionTaskConfig and checks if
-     * the selected model can be used to instantiate a LNAModel. The LNA model instance is then
-     * stored in model. */
+     * the snapshot of the selected model can be used to instantiate a SSA. */
     virtual void setModelDocument(DocumentItem *document);
 
-    /** Implements the @c SpeciesSelectionTaskConfig interface, and returns the LNA model instance. */
-    virtual iNA::Ast::Model *getModel() const;
+    /** Implements the @c SpeciesSelectionTaskConfig interface, and returns the snapshot of the
+     * model. */
+    virtual const iNA::Ast::Model *getModel() const;
 
     /** Sets the number of threads for OpenMP. */
     void setNumThreads(size_t num);
@@ -76,7 +74,7 @@ public:
     void setTransientTime(double t_transient);
 
     inline const iNA::Ast::Parameter &getParameter() const { return *parameter; }
-    inline void setParameter(iNA::Ast::Parameter *id) { parameter = id; }
+    inline void setParameter(const iNA::Ast::Parameter *id) { parameter = id; }
     inline double getStartValue() const { return start_value; }
     inline void setStartValue(double value) { start_value = value; }
     inline double getEndValue() const { return end_value; }
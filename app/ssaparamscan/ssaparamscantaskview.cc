@@ -179,9 +179,10 @@ SSAParamScanResultWidget::saveAsMAT(const QString &filename) {
   }
 
   // Store data as matrix in MAT file:
+  // The table is read block-wise during serialization:
+  TableMatrixSource result(paramscan_task_wrapper->getParamScanTask()->getParameterScan());
   iNA::Utils::MatFile mat_file;
-  mat_file.add("SSA_param_scan",
-               paramscan_task_wrapper->getParamScanTask()->getParameterScan().matrix());
+  mat_file.add("SSA_param_scan", result);
   mat_file.serialize(file);
   file.close();
 }
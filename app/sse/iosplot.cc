@@ -11,7 +11,7 @@
 Plot::PlotConfig *
 createIOSEMRETimeSeriesPlotConfig(const QStringList &selected_species, IOSTask *task)
 {
-  Table *series = task->getTimeSeries();
+  const Table *series = task->getTimeSeries();
   Plot::PlotConfig *config = new Plot::PlotConfig(*series);
 
   // Get time & species units and assemble axis labels
@@ -30,7 +30,7 @@ createIOSEMRETimeSeriesPlotConfig(const QStringList &selected_species, IOSTask *
   }
 
   // Determine some numbers
-  iNA::Ast::Model *model = task->getConfig().getModel();
+  const iNA::Ast::Model *model = task->getConfig().getModel();
   size_t Nss = selected_species.size();
   size_t Ns = model->numSpecies();    // Number of species in model
   size_t offset = 1+Ns+(Ns*(Ns+1))/2; // skip time, RE & LNA
@@ -60,7 +60,7 @@ createIOSEMRETimeSeriesPlotConfig(const QStringList &selected_species, IOSTask *
 Plot::PlotConfig *
 createIOSEMREComparePlotConfig(const QStringList &selected_species, IOSTask *task)
 {
-  Table *series = task->getTimeSeries();
+  const Table *series = task->getTimeSeries();
   Plot::PlotConfig *config = new Plot::PlotConfig(*series);
 
   // Get time & species units and assemble axis labels
@@ -78,7 +78,7 @@ createIOSEMREComparePlotConfig(const QStringList &selected_species, IOSTask *tas
     config->setYLabel(QObject::tr("amount [%1]").arg(species_unit));
   }
 
-  iNA::Ast::Model *model = task->getConfig().getModel();
+  const iNA::Ast::Model *model = task->getConfig().getModel();
   size_t Ntot  = model->numSpecies();
   size_t Nsel = selected_species.size();
   size_t off_re   = 1;
@@ -122,7 +122,7 @@ createIOSEMREComparePlotConfig(const QStringList &selected_species, IOSTask *tas
 Plot::PlotConfig *
 createIOSEMRECorrelationPlotConfig(const QStringList &selected_species, IOSTask *task)
 {
-  Table *series = task->getTimeSeries();
+  const Table *series = task->getTimeSeries();
   Plot::PlotConfig *config = new Plot::PlotConfig(*series);
 
   std::stringstream unit_str;
@@ -132,7 +132,7 @@ createIOSEMRECorrelationPlotConfig(const QStringList &selected_species, IOSTask
   config->setXLabel(QObject::tr("time [%1]").arg(time_unit));
   config->setYLabel(QObject::tr("correlation coefficient"));
 
-  iNA::Ast::Model *model = task->getConfig().getModel();
+  const iNA::Ast::Model *model = task->getConfig().getModel();
   size_t Nss = selected_species.size();
   size_t Ns = model->numSpecies();
 
@@ -10,7 +10,7 @@ using namespace iNA;
  * ******************************************************************************************** */
 IOSTask::IOSTask(const SSETaskConfig &config, QObject *parent) :
   Task(parent), config(config), _Ns(config.getModel()->numSpecies()),
-  interpreter(0),
+  interpreter(0), stepper(0), steady_state(0),
   timeseries(
     1 + 3*_Ns + _Ns*(_Ns+1),
     1+config.getIntegrationRange().getSteps()/(1+config.getIntermediateSteps())),
@@ -84,6 +84,10 @@ IOSTask::~IOSTask()
   if (0 != this->stepper)
     delete stepper;
 
+  // Free steady-state event:
+  if (0 != this->steady_state)
+    delete steady_state;
+
   // Free interpreter
   if (0 != this->interpreter)
     delete interpreter;
@@ -146,7 +150,15 @@ IOSTask::process()
    * Perform integration
    */
   double t  = config.getIntegrationRange().getStartTime();
-  double dt = config.getIntegrationRange().getStepSize();
+  // Integrates over the range, interpolates the output states if the stepper supports it:
+  ODE::DenseOutputDriver driver(*this->stepper, config.getIntegrationRange());
+  // Stop the integration once the steady state is reached, if requested:
+  if (config.getStopAtSteadyState()) {
+    this->stepper->addEvent(this->steady_state);
+  }
+  // Measure the time spent in each phase of the integration:
+  this->stepper->statistics().setTiming(true);
+  bool steady = driver.start(x);
 
   // store initial state:
   output_vector(0) = t;
@@ -165,7 +177,7 @@ IOSTask::process()
   // Integration loop:
   size_t N_steps = config.getIntegrationRange().getSteps();
   size_t N_intermediate = config.getIntermediateSteps();
-  for (size_t s=0; s<N_steps; s++)
+  for (size_t s=0; (s<N_steps) && (! steady); s++)
   {
     // Check if task shall terminate:
     if (Task::TERMINATING == this->getState()) {
@@ -176,10 +188,10 @@ IOSTask::process()
     this->setProgress(double(s)/N_steps);
 
     // Update state & time
-    this->stepper->step(x, t); t += dt;
+    steady = driver.next(x, t);
 
-    // Skip immediate steps
-    if(0 != N_intermediate && 0 != s%(1+N_intermediate)) {
+    // Skip immediate steps (but store the steady state)
+    if(! steady && 0 != N_intermediate && 0 != s%(1+N_intermediate)) {
       continue;
     }
 
@@ -208,6 +220,17 @@ IOSTask::process()
     this->timeseries.append(output_vector);
   }
 
+  this->stepper->clearEvents();
+
+  this->statistics = this->stepper->statistics();
+  this->statistics.log("IOS integrator statistics");
+
+  if (steady) {
+    Utils::Message message = LOG_MESSAGE(Utils::Message::INFO);
+    message << "Reached steady state at t=" << t << ".";
+    Utils::Logger::get().log(message);
+  }
+
   // Finally send last progress event:
   this->setProgress(1.0);
   this->setState(Task::DONE);
@@ -226,6 +249,12 @@ IOSTask::getLabel() {
 }
 
 
+const iNA::ODE::StepperStatistics &
+IOSTask::getStatistics() const {
+  return this->statistics;
+}
+
+
 Table *
 IOSTask::getTimeSeries() {
   return &(this->timeseries);
@@ -264,7 +293,8 @@ void
 IOSTask::instantiateInterpreter()
 {
   /*
-   * First, construct interpreter and integerator by selected execution engine:
+   * First, construct interpreter and integerator by selected execution engine. The IOS system is
+   * large, hence the byte-code engines compile it using as many worker processes as threads.
    */
   switch(config.getEngine()) {
 
@@ -275,7 +305,7 @@ IOSTask::instantiateInterpreter()
         Models::IOSmodel, Eval::direct::Engine<Eigen::VectorXd, Eigen::VectorXd>,
         Eval::direct::Engine<Eigen::VectorXd, Eigen::MatrixXd> >(
           *_sseModel,
-          config.getOptLevel(), config.getNumEvalThreads(), false);
+          config.getOptLevel(), config.getNumEvalThreads(), false, config.getNumEvalThreads());
 
     // Instantiate integrator for that engine:
     switch (config.getIntegrator()) {
@@ -323,15 +353,78 @@ IOSTask::instantiateInterpreter()
       break;
 
     case SSETaskConfig::Rosenbrock4:
-      // First, let Interpreter compile the jacobian
-      static_cast<Models::GenericSSEinterpreter<
-          Models::IOSmodel, Eval::direct::Engine<Eigen::VectorXd, Eigen::VectorXd>,
-          Eval::direct::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter)->compileJacobian();
+      // Large IOS systems have a sparse Jacobian, use a sparse LU decomposition for them:
+      if (_sseModel->getDimension() >= IOSTask::sparseJacobianDimension) {
+        // First, let Interpreter compile the sparse jacobian, then setup integrator:
+        static_cast<Models::GenericSSEinterpreter<
+            Models::IOSmodel, Eval::direct::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::direct::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter)->compileSparseJacobian();
+        this->stepper = new ODE::SparseRosenbrock4TimeInd< Models::GenericSSEinterpreter<
+            Models::IOSmodel, Eval::direct::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::direct::Engine<Eigen::VectorXd, Eigen::MatrixXd> > >(
+              *static_cast< Models::GenericSSEinterpreter<
+              Models::IOSmodel, Eval::direct::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+              Eval::direct::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter),
+              config.getIntegrationRange().getStepSize(),
+              config.getEpsilonAbs(), config.getEpsilonRel());
+      } else {
+        // First, let Interpreter compile the jacobian, then setup integrator:
+        static_cast<Models::GenericSSEinterpreter<
+            Models::IOSmodel, Eval::direct::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::direct::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter)->compileJacobian();
+        this->stepper = new ODE::Rosenbrock4TimeInd< Models::GenericSSEinterpreter<
+            Models::IOSmodel, Eval::direct::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::direct::Engine<Eigen::VectorXd, Eigen::MatrixXd> > >(
+              *static_cast< Models::GenericSSEinterpreter<
+              Models::IOSmodel, Eval::direct::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+              Eval::direct::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter),
+              config.getIntegrationRange().getStepSize(),
+              config.getEpsilonAbs(), config.getEpsilonRel());
+      }
+      break;
+
+    case SSETaskConfig::BDF:
+      // Large IOS systems have a sparse Jacobian, use a sparse LU decomposition for them:
+      if (_sseModel->getDimension() >= IOSTask::sparseJacobianDimension) {
+        // First, let Interpreter compile the sparse jacobian, then setup integrator:
+        static_cast<Models::GenericSSEinterpreter<
+            Models::IOSmodel, Eval::direct::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::direct::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter)->compileSparseJacobian();
+        this->stepper = new ODE::BDFStepper< Models::GenericSSEinterpreter<
+            Models::IOSmodel, Eval::direct::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::direct::Engine<Eigen::VectorXd, Eigen::MatrixXd> >,
+            ODE::BDFSparseSolver< Models::GenericSSEinterpreter<
+            Models::IOSmodel, Eval::direct::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::direct::Engine<Eigen::VectorXd, Eigen::MatrixXd> > > >(
+              *static_cast< Models::GenericSSEinterpreter<
+              Models::IOSmodel, Eval::direct::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+              Eval::direct::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter),
+              config.getIntegrationRange().getStepSize(),
+              config.getEpsilonAbs(), config.getEpsilonRel());
+      } else {
+        // First, let Interpreter compile the jacobian, then setup integrator:
+        static_cast<Models::GenericSSEinterpreter<
+            Models::IOSmodel, Eval::direct::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::direct::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter)->compileJacobian();
+        this->stepper = new ODE::BDFStepper< Models::GenericSSEinterpreter<
+            Models::IOSmodel, Eval::direct::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::direct::Engine<Eigen::VectorXd, Eigen::MatrixXd> > >(
+              *static_cast< Models::GenericSSEinterpreter<
+              Models::IOSmodel, Eval::direct::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+              Eval::direct::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter),
+              config.getIntegrationRange().getStepSize(),
+              config.getEpsilonAbs(), config.getEpsilonRel());
+      }
+      break;
 
-      // Then, setup integrator:
-      this->stepper = new ODE::Rosenbrock4TimeInd< Models::GenericSSEinterpreter<
+    case SSETaskConfig::BDFKrylov:
+      // The Jacobian-free linear solver needs no compiled Jacobian:
+      this->stepper = new ODE::BDFStepper< Models::GenericSSEinterpreter<
           Models::IOSmodel, Eval::direct::Engine<Eigen::VectorXd, Eigen::VectorXd>,
-          Eval::direct::Engine<Eigen::VectorXd, Eigen::MatrixXd> > >(
+          Eval::direct::Engine<Eigen::VectorXd, Eigen::MatrixXd> >,
+          ODE::BDFGMRESSolver< Models::GenericSSEinterpreter<
+          Models::IOSmodel, Eval::direct::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+          Eval::direct::Engine<Eigen::VectorXd, Eigen::MatrixXd> > > >(
             *static_cast< Models::GenericSSEinterpreter<
             Models::IOSmodel, Eval::direct::Engine<Eigen::VectorXd, Eigen::VectorXd>,
             Eval::direct::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter),
@@ -348,7 +441,7 @@ IOSTask::instantiateInterpreter()
         Models::IOSmodel, Eval::bci::Engine<Eigen::VectorXd, Eigen::VectorXd>,
         Eval::bci::Engine<Eigen::VectorXd, Eigen::MatrixXd> >(
           *_sseModel,
-          config.getOptLevel(), config.getNumEvalThreads(), false);
+          config.getOptLevel(), config.getNumEvalThreads(), false, config.getNumEvalThreads());
 
     // Instantiate integrator for that engine:
     switch (config.getIntegrator()) {
@@ -396,15 +489,78 @@ IOSTask::instantiateInterpreter()
         break;
 
       case SSETaskConfig::Rosenbrock4:
-        // First, let Interpreter compile the jacobian
-        static_cast<Models::GenericSSEinterpreter<
-            Models::IOSmodel, Eval::bci::Engine<Eigen::VectorXd, Eigen::VectorXd>,
-            Eval::bci::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter)->compileJacobian();
+        // Large IOS systems have a sparse Jacobian, use a sparse LU decomposition for them:
+        if (_sseModel->getDimension() >= IOSTask::sparseJacobianDimension) {
+          // First, let Interpreter compile the sparse jacobian, then setup integrator:
+          static_cast<Models::GenericSSEinterpreter<
+              Models::IOSmodel, Eval::bci::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+              Eval::bci::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter)->compileSparseJacobian();
+          stepper = new ODE::SparseRosenbrock4TimeInd< Models::GenericSSEinterpreter<
+              Models::IOSmodel, Eval::bci::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+              Eval::bci::Engine<Eigen::VectorXd, Eigen::MatrixXd> > >(
+                *static_cast< Models::GenericSSEinterpreter<
+                Models::IOSmodel, Eval::bci::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+                Eval::bci::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter),
+                config.getIntegrationRange().getStepSize(),
+                config.getEpsilonAbs(), config.getEpsilonRel());
+        } else {
+          // First, let Interpreter compile the jacobian, then setup integrator:
+          static_cast<Models::GenericSSEinterpreter<
+              Models::IOSmodel, Eval::bci::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+              Eval::bci::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter)->compileJacobian();
+          stepper = new ODE::Rosenbrock4TimeInd< Models::GenericSSEinterpreter<
+              Models::IOSmodel, Eval::bci::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+              Eval::bci::Engine<Eigen::VectorXd, Eigen::MatrixXd> > >(
+                *static_cast< Models::GenericSSEinterpreter<
+                Models::IOSmodel, Eval::bci::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+                Eval::bci::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter),
+                config.getIntegrationRange().getStepSize(),
+                config.getEpsilonAbs(), config.getEpsilonRel());
+        }
+        break;
 
-        // Then, setup integrator:
-        stepper = new ODE::Rosenbrock4TimeInd< Models::GenericSSEinterpreter<
+      case SSETaskConfig::BDF:
+        // Large IOS systems have a sparse Jacobian, use a sparse LU decomposition for them:
+        if (_sseModel->getDimension() >= IOSTask::sparseJacobianDimension) {
+          // First, let Interpreter compile the sparse jacobian, then setup integrator:
+          static_cast<Models::GenericSSEinterpreter<
+              Models::IOSmodel, Eval::bci::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+              Eval::bci::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter)->compileSparseJacobian();
+          stepper = new ODE::BDFStepper< Models::GenericSSEinterpreter<
+              Models::IOSmodel, Eval::bci::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+              Eval::bci::Engine<Eigen::VectorXd, Eigen::MatrixXd> >,
+              ODE::BDFSparseSolver< Models::GenericSSEinterpreter<
+              Models::IOSmodel, Eval::bci::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+              Eval::bci::Engine<Eigen::VectorXd, Eigen::MatrixXd> > > >(
+                *static_cast< Models::GenericSSEinterpreter<
+                Models::IOSmodel, Eval::bci::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+                Eval::bci::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter),
+                config.getIntegrationRange().getStepSize(),
+                config.getEpsilonAbs(), config.getEpsilonRel());
+        } else {
+          // First, let Interpreter compile the jacobian, then setup integrator:
+          static_cast<Models::GenericSSEinterpreter<
+              Models::IOSmodel, Eval::bci::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+              Eval::bci::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter)->compileJacobian();
+          stepper = new ODE::BDFStepper< Models::GenericSSEinterpreter<
+              Models::IOSmodel, Eval::bci::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+              Eval::bci::Engine<Eigen::VectorXd, Eigen::MatrixXd> > >(
+                *static_cast< Models::GenericSSEinterpreter<
+                Models::IOSmodel, Eval::bci::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+                Eval::bci::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter),
+                config.getIntegrationRange().getStepSize(),
+                config.getEpsilonAbs(), config.getEpsilonRel());
+        }
+        break;
+
+      case SSETaskConfig::BDFKrylov:
+        // The Jacobian-free linear solver needs no compiled Jacobian:
+        stepper = new ODE::BDFStepper< Models::GenericSSEinterpreter<
             Models::IOSmodel, Eval::bci::Engine<Eigen::VectorXd, Eigen::VectorXd>,
-            Eval::bci::Engine<Eigen::VectorXd, Eigen::MatrixXd> > >(
+            Eval::bci::Engine<Eigen::VectorXd, Eigen::MatrixXd> >,
+            ODE::BDFGMRESSolver< Models::GenericSSEinterpreter<
+            Models::IOSmodel, Eval::bci::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::bci::Engine<Eigen::VectorXd, Eigen::MatrixXd> > > >(
               *static_cast< Models::GenericSSEinterpreter<
               Models::IOSmodel, Eval::bci::Engine<Eigen::VectorXd, Eigen::VectorXd>,
               Eval::bci::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter),
@@ -421,7 +577,7 @@ IOSTask::instantiateInterpreter()
         Models::IOSmodel, Eval::bcimp::Engine<Eigen::VectorXd, Eigen::VectorXd>,
         Eval::bcimp::Engine<Eigen::VectorXd, Eigen::MatrixXd> >(
           *_sseModel,
-          config.getOptLevel(), config.getNumEvalThreads(), false);
+          config.getOptLevel(), config.getNumEvalThreads(), false, config.getNumEvalThreads());
 
     // Instantiate integrator for that engine:
     switch (config.getIntegrator()) {
@@ -469,15 +625,78 @@ IOSTask::instantiateInterpreter()
       break;
 
     case SSETaskConfig::Rosenbrock4:
-      // First, let Interpreter compile the jacobian
-      static_cast<Models::GenericSSEinterpreter<
-          Models::IOSmodel, Eval::bcimp::Engine<Eigen::VectorXd, Eigen::VectorXd>,
-          Eval::bcimp::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter)->compileJacobian();
+      // Large IOS systems have a sparse Jacobian, use a sparse LU decomposition for them:
+      if (_sseModel->getDimension() >= IOSTask::sparseJacobianDimension) {
+        // First, let Interpreter compile the sparse jacobian, then setup integrator:
+        static_cast<Models::GenericSSEinterpreter<
+            Models::IOSmodel, Eval::bcimp::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::bcimp::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter)->compileSparseJacobian();
+        stepper = new ODE::SparseRosenbrock4TimeInd< Models::GenericSSEinterpreter<
+            Models::IOSmodel, Eval::bcimp::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::bcimp::Engine<Eigen::VectorXd, Eigen::MatrixXd> > >(
+              *static_cast< Models::GenericSSEinterpreter<
+              Models::IOSmodel, Eval::bcimp::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+              Eval::bcimp::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter),
+              config.getIntegrationRange().getStepSize(),
+              config.getEpsilonAbs(), config.getEpsilonRel());
+      } else {
+        // First, let Interpreter compile the jacobian, then setup integrator:
+        static_cast<Models::GenericSSEinterpreter<
+            Models::IOSmodel, Eval::bcimp::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::bcimp::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter)->compileJacobian();
+        stepper = new ODE::Rosenbrock4TimeInd< Models::GenericSSEinterpreter<
+            Models::IOSmodel, Eval::bcimp::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::bcimp::Engine<Eigen::VectorXd, Eigen::MatrixXd> > >(
+              *static_cast< Models::GenericSSEinterpreter<
+              Models::IOSmodel, Eval::bcimp::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+              Eval::bcimp::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter),
+              config.getIntegrationRange().getStepSize(),
+              config.getEpsilonAbs(), config.getEpsilonRel());
+      }
+      break;
 
-      // Then, setup integrator:
-      stepper = new ODE::Rosenbrock4TimeInd< Models::GenericSSEinterpreter<
+    case SSETaskConfig::BDF:
+      // Large IOS systems have a sparse Jacobian, use a sparse LU decomposition for them:
+      if (_sseModel->getDimension() >= IOSTask::sparseJacobianDimension) {
+        // First, let Interpreter compile the sparse jacobian, then setup integrator:
+        static_cast<Models::GenericSSEinterpreter<
+            Models::IOSmodel, Eval::bcimp::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::bcimp::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter)->compileSparseJacobian();
+        stepper = new ODE::BDFStepper< Models::GenericSSEinterpreter<
+            Models::IOSmodel, Eval::bcimp::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::bcimp::Engine<Eigen::VectorXd, Eigen::MatrixXd> >,
+            ODE::BDFSparseSolver< Models::GenericSSEinterpreter<
+            Models::IOSmodel, Eval::bcimp::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::bcimp::Engine<Eigen::VectorXd, Eigen::MatrixXd> > > >(
+              *static_cast< Models::GenericSSEinterpreter<
+              Models::IOSmodel, Eval::bcimp::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+              Eval::bcimp::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter),
+              config.getIntegrationRange().getStepSize(),
+              config.getEpsilonAbs(), config.getEpsilonRel());
+      } else {
+        // First, let Interpreter compile the jacobian, then setup integrator:
+        static_cast<Models::GenericSSEinterpreter<
+            Models::IOSmodel, Eval::bcimp::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::bcimp::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter)->compileJacobian();
+        stepper = new ODE::BDFStepper< Models::GenericSSEinterpreter<
+            Models::IOSmodel, Eval::bcimp::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::bcimp::Engine<Eigen::VectorXd, Eigen::MatrixXd> > >(
+              *static_cast< Models::GenericSSEinterpreter<
+              Models::IOSmodel, Eval::bcimp::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+              Eval::bcimp::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter),
+              config.getIntegrationRange().getStepSize(),
+              config.getEpsilonAbs(), config.getEpsilonRel());
+      }
+      break;
+
+    case SSETaskConfig::BDFKrylov:
+      // The Jacobian-free linear solver needs no compiled Jacobian:
+      stepper = new ODE::BDFStepper< Models::GenericSSEinterpreter<
           Models::IOSmodel, Eval::bcimp::Engine<Eigen::VectorXd, Eigen::VectorXd>,
-          Eval::bcimp::Engine<Eigen::VectorXd, Eigen::MatrixXd> > >(
+          Eval::bcimp::Engine<Eigen::VectorXd, Eigen::MatrixXd> >,
+          ODE::BDFGMRESSolver< Models::GenericSSEinterpreter<
+          Models::IOSmodel, Eval::bcimp::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+          Eval::bcimp::Engine<Eigen::VectorXd, Eigen::MatrixXd> > > >(
             *static_cast< Models::GenericSSEinterpreter<
             Models::IOSmodel, Eval::bcimp::Engine<Eigen::VectorXd, Eigen::VectorXd>,
             Eval::bcimp::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter),
@@ -495,7 +714,7 @@ IOSTask::instantiateInterpreter()
         Models::IOSmodel, Eval::jit::Engine<Eigen::VectorXd, Eigen::VectorXd>,
         Eval::jit::Engine<Eigen::VectorXd, Eigen::MatrixXd> >(
           *_sseModel,
-          config.getOptLevel(), config.getNumEvalThreads(), false);
+          config.getOptLevel(), config.getNumEvalThreads(), false, config.getNumEvalThreads());
 
     // Instantiate integrator for that engine:
     switch (config.getIntegrator()) {
@@ -543,15 +762,78 @@ IOSTask::instantiateInterpreter()
       break;
 
     case SSETaskConfig::Rosenbrock4:
-      // First, let Interpreter compile the jacobian
-      static_cast<Models::GenericSSEinterpreter<
-          Models::IOSmodel, Eval::jit::Engine<Eigen::VectorXd, Eigen::VectorXd>,
-          Eval::jit::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter)->compileJacobian();
+      // Large IOS systems have a sparse Jacobian, use a sparse LU decomposition for them:
+      if (_sseModel->getDimension() >= IOSTask::sparseJacobianDimension) {
+        // First, let Interpreter compile the sparse jacobian, then setup integrator:
+        static_cast<Models::GenericSSEinterpreter<
+            Models::IOSmodel, Eval::jit::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::jit::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter)->compileSparseJacobian();
+        stepper = new ODE::SparseRosenbrock4TimeInd< Models::GenericSSEinterpreter<
+            Models::IOSmodel, Eval::jit::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::jit::Engine<Eigen::VectorXd, Eigen::MatrixXd> > >(
+              *static_cast< Models::GenericSSEinterpreter<
+              Models::IOSmodel, Eval::jit::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+              Eval::jit::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter),
+              config.getIntegrationRange().getStepSize(),
+              config.getEpsilonAbs(), config.getEpsilonRel());
+      } else {
+        // First, let Interpreter compile the jacobian, then setup integrator:
+        static_cast<Models::GenericSSEinterpreter<
+            Models::IOSmodel, Eval::jit::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::jit::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter)->compileJacobian();
+        stepper = new ODE::Rosenbrock4TimeInd< Models::GenericSSEinterpreter<
+            Models::IOSmodel, Eval::jit::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::jit::Engine<Eigen::VectorXd, Eigen::MatrixXd> > >(
+              *static_cast< Models::GenericSSEinterpreter<
+              Models::IOSmodel, Eval::jit::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+              Eval::jit::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter),
+              config.getIntegrationRange().getStepSize(),
+              config.getEpsilonAbs(), config.getEpsilonRel());
+      }
+      break;
 
-      // Then, setup integrator:
-      stepper = new ODE::Rosenbrock4TimeInd< Models::GenericSSEinterpreter<
+    case SSETaskConfig::BDF:
+      // Large IOS systems have a sparse Jacobian, use a sparse LU decomposition for them:
+      if (_sseModel->getDimension() >= IOSTask::sparseJacobianDimension) {
+        // First, let Interpreter compile the sparse jacobian, then setup integrator:
+        static_cast<Models::GenericSSEinterpreter<
+            Models::IOSmodel, Eval::jit::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::jit::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter)->compileSparseJacobian();
+        stepper = new ODE::BDFStepper< Models::GenericSSEinterpreter<
+            Models::IOSmodel, Eval::jit::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::jit::Engine<Eigen::VectorXd, Eigen::MatrixXd> >,
+            ODE::BDFSparseSolver< Models::GenericSSEinterpreter<
+            Models::IOSmodel, Eval::jit::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::jit::Engine<Eigen::VectorXd, Eigen::MatrixXd> > > >(
+              *static_cast< Models::GenericSSEinterpreter<
+              Models::IOSmodel, Eval::jit::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+              Eval::jit::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter),
+              config.getIntegrationRange().getStepSize(),
+              config.getEpsilonAbs(), config.getEpsilonRel());
+      } else {
+        // First, let Interpreter compile the jacobian, then setup integrator:
+        static_cast<Models::GenericSSEinterpreter<
+            Models::IOSmodel, Eval::jit::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::jit::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter)->compileJacobian();
+        stepper = new ODE::BDFStepper< Models::GenericSSEinterpreter<
+            Models::IOSmodel, Eval::jit::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::jit::Engine<Eigen::VectorXd, Eigen::MatrixXd> > >(
+              *static_cast< Models::GenericSSEinterpreter<
+              Models::IOSmodel, Eval::jit::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+              Eval::jit::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter),
+              config.getIntegrationRange().getStepSize(),
+              config.getEpsilonAbs(), config.getEpsilonRel());
+      }
+      break;
+
+    case SSETaskConfig::BDFKrylov:
+      // The Jacobian-free linear solver needs no compiled Jacobian:
+      stepper = new ODE::BDFStepper< Models::GenericSSEinterpreter<
           Models::IOSmodel, Eval::jit::Engine<Eigen::VectorXd, Eigen::VectorXd>,
-          Eval::jit::Engine<Eigen::VectorXd, Eigen::MatrixXd> > >(
+          Eval::jit::Engine<Eigen::VectorXd, Eigen::MatrixXd> >,
+          ODE::BDFGMRESSolver< Models::GenericSSEinterpreter<
+          Models::IOSmodel, Eval::jit::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+          Eval::jit::Engine<Eigen::VectorXd, Eigen::MatrixXd> > > >(
             *static_cast< Models::GenericSSEinterpreter<
             Models::IOSmodel, Eval::jit::Engine<Eigen::VectorXd, Eigen::VectorXd>,
             Eval::jit::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter),
@@ -561,4 +843,7 @@ IOSTask::instantiateInterpreter()
     }
     break;
   }
+
+  // The event is bound to the concrete interpreter, hence the system is not evaluated virtually:
+  steady_state = interpreter->createSteadyStateEvent(config.getEpsilonAbs(), config.getEpsilonRel());
 }
@@ -36,6 +36,9 @@ protected:
   /** Holds a weak reference to the stepper being used. */
   iNA::ODE::Stepper *stepper;
 
+  /** Holds the event, that stops the integration at the steady state (if enabled). */
+  iNA::ODE::Event *steady_state;
+
   /** This table will hold the results of the integration as a time-series.
    * Lets assume there are N species, then this table will have
    * 1 + 3*N + (N*(N+1)) columns. The first column holds the integration time,
@@ -46,6 +49,9 @@ protected:
    * the last N columns holds the EMRE-IOS mean corrections. */
   Table timeseries;
 
+  /** Holds the statistics of the integrator. */
+  iNA::ODE::StepperStatistics statistics;
+
   /** Holds the list of the names of the selected species. */
   QVector<QString> species_names;
 
@@ -73,6 +79,11 @@ protected:
   bool has_negative_variance;
 
 
+public:
+  /** Systems of at least this dimension are integrated with a sparse Jacobian by the
+   * Rosenbrock integrator. */
+  static const size_t sparseJacobianDimension = 200;
+
 public:
   /** Constructs a Task. */
   explicit IOSTask(const SSETaskConfig &config, QObject *parent = 0);
@@ -89,6 +100,9 @@ public:
   /** Returns the time-series table. */
   Table *getTimeSeries();
 
+  /** Returns the statistics of the integrator. */
+  const iNA::ODE::StepperStatistics &getStatistics() const;
+
   /** Returns the (common) unit of the species. */
   iNA::Ast::Unit getSpeciesUnit() const;
 
@@ -71,6 +71,12 @@ IOSResultWidget::IOSResultWidget(IOSTaskItem *task_wrapper, QWidget *parent):
   QVBoxLayout *layout = new QVBoxLayout();
   layout->addLayout(button_box);
   layout->addWidget(_dataTable);
+
+  // Show some statistics of the integrator:
+  QLabel *statistics = new QLabel(
+        _ios_task_wrapper->getIOSTask()->getStatistics().summary().c_str());
+  statistics->setWordWrap(true);
+  layout->addWidget(statistics);
   this->setLayout(layout);
 }
 
@@ -159,8 +165,10 @@ IOSResultWidget::saveAsMAT(const QString &filename) {
     return;
   }
 
+  // The table is read block-wise during serialization:
+  TableMatrixSource result(*_ios_task_wrapper->getIOSTask()->getTimeSeries());
   iNA::Utils::MatFile mat_file;
-  mat_file.add("IOS_result", _ios_task_wrapper->getIOSTask()->getTimeSeries()->matrix());
+  mat_file.add("IOS_result", result);
   mat_file.serialize(file);
   file.close();
 }
@@ -8,7 +8,7 @@
 Plot::PlotConfig *
 createLNATimeSeriesPlotConfig(QStringList &selected_species, LNATask *task)
 {
-  Table *series = task->getTimeSeries();
+  const Table *series = task->getTimeSeries();
   Plot::PlotConfig *config = new Plot::PlotConfig(*series);
 
   // Get species unit
@@ -29,7 +29,7 @@ createLNATimeSeriesPlotConfig(QStringList &selected_species, LNATask *task)
     config->setYLabel(QObject::tr("amount [%1]").arg(species_unit));
   }
 
-  iNA::Ast::Model *model = task->getConfig().getModel();
+  const iNA::Ast::Model *model = task->getConfig().getModel();
   size_t Ntot = model->numSpecies();
   size_t Nsel = selected_species.size();
 
@@ -59,7 +59,7 @@ createLNATimeSeriesPlotConfig(QStringList &selected_species, LNATask *task)
 Plot::PlotConfig *
 createLNACorrelationPlotConfig(QStringList &selected_species, LNATask *task)
 {
-  Table *data = task->getTimeSeries();
+  const Table *data = task->getTimeSeries();
   Plot::PlotConfig *config = new Plot::PlotConfig(*data);
 
   // Get time unit
@@ -70,7 +70,7 @@ createLNACorrelationPlotConfig(QStringList &selected_species, LNATask *task)
   config->setXLabel(QObject::tr("time [%1]").arg(time_unit));
   config->setYLabel(QObject::tr("correlation coefficient"));
 
-  iNA::Ast::Model *model= task->getConfig().getModel();
+  const iNA::Ast::Model *model = task->getConfig().getModel();
   size_t Nsel = selected_species.size();
   size_t Ntot = model->numSpecies();
 
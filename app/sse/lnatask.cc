@@ -10,7 +10,7 @@ using namespace iNA;
  * ******************************************************************************************** */
 LNATask::LNATask(const SSETaskConfig &config, QObject *parent) :
   Task(parent), _config(config), _Ns(config.getModel()->numSpecies()),
-  _interpreter(0), _stepper(0),
+  _interpreter(0), _stepper(0), _steady_state(0), _mean_steady_state(0),
   _timeseries(1 + 2*_Ns + _Ns*(_Ns+1)/2,
     1+config.getIntegrationRange().getSteps()/(1+config.getIntermediateSteps())),
   _species_names(_Ns)
@@ -56,6 +56,12 @@ LNATask::~LNATask()
   if (0 != this->_stepper)
     delete _stepper;
 
+  // Free steady-state events:
+  if (0 != _steady_state)
+    delete _steady_state;
+  if (0 != _mean_steady_state)
+    delete _mean_steady_state;
+
   // Free interpreter
   if (0 != _interpreter)
     delete _interpreter;
@@ -75,8 +81,6 @@ LNATask::process()
 
   // Holds the current system state (reduced state)
   Eigen::VectorXd x(_sseModel->getDimension());
-  // Holds the update to the next state (reduced state)
-  Eigen::VectorXd dx(_sseModel->getDimension());
 
   // Holds the concentrations for each species (full state)
   Eigen::VectorXd concentrations(_Ns);
@@ -106,7 +110,15 @@ LNATask::process()
 
   /* Perform integration */
   double t  = _config.getIntegrationRange().getStartTime();
-  double dt = _config.getIntegrationRange().getStepSize();
+  // Integrates over the range, interpolates the output states if the stepper supports it:
+  ODE::DenseOutputDriver driver(*this->_stepper, _config.getIntegrationRange());
+  // Stop the integration once the steady state is reached, if requested:
+  if (_config.getStopAtSteadyState()) {
+    this->_stepper->addEvent(this->_steady_state);
+  }
+  // Measure the time spent in each phase of the integration:
+  this->_stepper->statistics().setTiming(true);
+  bool steady = driver.start(x);
 
   // store initial state RE
   output_vector(0) = t;
@@ -126,8 +138,15 @@ LNATask::process()
   }
   this->_timeseries.append(output_vector);
 
+  // Once the RE mean is stationary, the covariance and EMRE corrections obey linear ODEs with
+  // constant coefficients and are propagated exactly (if enabled):
+  size_t N_re = _sseModel->numIndSpecies(), N_lin = x.size()-N_re;
+  bool exact = false, try_exact = _config.getExactPropagation() && (N_lin <= exactPropagationDimension);
+  ODE::LinearPropagator propagator;
+  Eigen::VectorXd y(N_lin), y_new(N_lin);
+
   // Integration loop:
-  for (size_t i=0; i<_config.getIntegrationRange().getSteps(); i++)
+  for (size_t i=0; (i<_config.getIntegrationRange().getSteps()) && (! steady); i++)
   {
     // Check if task shall terminate:
     if (Task::TERMINATING == this->getState()) {
@@ -137,13 +156,23 @@ LNATask::process()
 
     this->setProgress(double(i)/_config.getIntegrationRange().getSteps());
 
-    // Determine update:
-    this->_stepper->step(x, t, dx);
-    // Update state & time
-    x+=dx; t += dt;
+    // Update state & time:
+    if (exact) {
+      y = x.tail(N_lin); propagator.propagate(y, y_new); x.tail(N_lin) = y_new;
+      t = _config.getIntegrationRange().getStartTime() + (i+1)*propagator.getStepSize();
+      steady = _config.getStopAtSteadyState() && (0 >= _steady_state->evaluate(x, t));
+    } else {
+      steady = driver.next(x, t);
+      if (try_exact && (! steady) && isStationary(x, t)) {
+        initializePropagator(x, t, N_re, propagator); exact = true;
+        Utils::Message message = LOG_MESSAGE(Utils::Message::INFO);
+        message << "Mean reached steady state at t=" << t << ", propagate LNA exactly.";
+        Utils::Logger::get().log(message);
+      }
+    }
 
-    // Skip immediate steps
-    if(0 != _config.getIntermediateSteps() && 0 != i%(1+_config.getIntermediateSteps())) {
+    // Skip immediate steps (but store the steady state)
+    if(! steady && 0 != _config.getIntermediateSteps() && 0 != i%(1+_config.getIntermediateSteps())) {
       continue;
     }
 
@@ -174,6 +203,17 @@ LNATask::process()
     this->_timeseries.append(output_vector);
   }
 
+  this->_stepper->clearEvents();
+
+  this->_statistics = this->_stepper->statistics();
+  this->_statistics.log("LNA integrator statistics");
+
+  if (steady) {
+    Utils::Message message = LOG_MESSAGE(Utils::Message::INFO);
+    message << "Reached steady state at t=" << t << ".";
+    Utils::Logger::get().log(message);
+  }
+
   {
     Utils::Message message = LOG_MESSAGE(Utils::Message::INFO);
     message << "Finished LNA time course analysis.";
@@ -192,6 +232,35 @@ LNATask::getLabel() {
 }
 
 
+const iNA::ODE::StepperStatistics &
+LNATask::getStatistics() const {
+  return this->_statistics;
+}
+
+
+bool
+LNATask::isStationary(const Eigen::VectorXd &state, double t)
+{
+  return 0 >= _mean_steady_state->evaluate(state, t);
+}
+
+
+void
+LNATask::initializePropagator(const Eigen::VectorXd &state, double t, size_t N_re,
+                              ODE::LinearPropagator &propagator)
+{
+  size_t N_lin = state.size()-N_re;
+  Eigen::VectorXd rates(state.size());
+  Eigen::MatrixXd jacobian(state.size(), state.size());
+  _interpreter->linearize(state, t, rates, jacobian);
+
+  // The ODEs of the covariance and EMRE are affine at the fixed mean: dy/dt = A y + b.
+  Eigen::MatrixXd A = jacobian.bottomRightCorner(N_lin, N_lin);
+  Eigen::VectorXd b = rates.tail(N_lin) - A*state.tail(N_lin);
+  propagator.initialize(A, b, _config.getIntegrationRange().getStepSize());
+}
+
+
 Table *
 LNATask::getTimeSeries() {
   return &(this->_timeseries);
@@ -296,6 +365,38 @@ LNATask::instantiateInterpreter()
             _config.getIntegrationRange().getStepSize(),
             _config.getEpsilonAbs(), _config.getEpsilonRel());
       break;
+
+    case SSETaskConfig::BDF:
+      // First, let Interpreter compile the jacobian
+      static_cast<Models::GenericSSEinterpreter<
+          Models::LNAmodel, Eval::direct::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+          Eval::direct::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(_interpreter)->compileJacobian();
+
+      // Then, setup integrator:
+      this->_stepper = new ODE::BDFStepper< Models::GenericSSEinterpreter<
+          Models::LNAmodel, Eval::direct::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+          Eval::direct::Engine<Eigen::VectorXd, Eigen::MatrixXd> > >(
+            *static_cast< Models::GenericSSEinterpreter<
+            Models::LNAmodel, Eval::direct::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::direct::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(_interpreter),
+            _config.getIntegrationRange().getStepSize(),
+            _config.getEpsilonAbs(), _config.getEpsilonRel());
+      break;
+
+    case SSETaskConfig::BDFKrylov:
+      // The Jacobian-free linear solver needs no compiled Jacobian:
+      this->_stepper = new ODE::BDFStepper< Models::GenericSSEinterpreter<
+          Models::LNAmodel, Eval::direct::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+          Eval::direct::Engine<Eigen::VectorXd, Eigen::MatrixXd> >,
+          ODE::BDFGMRESSolver< Models::GenericSSEinterpreter<
+          Models::LNAmodel, Eval::direct::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+          Eval::direct::Engine<Eigen::VectorXd, Eigen::MatrixXd> > > >(
+            *static_cast< Models::GenericSSEinterpreter<
+            Models::LNAmodel, Eval::direct::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::direct::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(_interpreter),
+            _config.getIntegrationRange().getStepSize(),
+            _config.getEpsilonAbs(), _config.getEpsilonRel());
+      break;
     }
     break;
 
@@ -369,6 +470,38 @@ LNATask::instantiateInterpreter()
               _config.getIntegrationRange().getStepSize(),
               _config.getEpsilonAbs(), _config.getEpsilonRel());
         break;
+
+      case SSETaskConfig::BDF:
+        // First, let Interpreter compile the jacobian
+        static_cast<Models::GenericSSEinterpreter<
+            Models::LNAmodel, Eval::bci::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::bci::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(_interpreter)->compileJacobian();
+
+        // Then, setup integrator:
+        _stepper = new ODE::BDFStepper< Models::GenericSSEinterpreter<
+            Models::LNAmodel, Eval::bci::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::bci::Engine<Eigen::VectorXd, Eigen::MatrixXd> > >(
+              *static_cast< Models::GenericSSEinterpreter<
+              Models::LNAmodel, Eval::bci::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+              Eval::bci::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(_interpreter),
+              _config.getIntegrationRange().getStepSize(),
+              _config.getEpsilonAbs(), _config.getEpsilonRel());
+        break;
+
+      case SSETaskConfig::BDFKrylov:
+        // The Jacobian-free linear solver needs no compiled Jacobian:
+        _stepper = new ODE::BDFStepper< Models::GenericSSEinterpreter<
+            Models::LNAmodel, Eval::bci::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::bci::Engine<Eigen::VectorXd, Eigen::MatrixXd> >,
+            ODE::BDFGMRESSolver< Models::GenericSSEinterpreter<
+            Models::LNAmodel, Eval::bci::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::bci::Engine<Eigen::VectorXd, Eigen::MatrixXd> > > >(
+              *static_cast< Models::GenericSSEinterpreter<
+              Models::LNAmodel, Eval::bci::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+              Eval::bci::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(_interpreter),
+              _config.getIntegrationRange().getStepSize(),
+              _config.getEpsilonAbs(), _config.getEpsilonRel());
+        break;
       }
     break;
 
@@ -442,6 +575,38 @@ LNATask::instantiateInterpreter()
             _config.getIntegrationRange().getStepSize(),
             _config.getEpsilonAbs(), _config.getEpsilonRel());
       break;
+
+    case SSETaskConfig::BDF:
+      // First, let Interpreter compile the jacobian
+      static_cast<Models::GenericSSEinterpreter<
+          Models::LNAmodel, Eval::bcimp::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+          Eval::bcimp::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(_interpreter)->compileJacobian();
+
+      // Then, setup integrator:
+      _stepper = new ODE::BDFStepper< Models::GenericSSEinterpreter<
+          Models::LNAmodel, Eval::bcimp::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+          Eval::bcimp::Engine<Eigen::VectorXd, Eigen::MatrixXd> > >(
+            *static_cast< Models::GenericSSEinterpreter<
+            Models::LNAmodel, Eval::bcimp::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::bcimp::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(_interpreter),
+            _config.getIntegrationRange().getStepSize(),
+            _config.getEpsilonAbs(), _config.getEpsilonRel());
+      break;
+
+    case SSETaskConfig::BDFKrylov:
+      // The Jacobian-free linear solver needs no compiled Jacobian:
+      _stepper = new ODE::BDFStepper< Models::GenericSSEinterpreter<
+          Models::LNAmodel, Eval::bcimp::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+          Eval::bcimp::Engine<Eigen::VectorXd, Eigen::MatrixXd> >,
+          ODE::BDFGMRESSolver< Models::GenericSSEinterpreter<
+          Models::LNAmodel, Eval::bcimp::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+          Eval::bcimp::Engine<Eigen::VectorXd, Eigen::MatrixXd> > > >(
+            *static_cast< Models::GenericSSEinterpreter<
+            Models::LNAmodel, Eval::bcimp::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::bcimp::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(_interpreter),
+            _config.getIntegrationRange().getStepSize(),
+            _config.getEpsilonAbs(), _config.getEpsilonRel());
+      break;
     }
     break;
 
@@ -516,7 +681,45 @@ LNATask::instantiateInterpreter()
             _config.getIntegrationRange().getStepSize(),
             _config.getEpsilonAbs(), _config.getEpsilonRel());
       break;
+
+    case SSETaskConfig::BDF:
+      // First, let Interpreter compile the jacobian
+      static_cast<Models::GenericSSEinterpreter<
+          Models::LNAmodel, Eval::jit::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+          Eval::jit::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(_interpreter)->compileJacobian();
+
+      // Then, setup integrator:
+      _stepper = new ODE::BDFStepper< Models::GenericSSEinterpreter<
+          Models::LNAmodel, Eval::jit::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+          Eval::jit::Engine<Eigen::VectorXd, Eigen::MatrixXd> > >(
+            *static_cast< Models::GenericSSEinterpreter<
+            Models::LNAmodel, Eval::jit::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::jit::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(_interpreter),
+            _config.getIntegrationRange().getStepSize(),
+            _config.getEpsilonAbs(), _config.getEpsilonRel());
+      break;
+
+    case SSETaskConfig::BDFKrylov:
+      // The Jacobian-free linear solver needs no compiled Jacobian:
+      _stepper = new ODE::BDFStepper< Models::GenericSSEinterpreter<
+          Models::LNAmodel, Eval::jit::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+          Eval::jit::Engine<Eigen::VectorXd, Eigen::MatrixXd> >,
+          ODE::BDFGMRESSolver< Models::GenericSSEinterpreter<
+          Models::LNAmodel, Eval::jit::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+          Eval::jit::Engine<Eigen::VectorXd, Eigen::MatrixXd> > > >(
+            *static_cast< Models::GenericSSEinterpreter<
+            Models::LNAmodel, Eval::jit::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::jit::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(_interpreter),
+            _config.getIntegrationRange().getStepSize(),
+            _config.getEpsilonAbs(), _config.getEpsilonRel());
+      break;
     }
     break;
   }
+
+  // The events are bound to the concrete interpreter, hence the system is not evaluated virtually:
+  _steady_state = _interpreter->createSteadyStateEvent(
+        _config.getEpsilonAbs(), _config.getEpsilonRel());
+  _mean_steady_state = _interpreter->createSteadyStateEvent(
+        _config.getEpsilonAbs(), _config.getEpsilonRel(), _sseModel->numIndSpecies());
 }
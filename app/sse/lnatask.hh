@@ -11,6 +11,7 @@
 #include <models/sseinterpreter.hh>
 #include <ode/integrationrange.hh>
 #include <ode/stepper.hh>
+#include <ode/linearpropagator.hh>
 
 
 /**
@@ -39,6 +40,12 @@ protected:
   /** Holds the stepper being used. */
   iNA::ODE::Stepper *_stepper;
 
+  /** Holds the event, that stops the integration at the steady state (if enabled). */
+  iNA::ODE::Event *_steady_state;
+
+  /** Holds the event, that detects the steady state of the RE mean. */
+  iNA::ODE::Event *_mean_steady_state;
+
   /** This table will hold the results of the integration as a time-series.
    * Lets assume there are N species , then this table will have
    * 1 + N + (N*(N+1))/2 + N columns. The first column holds the integration time,
@@ -48,10 +55,19 @@ protected:
    * corrections + LNA means. */
   Table _timeseries;
 
+  /** Holds the statistics of the integrator. */
+  iNA::ODE::StepperStatistics _statistics;
+
   /** Holds the vector of display names of the species. */
   QVector<QString> _species_names;
 
 
+public:
+  /** Systems with at most this number of covariances and EMRE corrections are propagated
+   * exactly at the steady state of the mean (if enabled). */
+  static const size_t exactPropagationDimension = 1000;
+
+
 public:
   /** Constructs a LNA anlysis task.*/
   explicit LNATask(const SSETaskConfig &_config, QObject *parent = 0);
@@ -70,6 +86,11 @@ public:
    */
   Table *getTimeSeries();
 
+  /**
+   * Returns the statistics of the integrator.
+   */
+  const iNA::ODE::StepperStatistics &getStatistics() const;
+
   /**
    * Returns the (common) unit of the species.
    */
@@ -96,6 +117,15 @@ protected:
 private:
   /** Instantiates the interpreter. */
   void instantiateInterpreter();
+
+  /** Returns true if the rates of change of the RE mean are below the absolute and relative
+   * error. */
+  bool isStationary(const Eigen::VectorXd &state, double t);
+
+  /** Linearizes the covariance and EMRE ODEs at the given state with fixed mean and initializes
+   * the propagator for the output time step. */
+  void initializePropagator(const Eigen::VectorXd &state, double t, size_t N_re,
+                            iNA::ODE::LinearPropagator &propagator);
 };
 
 #endif // __INA_APP_SSE_LNATASK_HH__
@@ -69,6 +69,12 @@ LNAResultWidget::LNAResultWidget(LNATaskItem *task_wrapper, QWidget *parent):
   QVBoxLayout *layout = new QVBoxLayout();
   layout->addLayout(button_box);
   layout->addWidget(_dataTable);
+
+  // Show some statistics of the integrator:
+  QLabel *statistics = new QLabel(
+        _lna_task_wrapper->getLNATask()->getStatistics().summary().c_str());
+  statistics->setWordWrap(true);
+  layout->addWidget(statistics);
   setLayout(layout);
 }
 
@@ -156,8 +162,10 @@ LNAResultWidget::saveAsMAT(const QString &filename) {
     return;
   }
 
+  // The table is read block-wise during serialization:
+  TableMatrixSource result(*_lna_task_wrapper->getLNATask()->getTimeSeries());
   iNA::Utils::MatFile mat_file;
-  mat_file.add("LNA_result", _lna_task_wrapper->getLNATask()->getTimeSeries()->matrix());
+  mat_file.add("LNA_result", result);
   mat_file.serialize(file);
   file.close();
 }
@@ -12,7 +12,7 @@
 Plot::PlotConfig *
 createRETimeSeriesPlotConfig(QStringList &selected_species, RETask *task)
 {
-  Table *series = task->getTimeSeries();
+  const Table *series = task->getTimeSeries();
   Plot::PlotConfig *config = new Plot::PlotConfig(*series);
   config->setTile("Mean concentrations (RE)");
 
@@ -15,7 +15,7 @@ using namespace iNA;
  * ******************************************************************************************** */
 RETask::RETask(SSETaskConfig &config, QObject *parent) :
   Task(parent), config(config), _Ns(config.getModel()->numSpecies()),
-  interpreter(0), stepper(0),
+  interpreter(0), stepper(0), steady_state(0),
   timeseries(1 + _Ns, 1+config.getIntegrationRange().getSteps()/(1+config.getIntermediateSteps()))
 {
   _sseModel = new iNA::Models::REmodel(*config.getModel());
@@ -93,6 +93,38 @@ RETask::RETask(SSETaskConfig &config, QObject *parent) :
             config.getIntegrationRange().getStepSize(),
             config.getEpsilonAbs(), config.getEpsilonRel());
       break;
+
+    case SSETaskConfig::BDF:
+      // First, let Interpreter compile the jacobian
+      static_cast<Models::GenericSSEinterpreter<
+          Models::REmodel, Eval::direct::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+          Eval::direct::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter)->compileJacobian();
+
+      // Then, setup integrator:
+      this->stepper = new ODE::BDFStepper< Models::GenericSSEinterpreter<
+          Models::REmodel, Eval::direct::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+          Eval::direct::Engine<Eigen::VectorXd, Eigen::MatrixXd> > >(
+            *static_cast< Models::GenericSSEinterpreter<
+            Models::REmodel, Eval::direct::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::direct::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter),
+            config.getIntegrationRange().getStepSize(),
+            config.getEpsilonAbs(), config.getEpsilonRel());
+      break;
+
+    case SSETaskConfig::BDFKrylov:
+      // The Jacobian-free linear solver needs no compiled Jacobian:
+      this->stepper = new ODE::BDFStepper< Models::GenericSSEinterpreter<
+          Models::REmodel, Eval::direct::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+          Eval::direct::Engine<Eigen::VectorXd, Eigen::MatrixXd> >,
+          ODE::BDFGMRESSolver< Models::GenericSSEinterpreter<
+          Models::REmodel, Eval::direct::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+          Eval::direct::Engine<Eigen::VectorXd, Eigen::MatrixXd> > > >(
+            *static_cast< Models::GenericSSEinterpreter<
+            Models::REmodel, Eval::direct::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::direct::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter),
+            config.getIntegrationRange().getStepSize(),
+            config.getEpsilonAbs(), config.getEpsilonRel());
+      break;
     }
     break;
 
@@ -166,6 +198,38 @@ RETask::RETask(SSETaskConfig &config, QObject *parent) :
               config.getIntegrationRange().getStepSize(),
               config.getEpsilonAbs(), config.getEpsilonRel());
         break;
+
+      case SSETaskConfig::BDF:
+        // First, let Interpreter compile the jacobian
+        static_cast<Models::GenericSSEinterpreter<
+            Models::REmodel, Eval::bci::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::bci::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter)->compileJacobian();
+
+        // Then, setup integrator:
+        stepper = new ODE::BDFStepper< Models::GenericSSEinterpreter<
+            Models::REmodel, Eval::bci::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::bci::Engine<Eigen::VectorXd, Eigen::MatrixXd> > >(
+              *static_cast< Models::GenericSSEinterpreter<
+              Models::REmodel, Eval::bci::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+              Eval::bci::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter),
+              config.getIntegrationRange().getStepSize(),
+              config.getEpsilonAbs(), config.getEpsilonRel());
+        break;
+
+      case SSETaskConfig::BDFKrylov:
+        // The Jacobian-free linear solver needs no compiled Jacobian:
+        stepper = new ODE::BDFStepper< Models::GenericSSEinterpreter<
+            Models::REmodel, Eval::bci::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::bci::Engine<Eigen::VectorXd, Eigen::MatrixXd> >,
+            ODE::BDFGMRESSolver< Models::GenericSSEinterpreter<
+            Models::REmodel, Eval::bci::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::bci::Engine<Eigen::VectorXd, Eigen::MatrixXd> > > >(
+              *static_cast< Models::GenericSSEinterpreter<
+              Models::REmodel, Eval::bci::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+              Eval::bci::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter),
+              config.getIntegrationRange().getStepSize(),
+              config.getEpsilonAbs(), config.getEpsilonRel());
+        break;
       }
     break;
 
@@ -239,6 +303,38 @@ RETask::RETask(SSETaskConfig &config, QObject *parent) :
             config.getIntegrationRange().getStepSize(),
             config.getEpsilonAbs(), config.getEpsilonRel());
       break;
+
+    case SSETaskConfig::BDF:
+      // First, let Interpreter compile the jacobian
+      static_cast<Models::GenericSSEinterpreter<
+          Models::REmodel, Eval::bcimp::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+          Eval::bcimp::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter)->compileJacobian();
+
+      // Then, setup integrator:
+      stepper = new ODE::BDFStepper< Models::GenericSSEinterpreter<
+          Models::REmodel, Eval::bcimp::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+          Eval::bcimp::Engine<Eigen::VectorXd, Eigen::MatrixXd> > >(
+            *static_cast< Models::GenericSSEinterpreter<
+            Models::REmodel, Eval::bcimp::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::bcimp::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter),
+            config.getIntegrationRange().getStepSize(),
+            config.getEpsilonAbs(), config.getEpsilonRel());
+      break;
+
+    case SSETaskConfig::BDFKrylov:
+      // The Jacobian-free linear solver needs no compiled Jacobian:
+      stepper = new ODE::BDFStepper< Models::GenericSSEinterpreter<
+          Models::REmodel, Eval::bcimp::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+          Eval::bcimp::Engine<Eigen::VectorXd, Eigen::MatrixXd> >,
+          ODE::BDFGMRESSolver< Models::GenericSSEinterpreter<
+          Models::REmodel, Eval::bcimp::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+          Eval::bcimp::Engine<Eigen::VectorXd, Eigen::MatrixXd> > > >(
+            *static_cast< Models::GenericSSEinterpreter<
+            Models::REmodel, Eval::bcimp::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::bcimp::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter),
+            config.getIntegrationRange().getStepSize(),
+            config.getEpsilonAbs(), config.getEpsilonRel());
+      break;
     }
     break;
 
@@ -313,10 +409,45 @@ RETask::RETask(SSETaskConfig &config, QObject *parent) :
             config.getIntegrationRange().getStepSize(),
             config.getEpsilonAbs(), config.getEpsilonRel());
       break;
+
+    case SSETaskConfig::BDF:
+      // First, let Interpreter compile the jacobian
+      static_cast<Models::GenericSSEinterpreter<
+          Models::REmodel, Eval::jit::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+          Eval::jit::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter)->compileJacobian();
+
+      // Then, setup integrator:
+      stepper = new ODE::BDFStepper< Models::GenericSSEinterpreter<
+          Models::REmodel, Eval::jit::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+          Eval::jit::Engine<Eigen::VectorXd, Eigen::MatrixXd> > >(
+            *static_cast< Models::GenericSSEinterpreter<
+            Models::REmodel, Eval::jit::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::jit::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter),
+            config.getIntegrationRange().getStepSize(),
+            config.getEpsilonAbs(), config.getEpsilonRel());
+      break;
+
+    case SSETaskConfig::BDFKrylov:
+      // The Jacobian-free linear solver needs no compiled Jacobian:
+      stepper = new ODE::BDFStepper< Models::GenericSSEinterpreter<
+          Models::REmodel, Eval::jit::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+          Eval::jit::Engine<Eigen::VectorXd, Eigen::MatrixXd> >,
+          ODE::BDFGMRESSolver< Models::GenericSSEinterpreter<
+          Models::REmodel, Eval::jit::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+          Eval::jit::Engine<Eigen::VectorXd, Eigen::MatrixXd> > > >(
+            *static_cast< Models::GenericSSEinterpreter<
+            Models::REmodel, Eval::jit::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+            Eval::jit::Engine<Eigen::VectorXd, Eigen::MatrixXd> > *>(interpreter),
+            config.getIntegrationRange().getStepSize(),
+            config.getEpsilonAbs(), config.getEpsilonRel());
+      break;
     }
     break;
   }
 
+  // The event is bound to the concrete interpreter, hence the system is not evaluated virtually:
+  steady_state = interpreter->createSteadyStateEvent(config.getEpsilonAbs(), config.getEpsilonRel());
+
 
   size_t column = 0;
   QVector<QString> species_names(_Ns);
@@ -344,6 +475,10 @@ RETask::~RETask()
   if (0 != this->stepper)
     delete stepper;
 
+  // Free steady-state event:
+  if (0 != this->steady_state)
+    delete steady_state;
+
   // Free interpreter
   if (0 != this->interpreter)
     delete interpreter;
@@ -360,8 +495,6 @@ RETask::process()
 
   // Holds the current system state (reduced state)
   Eigen::VectorXd x(_sseModel->getDimension());
-  // Holds the update to the next state (reduced state)
-  Eigen::VectorXd dx(_sseModel->getDimension());
 
   // Holds the concentrations for each species (full state)
   Eigen::VectorXd concentrations(config.getModel()->numSpecies());
@@ -386,7 +519,15 @@ RETask::process()
    * Perform integration
    */
   double t  = config.getIntegrationRange().getStartTime();
-  double dt = config.getIntegrationRange().getStepSize();
+  // Integrates over the range, interpolates the output states if the stepper supports it:
+  ODE::DenseOutputDriver driver(*this->stepper, config.getIntegrationRange());
+  // Stop the integration once the steady state is reached, if requested:
+  if (config.getStopAtSteadyState()) {
+    this->stepper->addEvent(this->steady_state);
+  }
+  // Measure the time spent in each phase of the integration:
+  this->stepper->statistics().setTiming(true);
+  bool steady = driver.start(x);
 
   // store initial state:
   output_vector(0) = t;
@@ -398,7 +539,7 @@ RETask::process()
   // Integration loop:
   size_t N_steps = config.getIntegrationRange().getSteps();
   size_t N_intermediate = config.getIntermediateSteps();
-  for (size_t i=0; i<N_steps; i++)
+  for (size_t i=0; (i<N_steps) && (! steady); i++)
   {
     // Check if task shall terminate:
     if (Task::TERMINATING == this->getState()) {
@@ -408,14 +549,11 @@ RETask::process()
 
     this->setProgress(double(i)/N_steps);
 
-    // Determine update:
-    this->stepper->step(x, t, dx);
-
-    // Update state & time
-    x+=dx; t += dt;
+    // Update state & time:
+    steady = driver.next(x, t);
 
-    // Skip immediate steps
-    if(0 != N_intermediate && 0 != i%(1+N_intermediate))
+    // Skip immediate steps (but store the steady state)
+    if(! steady && 0 != N_intermediate && 0 != i%(1+N_intermediate))
       continue;
 
     // Get full state:
@@ -431,6 +569,17 @@ RETask::process()
     this->timeseries.append(output_vector);
   }
 
+  this->stepper->clearEvents();
+
+  this->statistics = this->stepper->statistics();
+  this->statistics.log("RE integrator statistics");
+
+  if (steady) {
+    Utils::Message message = LOG_MESSAGE(Utils::Message::INFO);
+    message << "Reached steady state at t=" << t << ".";
+    Utils::Logger::get().log(message);
+  }
+
   {
     Utils::Message message = LOG_MESSAGE(Utils::Message::INFO);
     message << "Finished RE time course analysis.";
@@ -455,6 +604,12 @@ RETask::getConfig() const {
 }
 
 
+const iNA::ODE::StepperStatistics &
+RETask::getStatistics() const {
+  return this->statistics;
+}
+
+
 Table *
 RETask::getTimeSeries()
 {
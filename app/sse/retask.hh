@@ -43,6 +43,9 @@ protected:
   /** Holds a weak reference to the stepper being used. */
   iNA::ODE::Stepper *stepper;
 
+  /** Holds the event, that stops the integration at the steady state (if enabled). */
+  iNA::ODE::Event *steady_state;
+
   /** This table will hold the results of the integration as a time-series.
    *
    * Lets assume there are N , then this table will have
@@ -53,6 +56,9 @@ protected:
    * corrections + LNA means. */
   Table timeseries;
 
+  /** Holds the statistics of the integrator. */
+  iNA::ODE::StepperStatistics statistics;
+
 
 public:
   /** Constructs a Task. */
@@ -64,6 +70,9 @@ public:
   /** Returns the time-series table. */
   Table *getTimeSeries();
 
+  /** Returns the statistics of the integrator. */
+  const iNA::ODE::StepperStatistics &getStatistics() const;
+
   /** Returns the (common) unit of the species. */
   iNA::Ast::Unit getSpeciesUnit() const;
 
@@ -70,6 +70,12 @@ REResultWidget::REResultWidget(RETaskItem *task_wrapper, QWidget *parent):
   QVBoxLayout *layout = new QVBoxLayout();
   layout->addLayout(button_box);
   layout->addWidget(this->dataTable);
+
+  // Show some statistics of the integrator:
+  QLabel *statistics = new QLabel(
+        re_task_wrapper->getRETask()->getStatistics().summary().c_str());
+  statistics->setWordWrap(true);
+  layout->addWidget(statistics);
   this->setLayout(layout);
 }
 
@@ -148,8 +154,10 @@ REResultWidget::saveAsMAT(const QString &filename) {
     return;
   }
 
+  // The table is read block-wise during serialization:
+  TableMatrixSource result(*re_task_wrapper->getRETask()->getTimeSeries());
   iNA::Utils::MatFile mat_file;
-  mat_file.add("RE_result", re_task_wrapper->getRETask()->getTimeSeries()->matrix());
+  mat_file.add("RE_result", result);
   mat_file.serialize(file);
   file.close();
 }
@@ -32,34 +32,27 @@ public:
   /** Copy constructor. */
   SSETaskConfig(const SSETaskConfig &other);
 
-  /** Overrides the default implenentation of @c ModelSelectionTaskConfig and checks if
-   * the selected model can be used to instantiate the specified analysis. */
-  virtual void setModelDocument(DocumentItem *document);
-
-  /** Allows to reset the model. */
-  void setModel(iNA::Ast::Model *m);
-
-  /** Implements the @c SpeciesSelectionTaskConfig interface, and returns the model instance. */
-  virtual iNA::Ast::Model *getModel() const;
-
-  /** Get model as specific type.
-  * @note Now absolete!
-  */
-  template <class T> T* getModelAs() const {
-    return dynamic_cast<T *>(getModel());
-  }
+  /** Implements the @c SpeciesSelectionTaskConfig interface, and returns the snapshot of the
+   * model. The analysis model is constructed from it by the task. */
+  virtual const iNA::Ast::Model *getModel() const;
 
   /** Sets the selected analysis method. This determines, which kind of analysis will be
-   * instantiated when @c setModelDocument is called. */
+   * instantiated by the task. */
   void setMethod(SSEMethod method);
   /** Returns the selected method. */
   SSEMethod method() const;
 
+  /** Returns true if the LNA covariance and EMRE corrections are propagated exactly once the
+   * RE mean reached a steady state. */
+  bool getExactPropagation() const;
+  /** Enables or disables the exact propagation at the steady state of the mean. */
+  void setExactPropagation(bool enabled);
+
 protected:
   /** Specifies the selected SSE analysis method. */
   SSEMethod _selected_method;
-  /** The model to be analyzed. */
-  iNA::Ast::Model *_re_model;
+  /** If true, the LNA is propagated exactly at the steady state of the mean. */
+  bool _exact_propagation;
 
 };
 
@@ -123,6 +123,44 @@ SSEIntegratorPage::SSEIntegratorPage(GeneralTaskWizard *parent)
 {
   this->setTitle("Time Course Analysis (SSE)");
   this->setSubTitle("Set parameters");
+
+  this->exact_propagation = new QCheckBox();
+  this->exact_propagation->setChecked(false);
+  this->exact_propagation->setToolTip(
+        "Once the mean reached its steady state, the covariance and EMRE corrections obey linear ODEs.\n"
+        "These are then solved exactly instead of being integrated step-by-step.");
+  static_cast<QFormLayout *>(this->layout())->addRow(
+        tr("Exact propagation at steady state"), this->exact_propagation);
+}
+
+
+void
+SSEIntegratorPage::initializePage()
+{
+  IntegratorWizardPage::initializePage();
+
+  GeneralTaskWizard *wizard = static_cast<GeneralTaskWizard *>(this->wizard());
+  SSETaskConfig &config = wizard->getConfigCast<SSETaskConfig>();
+
+  bool is_lna = (SSETaskConfig::LNA_ANALYSIS == config.method());
+  QFormLayout *layout = static_cast<QFormLayout *>(this->layout());
+  layout->labelForField(this->exact_propagation)->setVisible(is_lna);
+  this->exact_propagation->setVisible(is_lna);
+  if (! is_lna) { this->exact_propagation->setChecked(false); }
+}
+
+
+bool
+SSEIntegratorPage::validatePage()
+{
+  if (! IntegratorWizardPage::validatePage()) {
+    return false;
+  }
+
+  GeneralTaskWizard *wizard = static_cast<GeneralTaskWizard *>(this->wizard());
+  SSETaskConfig &config = wizard->getConfigCast<SSETaskConfig>();
+  config.setExactPropagation(this->exact_propagation->isChecked());
+  return true;
 }
 
 
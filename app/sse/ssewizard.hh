@@ -96,6 +96,16 @@ class SSEIntegratorPage : public IntegratorWizardPage
 public:
   /** Constructor. */
   explicit SSEIntegratorPage(GeneralTaskWizard *parent);
+
+  /** Shows the exact propagation option for the LNA analysis only. */
+  virtual void initializePage();
+
+  /** Stores the exact propagation option in the config. */
+  virtual bool validatePage();
+
+private:
+  /** Enables the exact propagation of the LNA at the steady state of the mean. */
+  QCheckBox *exact_propagation;
 };
 
 
@@ -1,7 +1,7 @@
 #include "steadystatespectrumplot.hh"
 
 
-SteadyStateSpectrumPlot::SteadyStateSpectrumPlot(Table &spectrum, const iNA::Ast::Unit &species_unit, const iNA::Ast::Unit &time_unit, QObject *parent)
+SteadyStateSpectrumPlot::SteadyStateSpectrumPlot(const Table &spectrum, const iNA::Ast::Unit &species_unit, const iNA::Ast::Unit &time_unit, QObject *parent)
   : Plot::Figure("Power spectrum", parent)
 {
   // Calc spectrum unit:
@@ -5,7 +5,7 @@
  * ******************************************************************************************* */
 SteadyStateTask::Config::Config()
   : GeneralTaskConfig(), ModelSelectionTaskConfig(),
-    model(0), max_iterations(0), max_time_step(0), epsilon(0), auto_frequencies(false),
+    max_iterations(0), max_time_step(0), epsilon(0), auto_frequencies(false),
     min_frequency(0), max_frequency(0), num_frequency(0)
 {
   // Pass...
@@ -13,7 +13,7 @@ SteadyStateTask::Config::Config()
 
 SteadyStateTask::Config::Config(const Config &other)
   : GeneralTaskConfig(), ModelSelectionTaskConfig(other),
-    model(other.model), max_iterations(other.max_iterations), max_time_step(other.max_time_step),
+    max_iterations(other.max_iterations), max_time_step(other.max_time_step),
     epsilon(other.epsilon), auto_frequencies(other.auto_frequencies),
     min_frequency(other.min_frequency), max_frequency(other.max_frequency),
     num_frequency(other.num_frequency)
@@ -21,18 +21,10 @@ SteadyStateTask::Config::Config(const Config &other)
   // Pass...
 }
 
-void
-SteadyStateTask::Config::setModelDocument(DocumentItem *document)
-{
-  ModelSelectionTaskConfig::setModelDocument(document);
-  // Construct LNA model from SBML model associated with the selected document
-  this->model = new iNA::Models::IOSmodel(document->getModel());
-}
-
-iNA::Ast::Model *
+const iNA::Ast::Model *
 SteadyStateTask::Config::getModel() const
 {
-  return this->model;
+  return &(*_model);
 }
 
 
@@ -79,7 +71,8 @@ SteadyStateTask::Config::setEpsilon(double eps)
  * ******************************************************************************************* */
 SteadyStateTask::SteadyStateTask(const Config &config, QObject *parent)
   : Task(parent), config(config), _Ns(config.getModel()->numSpecies()),
-    steady_state(dynamic_cast<iNA::Models::IOSmodel &>(*config.getModel()),
+    _sseModel(*config.getModel()),
+    steady_state(_sseModel,
       config.getMaxIterations(), config.getEpsilon(), config.getMaxTimeStep()),
     re_concentrations(_Ns), emre_corrections(_Ns), ios_corrections(_Ns),
     lna_covariances(_Ns, _Ns), ios_covariances(_Ns, _Ns), spectrum(1, _Ns+1)
@@ -95,11 +88,8 @@ SteadyStateTask::process()
   this->setState(Task::INITIALIZED);
   this->setProgress(0);
 
-  iNA::Models::IOSmodel *ios_model
-      = dynamic_cast<iNA::Models::IOSmodel *>(config.getModel());
-
   // Allocate reduced state vector (independent species)
-  Eigen::VectorXd reduced_state(ios_model->getDimension());
+  Eigen::VectorXd reduced_state(_sseModel.getDimension());
 
   // Calc steadystate:
   this->steady_state.calcSteadyState(reduced_state);
@@ -113,7 +103,7 @@ SteadyStateTask::process()
 
   // Get full state and covariance and EMRE corrections for steady state;
   Eigen::VectorXd thirdOrder(_Ns);
-  ios_model->fullState(reduced_state, re_concentrations, lna_covariances, emre_corrections,
+  _sseModel.fullState(reduced_state, re_concentrations, lna_covariances, emre_corrections,
                        ios_covariances, thirdOrder, ios_corrections);
 
 //  // Get steadystate spectrum:
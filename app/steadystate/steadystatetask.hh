@@ -21,8 +21,6 @@ public:
       public ModelSelectionTaskConfig
   {
   protected:
-    iNA::Models::IOSmodel *model;
-
     int max_iterations;
     double max_time_step;
     double epsilon;
@@ -39,13 +37,9 @@ public:
     /** Copy constructor. */
     Config(const Config &other);
 
-    /** Overrides the default implenentation of @c ModelSelectionTaskConfig and checks if
-     * the selected model can be used to instantiate a LNAModel. The LNA model instance is then
-     * stored in model. */
-    virtual void setModelDocument(DocumentItem *document);
-
-    /** Implements the @c SpeciesSelectionTaskConfig interface, and returns the LNA model instance. */
-    virtual iNA::Ast::Model *getModel() const;
+    /** Implements the @c SpeciesSelectionTaskConfig interface, and returns the snapshot of the
+     * model. The IOS model is constructed from it by the task. */
+    virtual const iNA::Ast::Model *getModel() const;
 
     /** Returns the max number of iterations.*/
     size_t getMaxIterations() const;
@@ -68,6 +62,8 @@ protected:
   Config config;
   /** Holds the number of species in the selected model. */
   size_t _Ns;
+  /** Holds the IOS model, constructed from the snapshot of the model. */
+  iNA::Models::IOSmodel _sseModel;
   /** Holds an instance of the analysis. */
   iNA::Models::SteadyStateAnalysis<iNA::Models::IOSmodel> steady_state;
   Eigen::VectorXd re_concentrations;
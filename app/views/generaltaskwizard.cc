@@ -110,7 +110,7 @@ SpeciesSelectionWizardPage::initializePage()
   // Get selected model from wizard:
   GeneralTaskWizard *wizard = static_cast<GeneralTaskWizard *>(this->wizard());
   SpeciesSelectionTaskConfig &config = wizard->getConfigCast<SpeciesSelectionTaskConfig>();
-  iNA::Ast::Model *model = config.getModel();
+  const iNA::Ast::Model *model = config.getModel();
 
   // Construct list of species
   for (size_t i=0; i<model->numSpecies(); i++)
@@ -286,6 +286,8 @@ IntegratorWizardPage::IntegratorWizardPage(QWidget *parent)
   this->integrator->addItem("RKF45 (adaptive)", QVariant("rkf45"));
   this->integrator->addItem("Dopri5 (adaptive)", QVariant("dopr5"));
   this->integrator->addItem("Rosenbrock4 (stiff)", QVariant("ros4"));
+  this->integrator->addItem("BDF (very stiff)", QVariant("bdf"));
+  this->integrator->addItem("BDF (very stiff, Jacobian-free)", QVariant("bdfk"));
 //  this->integrator->addItem("RK4", QVariant("rk4"));
   this->integrator->setSizePolicy(QSizePolicy::MinimumExpanding, QSizePolicy::Minimum);
   this->registerField("integrator", this->integrator);
@@ -304,6 +306,10 @@ IntegratorWizardPage::IntegratorWizardPage(QWidget *parent)
   ep_abs_val->setBottom(0); ep_rel->setValidator(ep_rel_val);
   this->registerField("epsilon_rel", ep_rel);
 
+  QCheckBox *stop_steady = new QCheckBox();
+  stop_steady->setChecked(false);
+  this->registerField("stop_steady", stop_steady);
+
   QFormLayout *layout = new QFormLayout();
   layout->addRow(tr("Final time"), t);
   layout->addRow(tr("Plot points"), n);
@@ -311,12 +317,15 @@ IntegratorWizardPage::IntegratorWizardPage(QWidget *parent)
   layout->addRow(tr("Integrator"), this->integrator);
   layout->addRow(tr("Max. absolute error"), ep_abs);
   layout->addRow(tr("Max. relative error"), ep_rel);
+  layout->addRow(tr("Stop at steady state"), stop_steady);
 
   t->setToolTip("Final time of integration.");
   n->setToolTip("Number of individual time points for output.");
   intermediateSteps->setToolTip("Number of additional steps to be taken. \n"
                                 "Increasing this number can improve the accuracy of the computation at the cost of slower runtime.");
   integrator->setToolTip("Sets the numerical algorithm for ODE integration. \n LSODA is a good general-purpose choice.");
+  stop_steady->setToolTip("Stops the integration once all rates of change are below the absolute and relative error, \n"
+                          "i.e. once the system reached its steady state.");
 
   this->setLayout(layout);
 }
@@ -366,6 +375,7 @@ IntegratorWizardPage::validatePage()
   config.setIntegrationRange(iNA::ODE::IntegrationRange(t0, t, n*(1+n_imm)));
   config.setEpsilon(epsilon_abs, epsilon_rel);
   config.setIntermediateSteps(n_imm);
+  config.setStopAtSteadyState(this->field("stop_steady").toBool());
 
   if ("rk4" == this->integrator->itemData(this->integrator->currentIndex()).toString()) {
     config.setIntegrator(ODEIntTaskConfig::RungeKutta4);
@@ -377,6 +387,10 @@ IntegratorWizardPage::validatePage()
         config.setIntegrator(ODEIntTaskConfig::LSODA);
   } else if ("ros4" == this->integrator->itemData(this->integrator->currentIndex()).toString()) {
     config.setIntegrator(ODEIntTaskConfig::Rosenbrock4);
+  } else if ("bdf" == this->integrator->itemData(this->integrator->currentIndex()).toString()) {
+    config.setIntegrator(ODEIntTaskConfig::BDF);
+  } else if ("bdfk" == this->integrator->itemData(this->integrator->currentIndex()).toString()) {
+    config.setIntegrator(ODEIntTaskConfig::BDFKrylov);
   } else {
     return false;
   }
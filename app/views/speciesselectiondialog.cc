@@ -16,7 +16,7 @@ using namespace iNA;
 /* ******************************************************************************************* *
  * Implements the species selection widget
  * ******************************************************************************************* */
-SpeciesSelectionWidget::SpeciesSelectionWidget(Ast::Model *model, QWidget *parent)
+SpeciesSelectionWidget::SpeciesSelectionWidget(const Ast::Model *model, QWidget *parent)
   : QWidget(parent)
 {
   // Create selection model
@@ -72,7 +72,7 @@ SpeciesSelectionWidget::invertSelection() {
 /* ******************************************************************************************* *
  * Implements the species selection dialog.
  * ******************************************************************************************* */
-SpeciesSelectionDialog::SpeciesSelectionDialog(Ast::Model *model, QWidget *parent)
+SpeciesSelectionDialog::SpeciesSelectionDialog(const Ast::Model *model, QWidget *parent)
   : QDialog(parent)
 {
   // Allocate label.
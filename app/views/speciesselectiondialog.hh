@@ -17,7 +17,7 @@ class SpeciesSelectionWidget: public QWidget
 
 public:
   /** Constructs the species selection widget. */
-  SpeciesSelectionWidget(iNA::Ast::Model *model, QWidget *parent=0);
+  SpeciesSelectionWidget(const iNA::Ast::Model *model, QWidget *parent=0);
 
   /** Returns the selected species. */
   QStringList selectedSpecies();
@@ -48,7 +48,7 @@ class SpeciesSelectionDialog : public QDialog
 
 public:
   /** Constructor. */
-  explicit SpeciesSelectionDialog(iNA::Ast::Model *model, QWidget *parent = 0);
+  explicit SpeciesSelectionDialog(const iNA::Ast::Model *model, QWidget *parent = 0);
   
   /** Retunrs the list of selected species. */
   QList<QString> selectedSpecies() const;
@@ -35,5 +35,6 @@
 
 #include "unitconverter.hh"
 #include "modelcopyist.hh"
+#include "modelsnapshot.hh"
 
 #endif // __FLUC_COMPILER_AST_HH__
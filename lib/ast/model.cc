@@ -13,6 +13,47 @@ using namespace iNA;
 using namespace iNA::Ast;
 
 
+/* Inserts the given definition into the vector at the given position and updates the indices of
+ * all following definitions. */
+template <class T>
+static void
+insertIndexed(std::vector<T *> &vector, std::map<const Definition *, size_t> &index,
+              size_t pos, T *def)
+{
+  vector.insert(vector.begin()+pos, def);
+  for (size_t i=pos; i<vector.size(); i++) {
+    index[vector[i]] = i;
+  }
+}
+
+/* Removes the definition at the given position from the vector and updates the indices of all
+ * following definitions. */
+template <class T>
+static void
+eraseIndexed(std::vector<T *> &vector, std::map<const Definition *, size_t> &index, size_t pos)
+{
+  index.erase(vector[pos]);
+  vector.erase(vector.begin()+pos);
+  for (size_t i=pos; i<vector.size(); i++) {
+    index[vector[i]] = i;
+  }
+}
+
+/* Returns the position right after the given definition or the end of the vector if the
+ * definition is not an element of the vector. */
+template <class T>
+static size_t
+positionAfter(const std::vector<T *> &vector, const std::map<const Definition *, size_t> &index,
+              const Definition *after)
+{
+  std::map<const Definition *, size_t>::const_iterator item = index.find(after);
+  if ((index.end() != item) && (item->second < vector.size()) && (after == vector[item->second])) {
+    return item->second+1;
+  }
+  return vector.size();
+}
+
+
 Ast::Model::Model(const std::string &identifier, const std::string &name)
   : Scope(), _identifier(identifier), _name(name), _species_have_substance_units(false)
 {
@@ -459,13 +500,10 @@ Model::getParameterIdx(const GiNaC::symbol &symbol) const
 size_t
 Model::getParameterIdx(const Parameter *parameter) const
 {
-  // Search vector for parameter:
-  for (size_t i=0; i<this->_parameter_vector.size(); i++)
-  {
-    if (parameter == this->_parameter_vector[i])
-    {
-      return i;
-    }
+  // Lookup index in index table:
+  std::map<const Definition *, size_t>::const_iterator item = this->_index_table.find(parameter);
+  if (this->_index_table.end() != item) {
+    return item->second;
   }
 
   SymbolError err;
@@ -590,13 +628,10 @@ Model::getCompartmentIdx(const GiNaC::symbol &symbol) const
 size_t
 Model::getCompartmentIdx(Compartment *compartment) const
 {
-  // Search compartment vector for compartment:
-  for (size_t i=0; i<this->_compartment_vector.size(); i++)
-  {
-    if (compartment == this->_compartment_vector[i])
-    {
-      return i;
-    }
+  // Lookup index in index table:
+  std::map<const Definition *, size_t>::const_iterator item = this->_index_table.find(compartment);
+  if (this->_index_table.end() != item) {
+    return item->second;
   }
 
   SymbolError err;
@@ -719,13 +754,10 @@ Model::getSpeciesIdx(const GiNaC::symbol &symbol) const
 size_t
 Model::getSpeciesIdx(Species *species) const
 {
-  // Search species vector for species:
-  for (size_t i=0; i<this->_species_vector.size(); i++)
-  {
-    if (species == this->_species_vector[i])
-    {
-      return i;
-    }
+  // Lookup index in index table:
+  std::map<const Definition *, size_t>::const_iterator item = this->_index_table.find(species);
+  if (this->_index_table.end() != item) {
+    return item->second;
   }
 
   SymbolError err;
@@ -793,11 +825,10 @@ Model::getReactionIdx(const std::string &id) const {
 size_t
 Model::getReactionIdx(Reaction *reac) const
 {
-  // Search reaction in reaction vector:
-  for (size_t i=0; i<this->_reaction_vector.size(); i++) {
-    if (reac == this->_reaction_vector[i]) {
-      return i;
-    }
+  // Lookup index in index table:
+  std::map<const Definition *, size_t>::const_iterator item = this->_index_table.find(reac);
+  if (this->_index_table.end() != item) {
+    return item->second;
   }
 
   SymbolError err;
@@ -879,18 +910,22 @@ Model::addDefinition(Definition *def)
   switch (def->getNodeType())
   {
   case Node::COMPARTMENT_DEFINITION:
+    this->_index_table[def] = this->_compartment_vector.size();
     this->_compartment_vector.push_back(static_cast<Compartment *>(def));
     break;
 
   case Node::SPECIES_DEFINITION:
+    this->_index_table[def] = this->_species_vector.size();
     this->_species_vector.push_back(static_cast<Species *>(def));
     break;
 
   case Node::PARAMETER_DEFINITION:
+    this->_index_table[def] = this->_parameter_vector.size();
     this->_parameter_vector.push_back(static_cast<Parameter *>(def));
     break;
 
   case Node::REACTION_DEFINITION:
+    this->_index_table[def] = this->_reaction_vector.size();
     this->_reaction_vector.push_back(static_cast<Reaction *>(def));
     break;
 
@@ -909,36 +944,28 @@ Model::addDefinition(Definition *def, Definition *after)
   switch (def->getNodeType())
   {
   case Node::COMPARTMENT_DEFINITION:
-  {
-    std::vector<Compartment *>::iterator pos=this->_compartment_vector.begin();
-    while(pos!=this->_compartment_vector.end())
-        if((*(pos++))==static_cast<Compartment *>(after)) break;
-    this->_compartment_vector.insert(pos,static_cast<Compartment *>(def));
-  } break;
+    insertIndexed(this->_compartment_vector, this->_index_table,
+                  positionAfter(this->_compartment_vector, this->_index_table, after),
+                  static_cast<Compartment *>(def));
+    break;
 
   case Node::SPECIES_DEFINITION:
-  {
-    std::vector<Species *>::iterator pos=this->_species_vector.begin();
-    while(pos!=this->_species_vector.end())
-        if((*(pos++))==static_cast<Species *>(after)) break;
-    this->_species_vector.insert(pos,static_cast<Species *>(def));
-  } break;
+    insertIndexed(this->_species_vector, this->_index_table,
+                  positionAfter(this->_species_vector, this->_index_table, after),
+                  static_cast<Species *>(def));
+    break;
 
   case Node::PARAMETER_DEFINITION:
-  {
-    std::vector<Parameter *>::iterator pos=this->_parameter_vector.begin();
-    while(pos!=this->_parameter_vector.end())
-        if((*(pos++))==static_cast<Parameter *>(after)) break;
-    this->_parameter_vector.insert(pos,static_cast<Parameter *>(def));
-  } break;
+    insertIndexed(this->_parameter_vector, this->_index_table,
+                  positionAfter(this->_parameter_vector, this->_index_table, after),
+                  static_cast<Parameter *>(def));
+    break;
 
   case Node::REACTION_DEFINITION:
-  {
-    std::vector<Reaction *>::iterator pos=this->_reaction_vector.begin();
-    while(pos!=this->_reaction_vector.end())
-        if((*(pos++))==static_cast<Reaction *>(after)) break;
-    this->_reaction_vector.insert(pos,static_cast<Reaction *>(def));
-  } break;
+    insertIndexed(this->_reaction_vector, this->_index_table,
+                  positionAfter(this->_reaction_vector, this->_index_table, after),
+                  static_cast<Reaction *>(def));
+    break;
 
   default:
     break;
@@ -952,23 +979,23 @@ Model::remDefinition(Definition *def)
   // Remove definition from index vectors.
   switch(def->getNodeType()) {
   case Node::COMPARTMENT_DEFINITION:
-    this->_compartment_vector.erase(
-          _compartment_vector.begin()+getCompartmentIdx(static_cast<Compartment *>(def)));
+    eraseIndexed(this->_compartment_vector, this->_index_table,
+                 getCompartmentIdx(static_cast<Compartment *>(def)));
     break;
 
   case Node::SPECIES_DEFINITION:
-    this->_species_vector.erase(
-          _species_vector.begin()+getSpeciesIdx(static_cast<Species *>(def)));
+    eraseIndexed(this->_species_vector, this->_index_table,
+                 getSpeciesIdx(static_cast<Species *>(def)));
     break;
 
   case Node::PARAMETER_DEFINITION:
-    this->_parameter_vector.erase(
-          _parameter_vector.begin()+getParameterIdx(static_cast<Parameter *>(def)));
+    eraseIndexed(this->_parameter_vector, this->_index_table,
+                 getParameterIdx(static_cast<Parameter *>(def)));
     break;
 
   case Node::REACTION_DEFINITION:
-    this->_reaction_vector.erase(
-          _reaction_vector.begin()+getReactionIdx(static_cast<Reaction *>(def)));
+    eraseIndexed(this->_reaction_vector, this->_index_table,
+                 getReactionIdx(static_cast<Reaction *>(def)));
     break;
 
   default:
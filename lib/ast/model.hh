@@ -389,6 +389,11 @@ protected:
   /** Holds a vector of weak-references to all reactions in the model, in order of their definition.
    * This vector does not own the reaction instances. */
   std::vector<Reaction *> _reaction_vector;
+
+  /** Maps each compartment, species, parameter and reaction to its index in the corresponding
+   * vector above. This table allows to obtain the index of a definition in logarithmic time and is
+   * maintained by @c addDefinition and @c remDefinition. */
+  std::map<const Definition *, size_t> _index_table;
 };
 
 
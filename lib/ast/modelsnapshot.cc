@@ -0,0 +1,138 @@
+#include "modelsnapshot.hh"
+#include "exception.hh"
+
+using namespace iNA;
+using namespace iNA::Ast;
+
+
+ModelSnapshot::ModelSnapshot()
+  : _shared(0)
+{
+  // Pass...
+}
+
+ModelSnapshot::ModelSnapshot(const Model &model)
+  : _shared(new Shared())
+{
+  _shared->model = new Model(model);
+  _shared->refcount = 1;
+}
+
+ModelSnapshot::ModelSnapshot(Model *model)
+  : _shared(new Shared())
+{
+  _shared->model = model;
+  _shared->refcount = 1;
+}
+
+ModelSnapshot::ModelSnapshot(const ModelSnapshot &other)
+  : _shared(other._shared)
+{
+  if (0 != _shared) {
+#pragma omp critical (ina_model_snapshot)
+    {
+      _shared->refcount++;
+    }
+  }
+}
+
+ModelSnapshot::~ModelSnapshot()
+{
+  release();
+}
+
+
+const ModelSnapshot &
+ModelSnapshot::operator =(const ModelSnapshot &other)
+{
+  // Take reference first, this handles self-assignment:
+  Shared *shared = other._shared;
+  if (0 != shared) {
+#pragma omp critical (ina_model_snapshot)
+    {
+      shared->refcount++;
+    }
+  }
+  release();
+  _shared = shared;
+  return *this;
+}
+
+
+bool
+ModelSnapshot::isNull() const {
+  return 0 == _shared;
+}
+
+bool
+ModelSnapshot::isShared() const {
+  if (0 == _shared) { return false; }
+  bool shared = false;
+#pragma omp critical (ina_model_snapshot)
+  {
+    shared = (1 < _shared->refcount);
+  }
+  return shared;
+}
+
+
+const Model &
+ModelSnapshot::model() const
+{
+  if (0 == _shared) {
+    InternalError err;
+    err << "Cannot access model of an empty ModelSnapshot.";
+    throw err;
+  }
+  return *(_shared->model);
+}
+
+const Model *
+ModelSnapshot::operator ->() const {
+  return &model();
+}
+
+const Model &
+ModelSnapshot::operator *() const {
+  return model();
+}
+
+
+Model &
+ModelSnapshot::modify()
+{
+  // Detach from the other snapshots:
+  if (isShared()) {
+    Shared *copy = new Shared();
+    copy->model = new Model(*(_shared->model));
+    copy->refcount = 1;
+    release();
+    _shared = copy;
+  }
+
+  return const_cast<Model &>(model());
+}
+
+
+void
+ModelSnapshot::reset()
+{
+  release();
+}
+
+
+void
+ModelSnapshot::release()
+{
+  if (0 == _shared) { return; }
+  bool last = false;
+#pragma omp critical (ina_model_snapshot)
+  {
+    last = (0 == --(_shared->refcount));
+  }
+  if (last) {
+    delete _shared->model;
+    delete _shared;
+  }
+  _shared = 0;
+}
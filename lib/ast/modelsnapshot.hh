@@ -0,0 +1,90 @@
+#ifndef __INA_AST_MODELSNAPSHOT_HH__
+#define __INA_AST_MODELSNAPSHOT_HH__
+
+#include "model.hh"
+
+
+namespace iNA {
+namespace Ast {
+
+
+/**
+ * Shareable, immutable snapshot of a @c Ast::Model with copy-on-write semantics.
+ *
+ * A snapshot holds a reference-counted copy of a model. Copying a snapshot does not copy the
+ * model, all copies share the same instance and provide read-only access to it. A deep copy of
+ * the model is only performed by @c modify, if the model is shared with other snapshots. Hence
+ * several tasks, configured on the same revision of a model, share a single copy of it until one
+ * of them transforms its model.
+ *
+ * @note The reference counter is guarded by a critical section, hence snapshots sharing a model
+ *       may be copied and destroyed from different threads, i.e. by a task running in the
+ *       background. Concurrent read-only access to the model is fine.
+ *
+ * @ingroup ast
+ */
+class ModelSnapshot
+{
+public:
+  /** Constructs an empty snapshot. */
+  ModelSnapshot();
+
+  /** Constructs a snapshot of the given model, the model is copied once. */
+  explicit ModelSnapshot(const Model &model);
+
+  /** Constructs a snapshot by taking ownership of the given model. */
+  explicit ModelSnapshot(Model *model);
+
+  /** Copy constructor, shares the model with @c other. */
+  ModelSnapshot(const ModelSnapshot &other);
+
+  /** Destructor, destroys the model if it is not shared anymore. */
+  ~ModelSnapshot();
+
+  /** Assignment operator, shares the model with @c other. */
+  const ModelSnapshot &operator=(const ModelSnapshot &other);
+
+  /** Returns true if the snapshot is empty. */
+  bool isNull() const;
+
+  /** Returns true if the model is shared with other snapshots. */
+  bool isShared() const;
+
+  /** Returns the model (read-only). */
+  const Model &model() const;
+
+  /** Returns a pointer to the model (read-only). */
+  const Model *operator->() const;
+
+  /** Returns the model (read-only). */
+  const Model &operator*() const;
+
+  /** Returns the model for modification. If the model is shared with other snapshots, it gets
+   * copied first, the other snapshots remain untouched. */
+  Model &modify();
+
+  /** Resets the snapshot to be empty. */
+  void reset();
+
+protected:
+  /** Drops the reference to the shared model. */
+  void release();
+
+protected:
+  /** The shared model and its reference counter. */
+  struct Shared {
+    /** The model. */
+    Model *model;
+    /** The number of snapshots sharing the model. */
+    size_t refcount;
+  };
+
+  /** Holds the shared model or 0. */
+  Shared *_shared;
+};
+
+
+}
+}
+
+#endif // __INA_AST_MODELSNAPSHOT_HH__
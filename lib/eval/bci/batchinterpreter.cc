@@ -0,0 +1,170 @@
+#include "batchinterpreter.hh"
+#include <cmath>
+#include <algorithm>
+
+using namespace iNA;
+using namespace iNA::Eval::bci;
+
+
+BatchInterpreter::BatchInterpreter()
+  : code(0), depth(0), stack()
+{
+  // Pass...
+}
+
+
+BatchInterpreter::BatchInterpreter(Code *code)
+  : code(0), depth(0), stack()
+{
+  setCode(code);
+}
+
+
+void
+BatchInterpreter::setCode(Code *code)
+{
+  this->code = code;
+
+  // Determine maximum stack depth:
+  size_t current = 0; depth = 0;
+  for (Code::iterator inst=code->begin(); inst!=code->end(); inst++) {
+    switch (inst->opcode) {
+    case Instruction::LOAD:
+    case Instruction::PUSH:
+      current++;
+      break;
+
+    case Instruction::STORE:
+      current--;
+      break;
+
+    case Instruction::ADD:
+    case Instruction::SUB:
+    case Instruction::MUL:
+    case Instruction::DIV:
+    case Instruction::POW:
+      if (! inst->valueImmediate) { current--; }
+      break;
+
+    default:
+      break;
+    }
+    depth = std::max(depth, current);
+  }
+}
+
+
+void
+BatchInterpreter::run(const double *input, double *output, size_t K)
+{
+  // The first stack element is never used, it marks the empty stack:
+  if (stack.size() < (depth+1)*K) { stack.resize((depth+1)*K); }
+
+  // Points to the top-of-stack:
+  double *top = &(stack[0]);
+
+  for (Code::iterator inst=code->begin(); inst!=code->end(); inst++) {
+    switch (inst->opcode) {
+    case Instruction::ADD:
+      if (inst->valueImmediate) {
+        double rhs = inst->value.asComplex.real;
+        for (size_t k=0; k<K; k++) { top[k] += rhs; }
+      } else {
+        double *lhs = top-K;
+        for (size_t k=0; k<K; k++) { lhs[k] += top[k]; }
+        top = lhs;
+      }
+      break;
+
+    case Instruction::SUB:
+      if (inst->valueImmediate) {
+        double rhs = inst->value.asComplex.real;
+        for (size_t k=0; k<K; k++) { top[k] -= rhs; }
+      } else {
+        double *lhs = top-K;
+        for (size_t k=0; k<K; k++) { lhs[k] -= top[k]; }
+        top = lhs;
+      }
+      break;
+
+    case Instruction::MUL:
+      if (inst->valueImmediate) {
+        double rhs = inst->value.asComplex.real;
+        for (size_t k=0; k<K; k++) { top[k] *= rhs; }
+      } else {
+        double *lhs = top-K;
+        for (size_t k=0; k<K; k++) { lhs[k] *= top[k]; }
+        top = lhs;
+      }
+      break;
+
+    case Instruction::DIV:
+      if (inst->valueImmediate) {
+        double rhs = inst->value.asComplex.real;
+        for (size_t k=0; k<K; k++) { top[k] /= rhs; }
+      } else {
+        double *lhs = top-K;
+        for (size_t k=0; k<K; k++) { lhs[k] /= top[k]; }
+        top = lhs;
+      }
+      break;
+
+    case Instruction::POW:
+      if (inst->valueImmediate) {
+        double rhs = inst->value.asComplex.real;
+        for (size_t k=0; k<K; k++) { top[k] = std::pow(top[k], rhs); }
+      } else {
+        double *lhs = top-K;
+        for (size_t k=0; k<K; k++) { lhs[k] = std::pow(lhs[k], top[k]); }
+        top = lhs;
+      }
+      break;
+
+    case Instruction::IPOW:
+      for (size_t k=0; k<K; k++) {
+        double x = top[k];
+        for (size_t i=1; i<inst->value.asIndex; i++) { top[k] *= x; }
+      }
+      break;
+
+    case Instruction::LOAD:
+    {
+      const double *value = input + inst->value.asIndex*K;
+      top += K;
+      for (size_t k=0; k<K; k++) { top[k] = value[k]; }
+    }
+      break;
+
+    case Instruction::STORE:
+    {
+      double *value = output + inst->value.asIndex*K;
+      for (size_t k=0; k<K; k++) { value[k] = top[k]; }
+      top -= K;
+    }
+      break;
+
+    case Instruction::STORE_ZERO:
+      std::fill(output + inst->value.asIndex*K, output + (inst->value.asIndex+1)*K, 0.0);
+      break;
+
+    case Instruction::PUSH:
+      top += K;
+      std::fill(top, top+K, inst->value.asComplex.real);
+      break;
+
+    case Instruction::CALL:
+      switch (Instruction::FunctionCode(inst->value.asIndex)) {
+      case Instruction::FUNCTION_ABS:
+        for (size_t k=0; k<K; k++) { top[k] = std::abs(top[k]); }
+        break;
+      case Instruction::FUNCTION_LOG:
+        for (size_t k=0; k<K; k++) { top[k] = std::log(top[k]); }
+        break;
+      case Instruction::FUNCTION_EXP:
+        for (size_t k=0; k<K; k++) { top[k] = std::exp(top[k]); }
+        break;
+      }
+      break;
+    }
+  }
+}
@@ -0,0 +1,62 @@
+#ifndef __INA_EVAL_BCI_BATCHINTERPRETER_HH__
+#define __INA_EVAL_BCI_BATCHINTERPRETER_HH__
+
+#include <vector>
+#include "code.hh"
+
+
+namespace iNA {
+namespace Eval {
+namespace bci {
+
+
+/**
+ * Evaluates real-valued byte-code for a batch of @c K independent inputs at once.
+ *
+ * In contrast to the @c Interpreter, which evaluates the byte-code for a single input vector, the
+ * batch interpreter dispatches each instruction only once for all @c K inputs. The inputs, outputs
+ * and the stack are laid out structure-of-arrays, i.e. the @c K values of the i-th element are
+ * stored contiguously: The j-th input value of the k-th member is found at
+ * <tt>input[j*K+k]</tt>. This is exactly the layout of a column-major matrix with @c K rows,
+ * hence the inner loops over the batch run over contiguous memory and can be vectorized.
+ *
+ * @ingroup bci
+ */
+class BatchInterpreter
+{
+protected:
+  /** Holds a weak reference to the code to be evaluated. */
+  Code *code;
+  /** Holds the maximum stack depth of the code. */
+  size_t depth;
+  /** Holds the stack, each stack element holds the values of all members of the batch. */
+  std::vector<double> stack;
+
+
+public:
+  /** Constructs an interpreter with-out any byte-code. */
+  BatchInterpreter();
+
+  /** Constructs an interpreter with the given byte-code. */
+  BatchInterpreter(Code *code);
+
+  /** Resets the code. */
+  void setCode(Code *code);
+
+  /**
+   * Executes the byte-code for @c K inputs.
+   *
+   * @param input Specifies the inputs, the j-th value of the k-th member at <tt>input[j*K+k]</tt>.
+   * @param output On exit, the outputs, the i-th value of the k-th member at
+   *        <tt>output[i*K+k]</tt>.
+   * @param K Specifies the batch size.
+   */
+  void run(const double *input, double *output, size_t K);
+};
+
+
+}
+}
+}
+
+#endif // __INA_EVAL_BCI_BATCHINTERPRETER_HH__
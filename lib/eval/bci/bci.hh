@@ -5,5 +5,6 @@
 #include "code.hh"
 #include "compiler.hh"
 #include "interpreter.hh"
+#include "batchinterpreter.hh"
 
 #endif // __FLUC_EVALUATE_BCI_HH__
@@ -1,9 +1,81 @@
 #include "code.hh"
+#include "../../exception.hh"
+#include <cstring>
+#include <stdint.h>
 
 using namespace iNA;
 using namespace iNA::Eval::bci;
 
 
+/* ********************************************************************************************* *
+ * Helper functions for the serialization of byte-code:
+ * ********************************************************************************************* */
+/** Magic bytes, identifying serialized byte-code. */
+static const char __serialized_code_magic[4] = {'i', 'N', 'A', 'B'};
+/** Version of the serialization format. */
+static const uint32_t __serialized_code_version = 1;
+
+/** Writes an unsigned integer of the given size in little-endian byte-order. */
+static inline void
+__write_uint(std::ostream &stream, uint64_t value, size_t bytes)
+{
+  for (size_t i=0; i<bytes; i++) {
+    stream.put(char((value >> (8*i)) & 0xff));
+  }
+}
+
+/** Reads an unsigned integer of the given size in little-endian byte-order. */
+static inline uint64_t
+__read_uint(std::istream &stream, size_t bytes)
+{
+  uint64_t value = 0;
+  for (size_t i=0; i<bytes; i++) {
+    int c = stream.get();
+    if (std::istream::traits_type::eof() == c) {
+      RuntimeError err;
+      err << "Can not read byte-code: Unexpected end of stream.";
+      throw err;
+    }
+    value |= (uint64_t(c) & 0xff) << (8*i);
+  }
+  return value;
+}
+
+/** Writes a IEEE 754 double precision value bit-exact. */
+static inline void
+__write_double(std::ostream &stream, double value)
+{
+  uint64_t bits; std::memcpy(&bits, &value, sizeof(double));
+  __write_uint(stream, bits, 8);
+}
+
+/** Reads a IEEE 754 double precision value bit-exact. */
+static inline double
+__read_double(std::istream &stream)
+{
+  uint64_t bits = __read_uint(stream, 8);
+  double value; std::memcpy(&value, &bits, sizeof(double));
+  return value;
+}
+
+/** Returns true, if the immediate value of the given instruction is an index. */
+static inline bool
+__has_index_value(Instruction::OpCode opcode)
+{
+  switch (opcode) {
+  case Instruction::IPOW:
+  case Instruction::LOAD:
+  case Instruction::STORE:
+  case Instruction::STORE_ZERO:
+  case Instruction::CALL:
+    return true;
+  default:
+    break;
+  }
+  return false;
+}
+
+
 
 /* ********************************************************************************************* *
  * Implementation of Code:
@@ -215,3 +287,73 @@ Code::dump(std::ostream &str)
     }
   }
 }
+
+
+void
+Code::serialize(std::ostream &stream) const
+{
+  // Header: magic, version, min. stack size and number of instructions
+  stream.write(__serialized_code_magic, 4);
+  __write_uint(stream, __serialized_code_version, 4);
+  __write_uint(stream, this->max_stack_size, 8);
+  __write_uint(stream, this->code.size(), 8);
+
+  for (Code::const_iterator inst = this->begin(); inst != this->end(); inst++)
+  {
+    __write_uint(stream, inst->opcode, 1);
+    __write_uint(stream, inst->valueImmediate ? 1 : 0, 1);
+    if (__has_index_value(inst->opcode)) {
+      __write_uint(stream, inst->value.asIndex, 8);
+    } else if (inst->valueImmediate) {
+      __write_double(stream, inst->value.asComplex.real);
+      __write_double(stream, inst->value.asComplex.imag);
+    }
+  }
+}
+
+
+void
+Code::deserialize(std::istream &stream)
+{
+  char magic[4];
+  if (! stream.read(magic, 4) || 0 != std::memcmp(magic, __serialized_code_magic, 4)) {
+    RuntimeError err;
+    err << "Can not read byte-code: Invalid header.";
+    throw err;
+  }
+
+  uint64_t version = __read_uint(stream, 4);
+  if (__serialized_code_version != version) {
+    RuntimeError err;
+    err << "Can not read byte-code: Unsupported format version " << version << ".";
+    throw err;
+  }
+
+  size_t stack_size = __read_uint(stream, 8);
+  size_t num_instructions = __read_uint(stream, 8);
+
+  std::vector<Instruction> instructions;
+  instructions.reserve(num_instructions);
+  for (size_t i=0; i<num_instructions; i++)
+  {
+    uint64_t opcode = __read_uint(stream, 1);
+    if (opcode > Instruction::CALL) {
+      RuntimeError err;
+      err << "Can not read byte-code: Invalid op-code " << opcode << ".";
+      throw err;
+    }
+
+    Instruction inst((Instruction::OpCode) opcode);
+    inst.valueImmediate = (0 != __read_uint(stream, 1));
+    if (__has_index_value(inst.opcode)) {
+      inst.value.asIndex = __read_uint(stream, 8);
+    } else if (inst.valueImmediate) {
+      inst.value.asComplex.real = __read_double(stream);
+      inst.value.asComplex.imag = __read_double(stream);
+    }
+    instructions.push_back(inst);
+  }
+
+  this->code.swap(instructions);
+  this->max_stack_size = stack_size;
+}
@@ -4,6 +4,7 @@
 #include <vector>
 #include <cstdlib>
 #include <complex>
+#include <iostream>
 
 
 namespace iNA {
@@ -150,6 +151,15 @@ public:
   /** Dumps the code into the given stream. */
   void dump(std::ostream &str);
 
+  /** Serializes the byte-code into the given stream.
+   * The binary format is stable, i.e. it does not depend on the platform (word-size and
+   * byte-order) nor on the memory layout of @c Instruction. */
+  void serialize(std::ostream &stream) const;
+
+  /** Replaces the byte-code by the one read from the given stream.
+   * @throws RuntimeError If the stream does not contain valid byte-code. */
+  void deserialize(std::istream &stream);
+
   /** Returns the minimum stack-size required to execute this code.
    * @note You need to call check() to update the minimum required stack size once, the bytecode
    *       was modified. */
@@ -9,6 +9,7 @@
 #include "../../ast/model.hh"
 #include "assembler.hh"
 #include "pass.hh"
+#include "forkcompiler.hh"
 #include "../../utils/cputime.hh"
 #include "../../utils/logger.hh"
 #include "../compilercommon.hh"
@@ -75,6 +76,13 @@ public:
   }
 
 
+  /** Returns the symbol->index mapping used by this compiler. */
+  std::map<GiNaC::symbol, size_t, GiNaC::ex_is_less> &getIndexTable()
+  {
+    return this->index_table;
+  }
+
+
   /** Compiles expression and creates a STORE instruction, that will store the value of the
    * expression at the given index in the output-vector during evaluation.  */
   virtual void compileExpressionAndStore(const GiNaC::ex &expression, size_t index)
@@ -85,6 +93,16 @@ public:
   }
 
 
+  /** Generates and compiles the expressions of the given generator, possibly using several
+   * worker processes (see @c ForkCompiler). */
+  virtual void compileGenerated(ExpressionGenerator &generator, size_t num_processes=1)
+  {
+    std::vector<Code *> codes(1, this->code);
+    ForkCompiler::compile(generator, this->index_table, codes, 0,
+                          OutType::Flags & Eigen::RowMajorBit, num_processes);
+  }
+
+
   /** Performs some optimizations on the byte-code. */
   virtual void finalize(size_t level=0)
   {
@@ -0,0 +1,193 @@
+#include "forkcompiler.hh"
+#include "assembler.hh"
+#include "exception.hh"
+#include "utils/logger.hh"
+#include <sstream>
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+
+#ifndef WIN32
+#include <unistd.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#endif
+
+using namespace iNA;
+using namespace iNA::Eval::bci;
+
+
+#ifndef WIN32
+/** Writes the complete buffer into the file descriptor. */
+static bool
+__write_all(int fd, const std::string &buffer)
+{
+  size_t written = 0;
+  while (written < buffer.size()) {
+    ssize_t ret = ::write(fd, buffer.data()+written, buffer.size()-written);
+    if (0 > ret) {
+      if (EINTR == errno) { continue; }
+      return false;
+    }
+    written += ret;
+  }
+  return true;
+}
+
+/** Reads from the file descriptor until EOF. */
+static bool
+__read_all(int fd, std::string &buffer)
+{
+  char chunk[4096];
+  while (true) {
+    ssize_t ret = ::read(fd, chunk, sizeof(chunk));
+    if (0 > ret) {
+      if (EINTR == errno) { continue; }
+      return false;
+    }
+    if (0 == ret) { return true; }
+    buffer.append(chunk, ret);
+  }
+}
+#endif
+
+
+void
+ForkCompiler::compileSlice(ExpressionGenerator &generator,
+                           std::map<GiNaC::symbol, size_t, GiNaC::ex_is_less> &index_table,
+                           std::vector<Code *> &codes, size_t offset, bool row_major,
+                           size_t first, size_t last)
+{
+  size_t rows = generator.rows(), cols = generator.cols();
+
+  for (size_t k=first; k<last; k++) {
+    size_t i = k / cols, j = k % cols;
+    size_t index = row_major ? (j + cols*i) : (i + rows*j);
+
+    Code *code = codes[(offset+k) % codes.size()];
+    Assembler assembler(code, index_table);
+    generator.generate(i,j).accept(assembler);
+    (*code) << Instruction(Instruction::STORE, index);
+  }
+}
+
+
+void
+ForkCompiler::compile(ExpressionGenerator &generator,
+                      std::map<GiNaC::symbol, size_t, GiNaC::ex_is_less> &index_table,
+                      std::vector<Code *> &codes, size_t offset, bool row_major,
+                      size_t num_processes)
+{
+  size_t N = generator.rows()*generator.cols();
+
+#ifndef WIN32
+  // Only fork if there is enough work for all workers:
+  num_processes = std::min(num_processes, N);
+  if (1 >= num_processes) {
+    compileSlice(generator, index_table, codes, offset, row_major, 0, N);
+    return;
+  }
+
+  Utils::Message message = LOG_MESSAGE(Utils::Message::DEBUG);
+  message << "Compile " << N << " expressions using " << num_processes << " worker processes.";
+  Utils::Logger::get().log(message);
+
+  std::vector<pid_t> workers;
+  std::vector<int>   pipes;
+  for (size_t w=0; w<num_processes; w++)
+  {
+    size_t first = (w*N)/num_processes, last = ((w+1)*N)/num_processes;
+
+    int fds[2];
+    pid_t pid = -1;
+    if (0 == ::pipe(fds)) {
+      pid = ::fork();
+      if (0 > pid) { ::close(fds[0]); ::close(fds[1]); }
+    }
+
+    if (0 > pid) {
+      // Kill all workers started so far:
+      for (size_t i=0; i<workers.size(); i++) {
+        ::kill(workers[i], SIGKILL); ::close(pipes[i]); ::waitpid(workers[i], 0, 0);
+      }
+      RuntimeError err;
+      err << "Can not start worker process for compilation: " << strerror(errno);
+      throw err;
+    }
+
+    if (0 == pid) {
+      // Worker process: The child of a multi-threaded process only holds a copy of the calling
+      // thread. Hence it must neither use the logger, Qt nor stdio and must not return into the
+      // caller. Any exception is caught and reported to the parent, the child always leaves
+      // by _exit(). See the class documentation for the remaining requirements.
+      // Close read-ends of all pipes
+      ::close(fds[0]);
+      for (size_t i=0; i<pipes.size(); i++) { ::close(pipes[i]); }
+
+      // Compile slice into local codes, with the same distribution as the parent
+      std::vector<Code> local(codes.size());
+      std::vector<Code *> local_ptrs(codes.size());
+      for (size_t i=0; i<codes.size(); i++) { local_ptrs[i] = &local[i]; }
+
+      // The first byte of the message is a status byte, followed by the serialized codes or an
+      // error message.
+      std::ostringstream buffer;
+      try {
+        compileSlice(generator, index_table, local_ptrs, offset, row_major, first, last);
+        buffer.put(0);
+        for (size_t i=0; i<local.size(); i++) { local[i].serialize(buffer); }
+      } catch (std::exception &e) {
+        buffer.str(""); buffer.put(1); buffer << e.what();
+      } catch (...) {
+        buffer.str(""); buffer.put(1); buffer << "Unknown error in worker process.";
+      }
+
+      bool success = __write_all(fds[1], buffer.str());
+      ::close(fds[1]);
+      // Do not run any destructors or exit-handlers of the parent process:
+      ::_exit(success ? 0 : 1);
+    }
+
+    // Parent process:
+    ::close(fds[1]);
+    workers.push_back(pid);
+    pipes.push_back(fds[0]);
+  }
+
+  // Collect results in order:
+  std::vector<std::string> results(num_processes);
+  bool success = true;
+  for (size_t w=0; w<num_processes; w++) {
+    success = __read_all(pipes[w], results[w]) && success;
+    ::close(pipes[w]);
+    int status = 0;
+    while ((0 > ::waitpid(workers[w], &status, 0)) && (EINTR == errno)) { }
+    success = success && WIFEXITED(status) && (0 == WEXITSTATUS(status)) && (0 < results[w].size());
+  }
+
+  if (! success) {
+    RuntimeError err;
+    err << "Compilation failed: A worker process terminated unexpectedly.";
+    throw err;
+  }
+
+  // Merge codes:
+  for (size_t w=0; w<num_processes; w++) {
+    if (0 != results[w][0]) {
+      RuntimeError err;
+      err << "Compilation failed: " << results[w].substr(1);
+      throw err;
+    }
+
+    std::istringstream buffer(results[w].substr(1));
+    for (size_t i=0; i<codes.size(); i++) {
+      Code code; code.deserialize(buffer);
+      (*codes[i]) << code;
+    }
+  }
+#else
+  // No fork() on this platform, compile sequentially:
+  compileSlice(generator, index_table, codes, offset, row_major, 0, N);
+#endif
+}
@@ -0,0 +1,79 @@
+#ifndef __INA_EVAL_BCI_FORKCOMPILER_HH__
+#define __INA_EVAL_BCI_FORKCOMPILER_HH__
+
+#include <map>
+#include <vector>
+#include <ginac/ginac.h>
+#include "code.hh"
+#include "../compilercommon.hh"
+
+
+namespace iNA {
+namespace Eval {
+namespace bci {
+
+
+/**
+ * Generates and assembles expressions into byte-code using several worker processes.
+ *
+ * GiNaC is not thread-safe, hence the generation (i.e. differentiation) and compilation of large
+ * systems can not be parallelized using threads. Instead, this class forks the given number of
+ * worker processes, each generating and assembling a contiguous slice of the expressions. The
+ * byte-code of each slice is send back to the parent process in its serialized form (see
+ * @c Code::serialize) and appended to the code in order. Hence the result is identical to the
+ * sequential compilation.
+ *
+ * On platforms without @c fork() or if only one process is requested, all expressions are
+ * compiled sequentially.
+ *
+ * @note The compilation is usually started from the worker thread of a task, hence the process is
+ * forked while other threads are running. POSIX only allows async-signal-safe functions in the
+ * child of a multi-threaded process until it calls @c exec or @c _exit, but the workers need to
+ * allocate memory and use GiNaC. This is safe under the following conditions, which the caller
+ * must ensure:
+ * @li No other thread uses GiNaC during the compilation. As GiNaC is not thread-safe, this is
+ *     already required for the sequential compilation.
+ * @li The C library re-initializes the locks of @c malloc in the child (i.e. glibc and the BSD
+ *     libc do so by their internal @c atfork handlers). On other platforms, the compilation must be
+ *     performed with a single process or from a single-threaded process.
+ * The worker never touches the logger, Qt or stdio, sends its result using @c write and
+ * terminates by @c _exit, also if the compilation throws.
+ *
+ * @ingroup bci
+ */
+class ForkCompiler
+{
+public:
+  /**
+   * Generates and assembles all expressions of the given generator.
+   *
+   * The expressions are processed row-by-row, the k-th expression is appended to the code
+   * <tt>codes[(offset+k) % codes.size()]</tt> followed by a @c STORE instruction.
+   *
+   * @param generator Specifies the expressions to compile.
+   * @param index_table Specifies the mapping of symbols to indices of the input vector.
+   * @param codes Specifies the codes to append the instructions to.
+   * @param offset Specifies the index of the code the first expression is appended to.
+   * @param row_major Specifies if the output matrix is stored in row-major order.
+   * @param num_processes Specifies the number of worker processes.
+   * @throws RuntimeError If a worker process fails.
+   */
+  static void compile(ExpressionGenerator &generator,
+                      std::map<GiNaC::symbol, size_t, GiNaC::ex_is_less> &index_table,
+                      std::vector<Code *> &codes, size_t offset, bool row_major,
+                      size_t num_processes);
+
+protected:
+  /** Generates and assembles the k-th to (last-1)-th expressions. */
+  static void compileSlice(ExpressionGenerator &generator,
+                           std::map<GiNaC::symbol, size_t, GiNaC::ex_is_less> &index_table,
+                           std::vector<Code *> &codes, size_t offset, bool row_major,
+                           size_t first, size_t last);
+};
+
+
+}
+}
+}
+
+#endif // __INA_EVAL_BCI_FORKCOMPILER_HH__
@@ -1,5 +1,8 @@
 #include "code.hh"
+#include <stdint.h>
 #include "utils/logger.hh"
+#include "exception.hh"
+using namespace iNA;
 using namespace iNA::Eval;
 using namespace iNA::Eval::bcimp;
 
@@ -26,3 +29,46 @@ Code::getCode(size_t i)
 {
   return this->codes[i];
 }
+
+
+
+void
+Code::serialize(std::ostream &stream) const
+{
+  // Number of blocks as 32bit little-endian integer followed by the blocks:
+  uint32_t num_codes = this->codes.size();
+  for (size_t i=0; i<4; i++) {
+    stream.put(char((num_codes >> (8*i)) & 0xff));
+  }
+  for (size_t i=0; i<this->codes.size(); i++) {
+    this->codes[i].serialize(stream);
+  }
+}
+
+
+void
+Code::deserialize(std::istream &stream)
+{
+  uint32_t num_codes = 0;
+  for (size_t i=0; i<4; i++) {
+    int c = stream.get();
+    if (std::istream::traits_type::eof() == c) {
+      RuntimeError err;
+      err << "Can not read byte-code: Unexpected end of stream.";
+      throw err;
+    }
+    num_codes |= (uint32_t(c) & 0xff) << (8*i);
+  }
+
+  if (0 == num_codes) {
+    RuntimeError err;
+    err << "Can not read byte-code: Invalid number of threads.";
+    throw err;
+  }
+
+  std::vector<bci::Code> new_codes(num_codes);
+  for (size_t i=0; i<num_codes; i++) {
+    new_codes[i].deserialize(stream);
+  }
+  this->codes.swap(new_codes);
+}
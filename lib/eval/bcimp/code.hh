@@ -40,6 +40,19 @@ public:
    * Returns the code for the i-th thread.
    */
   bci::Code &getCode(size_t i);
+
+  /**
+   * Serializes the byte-codes of all threads into the given stream (see
+   * @c bci::Code::serialize).
+   */
+  void serialize(std::ostream &stream) const;
+
+  /**
+   * Replaces the byte-codes by the ones read from the given stream. The number of threads is
+   * taken from the stream.
+   * @throws RuntimeError If the stream does not contain valid byte-code.
+   */
+  void deserialize(std::istream &stream);
 };
 
 
@@ -81,6 +81,23 @@ public:
     this->code_idx = (this->code_idx + 1) % this->code->getNumThreads();
   }
 
+  /**
+   * Generates and compiles the expressions of the given generator, possibly using several
+   * worker processes (see @c bci::ForkCompiler). The expressions are distributed over all
+   * threads in the same way as by @c compileExpressionAndStore.
+   */
+  void compileGenerated(ExpressionGenerator &generator, size_t num_processes=1)
+  {
+    std::vector<bci::Code *> codes(this->code->getNumThreads());
+    for (size_t i=0; i<codes.size(); i++) {
+      codes[i] = &this->code->getCode(i);
+    }
+
+    bci::ForkCompiler::compile(generator, this->compiler.getIndexTable(), codes, this->code_idx,
+                               OutType::Flags & Eigen::RowMajorBit, num_processes);
+    this->code_idx = (this->code_idx + generator.rows()*generator.cols()) % codes.size();
+  }
+
   /**
    * Finalizes (check & optimizes) all byte-code.
    */
@@ -1 +1,38 @@
 #include "compilercommon.hh"
+
+using namespace iNA;
+using namespace iNA::Eval;
+
+
+/* ********************************************************************************************* *
+ * Implementation of ExpressionGenerator:
+ * ********************************************************************************************* */
+ExpressionGenerator::~ExpressionGenerator()
+{
+  // Pass...
+}
+
+
+/* ********************************************************************************************* *
+ * Implementation of MatrixExpressionGenerator:
+ * ********************************************************************************************* */
+MatrixExpressionGenerator::MatrixExpressionGenerator(const Eigen::MatrixXex &matrix)
+  : _matrix(matrix)
+{
+  // Pass...
+}
+
+size_t
+MatrixExpressionGenerator::rows() const {
+  return _matrix.rows();
+}
+
+size_t
+MatrixExpressionGenerator::cols() const {
+  return _matrix.cols();
+}
+
+GiNaC::ex
+MatrixExpressionGenerator::generate(size_t i, size_t j) {
+  return _matrix(i,j);
+}
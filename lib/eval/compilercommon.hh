@@ -8,6 +8,50 @@
 namespace iNA {
 namespace Eval {
 
+/**
+ * Interface of a matrix of GiNaC expressions that are generated on demand, i.e. the elements of
+ * a Jacobian that are differentiated only when they get compiled. This allows to distribute the
+ * generation of the expressions together with their compilation over several worker processes
+ * (see @c CompilerCommon::compileGenerated).
+ *
+ * @ingroup eval
+ */
+class ExpressionGenerator
+{
+public:
+  /** Destructor. */
+  virtual ~ExpressionGenerator();
+
+  /** Returns the number of rows. */
+  virtual size_t rows() const = 0;
+  /** Returns the number of columns. */
+  virtual size_t cols() const = 0;
+  /** Generates the expression (i,j). */
+  virtual GiNaC::ex generate(size_t i, size_t j) = 0;
+};
+
+
+/**
+ * Implements the @c ExpressionGenerator interface for a given matrix or vector of expressions.
+ *
+ * @ingroup eval
+ */
+class MatrixExpressionGenerator : public ExpressionGenerator
+{
+protected:
+  /** Holds the matrix (GiNaC expressions are reference counted, hence copying is cheap). */
+  Eigen::MatrixXex _matrix;
+
+public:
+  /** Constructor. */
+  MatrixExpressionGenerator(const Eigen::MatrixXex &matrix);
+
+  virtual size_t rows() const;
+  virtual size_t cols() const;
+  virtual GiNaC::ex generate(size_t i, size_t j);
+};
+
+
 /**
  * This class implements the compilation method for vectors and matrices of GiNaC expressions.
  *
@@ -52,6 +96,31 @@ public:
       }
     }
   }
+
+  /** Returns the index in the output vector of the element (i,j) of a matrix of the given
+   * shape. */
+  static size_t outputIndex(size_t i, size_t j, size_t rows, size_t cols) {
+    if (OutType::Flags & Eigen::RowMajorBit) {
+      return j + cols*i;
+    }
+    return i + rows*j;
+  }
+
+  /** Compiles all expressions generated by the given generator, that will evaluate to an
+   * @c Eigen::MatrixXd of the same shape. The expressions are compiled in the same order as
+   * by @c compileMatrix.
+   *
+   * By default, the expressions are generated and compiled sequentially. Compilers that can
+   * serialize their code (i.e. the byte-code compilers) may distribute this task over
+   * @c num_processes worker processes. */
+  virtual void compileGenerated(ExpressionGenerator &generator, size_t num_processes=1) {
+    for (size_t i=0; i<generator.rows(); i++) {
+      for (size_t j=0; j<generator.cols(); j++) {
+        this->compileExpressionAndStore(
+              generator.generate(i,j), outputIndex(i, j, generator.rows(), generator.cols()));
+      }
+    }
+  }
 };
 
 
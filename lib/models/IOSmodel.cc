@@ -4,6 +4,76 @@
 using namespace iNA;
 using namespace iNA::Models;
 
+
+/**
+ * Holds the species (j,k,l) of a term of the 3rd-order sums over @c PhilippianM.
+ */
+struct ThirdOrderIndex
+{
+    size_t j, k, l;
+};
+
+/**
+ * Replays the order in which the 3rd-order sums of the IOS update visit the columns of
+ * @c PhilippianM: all (j,k,l) with k<j and l<=k, followed by (j,j,j).
+ */
+static void
+makeThirdOrderIndex(size_t N, std::vector<ThirdOrderIndex> &index)
+{
+    index.clear();
+    ThirdOrderIndex t;
+    for(t.j=0; t.j<N; t.j++)
+    {
+        for(t.k=0; t.k<t.j; t.k++)
+            for(t.l=0; t.l<=t.k; t.l++)
+                index.push_back(t);
+        t.k = t.l = t.j;
+        index.push_back(t);
+    }
+}
+
+/**
+ * Sums the 4-th moments (using Wick's theorem) weighted by the given row of the Hessian.
+ */
+static GiNaC::ex
+hessianWick(const SparseMatrixEx::Row &row, size_t a, size_t b, const Eigen::MatrixXex &cov)
+{
+    GiNaC::ex result = 0;
+    for(SparseMatrixEx::Row::const_iterator item=row.begin(); item!=row.end(); item++)
+    {
+        size_t r, s; SSEBaseModel::decodeHessianIndex(item->first, r, s);
+        GiNaC::ex wick = (cov(s,r)*cov(a,b)+cov(s,a)*cov(r,b)+cov(s,b)*cov(r,a));
+        if(s==r)
+            result += item->second*wick/2;
+        else
+            // fac 2 by symmetry, saves summing over symmetric indices of Hessian
+            result += item->second*wick;
+    }
+    return result;
+}
+
+/**
+ * Adds the 4-th moments (using Wick's theorem) weighted by the given row of @c PhilippianM to the
+ * update of the covariance @c idx. Terms of distinct (k,l,m) are added to the update @c target
+ * as in the original dense assembly.
+ */
+static void
+philippianWick(const SparseMatrixEx::Row &row, const std::vector<ThirdOrderIndex> &index,
+               size_t a, size_t target, size_t idx, const Eigen::MatrixXex &cov,
+               Eigen::VectorXex &update)
+{
+    for(SparseMatrixEx::Row::const_iterator item=row.begin(); item!=row.end(); item++)
+    {
+        if (item->first >= index.size()) continue;
+        size_t k = index[item->first].j, l = index[item->first].k, m = index[item->first].l;
+        GiNaC::ex wick = (cov(k,l)*cov(m,a)+cov(k,m)*cov(l,a)+cov(k,a)*cov(l,m));
+        if (m<l)      update(target) += item->second*wick;
+        else if (l<k) update(idx) += item->second*wick/2;
+        else          update(idx) += item->second*wick/6;
+    }
+}
+
+
 IOSmodel::IOSmodel(const Ast::Model &model)
   : LNAmodel(model)
 {
@@ -14,8 +84,6 @@ void
 IOSmodel::postConstructor()
 {
 
-    GiNaC::ex temp;
-
     dim3M = (this->numIndSpecies()*(this->numIndSpecies()+1)*(this->numIndSpecies()+2))/6;
 
     size_t dimold = dim;
@@ -95,7 +163,6 @@ IOSmodel::postConstructor()
     Eigen::VectorXex ThirdMomentUpdate(dim3M);
 
     idx=0;
-    size_t idy;
     for(size_t i=0;i<this->numIndSpecies();i++)
         for(size_t j=0;j<=i;j++)
         {
@@ -107,7 +174,6 @@ IOSmodel::postConstructor()
 
                 ThirdMomentUpdate(idx)+=this->DiffusionMatrix(j,k)*emreVariables(i)+this->DiffusionMatrix(i,k)*emreVariables(j)+this->DiffusionMatrix(i,j)*emreVariables(k);
 
-                idy = 0;
                 for(size_t r=0; r<this->numIndSpecies(); r++)
                 {
 
@@ -116,34 +182,16 @@ IOSmodel::postConstructor()
                     ThirdMomentUpdate(idx) += this->JacobianM(i,r)*thirdmomentVariables[r](j,k);
                     ThirdMomentUpdate(idx) += this->JacobianM(j,r)*thirdmomentVariables[r](i,k);
                     ThirdMomentUpdate(idx) += this->JacobianM(k,r)*thirdmomentVariables[r](i,j);
-
-                    for (size_t s=0; s<=r; s++)
-                    {
-                        // use Wick's theorem to calculate 4-th moment
-                        GiNaC::ex wick1 = (cov(s,r)*cov(j,k)+cov(s,j)*cov(r,k)+cov(s,k)*cov(r,j));
-                        // i -> j
-                        GiNaC::ex wick2 = (cov(s,r)*cov(i,k)+cov(s,i)*cov(r,k)+cov(s,k)*cov(r,i));
-                        // j -> k
-                        GiNaC::ex wick3 = (cov(s,r)*cov(i,j)+cov(s,i)*cov(r,j)+cov(s,j)*cov(r,i));
-
-                        if(s==r)
-                        {
-                            ThirdMomentUpdate(idx)+=this->Hessian(i,idy)*wick1/2;
-                            ThirdMomentUpdate(idx)+=this->Hessian(j,idy)*wick2/2;
-                            ThirdMomentUpdate(idx)+=this->Hessian(k,idy)*wick3/2;
-                        }
-                        else
-                        {
-                            // fac 2 by symmetry, saves summing over symmetric indices of Hessian
-                            ThirdMomentUpdate(idx)+=this->Hessian(i,idy)*wick1;
-                            ThirdMomentUpdate(idx)+=this->Hessian(j,idy)*wick2;
-                            ThirdMomentUpdate(idx)+=this->Hessian(k,idy)*wick3;
-                        }
-
-                        idy++; // counts the r,s loop
-                    } //end s loop
                 } // end r loop
 
+                // use Wick's theorem to calculate 4-th moment,
+                // only structurally non-zero entries of the Hessian contribute
+                ThirdMomentUpdate(idx) += hessianWick(this->Hessian.row(i), j, k, cov);
+                // i -> j
+                ThirdMomentUpdate(idx) += hessianWick(this->Hessian.row(j), i, k, cov);
+                // j -> k
+                ThirdMomentUpdate(idx) += hessianWick(this->Hessian.row(k), i, j, cov);
+
                 idx++; // counts i,j,k
             } // end k loop
             } // end i,j loop
@@ -152,15 +200,16 @@ IOSmodel::postConstructor()
     // calculate update for LNA correction
     ///////////////////////////////////////
 
+    // decode the running index of the 3rd-order terms of the loops below
+    std::vector<ThirdOrderIndex> thirdIndex;
+    makeThirdOrderIndex(this->numIndSpecies(), thirdIndex);
+
     Eigen::VectorXex iosUpdate(dimCOV);
 
     Eigen::MatrixXex iosCov;
     constructSymmetricMatrix(iosVariables,iosCov);
 
     idx=0;
-    idy=0;
-
-    GiNaC::ex wick1,wick2;
 
     for(size_t i=0;i<this->numIndSpecies();i++)
     for(size_t j=0;j<=i;j++)
@@ -169,9 +218,6 @@ IOSmodel::postConstructor()
 
         iosUpdate(idx)+=this->REcorrections(i)*emreVariables(j)+this->REcorrections(j)*emreVariables(i);
 
-        idy=0;
-        int idz=0;
-
         for(size_t k=0; k<this->numIndSpecies(); k++)
         {
 
@@ -180,43 +226,35 @@ IOSmodel::postConstructor()
             iosUpdate(idx) += diffjac[k](i,j)*emreVariables(k);//this->DiffusionJacM(idx,k)*emreVariables(k);
             iosUpdate(idx) += this->JacobianM(i,k)*iosCov(k,j)+this->JacobianM(j,k)*iosCov(k,i);
 
-            for(size_t l=0; l<k; l++)
-            {
-                iosUpdate(idx) += this->Hessian(i,idy)*thirdmomentVariables[j](k,l)+this->Hessian(j,idy)*thirdmomentVariables[i](k,l);
-                iosUpdate(idx) += this->DiffusionHessianM(idx,idy)*cov(k,l);
-                idy++; //counts l,k loop
-
-                temp=0;
-                for(size_t m=0; m<l; m++)
-                {
-
-                    // use Wick's theorem to calculate 4-th moment + (i <-> j)
-                    wick1 = (cov(k,l)*cov(m,j)+cov(k,m)*cov(l,j)+cov(k,j)*cov(l,m));
-                    wick2 = (cov(k,l)*cov(m,i)+cov(k,m)*cov(l,i)+cov(k,i)*cov(l,m));
-                    iosUpdate(i) += (this->PhilippianM(i,idz)*wick1+this->PhilippianM(j,idz)*wick2);
-                    idz++;
-                }
-                // m=l
-                wick1 = (2*cov(k,l)*cov(l,j)+cov(k,j)*cov(l,l));
-                wick2 = (2*cov(k,l)*cov(l,i)+cov(k,i)*cov(l,l));
-                iosUpdate(idx) += (this->PhilippianM(i,idz)*wick1+this->PhilippianM(j,idz)*wick2)/2;
-
-                idz++;
-
-            } // end l
-
-            wick1 = 3*cov(k,k)*cov(k,j);
-            wick2 = 3*cov(k,k)*cov(k,i);
-            iosUpdate(idx) += (this->PhilippianM(i,idz)*wick1+this->PhilippianM(j,idz)*wick2)/6;
-            idz++;
-
-            // same for l=k appears only once in sum
-            iosUpdate(idx) += (this->Hessian(i,idy)*thirdmomentVariables[j](k,k)/2+this->Hessian(j,idy)*thirdmomentVariables[i](k,k)/2);
-            iosUpdate(idx) += this->DiffusionHessianM(idx,idy)*cov(k,k)/2;
-            idy++;
+        }
 
+        // Hessian and 4-tensor terms, only structurally non-zero entries
+        const SparseMatrixEx::Row &rowI = this->Hessian.row(i);
+        for(SparseMatrixEx::Row::const_iterator item=rowI.begin(); item!=rowI.end(); item++)
+        {
+            size_t k, l; decodeHessianIndex(item->first, k, l);
+            if (l<k) iosUpdate(idx) += item->second*thirdmomentVariables[j](k,l);
+            else     iosUpdate(idx) += item->second*thirdmomentVariables[j](k,k)/2;
+        }
+        const SparseMatrixEx::Row &rowJ = this->Hessian.row(j);
+        for(SparseMatrixEx::Row::const_iterator item=rowJ.begin(); item!=rowJ.end(); item++)
+        {
+            size_t k, l; decodeHessianIndex(item->first, k, l);
+            if (l<k) iosUpdate(idx) += item->second*thirdmomentVariables[i](k,l);
+            else     iosUpdate(idx) += item->second*thirdmomentVariables[i](k,k)/2;
+        }
+        const SparseMatrixEx::Row &rowD = this->DiffusionHessianM.row(idx);
+        for(SparseMatrixEx::Row::const_iterator item=rowD.begin(); item!=rowD.end(); item++)
+        {
+            size_t k, l; decodeHessianIndex(item->first, k, l);
+            if (l<k) iosUpdate(idx) += item->second*cov(k,l);
+            else     iosUpdate(idx) += item->second*cov(k,k)/2;
         }
 
+        // use Wick's theorem to calculate 4-th moment + (i <-> j)
+        philippianWick(this->PhilippianM.row(i), thirdIndex, j, i, idx, cov, iosUpdate);
+        philippianWick(this->PhilippianM.row(j), thirdIndex, i, i, idx, cov, iosUpdate);
+
         idx++; // counts i,j loop
      }
 
@@ -229,38 +267,30 @@ IOSmodel::postConstructor()
     for (size_t i=0; i<this->numIndSpecies(); i++)
     {
       Delta(i)=0.;
-      idx=0;
-      idy=0;
-      for (size_t j=0; j<this->numIndSpecies(); j++)
-      {
-        for (size_t k=0; k<j; k++)
-        {
-            // factor 2 is used to sum over strictly upper cov matrix
-            Delta(i) += this->Hessian(i,idx)*iosVariables(idx);
-            idx++; // counts j,k loop
-
-            temp = 0;
-            for (size_t l=0; l<k; l++)
-            {
-                Delta(i) += this->PhilippianM(i,idy)*thirdmomentVariables[j](k,l);
-                idy++;
-            }
-            // k=l
-            Delta(i) += this->PhilippianM(i,idy)*thirdmomentVariables[j](k,k)/2;
-            idy++;
-        }
 
-        Delta(i) += this->PhilippianM(i,idy)*thirdmomentVariables[j](j,j)/6;
-
-        idy++;
-
-        Delta(i) += this->Hessian(i,idx)*iosVariables(idx)/2.;
-        idx++;
+      for (size_t j=0; j<this->numIndSpecies(); j++)
         Delta(i) += this->JacobianMO1(i,j)*emreVariables(j);
 
+      // only structurally non-zero entries of the Hessian ...
+      const SparseMatrixEx::Row &row = this->Hessian.row(i);
+      for (SparseMatrixEx::Row::const_iterator item=row.begin(); item!=row.end(); item++)
+      {
+        size_t j, k; decodeHessianIndex(item->first, j, k);
+        // factor 2 is used to sum over strictly upper cov matrix
+        if (k<j) Delta(i) += item->second*iosVariables(item->first);
+        else     Delta(i) += item->second*iosVariables(item->first)/2.;
       }
 
-
+      // ... and the 3rd derivatives contribute
+      const SparseMatrixEx::Row &third = this->PhilippianM.row(i);
+      for (SparseMatrixEx::Row::const_iterator item=third.begin(); item!=third.end(); item++)
+      {
+        if (item->first >= thirdIndex.size()) continue;
+        const ThirdOrderIndex &t = thirdIndex[item->first];
+        if (t.l<t.k)      Delta(i) += item->second*thirdmomentVariables[t.j](t.k,t.l);
+        else if (t.k<t.j) Delta(i) += item->second*thirdmomentVariables[t.j](t.k,t.k)/2;
+        else              Delta(i) += item->second*thirdmomentVariables[t.j](t.j,t.j)/6;
+      }
     }
 
     Eigen::VectorXex EMREiosUpdate = ((this->JacobianM*iosemreVariables)+Delta);
@@ -557,7 +587,7 @@ IOSmodel::fluxAnalysis(const Eigen::VectorXd &state, Eigen::VectorXd &flux, Eige
        }
 
     Eigen::MatrixXd rateJac(this->rates_gradient.rows(),this->rates_gradient.cols());
-    Eigen::MatrixXd rateHessian(this->numReactions(),this->dimCOV);
+    Eigen::MatrixXd rateHessian = Eigen::MatrixXd::Zero(this->numReactions(),this->dimCOV);
     Eigen::MatrixXd rate1Jac(this->rates_gradient.rows(),this->rates_gradient.cols());
 
     this->foldConservationConstants(rates_gradient);
@@ -570,9 +600,11 @@ IOSmodel::fluxAnalysis(const Eigen::VectorXd &state, Eigen::VectorXd &flux, Eige
           rate1Jac(i,j)=GiNaC::ex_to<GiNaC::numeric>(constants.apply(rates_gradientO1(i,j)).subs(subtab)).to_double();
           rateJac(i,j)=GiNaC::ex_to<GiNaC::numeric>(constants.apply(rates_gradient(i,j)).subs(subtab)).to_double();
       }
-      for(int j=0;j<this->rates_hessian.cols();j++)
+      // only evaluate non-zero entries
+      const SparseMatrixEx::Row &row = this->rates_hessian.row(i);
+      for(SparseMatrixEx::Row::const_iterator item=row.begin(); item!=row.end(); item++)
       {
-          rateHessian(i,j)=GiNaC::ex_to<GiNaC::numeric>(constants.apply(rates_hessian(i,j)).subs(subtab)).to_double();
+          rateHessian(i,item->first)=GiNaC::ex_to<GiNaC::numeric>(constants.apply(item->second).subs(subtab)).to_double();
       }
     }
 
@@ -74,18 +74,16 @@ LNAmodel::postConstructor()
     for (size_t i=0; i<this->numIndSpecies(); i++)
     {
       Delta(i)=0.;
-      idx=0;
-      for (size_t j=0; j<this->numIndSpecies(); j++)
+      // only visit structurally non-zero entries of the Hessian
+      const SparseMatrixEx::Row &row = this->Hessian.row(i);
+      for (SparseMatrixEx::Row::const_iterator item=row.begin(); item!=row.end(); item++)
       {
-        for (size_t k=0; k<j; k++)
-        {
+        size_t j, k; decodeHessianIndex(item->first, j, k);
+        if (k<j)
             // fac 2 by symmetry, saves summing over strictly upper cov matrix
-            Delta(i) += this->Hessian(i,idx)*cov(j,k);
-            idx++; // counts k,j loop
-        }
-        // j==k
-        Delta(i) += this->Hessian(i,idx)*cov(j,j)/2.;
-        idx++;
+            Delta(i) += item->second*cov(j,k);
+        else
+            Delta(i) += item->second*cov(j,j)/2.;
       }
       // now add rate corrections
       Delta(i)+=this->REcorrections(i);
@@ -260,15 +258,17 @@ LNAmodel::fluxAnalysis(const Eigen::VectorXd &state, Eigen::VectorXd &flux,
        }
 
     Eigen::MatrixXd rateJac(this->rates_gradient.rows(),this->rates_gradient.cols());
-    Eigen::MatrixXd rateHessian(this->numReactions(),this->dimCOV);
+    Eigen::MatrixXd rateHessian = Eigen::MatrixXd::Zero(this->numReactions(),this->dimCOV);
 
     this->foldConservationConstants(rates_gradient);
     for(int i=0;i<this->rates_gradient.rows();i++)
     {
       for(int j=0;j<this->rates_gradient.cols();j++)
           rateJac(i,j)=GiNaC::ex_to<GiNaC::numeric>(constants.apply(rates_gradient(i,j)).subs(subtab)).to_double();
-      for(int j=0;j<this->rates_hessian.cols();j++)
-          rateHessian(i,j)=GiNaC::ex_to<GiNaC::numeric>(constants.apply(rates_hessian(i,j)).subs(subtab)).to_double();
+      // only evaluate non-zero entries
+      const SparseMatrixEx::Row &row = this->rates_hessian.row(i);
+      for(SparseMatrixEx::Row::const_iterator item=row.begin(); item!=row.end(); item++)
+          rateHessian(i,item->first)=GiNaC::ex_to<GiNaC::numeric>(constants.apply(item->second).subs(subtab)).to_double();
     }
 
     fluxLNA = rateJac*covLNA*rateJac.transpose();
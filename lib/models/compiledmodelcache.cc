@@ -0,0 +1,201 @@
+#include "compiledmodelcache.hh"
+#include "../parser/sbmlsh/sbmlsh.hh"
+#include "../exception.hh"
+#include "../utils/logger.hh"
+#include <sstream>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include <cstdio>
+#include <stdint.h>
+
+using namespace iNA;
+using namespace iNA::Models;
+
+
+/** Computes the 64bit FNV-1a hash of the given string. */
+static inline uint64_t
+__fnv1a(const std::string &text, uint64_t hash)
+{
+  for (size_t i=0; i<text.size(); i++) {
+    hash ^= uint64_t((unsigned char)text[i]);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+
+CompiledModelCache *CompiledModelCache::_instance = 0;
+
+/* Increase on any change of the code generated for an unchanged model. */
+const unsigned int CompiledModelCache::codeVersion = 1;
+
+
+CompiledModelCache::CompiledModelCache()
+  : _directory(), _maxEntries(16), _entries(), _recent(), _hits(0), _misses(0)
+{
+  // Pass...
+}
+
+
+CompiledModelCache &
+CompiledModelCache::get()
+{
+  if (0 == _instance) {
+    _instance = new CompiledModelCache();
+  }
+  return *_instance;
+}
+
+
+void
+CompiledModelCache::setDirectory(const std::string &path)
+{
+#pragma omp critical (ina_compiled_model_cache)
+  {
+    _directory = path;
+  }
+}
+
+const std::string &
+CompiledModelCache::directory() const
+{
+  return _directory;
+}
+
+
+void
+CompiledModelCache::setMaxEntries(size_t num)
+{
+#pragma omp critical (ina_compiled_model_cache)
+  {
+    _maxEntries = std::max(size_t(1), num);
+    while (_recent.size() > _maxEntries) {
+      _entries.erase(_recent.back()); _recent.pop_back();
+    }
+  }
+}
+
+
+bool
+CompiledModelCache::lookup(const std::string &key, std::string &data)
+{
+  if (0 == key.size()) { return false; }
+
+  bool found = false;
+#pragma omp critical (ina_compiled_model_cache)
+  {
+    std::map<std::string, std::string>::iterator item = _entries.find(key);
+    if (_entries.end() != item) {
+      data = item->second; touch(key); found = true;
+    } else if (0 < _directory.size()) {
+      // Try to load entry from disk:
+      std::ifstream file(filename(key).c_str(), std::ios::in | std::ios::binary);
+      if (file.is_open()) {
+        std::stringstream buffer; buffer << file.rdbuf();
+        if (! file.bad()) {
+          data = buffer.str(); _entries[key] = data; touch(key); found = true;
+        }
+      }
+    }
+    if (found) { _hits++; } else { _misses++; }
+  }
+
+  if (found) {
+    Utils::Message message = LOG_MESSAGE(Utils::Message::DEBUG);
+    message << "Found compiled model " << key << " in cache.";
+    Utils::Logger::get().log(message);
+  }
+
+  return found;
+}
+
+
+void
+CompiledModelCache::store(const std::string &key, const std::string &data)
+{
+  if (0 == key.size()) { return; }
+
+#pragma omp critical (ina_compiled_model_cache)
+  {
+    _entries[key] = data; touch(key);
+
+    if (0 < _directory.size()) {
+      // Write into temporary file first and move it in place once complete:
+      std::string path = filename(key), tmp_path = path + ".tmp";
+      std::ofstream file(tmp_path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+      if (file.is_open()) {
+        file.write(data.data(), data.size()); file.close();
+        if (file.fail() || (0 != std::rename(tmp_path.c_str(), path.c_str()))) {
+          std::remove(tmp_path.c_str());
+        }
+      }
+    }
+  }
+}
+
+
+void
+CompiledModelCache::clear()
+{
+#pragma omp critical (ina_compiled_model_cache)
+  {
+    _entries.clear(); _recent.clear();
+    _hits = 0; _misses = 0;
+  }
+}
+
+
+size_t
+CompiledModelCache::numHits() const
+{
+  return _hits;
+}
+
+size_t
+CompiledModelCache::numMisses() const
+{
+  return _misses;
+}
+
+
+void
+CompiledModelCache::touch(const std::string &key)
+{
+  _recent.remove(key);
+  _recent.push_front(key);
+  while (_recent.size() > _maxEntries) {
+    _entries.erase(_recent.back()); _recent.pop_back();
+  }
+}
+
+
+std::string
+CompiledModelCache::filename(const std::string &key) const
+{
+  return _directory + "/" + key + ".inabc";
+}
+
+
+std::string
+CompiledModelCache::makeKey(Ast::Model &model, const std::string &analysis)
+{
+  // Serialize all values at full precision, models differing in the last digits of a value
+  // must not share a key:
+  std::stringstream buffer; buffer << std::setprecision(17);
+  try {
+    Parser::Sbmlsh::exportModel(model, buffer);
+  } catch (Exception &err) {
+    // Model can not be serialized -> do not cache
+    return "";
+  }
+  buffer << std::endl << analysis << std::endl << "code version " << codeVersion;
+
+  // Combine two independent hashes to make collisions unlikely:
+  std::string text = buffer.str();
+  std::stringstream key;
+  key << std::hex << std::setfill('0')
+      << std::setw(16) << __fnv1a(text, 14695981039346656037ULL)
+      << std::setw(16) << __fnv1a(text, 0x84222325cbf29ce4ULL);
+  return key.str();
+}
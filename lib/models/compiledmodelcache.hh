@@ -0,0 +1,174 @@
+#ifndef __INA_MODELS_COMPILEDMODELCACHE_HH__
+#define __INA_MODELS_COMPILEDMODELCACHE_HH__
+
+#include <map>
+#include <list>
+#include <string>
+#include <iostream>
+#include "../ast/model.hh"
+#include "../eval/bci/code.hh"
+#include "../eval/bcimp/code.hh"
+
+
+namespace iNA {
+namespace Models {
+
+
+/**
+ * A process wide cache of compiled models.
+ *
+ * The cache maps a key, identifying a model and the analysis performed on it (see @c makeKey), to
+ * the serialized byte-code of the compiled system. This allows to skip the folding of constants,
+ * the differentiation and the compilation of the system and its Jacobian, if an analysis is
+ * re-run on an unchanged model. The analysis model itself (i.e. the conservation analysis and the
+ * symbolic system size expansion) is still derived on every run, hence the cache saves the
+ * compilation time only. Entries are held in memory and, if a cache directory is set with
+ * @c setDirectory, are also stored on disk to persist between sessions.
+ *
+ * As the entries on disk survive updates of the library, the key includes the @c codeVersion.
+ *
+ * @ingroup models
+ */
+class CompiledModelCache
+{
+protected:
+  /** Holds the directory of the persistent cache, empty if disabled. */
+  std::string _directory;
+  /** Holds the maximum number of entries held in memory. */
+  size_t _maxEntries;
+  /** Holds the entries in memory. */
+  std::map<std::string, std::string> _entries;
+  /** Holds the keys in the order of their last use, the most recent first. */
+  std::list<std::string> _recent;
+  /** Holds the number of successful lookups. */
+  size_t _hits;
+  /** Holds the number of failed lookups. */
+  size_t _misses;
+
+  /** The global instance. */
+  static CompiledModelCache *_instance;
+
+
+public:
+  /**
+   * The version of the derivation and compilation of the systems. It must be increased whenever
+   * the code generated for an unchanged model changes (e.g. the choice of the independent
+   * species or the layout of the state vector), otherwise stale entries get loaded from disk.
+   */
+  static const unsigned int codeVersion;
+
+
+protected:
+  /** Hidden constructor, use @c get to obtain the global instance. */
+  CompiledModelCache();
+
+
+public:
+  /** Returns the global instance. */
+  static CompiledModelCache &get();
+
+  /** Sets the directory to store entries in. An empty string disables the persistent cache. */
+  void setDirectory(const std::string &path);
+  /** Returns the directory of the persistent cache. */
+  const std::string &directory() const;
+
+  /** Sets the maximum number of entries held in memory. */
+  void setMaxEntries(size_t num);
+
+  /** Searches the cache for the given key.
+   * @returns true and the cached data if the key was found. */
+  bool lookup(const std::string &key, std::string &data);
+  /** Stores (or replaces) the data for the given key. */
+  void store(const std::string &key, const std::string &data);
+  /** Removes all entries held in memory and resets the number of hits and misses. */
+  void clear();
+
+  /** Returns the number of successful lookups. */
+  size_t numHits() const;
+  /** Returns the number of failed lookups. */
+  size_t numMisses() const;
+
+  /**
+   * Computes the key of a model for the given analysis.
+   *
+   * The key is a hash of the SBML-sh representation of the model, the analysis, the given
+   * options (i.e. execution engine, optimization level and number of threads) and the
+   * @c codeVersion. If the model can not be serialized, an empty key is returned, indicating that
+   * the model should not be cached.
+   */
+  static std::string makeKey(Ast::Model &model, const std::string &analysis);
+
+
+protected:
+  /** Marks the key as recently used and removes old entries. */
+  void touch(const std::string &key);
+  /** Returns the filename of the entry for the given key. */
+  std::string filename(const std::string &key) const;
+};
+
+
+/**
+ * Provides additional information to identify a compiled system, that is not part of the
+ * model itself (i.e. options of the analysis). This template may be specialized for systems
+ * like the @c SensitivityModel.
+ *
+ * @ingroup models
+ */
+template <class Sys>
+class CacheTag
+{
+public:
+  /** Returns the additional tag for the given system, empty by default. */
+  static std::string get(Sys &system) { return ""; }
+};
+
+
+/**
+ * Serializes code of execution engines. By default, code is not serializable and will not
+ * be cached. The byte-code engines specialize this class.
+ *
+ * @ingroup models
+ */
+template <class Code>
+class CodeSerializer
+{
+public:
+  /** Returns true if the code can be serialized. */
+  static bool isSerializable() { return false; }
+  /** Serializes the code. */
+  static void serialize(Code &code, std::ostream &stream) { }
+  /** Deserializes the code. */
+  static void deserialize(Code &code, std::istream &stream) { }
+};
+
+/** Serialization of byte-code. */
+template <>
+class CodeSerializer<Eval::bci::Code>
+{
+public:
+  /** Returns true. */
+  static bool isSerializable() { return true; }
+  /** Serializes the code. */
+  static void serialize(Eval::bci::Code &code, std::ostream &stream) { code.serialize(stream); }
+  /** Deserializes the code. */
+  static void deserialize(Eval::bci::Code &code, std::istream &stream) { code.deserialize(stream); }
+};
+
+/** Serialization of parallel byte-code. */
+template <>
+class CodeSerializer<Eval::bcimp::Code>
+{
+public:
+  /** Returns true. */
+  static bool isSerializable() { return true; }
+  /** Serializes the code. */
+  static void serialize(Eval::bcimp::Code &code, std::ostream &stream) { code.serialize(stream); }
+  /** Deserializes the code. */
+  static void deserialize(Eval::bcimp::Code &code, std::istream &stream) { code.deserialize(stream); }
+};
+
+
+}
+}
+
+#endif // __INA_MODELS_COMPILEDMODELCACHE_HH__
@@ -5,6 +5,20 @@
 using namespace iNA;
 using namespace iNA::Models;
 
+
+/**
+ * Scales an entry of a link or conservation matrix by the ratio of two volumes. The result is
+ * only symbolic if the volumes are and differ.
+ */
+static GiNaC::ex
+scaleByVolumes(double value, const GiNaC::ex &numerator, const GiNaC::ex &denominator)
+{
+  if (0 == value) { return 0; }
+  if (numerator.is_equal(denominator)) { return value; }
+  return value*numerator/denominator;
+}
+
+
 ConservationAnalysis::ConservationAnalysis(const Ast::Model &model)
     : BaseModel(model),
       propensityExpansion((BaseModel &)(*this)),
@@ -17,27 +31,32 @@ ConservationAnalysis::ConservationAnalysis(const Ast::Model &model)
 
 {
 
-    // get Omega vectors for dependent and independent species
-    this->Omega_ind = (this->PermutationM.cast<GiNaC::ex>()*this->volumes).head(this->numIndSpecies());
-    this->Omega_dep = (this->PermutationM.cast<GiNaC::ex>()*this->volumes).tail(this->numDepSpecies());
+    // get Omega vectors for all, dependent and independent species in the permutated basis
+    for (size_t i=0; i<this->numSpecies(); i++)
+      Omega(i) = this->volumes(this->PermutationVec(i));
+    this->Omega_ind = Omega.head(this->numIndSpecies());
+    this->Omega_dep = Omega.tail(this->numDepSpecies());
 
     // initalize symbols as placeholders for constants arising from conservation laws
     for(size_t i=0;i<numDepSpecies();i++)
       conservationConstants(i) = GiNaC::symbol("conservation constant");
 
     // construct Link zero matrix for concentrations
-    this->Link0CMatrix = this->Omega_dep.asDiagonal().inverse()*this->link_zero_matrix.cast<GiNaC::ex>()*this->Omega_ind.asDiagonal();
+    for (size_t i=0; i<this->numDepSpecies(); i++)
+      for (size_t j=0; j<this->numIndSpecies(); j++)
+        this->Link0CMatrix(i,j) = scaleByVolumes(this->link_zero_matrix(i,j), Omega_ind(j), Omega_dep(i));
 
     // construct Link matrix for concentrations
-    Omega = this->PermutationM.cast<GiNaC::ex>()*this->volumes;
-    this->LinkCMatrix = Omega.asDiagonal().inverse()*this->link_matrix.cast<GiNaC::ex>()*this->Omega_ind.asDiagonal();
+    for (size_t i=0; i<this->numSpecies(); i++)
+      for (size_t j=0; j<this->numIndSpecies(); j++)
+        this->LinkCMatrix(i,j) = scaleByVolumes(this->link_matrix(i,j), Omega_ind(j), Omega(i));
 
     Eigen::VectorXex spec(this->numSpecies());
     for(size_t j=0; j<this->species.size(); j++)
-        spec(j) = this->species[j];
+        spec(j) = this->species[this->PermutationVec(j)];
 
-    Eigen::VectorXex ind_species = (this->PermutationM.cast<GiNaC::ex>() * spec).head(this->numIndSpecies());
-    Eigen::VectorXex dep_species = (this->PermutationM.cast<GiNaC::ex>() * spec).tail(this->numDepSpecies());
+    Eigen::VectorXex ind_species = spec.head(this->numIndSpecies());
+    Eigen::VectorXex dep_species = spec.tail(this->numDepSpecies());
 
     // reconstruct dependencies due to conservation laws
     // and substititute @c cconstants as constants
@@ -65,21 +84,39 @@ Eigen::MatrixXex
 ConservationAnalysis::getConservationMatrix()
 
 {
-    return this->Omega_dep.asDiagonal().inverse()*(conservation_matrix.cast<GiNaC::ex>())*(this->Omega.asDiagonal())*(this->PermutationM.cast<GiNaC::ex>());
+    Eigen::MatrixXex matrix(this->numDepSpecies(), this->numSpecies());
+    for (size_t i=0; i<this->numDepSpecies(); i++)
+      for (size_t j=0; j<this->numSpecies(); j++)
+        matrix(i,this->PermutationVec(j)) = scaleByVolumes(conservation_matrix(i,j), Omega(j), Omega_dep(i));
+    return matrix;
 }
 
 Eigen::VectorXex
 ConservationAnalysis::getConservedAmounts(const Eigen::VectorXex &InitialAmount)
 
 {
-    return (conservation_matrix.cast<GiNaC::ex>())*(this->PermutationM.cast<GiNaC::ex>())*(InitialAmount);
+    Eigen::VectorXex amounts(this->numDepSpecies());
+    for (size_t i=0; i<this->numDepSpecies(); i++) {
+      amounts(i) = 0;
+      for (size_t j=0; j<this->numSpecies(); j++)
+        if (0 != conservation_matrix(i,j))
+          amounts(i) += conservation_matrix(i,j)*InitialAmount(this->PermutationVec(j));
+    }
+    return amounts;
 }
 
 Eigen::VectorXex
 ConservationAnalysis::getConservedAmounts(const Eigen::VectorXd &InitialAmount)
 
 {
-    return (conservation_matrix.cast<GiNaC::ex>())*(this->Omega.asDiagonal())*(this->PermutationM.cast<GiNaC::ex>())*(InitialAmount.cast<GiNaC::ex>());
+    Eigen::VectorXex amounts(this->numDepSpecies());
+    for (size_t i=0; i<this->numDepSpecies(); i++) {
+      amounts(i) = 0;
+      for (size_t j=0; j<this->numSpecies(); j++)
+        if (0 != conservation_matrix(i,j))
+          amounts(i) += conservation_matrix(i,j)*Omega(j)*InitialAmount(this->PermutationVec(j));
+    }
+    return amounts;
 }
 
 Eigen::VectorXex
@@ -108,7 +145,10 @@ const Eigen::MatrixXex
 ConservationAnalysis::getLinkCMatrix()
 
 {
-    return (this->PermutationM.cast<GiNaC::ex>().transpose())*this->LinkCMatrix;
+    Eigen::MatrixXex matrix(this->numSpecies(), this->numIndSpecies());
+    for (size_t i=0; i<this->numSpecies(); i++)
+      matrix.row(this->PermutationVec(i)) = this->LinkCMatrix.row(i);
+    return matrix;
 }
 
 GiNaC::exmap
@@ -1,54 +1,107 @@
 #include "conservationanalysismixin.hh"
+#include <map>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <stdint.h>
 
 using namespace iNA;
 using namespace iNA::Models;
 
 
-ConservationAnalysisMixin::ConservationAnalysisMixin(BaseModel &base)
-  : ConstantStoichiometryMixin(base)
+/** A sparse row of integer coefficients. */
+typedef std::map<int, int64_t> SparseRow;
+
+/** Coefficients are kept below this bound, hence the products of two fit into 64 bit. */
+static const int64_t COEFFICIENT_LIMIT = int64_t(1) << 30;
+
+static int64_t
+gcd(int64_t a, int64_t b)
 {
+  if (0 > a) { a = -a; }
+  if (0 > b) { b = -b; }
+  while (0 != b) { int64_t t = a%b; a = b; b = t; }
+  return a;
+}
 
-    // Perform conservation analysis obtain reduced stoichiometry in permutated basis
+/** Divides the row by the GCD of its coefficients, returns false if a coefficient is too large. */
+static bool
+normalize(SparseRow &row)
+{
+  int64_t g = 0;
+  for (SparseRow::iterator item=row.begin(); item!=row.end(); item++) {
+    g = gcd(g, item->second);
+  }
+  if (1 < g) {
+    for (SparseRow::iterator item=row.begin(); item!=row.end(); item++) {
+      item->second /= g;
+    }
+  }
+  for (SparseRow::iterator item=row.begin(); item!=row.end(); item++) {
+    if ((COEFFICIENT_LIMIT < item->second) || (-COEFFICIENT_LIMIT > item->second)) { return false; }
+  }
+  return true;
+}
 
-    // number of reactions and species
-    int nreac = this->stoichiometry.cols();
-    int nspec = this->stoichiometry.rows();
+/** Eliminates column @c col of @c row using the pivot row: row = a*row - b*pivot. */
+static bool
+eliminate(SparseRow &row, const SparseRow &pivot, int col)
+{
+  int64_t p = pivot.find(col)->second, r = row[col];
+  int64_t g = gcd(p, r);
+  int64_t a = p/g, b = r/g;
 
-    Eigen::FullPivLU< Eigen::MatrixXd > LU;
+  if (1 != a) {
+    for (SparseRow::iterator item=row.begin(); item!=row.end(); item++) {
+      item->second *= a;
+    }
+  }
+  for (SparseRow::const_iterator item=pivot.begin(); item!=pivot.end(); item++) {
+    SparseRow::iterator entry = row.find(item->first);
+    if (row.end() == entry) {
+      row[item->first] = -b*item->second;
+    } else if (0 == (entry->second -= b*item->second)) {
+      row.erase(entry);
+    }
+  }
 
-    //LU decomposition of full stoichiometry
-    LU.compute(this->stoichiometry.transpose());
+  return normalize(row);
+}
 
-    //get permutation matrix
-    this->PermutationM = LU.permutationQ().transpose();
 
-    //evaluate dim of kernel and image, ie., number of dependent and independent species
 
-    int ndep= LU.dimensionOfKernel();
-    int nind= nspec-ndep;
+ConservationAnalysisMixin::ConservationAnalysisMixin(BaseModel &base)
+  : ConstantStoichiometryMixin(base)
+{
 
-    this->num_dep_species = ndep;
-    this->num_ind_species = nind;
+    // Perform conservation analysis obtain permutation and link zero matrix
 
-    this->PermutationVec = LU.permutationQ().indices();
+    if (! exactConservationAnalysis()) {
+      numericConservationAnalysis();
+    }
 
-    //Permute rows to obtain matrix with independent species first
-    //and extract stoichiometry of independent species
-    this->reduced_stoichiometry = (this->PermutationM * this->stoichiometry).block(0,0,nind,nreac);
+    // number of reactions and species
+    int nreac = this->stoichiometry.cols();
+    int nspec = this->stoichiometry.rows();
+    int nind = this->num_ind_species;
+    int ndep = this->num_dep_species;
 
-    //Compute the conservation matrix Gamma
-    Eigen::MatrixXd ker = LU.kernel();
-    Eigen::MatrixXd temp(ker);
+    //assemble permutation matrix
+    this->PermutationM = Eigen::MatrixXd::Zero(nspec, nspec);
+    for (int i=0; i<nspec; i++) {
+      this->PermutationM(i, this->PermutationVec(i)) = 1;
+    }
 
-    //permute basis of conservation matrix
-    for(int i=0;i<ndep;i++){
-        temp.col(i) = this->PermutationM*ker.col(i);
+    //Permute rows to obtain matrix with independent species first
+    //and extract stoichiometry of independent species
+    this->reduced_stoichiometry.resize(nind, nreac);
+    for (int i=0; i<nind; i++) {
+      this->reduced_stoichiometry.row(i) = this->stoichiometry.row(this->PermutationVec(i));
     }
-    // and transpose
-    this->conservation_matrix = temp.transpose();
 
-    //get L0 matrix from the form of the conservation matrix [-L0,I]
-    this->link_zero_matrix = -this->conservation_matrix.block(0,0,ndep,nind);
+    //get the conservation matrix from the link zero matrix [-L0,I]
+    this->conservation_matrix.resize(ndep, nspec);
+    this->conservation_matrix << -this->link_zero_matrix, Eigen::MatrixXd::Identity(ndep,ndep);
 
     //get Link matrix
     Eigen::MatrixXd L(nspec,nind);
@@ -58,6 +111,117 @@ ConservationAnalysisMixin::ConservationAnalysisMixin(BaseModel &base)
 
 }
 
+
+bool
+ConservationAnalysisMixin::exactConservationAnalysis()
+{
+  int nreac = this->stoichiometry.cols();
+  int nspec = this->stoichiometry.rows();
+
+  // Assemble sparse rows of the transposed stoichiometry, if integral:
+  std::vector<SparseRow> rows(nreac);
+  for (int j=0; j<nspec; j++) {
+    for (int i=0; i<nreac; i++) {
+      double value = this->stoichiometry(j,i);
+      if (0 == value) { continue; }
+      if ((value != std::floor(value)) || (double(COEFFICIENT_LIMIT) < std::abs(value))) {
+        return false;
+      }
+      rows[i][j] = int64_t(value);
+    }
+  }
+  for (int i=0; i<nreac; i++) {
+    normalize(rows[i]);
+  }
+
+  // Gauss-Jordan elimination, the columns are processed in order:
+  std::vector<int> pivot_cols;
+  std::vector<bool> is_pivot(nspec, false);
+  size_t rank = 0;
+  for (int col=0; col<nspec; col++) {
+    // Collect rows with a non-zero in this column and select the sparsest remaining one as pivot:
+    std::vector<int> nonzero; int pivot = -1;
+    for (int i=0; i<nreac; i++) {
+      if (0 == rows[i].count(col)) { continue; }
+      nonzero.push_back(i);
+      if ((i >= int(rank)) && ((0 > pivot) || (rows[i].size() < rows[pivot].size()))) {
+        pivot = i;
+      }
+    }
+    if (0 > pivot) { continue; }
+
+    std::swap(rows[rank], rows[pivot]);
+    for (size_t k=0; k<nonzero.size(); k++) {
+      // Rows were swapped:
+      int i = (nonzero[k] == pivot) ? int(rank) : ((nonzero[k] == int(rank)) ? pivot : nonzero[k]);
+      if (int(rank) == i) { continue; }
+      if (! eliminate(rows[i], rows[rank], col)) { return false; }
+    }
+
+    pivot_cols.push_back(col); is_pivot[col] = true; rank++;
+  }
+
+  // Independent species first:
+  this->num_ind_species = rank;
+  this->num_dep_species = nspec-rank;
+  this->PermutationVec.resize(nspec);
+  std::vector<int> dep_cols;
+  for (size_t i=0; i<rank; i++) { this->PermutationVec(i) = pivot_cols[i]; }
+  for (int col=0, i=rank; col<nspec; col++) {
+    if (! is_pivot[col]) { this->PermutationVec(i++) = col; dep_cols.push_back(col); }
+  }
+
+  // The kernel vector of the dependent species s has x_s=1 and x_j=-R(j,s)/R(j,j) for the
+  // independent species j, hence L0(s,j) = R(j,s)/R(j,j):
+  this->link_zero_matrix = Eigen::MatrixXd::Zero(this->num_dep_species, rank);
+  for (size_t j=0; j<rank; j++) {
+    double d = rows[j][pivot_cols[j]];
+    for (size_t s=0; s<dep_cols.size(); s++) {
+      SparseRow::iterator entry = rows[j].find(dep_cols[s]);
+      if (rows[j].end() != entry) {
+        this->link_zero_matrix(s,j) = entry->second/d;
+      }
+    }
+  }
+
+  return true;
+}
+
+
+void
+ConservationAnalysisMixin::numericConservationAnalysis()
+{
+  int nspec = this->stoichiometry.rows();
+
+  Eigen::FullPivLU< Eigen::MatrixXd > LU;
+
+  //LU decomposition of full stoichiometry
+  LU.compute(this->stoichiometry.transpose());
+
+  //evaluate dim of kernel and image, ie., number of dependent and independent species
+  int ndep= LU.dimensionOfKernel();
+  int nind= nspec-ndep;
+
+  this->num_dep_species = ndep;
+  this->num_ind_species = nind;
+
+  this->PermutationVec = LU.permutationQ().indices();
+
+  this->link_zero_matrix.resize(ndep, nind);
+  if (0 == ndep) { return; }
+
+  //Compute the kernel in the permutated basis, it has the form [-L0,I]^T
+  Eigen::MatrixXd ker = LU.kernel();
+  Eigen::MatrixXd temp(ndep, nspec);
+  for (int i=0; i<nspec; i++) {
+    temp.col(i) = ker.row(this->PermutationVec(i)).transpose();
+  }
+
+  //get L0 matrix
+  this->link_zero_matrix = -temp.block(0,0,ndep,nind);
+}
+
+
 void
 ConservationAnalysisMixin::getReducedStoichiometry(Eigen::MatrixXd &stoichiometry)
 {
@@ -75,4 +239,3 @@ ConservationAnalysisMixin::numDepSpecies()
 {
   return this->num_dep_species;
 }
-
@@ -18,6 +18,13 @@ namespace Models {
  *
  * The method has been described by Vallabhajosyula, Chickarmane and Sauro \cite vallabhajosyula2006.
  *
+ * If the stoichiometry is integral, the decomposition is obtained by an exact, fraction-free
+ * Gauss-Jordan elimination on the sparse rows of \f$ S^T \f$. Hence the rank of \f$ S \f$ and
+ * the link-zero matrix are exact, even for large stoichiometric matrices. Here, the independent
+ * species are chosen in the order of their definition. The elimination falls back to the LU
+ * decomposition with full pivoting for non-integral stoichiometry or if the coefficients grow too
+ * large.
+ *
  * @ingroup models
  */
 
@@ -71,6 +78,21 @@ private:
     */
     size_t num_ind_species;
 
+protected:
+
+    /**
+    * Performs the exact elimination, returns false if the stoichiometry is not integral or if the
+    * coefficients grow too large. On success, the permutation, the number of independent and
+    * dependent species and the link-zero matrix are set.
+    */
+    bool exactConservationAnalysis();
+
+    /**
+    * Obtains the permutation, the number of independent and dependent species and the link-zero
+    * matrix from the LU decomposition of the stoichiometry.
+    */
+    void numericConservationAnalysis();
+
 public:
 
    /**
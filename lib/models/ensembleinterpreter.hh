@@ -0,0 +1,144 @@
+#ifndef __INA_MODELS_ENSEMBLEINTERPRETER_HH__
+#define __INA_MODELS_ENSEMBLEINTERPRETER_HH__
+
+#include <vector>
+#include <map>
+#include <eigen3/Eigen/Eigen>
+#include "initialconditions.hh"
+#include "../eval/bci/bci.hh"
+#include "REmodel.hh"
+
+
+namespace iNA {
+namespace Models {
+
+
+/**
+ * Evaluates the update vector of a model for an ensemble of parameter sets at once.
+ *
+ * The update vector is compiled once, treating all compartments, global and local parameters and
+ * the conservation constants as inputs (like the @c ParameterScan). The values of these inputs are
+ * determined once for each member of the ensemble. The system is then evaluated for all members
+ * with a single call of the @c Eval::bci::BatchInterpreter.
+ *
+ * The states of the ensemble are stored as a matrix with one row per member and one column per
+ * state variable. As Eigen matrices are column-major, the values of a state variable of all
+ * members are stored contiguously (structure-of-arrays) as expected by the
+ * @c Eval::bci::BatchInterpreter. The interpreter implements the system interface of the
+ * @c ODE::EnsembleStepper.
+ *
+ * @ingroup models
+ */
+template <class M>
+class EnsembleInterpreter
+{
+protected:
+  /** Holds a weak reference to the model. */
+  M &model;
+  /** Holds the number of members of the ensemble. */
+  size_t numMembers;
+  /** Holds the dimension of the system. */
+  size_t dimension;
+  /** Maps the symbols of states and parameters to the columns of the input matrix. */
+  std::map<GiNaC::symbol, size_t, GiNaC::ex_is_less> index;
+  /** Holds the compiled update vector. */
+  Eval::bci::Code code;
+  /** The batch interpreter. */
+  Eval::bci::BatchInterpreter interpreter;
+  /** Holds the inputs of all members, the first columns are the states followed by the
+   * parameters. */
+  Eigen::MatrixXd input;
+  /** Holds the initial states of all members. */
+  Eigen::MatrixXd initial;
+
+
+public:
+  /**
+   * Constructor.
+   *
+   * @param model Specifies the model to integrate.
+   * @param parameterSets Specifies the parameter set of each member of the ensemble.
+   * @param opt_level Specifies the byte-code optimization level.
+   */
+  EnsembleInterpreter(M &model, const std::vector<ParameterSet> &parameterSets, size_t opt_level=0)
+    : model(model), numMembers(parameterSets.size()), dimension(model.getUpdateVector().size()),
+      index(model.stateIndex), code(), interpreter(), input(), initial()
+  {
+    size_t nstate = index.size();
+
+    // Fetch compartments
+    for (size_t i=0; i<model.numCompartments(); i++)
+      index.insert(std::make_pair(model.getCompartment(i)->getSymbol(), nstate++));
+
+    // Fetch global parameters
+    for (size_t i=0; i<model.numParameters(); i++)
+      index.insert(std::make_pair(model.getParameter(i)->getSymbol(), nstate++));
+
+    // Fetch local parameters
+    for (size_t i=0; i<model.numReactions(); i++) {
+      Ast::KineticLaw *kin = model.getReaction(i)->getKineticLaw();
+      for (size_t j=0; j<kin->numParameters(); j++)
+        index.insert(std::make_pair(kin->getParameter(j)->getSymbol(), nstate++));
+    }
+
+    // Fetch conservation constants
+    for (int i=0; i<model.getConservationConstants().size(); i++)
+      index.insert(std::make_pair(model.getConservationConstants()(i), nstate++));
+
+    // Compile update vector
+    Eval::bci::Compiler<Eigen::VectorXd> compiler(index);
+    compiler.setCode(&code);
+    compiler.compileVector(model.getUpdateVector());
+    compiler.finalize(opt_level);
+    interpreter.setCode(&code);
+
+    // Determine parameters and initial states of all members:
+    input.resize(numMembers, index.size());
+    initial.resize(numMembers, dimension);
+    Eigen::VectorXd x(dimension);
+    for (size_t k=0; k<numMembers; k++) {
+      Trafo::excludeType ptab = model.makeExclusionTable(parameterSets[k]);
+      Trafo::ConstantFolder constants(model, Trafo::Filter::ALL_CONST, ptab);
+      InitialConditions ICs(model, ptab);
+      ParameterFolder parameters(ptab);
+
+      for (std::map<GiNaC::symbol, size_t, GiNaC::ex_is_less>::const_iterator it=index.begin();
+           it!=index.end(); it++) {
+        if (it->second >= dimension)
+          input(k, it->second) = Eigen::ex2double(ICs.apply(parameters.apply(constants.apply(it->first))));
+      }
+
+      model.getInitial(ICs, x);
+      initial.row(k) = x.transpose();
+    }
+  }
+
+  /** Returns the dimension of the system. */
+  inline size_t getDimension() const { return dimension; }
+
+  /** Returns the number of members of the ensemble. */
+  inline size_t size() const { return numMembers; }
+
+  /** Returns the initial states of all members, one row per member. */
+  inline void getInitialState(Eigen::MatrixXd &states) const { states = initial; }
+
+  /**
+   * Evaluates the system for all members of the ensemble.
+   *
+   * @param states Specifies the states, one row per member.
+   * @param t Specifies the time of each member (unused as the models are autonomous).
+   * @param rates On exit, holds the rates of change, one row per member.
+   */
+  inline void evaluate(const Eigen::MatrixXd &states, const Eigen::VectorXd &t, Eigen::MatrixXd &rates)
+  {
+    input.leftCols(dimension) = states;
+    rates.resize(numMembers, dimension);
+    interpreter.run(input.data(), rates.data(), numMembers);
+  }
+};
+
+
+}
+}
+
+#endif // __INA_MODELS_ENSEMBLEINTERPRETER_HH__
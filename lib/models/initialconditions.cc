@@ -8,7 +8,8 @@ using namespace iNA::Models;
 */
 
 InitialConditions::InitialConditions(SSEBaseModel &model, Trafo::excludeType excludes)
-    : model(model), params(excludes),evICs(model,Trafo::Filter::ALL,excludes)
+    : model(model), excludedParams(excludes), params(excludedParams),
+      evICs(model,Trafo::Filter::ALL,excludes)
 {
 
     // Evaluate initial concentrations and evaluate volumes:
@@ -30,6 +31,12 @@ InitialConditions::InitialConditions(SSEBaseModel &model, Trafo::excludeType exc
     // generate substitution table
     substitutions = model.getConservationConstants(conserved_cycles);
 
+    // compose the chained substitutions of applyAll()
+    conservationFolder.setTable(substitutions);
+    allFolder.setTable(substitutions);
+    allFolder.compose(evICs.getTable());
+    allFolder.compose(params.getSubstitutions());
+
 }
 
 /**
@@ -51,13 +58,13 @@ InitialConditions::getInitialState()
 GiNaC::ex
 InitialConditions::apply(const GiNaC::ex &exIn)
 {
-    return exIn.subs(substitutions);
+    return conservationFolder.apply(exIn);
 }
 
 GiNaC::ex
 InitialConditions::applyAll(const GiNaC::ex &exIn)
 {
-    return params.apply(evICs.apply(exIn.subs(substitutions)));
+    return allFolder.apply(exIn);
 }
 
 
@@ -73,7 +80,7 @@ InitialConditions::apply(const Eigen::MatrixXex &vecIn)
     // ... and fold all constants due to conservation laws
     for (int i=0; i<vecIn.rows(); i++)
     for (int j=0; j<vecIn.cols(); j++)
-            vecOut(i,j)=vecIn(i,j).subs(substitutions);
+            vecOut(i,j)=conservationFolder.apply(vecIn(i,j));
 
     return vecOut;
 
@@ -5,6 +5,7 @@
 #include "ssebasemodel.hh"
 
 #include "../trafo/constantfolder.hh"
+#include "../trafo/substitutioncache.hh"
 
 namespace iNA {
 namespace Models {
@@ -98,10 +99,18 @@ protected:
 
     const SSEBaseModel &model;
 
+    /** Holds the excluded parameters referenced by @c params. */
+    Trafo::excludeType excludedParams;
 
     ParameterFolder params;
     Trafo::InitialValueFolder evICs;
 
+    /** Folds the conservation constants. */
+    Trafo::SubstitutionCache conservationFolder;
+
+    /** Folds conservation constants & initial conditions in a single pass. */
+    Trafo::SubstitutionCache allFolder;
+
 public:
 
     /**
@@ -27,8 +27,12 @@
 #include "IOSmodel.hh"
 
 #include "steadystateanalysis.hh"
+#include "multistartanalysis.hh"
 #include "sseparamscan.hh"
+#include "compiledmodelcache.hh"
 #include "sseinterpreter.hh"
+#include "sensitivityinterpreter.hh"
+#include "ensembleinterpreter.hh"
 
 #include "stochasticsimulator.hh"
 #include "gillespieSSA.hh"
@@ -0,0 +1,223 @@
+#ifndef __INA_MODELS_MULTISTARTANALYSIS_HH
+#define __INA_MODELS_MULTISTARTANALYSIS_HH
+
+#include <vector>
+#include <algorithm>
+#include "steadystateanalysis.hh"
+#include "../mersennetwister.hh"
+#include "../openmp.hh"
+
+namespace iNA {
+namespace Models {
+
+
+/**
+ * Holds a steady state found by the @c MultiStartAnalysis.
+ */
+class SteadyStateRoot
+{
+public:
+  /** Concentrations of the independent species. */
+  Eigen::VectorXd state;
+  /** Eigenvalues of the Jacobian at the steady state. */
+  Eigen::VectorXcd eigenvalues;
+  /** True if all eigenvalues have a negative real part. */
+  bool stable;
+  /** Number of starts that converged to this steady state. */
+  size_t hits;
+
+public:
+  /** Constructor. */
+  SteadyStateRoot(const Eigen::VectorXd &state)
+    : state(state), eigenvalues(), stable(false), hits(1)
+  {
+    // Pass...
+  }
+};
+
+
+/**
+ * Searches for all steady states of a model (i.e. of a multistable network) by starting the
+ * @c NLEsolve::HybridSolver from many initial states.
+ *
+ * The initial states are sampled uniformly within a box around the initial conditions of the
+ * model. As the solver works on the independent species only, the conservation laws are
+ * satisfied by construction. The samples are then moved towards the initial conditions, until the
+ * concentrations of the dependent species, given by the conserved cycles and the link matrix (see
+ * @c InitialConditions), are non-negative. The starts are distributed over several OpenMP threads,
+ * each thread has its own instance of the solver.
+ *
+ * The roots found are deduplicated and their stability is determined from the eigenvalues of the
+ * Jacobian. Please note that the hybrid solver falls back to the integration of the system, hence
+ * unstable steady states are only found if the Newton iteration converges from one of the starts.
+ *
+ * @ingroup models
+ */
+template <class M,
+          class VectorEngine = Eval::bci::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+          class MatrixEngine = Eval::bci::Engine<Eigen::VectorXd, Eigen::MatrixXd>,
+          class Newton = NLEsolve::NewtonRaphson<M, VectorEngine, MatrixEngine> >
+class MultiStartAnalysis
+    : public SteadyStateAnalysis<M, VectorEngine, MatrixEngine, Newton>
+{
+protected:
+  /** Defines the type of the solver. */
+  typedef NLEsolve::HybridSolver<M, VectorEngine, MatrixEngine, Newton> Solver;
+
+  /** Holds the size of the sampling box relative to the initial conditions. */
+  double box_factor;
+
+  /** Holds the relative tolerance, two roots are considered to be equal. */
+  double root_tolerance;
+
+public:
+  /**
+   * Constructor.
+   *
+   * @param model Specifies the model.
+   * @param iter Specifies the maximum number of iterations of the solver.
+   * @param epsilon Specifies the precision of the solver.
+   * @param t_max Specifies the maximum integration time of the solver.
+   * @param dt Specifies the minimum integration time step of the solver.
+   */
+  MultiStartAnalysis(M &model, size_t iter=100, double epsilon=1e-9, double t_max=1e9, double dt=1e-1)
+    : SteadyStateAnalysis<M, VectorEngine, MatrixEngine, Newton>(model, iter, epsilon, t_max, dt),
+      box_factor(2), root_tolerance(1e-6)
+  {
+    // Pass...
+  }
+
+  /** Sets the size of the sampling box, each concentration is sampled within
+   * [0, factor*max(x_0, mean(x_0))]. */
+  void setBoxFactor(double factor) { box_factor = factor; }
+
+  /** Sets the relative tolerance, two roots are considered to be equal. */
+  void setRootTolerance(double tolerance) { root_tolerance = tolerance; }
+
+  /**
+   * Samples @c numStarts initial states and solves for the steady state from each of them.
+   *
+   * @param roots On exit, holds the distinct steady states found, stable ones first.
+   * @param numStarts Specifies the number of initial states.
+   * @param seed Specifies the seed of the random number generator.
+   * @param numThreads Specifies the number of OpenMP threads.
+   */
+  void calcSteadyStates(std::vector<SteadyStateRoot> &roots, size_t numStarts, uint64_t seed=1234,
+                        size_t numThreads=OpenMP::getMaxThreads())
+  {
+    size_t N = this->sseModel.numIndSpecies();
+    roots.clear();
+    numThreads = std::max(size_t(1), std::min(numThreads, numStarts));
+
+    // Sample initial states serially, so the samples do not depend on the number of threads:
+    std::vector<Eigen::VectorXd> starts(numStarts);
+    sampleInitialStates(starts, seed);
+
+    // One solver per thread:
+    std::vector<Solver *> solvers(numThreads);
+    for (size_t i=0; i<numThreads; i++) {
+      solvers[i] = new Solver(this->sseModel);
+      solvers[i]->parameters = this->solver.parameters;
+      solvers[i]->set(this->codeODE, this->codeJac);
+    }
+
+    // Solve from each start:
+    std::vector<int> converged(numStarts, 0);
+#pragma omp parallel for if(numThreads>1) num_threads(numThreads) schedule(dynamic)
+    for (int i=0; i<int(numStarts); i++) {
+      Solver *solver = solvers[OpenMP::getThreadNum()];
+      // No exception must leave the parallel region, a failed start is just not converged. This
+      // includes std::bad_alloc and exceptions not derived from std::exception:
+      try {
+        NLEsolve::Status status = solver->solve(starts[i], this->max_time, this->min_time_step);
+        converged[i] = (NLEsolve::Success == status) && (starts[i].array() >= 0).all() ? 1 : 0;
+      } catch (...) {
+        converged[i] = 0;
+      }
+    }
+
+    for (size_t i=0; i<numThreads; i++) { delete solvers[i]; }
+
+    // Deduplicate roots:
+    for (size_t i=0; i<numStarts; i++) {
+      if (! converged[i]) continue;
+      bool known = false;
+      for (size_t j=0; j<roots.size(); j++) {
+        double scale = 1 + roots[j].state.lpNorm<Eigen::Infinity>();
+        if ((roots[j].state - starts[i]).lpNorm<Eigen::Infinity>() <= root_tolerance*scale) {
+          roots[j].hits++; known = true; break;
+        }
+      }
+      if (! known) roots.push_back(SteadyStateRoot(starts[i]));
+    }
+
+    // Classify stability:
+    typename MatrixEngine::Interpreter interpreter;
+    interpreter.setCode(&this->codeJac);
+    Eigen::MatrixXd jacobian(N, N);
+    for (size_t j=0; j<roots.size(); j++) {
+      interpreter.run(roots[j].state, jacobian);
+      roots[j].eigenvalues = jacobian.eigenvalues();
+      roots[j].stable = (roots[j].eigenvalues.real().array() < 0).all();
+    }
+    std::stable_sort(roots.begin(), roots.end(), isMoreStable);
+
+    Utils::Message message = LOG_MESSAGE(Utils::Message::INFO);
+    message << "Found " << roots.size() << " steady state(s) from " << numStarts << " starts.";
+    Utils::Logger::get().log(message);
+  }
+
+
+protected:
+  /**
+   * Samples the initial states, each satisfying the conservation laws with non-negative
+   * concentrations.
+   */
+  void sampleInitialStates(std::vector<Eigen::VectorXd> &starts, uint64_t seed)
+  {
+    size_t N = this->sseModel.numIndSpecies();
+    InitialConditions ICs(this->sseModel);
+    const Eigen::VectorXd &x0 = ICs.getInitialState();
+    Eigen::VectorXd c, dir;
+    Eigen::MatrixXd L0 = ICs.getLink0CMatrix();
+    if (0 < this->sseModel.numDepSpecies()) { c = ICs.getConservedCycles(); }
+
+    // Scale of the sampling box:
+    double mean = (0 < N) ? x0.array().abs().mean() : 0;
+    if (0 < c.size()) { mean = std::max(mean, c.array().abs().mean()); }
+    if (0 >= mean) { mean = 1; }
+
+    MersenneTwister rng(seed);
+    for (size_t i=0; i<starts.size(); i++) {
+      starts[i].resize(N);
+      for (size_t s=0; s<N; s++) {
+        starts[i](s) = rng.rand()*box_factor*std::max(std::abs(x0(s)), mean);
+      }
+
+      // Move towards x0, until all dependent species are non-negative:
+      if (0 < c.size()) {
+        dir = starts[i] - x0;
+        Eigen::VectorXd dep0 = c + L0*x0, ddep = L0*dir;
+        double lambda = 1;
+        for (int k=0; k<dep0.size(); k++) {
+          if ((0 > ddep(k)) && (dep0(k) + lambda*ddep(k) < 0)) {
+            lambda = std::max(0.0, -dep0(k)/ddep(k));
+          }
+        }
+        starts[i] = x0 + lambda*dir;
+      }
+    }
+  }
+
+  /** Orders stable roots before unstable ones. */
+  static bool isMoreStable(const SteadyStateRoot &a, const SteadyStateRoot &b)
+  {
+    return a.stable && (! b.stable);
+  }
+};
+
+
+}
+}
+
+#endif // __INA_MODELS_MULTISTARTANALYSIS_HH
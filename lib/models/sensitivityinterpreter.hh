@@ -0,0 +1,173 @@
+#ifndef __INA_MODELS_SENSITIVITYINTERPRETER_HH__
+#define __INA_MODELS_SENSITIVITYINTERPRETER_HH__
+
+#include "sensitivitymodel.hh"
+#include "sseinterpreter.hh"
+
+namespace iNA {
+namespace Models {
+
+
+/**
+ * Wraps an instance of a @c SensitivityModel and compiles it.
+ *
+ * In addition to the update vector of the augmented system, this interpreter compiles the
+ * Jacobian of the base model and the coupling blocks of the sensitivity equations separately.
+ * These are used by the @c ODE::StaggeredRosenbrock4 stepper, and to assemble the block
+ * lower-triangular Jacobian of the augmented system without compiling it as a dense matrix.
+ * The Jacobian of the base model takes the place of the Jacobian of the
+ * @c GenericSSEinterpreter, hence it is compiled once and stored in the
+ * @c CompiledModelCache along with the system.
+ *
+ * @ingroup models
+ */
+template <class Sys, class SysEngine, class JacEngine>
+class GenericSensitivityInterpreter
+    : public GenericSSEinterpreter<Sys, SysEngine, JacEngine>
+{
+protected:
+  /** Holds the dimension of the base model. */
+  size_t stateDim;
+
+  /** Holds the number of parameters. */
+  size_t numParams;
+
+  /** Holds the interpreter to evaluate the coupling blocks. */
+  typename JacEngine::Interpreter couplingInterpreter;
+
+  /** The bytecode of the coupling blocks. */
+  typename JacEngine::Code couplingCode;
+
+  /** Some temporary matrix holding the coupling blocks. */
+  Eigen::MatrixXd coupling;
+
+  /** Some temporary matrix holding the Jacobian of the base model. */
+  Eigen::MatrixXd stateJacobian;
+
+
+public:
+  /**
+   * Constructor.
+   *
+   * @param model Specifies the sensitivity model to integrate.
+   * @param opt_level Specifies the code-optimization level.
+   * @param num_threads Specifies the (optional) number of threads to use to evaluate the
+   *        system. By default, @c OpenMP::getMaxThreads will be used.
+   */
+  GenericSensitivityInterpreter(Sys &model, size_t opt_level=0,
+                                size_t num_threads=OpenMP::getMaxThreads())
+    : GenericSSEinterpreter<Sys, SysEngine, JacEngine>(model, opt_level, num_threads, false),
+      stateDim(model.getStateDimension()), numParams(model.numSensitivityParameters()),
+      couplingCode(num_threads),
+      coupling(stateDim*numParams, stateDim), stateJacobian(stateDim, stateDim)
+  {
+    // The update vector is not folded if the system was loaded from the cache:
+    this->foldUpdateVector();
+
+    // Get state symbols of the base model ordered by their index:
+    std::vector<GiNaC::symbol> state(stateDim);
+    std::map<GiNaC::symbol, size_t, GiNaC::ex_is_less>::const_iterator it;
+    for (it = this->lookup.begin(); it != this->lookup.end(); ++it) {
+      if (it->second < stateDim)
+        state[it->second] = it->first;
+    }
+
+    // Compile the Jacobian of the base model as the Jacobian of the system, unless it was loaded
+    // from the cache:
+    if (! this->hasJacobian) {
+      Eigen::MatrixXex jacobian(stateDim, stateDim);
+      for (size_t j=0; j<stateDim; j++) {
+        for (size_t i=0; i<stateDim; i++)
+          jacobian(i,j) = this->updateVector(i).diff(state[j]);
+      }
+
+      typename JacEngine::Compiler jacobian_compiler(this->lookup);
+      jacobian_compiler.setCode(&this->jacobianCode);
+      jacobian_compiler.compileMatrix(jacobian);
+      jacobian_compiler.finalize(this->opt_level);
+      this->hasJacobian = true;
+      this->storeInCache();
+    }
+
+    // Assemble and compile the coupling blocks from the folded update vector:
+    Eigen::MatrixXex couplingBlocks(stateDim*numParams, stateDim);
+    for (size_t j=0; j<stateDim; j++) {
+      for (size_t i=0; i<stateDim*numParams; i++)
+        couplingBlocks(i,j) = this->updateVector(stateDim+i).diff(state[j]);
+    }
+
+    typename JacEngine::Compiler coupling_compiler(this->lookup);
+    coupling_compiler.setCode(&couplingCode);
+    coupling_compiler.compileMatrix(couplingBlocks);
+    coupling_compiler.finalize(this->opt_level);
+
+    this->couplingInterpreter.setCode(&couplingCode);
+  }
+
+
+  /** Returns the dimension of the base model. */
+  size_t getStateDimension() const {
+    return stateDim;
+  }
+
+  /** Returns the number of parameters, the sensitivities are computed for. */
+  size_t numSensitivityParameters() const {
+    return numParams;
+  }
+
+  /** Evaluates the Jacobian of the base model at the given (augmented) state. */
+  inline void evaluateStateJacobian(const Eigen::VectorXd &state, double t, Eigen::MatrixXd &jac)
+  {
+    this->jacobian_interpreter.run(state, jac);
+  }
+
+  /** Evaluates the coupling blocks \f$C_k\f$, stacked row-wise, at the given (augmented) state. */
+  inline void evaluateSensitivityCoupling(const Eigen::VectorXd &state, double t,
+                                          Eigen::MatrixXd &blocks)
+  {
+    this->couplingInterpreter.run(state, blocks);
+  }
+
+  /**
+   * Evaluates the block lower-triangular Jacobian of the augmented system.
+   */
+  inline void evaluateJacobian(const Eigen::VectorXd &state, double t, Eigen::MatrixXd &jacobian)
+  {
+    jacobian.setZero();
+    this->jacobian_interpreter.run(state, stateJacobian);
+    this->couplingInterpreter.run(state, coupling);
+
+    for (size_t k=0; k<=numParams; k++)
+      jacobian.block(k*stateDim, k*stateDim, stateDim, stateDim) = stateJacobian;
+    jacobian.block(stateDim, 0, stateDim*numParams, stateDim) = coupling;
+  }
+};
+
+
+/**
+ * Defines the default sensitivity interpreter using byte-code interpreter with OpenMP support
+ * (if enabled).
+ */
+template <class Sys>
+class SensitivityInterpreter :
+    public GenericSensitivityInterpreter< Sys, Eval::bcimp::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+    Eval::bcimp::Engine<Eigen::VectorXd, Eigen::MatrixXd> >
+{
+public:
+  SensitivityInterpreter(Sys &model, size_t opt_level,
+                         size_t num_threads=OpenMP::getMaxThreads())
+    : GenericSensitivityInterpreter<Sys, Eval::bcimp::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+      Eval::bcimp::Engine<Eigen::VectorXd, Eigen::MatrixXd> >(model, opt_level, num_threads)
+  {
+    // Pass...
+  }
+};
+
+typedef SensitivityInterpreter<RESensitivityModel> RESensitivityInterpreter;
+typedef SensitivityInterpreter<LNASensitivityModel> LNASensitivityInterpreter;
+
+
+}
+}
+
+#endif // __INA_MODELS_SENSITIVITYINTERPRETER_HH__
@@ -0,0 +1,236 @@
+#ifndef __INA_MODELS_SENSITIVITYMODEL_HH__
+#define __INA_MODELS_SENSITIVITYMODEL_HH__
+
+#include "REmodel.hh"
+#include "LNAmodel.hh"
+#include "compiledmodelcache.hh"
+#include "../exception.hh"
+
+namespace iNA {
+namespace Models {
+
+
+/**
+ * Augments a SSE model (i.e. @c REmodel or @c LNAmodel) by the forward sensitivity equations
+ * w.r.t. a set of (global) parameters.
+ *
+ * Given the update vector \f$\dot{x}=f(x,p)\f$ of the base model with dimension \f$D\f$, the state
+ * is extended by the sensitivities \f$s_k=\partial x/\partial p_k\f$ for each of the \f$P\f$
+ * selected parameters, satisfying
+ * \f[
+ *   \dot{s}_k = J(x)\,s_k + \frac{\partial f}{\partial p_k}(x)\,,
+ * \f]
+ * where \f$J\f$ is the Jacobian of the base model. The state vector of the augmented model is
+ * \f$(x, s_1, \dots, s_P)\f$, hence all sensitivities are obtained by a single integration of the
+ * augmented system, which can be compiled and integrated with any execution engine and integrator.
+ * Use the @c SensitivityInterpreter together with the @c ODE::StaggeredRosenbrock4 stepper to
+ * integrate the augmented system efficiently.
+ *
+ * The initial values of the species are assumed to be independent of the selected parameters,
+ * hence the sensitivities are initially zero.
+ *
+ * @ingroup sse
+ */
+template <class BaseModel>
+class SensitivityModel
+    : public BaseModel
+{
+protected:
+  /** Holds the dimension of the base model. */
+  size_t stateDim;
+
+  /** Holds the identifiers of the parameters. */
+  std::vector<std::string> parameterIds;
+
+  /** Holds the symbols of the parameters. */
+  std::vector<GiNaC::symbol> parameters;
+
+  /** Holds the symbols of the sensitivities, \f$s_{k,i}\f$ is stored at index \f$kD+i\f$. */
+  std::vector<GiNaC::symbol> sensitivityVariables;
+
+  /** Holds the Jacobian of the base model. */
+  Eigen::MatrixXex stateJacobian;
+
+
+public:
+  /**
+   * Constructor.
+   *
+   * @param model Specifies the model.
+   * @param parameters Specifies the identifiers of the global, constant parameters to compute the
+   *        sensitivities for.
+   * @throws SymbolError If one of the identifiers does not name a global parameter.
+   * @throws SemanticError If one of the parameters is not constant.
+   */
+  SensitivityModel(const Ast::Model &model, const std::vector<std::string> &parameters)
+    : BaseModel(model), stateDim(BaseModel::getDimension()), parameterIds(parameters),
+      stateJacobian(stateDim, stateDim)
+  {
+    // Get parameter symbols:
+    for (size_t k=0; k<parameterIds.size(); k++) {
+      Ast::Parameter *param = this->getParameter(parameterIds[k]);
+      if (! param->isConst()) {
+        SemanticError err;
+        err << "Can not compute sensitivities w.r.t. parameter " << parameterIds[k]
+            << ": Parameter is not constant.";
+        throw err;
+      }
+      this->parameters.push_back(param->getSymbol());
+    }
+
+    // Get state symbols of the base model ordered by their index:
+    std::vector<GiNaC::symbol> state(stateDim);
+    std::map<GiNaC::symbol, size_t, GiNaC::ex_is_less>::const_iterator it;
+    for (it = this->stateIndex.begin(); it != this->stateIndex.end(); ++it)
+      state[it->second] = it->first;
+
+    // Assemble Jacobian of the base model:
+    for (size_t i=0; i<stateDim; i++)
+      for (size_t j=0; j<stateDim; j++)
+        stateJacobian(i,j) = this->updateVector(i).diff(state[j]);
+
+    // Assign new symbols for the sensitivities and add them to the index table
+    size_t P = this->parameters.size();
+    this->sensitivityVariables.reserve(stateDim*P);
+    for (size_t i=0; i<stateDim*P; i++) {
+      this->sensitivityVariables.push_back(GiNaC::symbol("S"));
+      this->stateIndex.insert(std::make_pair(this->sensitivityVariables[i], stateDim+i));
+    }
+
+    // Assemble sensitivity equations
+    Eigen::VectorXex update(stateDim*(1+P));
+    update.head(stateDim) = this->updateVector;
+    for (size_t k=0; k<P; k++) {
+      for (size_t i=0; i<stateDim; i++) {
+        GiNaC::ex rhs = this->updateVector(i).diff(this->parameters[k]);
+        for (size_t j=0; j<stateDim; j++) {
+          // skip structural zeros
+          if (! stateJacobian(i,j).is_zero())
+            rhs += stateJacobian(i,j)*this->sensitivityVariables[k*stateDim+j];
+        }
+        update(stateDim*(k+1)+i) = rhs;
+      }
+    }
+
+    // ... and combine to update vector
+    this->updateVector = update;
+    this->dim = stateDim*(1+P);
+  }
+
+  /** Returns the dimension of the base model. */
+  size_t getStateDimension() const {
+    return stateDim;
+  }
+
+  /** Returns the number of parameters, the sensitivities are computed for. */
+  size_t numSensitivityParameters() const {
+    return parameters.size();
+  }
+
+  /** Returns the identifier of the k-th parameter. */
+  const std::string &getSensitivityParameterId(size_t k) const {
+    return parameterIds[k];
+  }
+
+  /** Returns the symbol of the k-th parameter. */
+  const GiNaC::symbol &getSensitivityParameter(size_t k) const {
+    return parameters[k];
+  }
+
+  /** Returns the symbol of the sensitivity of the i-th state variable w.r.t. the k-th parameter. */
+  const GiNaC::symbol &getSensitivityVar(size_t i, size_t k) const {
+    return sensitivityVariables[k*stateDim+i];
+  }
+
+  /** Returns the Jacobian of the base model. */
+  const Eigen::MatrixXex &getStateJacobian() const {
+    return stateJacobian;
+  }
+
+  /**
+   * Get initial state vector for specific initial conditions. The initial state of the base
+   * model is extended by zero sensitivities.
+   */
+  virtual void getInitial(InitialConditions &ICs, Eigen::VectorXd &x)
+  {
+    Eigen::VectorXd base(stateDim);
+    BaseModel::getInitial(ICs, base);
+
+    x.resize(this->getDimension());
+    x.head(stateDim) = base;
+    x.tail(this->getDimension()-stateDim).setZero();
+  }
+
+  /**
+   * Unpacks the sensitivities from the (reduced) state into a matrix, where the k-th column holds
+   * the sensitivities of the (reduced) state of the base model w.r.t. the k-th parameter.
+   */
+  void getSensitivities(const Eigen::VectorXd &state, Eigen::MatrixXd &sensitivities)
+  {
+    sensitivities.resize(stateDim, parameters.size());
+    for (size_t k=0; k<parameters.size(); k++)
+      sensitivities.col(k) = state.segment(stateDim*(k+1), stateDim);
+  }
+
+  /**
+   * Reconstructs the sensitivities of the concentrations of all species from the (reduced) state.
+   * The k-th column of @c sensitivities holds the derivatives of the concentrations (in the
+   * original order of the species) w.r.t. the k-th parameter.
+   */
+  void fullSensitivities(InitialConditions &context, const Eigen::VectorXd &state,
+                         Eigen::MatrixXd &sensitivities)
+  {
+    sensitivities.resize(this->numSpecies(), parameters.size());
+
+    for (size_t k=0; k<parameters.size(); k++) {
+      Eigen::VectorXd col(this->numSpecies());
+      col.head(this->numIndSpecies()) = state.segment(stateDim*(k+1), this->numIndSpecies());
+      // The conserved quantities do not depend on the parameters:
+      if (this->numDepSpecies()>0) {
+        col.tail(this->numDepSpecies()) =
+            context.getLink0CMatrix()*state.segment(stateDim*(k+1), this->numIndSpecies());
+      }
+      // Restore original order:
+      sensitivities.col(k) = this->PermutationM.transpose()*col;
+    }
+  }
+
+  /**
+   * Reconstructs the sensitivities of the concentrations of all species from the (reduced) state.
+   */
+  void fullSensitivities(const Eigen::VectorXd &state, Eigen::MatrixXd &sensitivities)
+  {
+    InitialConditions context(*this);
+    fullSensitivities(context, state, sensitivities);
+  }
+};
+
+
+/**
+ * The compiled sensitivity model depends on the selected parameters.
+ */
+template <class BaseModel>
+class CacheTag< SensitivityModel<BaseModel> >
+{
+public:
+  /** Returns the identifiers of the selected parameters. */
+  static std::string get(SensitivityModel<BaseModel> &system) {
+    std::string tag = "sensitivities";
+    for (size_t k=0; k<system.numSensitivityParameters(); k++)
+      tag += " " + system.getSensitivityParameterId(k);
+    return tag;
+  }
+};
+
+
+/** The RE model augmented by the forward sensitivity equations. */
+typedef SensitivityModel<REmodel> RESensitivityModel;
+
+/** The LNA model augmented by the forward sensitivity equations. */
+typedef SensitivityModel<LNAmodel> LNASensitivityModel;
+
+
+}
+}
+
+#endif // __INA_MODELS_SENSITIVITYMODEL_HH__
@@ -0,0 +1,113 @@
+#include "sparsematrixex.hh"
+
+using namespace iNA;
+using namespace iNA::Models;
+
+
+const GiNaC::ex SparseMatrixEx::_zero = 0;
+
+
+SparseMatrixEx::SparseMatrixEx()
+  : _cols(0), _entries()
+{
+  // Pass...
+}
+
+SparseMatrixEx::SparseMatrixEx(size_t rows, size_t cols)
+  : _cols(cols), _entries(rows)
+{
+  // Pass...
+}
+
+
+void
+SparseMatrixEx::resize(size_t rows, size_t cols)
+{
+  _entries.clear();
+  _entries.resize(rows);
+  _cols = cols;
+}
+
+
+size_t
+SparseMatrixEx::nonZeros() const
+{
+  size_t count = 0;
+  for (size_t i=0; i<_entries.size(); i++) {
+    count += _entries[i].size();
+  }
+  return count;
+}
+
+
+void
+SparseMatrixEx::set(size_t i, size_t j, const GiNaC::ex &value)
+{
+  if (value.is_zero()) {
+    _entries[i].erase(j);
+  } else {
+    _entries[i][j] = value;
+  }
+}
+
+
+void
+SparseMatrixEx::add(size_t i, size_t j, const GiNaC::ex &value)
+{
+  if (value.is_zero()) { return; }
+
+  Row::iterator item = _entries[i].find(j);
+  if (_entries[i].end() == item) {
+    _entries[i].insert(std::make_pair(j, value));
+  } else {
+    item->second += value;
+    // Remove entry if it cancels out:
+    if (item->second.is_zero()) { _entries[i].erase(item); }
+  }
+}
+
+
+void
+SparseMatrixEx::scaleRow(size_t i, const GiNaC::ex &factor)
+{
+  for (Row::iterator item=_entries[i].begin(); item!=_entries[i].end(); item++) {
+    item->second *= factor;
+  }
+}
+
+
+Eigen::MatrixXex
+SparseMatrixEx::toDense() const
+{
+  Eigen::MatrixXex dense(rows(), cols());
+  for (size_t i=0; i<rows(); i++) {
+    for (size_t j=0; j<cols(); j++) {
+      dense(i,j) = 0;
+    }
+    for (Row::const_iterator item=_entries[i].begin(); item!=_entries[i].end(); item++) {
+      dense(i, item->first) = item->second;
+    }
+  }
+  return dense;
+}
+
+
+SparseMatrixEx
+SparseMatrixEx::product(const Eigen::MatrixXd &lhs, const SparseMatrixEx &rhs,
+                        const Eigen::VectorXex &scale)
+{
+  SparseMatrixEx result(lhs.rows(), rhs.cols());
+
+  // Accumulate row-wise, skipping all zero coefficients of lhs:
+  for (int i=0; i<lhs.rows(); i++) {
+    for (int m=0; m<lhs.cols(); m++) {
+      if (0 == lhs(i,m)) { continue; }
+      for (Row::const_iterator item=rhs.row(m).begin(); item!=rhs.row(m).end(); item++) {
+        result.add(i, item->first, lhs(i,m)*item->second);
+      }
+    }
+    result.scaleRow(i, 1/scale(i));
+  }
+
+  return result;
+}
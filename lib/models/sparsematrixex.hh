@@ -0,0 +1,88 @@
+#ifndef __INA_MODELS_SPARSEMATRIXEX_HH__
+#define __INA_MODELS_SPARSEMATRIXEX_HH__
+
+#include <map>
+#include <vector>
+#include "../ginacsupportforeigen.hh"
+
+namespace iNA {
+namespace Models {
+
+
+/**
+ * A simple row-wise sparse matrix of GiNaC expressions.
+ *
+ * Only structurally non-zero entries are stored, any other entry reads as zero. This class is used
+ * to hold the higher-order coefficient tensors of the system size expansion (i.e. the Hessian and
+ * 3rd derivatives of the rates) which are mostly zero for realistic reaction networks.
+ *
+ * @ingroup sse
+ */
+class SparseMatrixEx
+{
+public:
+  /** Holds the non-zero entries of a row indexed by their column. */
+  typedef std::map<size_t, GiNaC::ex> Row;
+
+public:
+  /** Constructs an empty matrix. */
+  SparseMatrixEx();
+
+  /** Constructs a zero matrix with the given dimension. */
+  SparseMatrixEx(size_t rows, size_t cols);
+
+  /** Resizes the matrix, all entries are set to zero. */
+  void resize(size_t rows, size_t cols);
+
+  /** Returns the number of rows. */
+  inline size_t rows() const { return _entries.size(); }
+
+  /** Returns the number of columns. */
+  inline size_t cols() const { return _cols; }
+
+  /** Returns the number of structurally non-zero entries. */
+  size_t nonZeros() const;
+
+  /** Returns the entry (i,j) or zero if the entry is not stored. */
+  inline const GiNaC::ex &operator() (size_t i, size_t j) const {
+    Row::const_iterator item = _entries[i].find(j);
+    if (_entries[i].end() == item) { return _zero; }
+    return item->second;
+  }
+
+  /** Returns the non-zero entries of the i-th row. */
+  inline const Row &row(size_t i) const { return _entries[i]; }
+
+  /** Sets the entry (i,j), zero values are not stored. */
+  void set(size_t i, size_t j, const GiNaC::ex &value);
+
+  /** Adds the value to the entry (i,j), entries that vanish are removed. */
+  void add(size_t i, size_t j, const GiNaC::ex &value);
+
+  /** Multiplies all entries of the i-th row by the given factor. */
+  void scaleRow(size_t i, const GiNaC::ex &factor);
+
+  /** Returns the dense representation of the matrix. */
+  Eigen::MatrixXex toDense() const;
+
+  /**
+   * Computes the product of a numeric matrix (i.e. the stoichiometric matrix) with the sparse
+   * matrix @c rhs, where the rows of the result are divided by the given @c scale.
+   */
+  static SparseMatrixEx product(const Eigen::MatrixXd &lhs, const SparseMatrixEx &rhs,
+                                const Eigen::VectorXex &scale);
+
+private:
+  /** Holds the number of columns. */
+  size_t _cols;
+  /** Holds the non-zero entries row-wise. */
+  std::vector<Row> _entries;
+  /** The zero, returned for all entries not stored. */
+  static const GiNaC::ex _zero;
+};
+
+
+}
+}
+
+#endif // __INA_MODELS_SPARSEMATRIXEX_HH__
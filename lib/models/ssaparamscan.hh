@@ -40,7 +40,8 @@ class SSAparamScan
 {
 protected:
 
-    Ast::Model& sbml_model;
+    /** Shares the model with the task configuration. */
+    Ast::ModelSnapshot sbml_model;
     double transientTime;
 
     std::vector<Models::GenericOptimizedSSA<Engine>*> simulators;
@@ -55,26 +56,26 @@ protected:
 
 
 public:
-    SSAparamScan(Ast::Model &model, std::vector<ParameterSet> &parameterSets,
+    SSAparamScan(const Ast::ModelSnapshot &model, std::vector<ParameterSet> &parameterSets,
                  double transientTime, size_t numThreads=OpenMP::getMaxThreads(), size_t opt_level=0)
       : sbml_model(model), transientTime(transientTime),
         simulators(parameterSets.size()),
         _n(1), state(numThreads)
     {
 
-      _mean = Eigen::MatrixXd::Zero(parameterSets.size(),sbml_model.numSpecies());
-      _cov  = Eigen::MatrixXd::Zero(parameterSets.size(),sbml_model.numSpecies()*(sbml_model.numSpecies()+1)/2);
+      _mean = Eigen::MatrixXd::Zero(parameterSets.size(),sbml_model->numSpecies());
+      _cov  = Eigen::MatrixXd::Zero(parameterSets.size(),sbml_model->numSpecies()*(sbml_model->numSpecies()+1)/2);
 
       // Create SSA for all parameter sets
       for(size_t j = 0; j < parameterSets.size(); j++)
       {
-        // Copy model
-        Ast::Model mod(sbml_model);
+        // Share model, it gets copied only if the parameter set changes it
+        Ast::ModelSnapshot mod(sbml_model);
         // Apply parameter set
         for(ParameterSet::iterator it=parameterSets[j].begin(); it!=parameterSets[j].end(); it++)
-          mod.getParameter((*it).first)->setValue((*it).second);
+          mod.modify().getParameter((*it).first)->setValue((*it).second);
         // Create SSA
-        simulators[j] = new Models::GenericOptimizedSSA<Engine>(mod, 1, time(0), opt_level, 1);
+        simulators[j] = new Models::GenericOptimizedSSA<Engine>(*mod, 1, time(0), opt_level, 1);
       }
 
       // Advance state
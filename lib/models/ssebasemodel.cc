@@ -23,7 +23,7 @@ SSEBaseModel::SSEBaseModel(const Ast::Model &model)
     DiffusionJacMO1(numIndSpecies()*(numIndSpecies()+1)/2,numIndSpecies()),
     Diffusion3Tensor(numIndSpecies()*(numIndSpecies()+1)*(numIndSpecies()+2)/6),
     DiffusionHessianM(numIndSpecies()*(numIndSpecies()+1)/2,numIndSpecies()*(numIndSpecies()+1)/2),
-    PhilippianM(numIndSpecies()*(numIndSpecies()+1)*(numIndSpecies()+2)/6,numIndSpecies()*(numIndSpecies()+1)*(numIndSpecies()+2)/6)
+    PhilippianM(numIndSpecies(),numIndSpecies()*(numIndSpecies()+1)*(numIndSpecies()+2)/6)
 {
   postConstructor();
 }
@@ -50,8 +50,8 @@ SSEBaseModel::postConstructor()
       // substitute conservation relations
       rate_corrections(i) = this->rates1[i].subs(dependentSpecies);
 
-      int idx=0;
-      int idy=0;
+      // collect independent species the rate depends on, all other derivatives vanish
+      std::vector<size_t> dependencies;
       for (size_t j=0; j<this->numIndSpecies(); j++)
       {
 
@@ -59,20 +59,29 @@ SSEBaseModel::postConstructor()
         rates_gradient(i,j) = GiNaC::diff(rate_expressions(i), species[PermutationVec(j)]);
         rates_gradientO1(i,j) = GiNaC::diff(rate_corrections(i), species[PermutationVec(j)]);
 
-        for (size_t k=0; k<=j; k++)
+        if (rate_expressions(i).has(species[PermutationVec(j)]))
+          dependencies.push_back(j);
+
+      }
+
+      // differentiate again, only for structurally non-zero entries
+      for (size_t a=0; a<dependencies.size(); a++)
+      {
+        size_t j = dependencies[a];
+        for (size_t b=0; b<=a; b++)
         {
-            // differentiate again
-            rates_hessian(i,idx) = GiNaC::diff(rates_gradient(i,j), species[PermutationVec(k)]);
-            for(size_t l=0; l<=k; l++)
+            size_t k = dependencies[b];
+            size_t idx = (j*(j+1))/2 + k;
+            rates_hessian.set(i, idx, GiNaC::diff(rates_gradient(i,j), species[PermutationVec(k)]));
+            if (rates_hessian(i,idx).is_zero()) continue;
+
+            for(size_t c=0; c<=b; c++)
             {
-                rates_3rd(i,idy) =
-                        GiNaC::diff( rates_hessian(i,idx), species[PermutationVec(l)]);
-                idy++;
+                size_t l = dependencies[c];
+                size_t idy = (j*(j+1)*(j+2))/6 + (k*(k+1))/2 + l;
+                rates_3rd.set(i, idy, GiNaC::diff( rates_hessian(i,idx), species[PermutationVec(l)]));
             }
-            idx++;
-
         }
-
       }
     }
 
@@ -81,16 +90,16 @@ SSEBaseModel::postConstructor()
     this->REcorrections = this->reduced_stoichiometry.cast< GiNaC::ex >()*rate_corrections;
     this->JacobianM = this->reduced_stoichiometry.cast< GiNaC::ex >()*rates_gradient;
     this->JacobianMO1 = this->reduced_stoichiometry.cast< GiNaC::ex >()*rates_gradientO1;
-    this->Hessian = this->reduced_stoichiometry.cast< GiNaC::ex >()*rates_hessian;
-    this->PhilippianM = this->reduced_stoichiometry.cast< GiNaC::ex >()*rates_3rd;
 
     // divide by volume
     this->REs = this->Omega_ind.asDiagonal().inverse()*this->REs;
     this->REcorrections = this->Omega_ind.asDiagonal().inverse()*this->REcorrections;
     this->JacobianM = this->Omega_ind.asDiagonal().inverse()*this->JacobianM;
     this->JacobianMO1 = this->Omega_ind.asDiagonal().inverse()*this->JacobianMO1;
-    this->Hessian = this->Omega_ind.asDiagonal().inverse()*this->Hessian;
-    this->PhilippianM = this->Omega_ind.asDiagonal().inverse()*this->PhilippianM;
+
+    // sparse products with stoichiometry divided by volume
+    this->Hessian = SparseMatrixEx::product(this->reduced_stoichiometry, rates_hessian, this->Omega_ind);
+    this->PhilippianM = SparseMatrixEx::product(this->reduced_stoichiometry, rates_3rd, this->Omega_ind);
 
     size_t idy = 0;
     size_t idz = 0;
@@ -151,28 +160,39 @@ SSEBaseModel::postConstructor()
 
     }
 
+    // collect the independent species changed by each reaction
+    std::vector< std::vector<size_t> > reactants(this->numReactions());
+    for(size_t m=0;m<this->numReactions();m++)
+       for(size_t i=0;i<this->numIndSpecies();i++)
+           if(0 != this->reduced_stoichiometry(i,m)) reactants[m].push_back(i);
+
+    // only reactions changing both species i and j contribute to D_{ij}^{kl}
+    for(size_t m=0;m<this->numReactions();m++)
+    {
+       const SparseMatrixEx::Row &row = rates_hessian.row(m);
+       for(size_t a=0;a<reactants[m].size();a++)
+       {
+           size_t i = reactants[m][a];
+           for(size_t b=0;b<=a;b++)
+           {
+               size_t j = reactants[m][b];
+               size_t idx = (i*(i+1))/2 + j;
+               for(SparseMatrixEx::Row::const_iterator item=row.begin(); item!=row.end(); item++)
+                   this->DiffusionHessianM.add(idx, item->first,
+                        item->second
+                        *this->reduced_stoichiometry(i,m)*this->reduced_stoichiometry(j,m));
+           }
+       }
+    }
+
+    //divide by volume squared
     size_t idx = 0;
     for(size_t i=0;i<this->numIndSpecies();i++)
        for(size_t j=0;j<=i;j++)
        {
-
-           idy = 0;
-           for(size_t k=0;k<this->numIndSpecies();k++)
-              for(size_t l=0;l<=k;l++)
-              {
-                  for(size_t m=0;m<this->numReactions();m++)
-                      this->DiffusionHessianM(idx,idy)+=
-                           rates_hessian(m,idy)
-                           *this->reduced_stoichiometry.cast< GiNaC::ex >()(i,m)
-                           *this->reduced_stoichiometry.cast< GiNaC::ex >()(j,m);
-
-                  this->DiffusionHessianM(idx,idy) /= this->Omega_ind(i)*this->Omega_ind(j);
-                  idy++;
-              } // end idy
-
+           this->DiffusionHessianM.scaleRow(idx, 1/(this->Omega_ind(i)*this->Omega_ind(j)));
            idx++;
-
-       } // end idx
+       }
 
 
 }
@@ -224,6 +244,15 @@ SSEBaseModel::vertex(std::list<size_t> &lower, std::list<size_t> &upper, size_t
 
 }
 
+void
+SSEBaseModel::decodeHessianIndex(size_t idx, size_t &j, size_t &k)
+{
+    // idx = j*(j+1)/2 + k with k<=j
+    j = 0;
+    while ((j+1)*(j+2)/2 <= idx) j++;
+    k = idx - (j*(j+1))/2;
+}
+
 Eigen::MatrixXex &
 SSEBaseModel::getDiffusionMatrix()
 
@@ -4,6 +4,7 @@
 #include "basemodel.hh"
 #include "propensityexpansion.hh"
 #include "conservationanalysis.hh"
+#include "sparsematrixex.hh"
 
 namespace iNA {
 namespace Models {
@@ -28,8 +29,8 @@ protected:
     Eigen::VectorXex rate_corrections;
     Eigen::MatrixXex rates_gradient;
     Eigen::MatrixXex rates_gradientO1;
-    Eigen::MatrixXex rates_hessian;
-    Eigen::MatrixXex rates_3rd;
+    SparseMatrixEx rates_hessian;
+    SparseMatrixEx rates_3rd;
 
 protected:
 
@@ -56,7 +57,7 @@ protected:
     /**
     * Expressions of Hessian in unconstrained base.
     */
-    Eigen::MatrixXex Hessian;
+    SparseMatrixEx Hessian;
 
     /**
     * Expressions for Diffusion matrix \f$ \underline{D} \f$ in unconstrained base.
@@ -91,12 +92,12 @@ protected:
     /**
     * Expressions for 4-tensor matrix \f$ D_{ij}^{kl} \f$ in unconstrained base.
     */
-    Eigen::MatrixXex DiffusionHessianM;
+    SparseMatrixEx DiffusionHessianM;
 
     /**
     * Expressions for 4-tensor matrix \f$ D_{i}^{jkl} \f$ in unconstrained base.
     */
-    Eigen::MatrixXex PhilippianM;
+    SparseMatrixEx PhilippianM;
 
 
     /**
@@ -132,6 +133,11 @@ public:
 
     Eigen::MatrixXex &getDiffusionMatrix();
 
+    /**
+     * Decodes the column index of the @c Hessian into the species pair (j,k) with k<=j.
+     */
+    static void decodeHessianIndex(size_t idx, size_t &j, size_t &k);
+
 };
 
 }
@@ -1,4 +1,5 @@
 #include "sseinterpreter.hh"
+#include <set>
 
 using namespace iNA::Models;
 
@@ -7,3 +8,94 @@ SSEInterpreterInterface::~SSEInterpreterInterface() {
   // pass...
 }
 
+
+
+
+JacobianGenerator::JacobianGenerator(const Eigen::VectorXex &updateVector,
+                                     const std::map<GiNaC::symbol, size_t, GiNaC::ex_is_less> &index)
+  : _updateVector(updateVector), _variables()
+{
+  std::map<GiNaC::symbol, size_t, GiNaC::ex_is_less>::const_iterator it;
+  for (it = index.begin(); it != index.end(); ++it) {
+    _variables.insert(std::make_pair(it->second, it->first));
+  }
+}
+
+size_t
+JacobianGenerator::rows() const {
+  return _updateVector.size();
+}
+
+size_t
+JacobianGenerator::cols() const {
+  return _updateVector.size();
+}
+
+GiNaC::ex
+JacobianGenerator::generate(size_t i, size_t j) {
+  std::map<size_t, GiNaC::symbol>::iterator var = _variables.find(j);
+  if (_variables.end() == var) { return 0; }
+  return _updateVector(i).diff(var->second);
+}
+
+
+
+SparseJacobianGenerator::SparseJacobianGenerator(
+    const Eigen::VectorXex &updateVector,
+    const std::map<GiNaC::symbol, size_t, GiNaC::ex_is_less> &index)
+  : _updateVector(updateVector), _variables(), _rows(), _cols()
+{
+  std::map<GiNaC::symbol, size_t, GiNaC::ex_is_less>::const_iterator it;
+  for (it = index.begin(); it != index.end(); ++it) {
+    _variables.insert(std::make_pair(it->second, it->first));
+  }
+
+  // Collect the state variables each element of the update vector depends on. This requires a
+  // single traversal of each expression instead of a test for each pair of element and variable:
+  std::vector< std::set<size_t> > columns(_updateVector.size());
+  for (int i=0; i<_updateVector.size(); i++) {
+    for (GiNaC::const_preorder_iterator node=_updateVector(i).preorder_begin();
+         node != _updateVector(i).preorder_end(); ++node) {
+      if (! GiNaC::is_a<GiNaC::symbol>(*node)) { continue; }
+      it = index.find(GiNaC::ex_to<GiNaC::symbol>(*node));
+      if ((index.end() != it) && (it->second < columns.size())) { columns[it->second].insert(i); }
+    }
+  }
+
+  // Enumerate non-zero elements in compressed column-major order:
+  for (size_t j=0; j<columns.size(); j++) {
+    for (std::set<size_t>::iterator i=columns[j].begin(); i!=columns[j].end(); i++) {
+      _rows.push_back(*i); _cols.push_back(j);
+    }
+  }
+}
+
+Eigen::SparseMatrix<double>
+SparseJacobianGenerator::pattern() const {
+  std::vector< Eigen::Triplet<double> > triplets;
+  triplets.reserve(_rows.size());
+  for (size_t k=0; k<_rows.size(); k++) {
+    triplets.push_back(Eigen::Triplet<double>(_rows[k], _cols[k], 0.0));
+  }
+  Eigen::SparseMatrix<double> pattern(_updateVector.size(), _updateVector.size());
+  pattern.setFromTriplets(triplets.begin(), triplets.end());
+  pattern.makeCompressed();
+  return pattern;
+}
+
+size_t
+SparseJacobianGenerator::rows() const {
+  return _rows.size();
+}
+
+size_t
+SparseJacobianGenerator::cols() const {
+  return 1;
+}
+
+GiNaC::ex
+SparseJacobianGenerator::generate(size_t k, size_t j) {
+  std::map<size_t, GiNaC::symbol>::iterator var = _variables.find(_cols[k]);
+  if (_variables.end() == var) { return 0; }
+  return _updateVector(_rows[k]).diff(var->second);
+}
@@ -7,19 +7,95 @@
 #include "../eval/eval.hh"
 #include "../eval/bcimp/engine.hh"
 #include "../trafo/constantfolder.hh"
+#include "compiledmodelcache.hh"
+#include "../ode/event.hh"
+#include <eigen3/Eigen/Sparse>
+#include <typeinfo>
+#include <sstream>
 
 namespace iNA {
 namespace Models {
 
 
 /** This class defines the virtual base class of all interpreters. This is necessary to allow
- * the determination of the execution engine at runtime. This class does not define any methods
- * to be implemented by the @c GenericSSEinterpreter, it just forces a RTTI vtable for all
- * interpreters.
+ * the determination of the execution engine at runtime. The integrators evaluate the system
+ * through the concrete @c GenericSSEinterpreter type, hence the evaluation of the system is not
+ * virtual. The interface only constructs objects bound to the concrete interpreter (i.e. a
+ * @c ODE::SteadyStateEvent) and linearizes the system once, without knowing the execution engine.
  */
 class SSEInterpreterInterface {
 public:
   virtual ~SSEInterpreterInterface();
+
+  /** Constructs an event that fires once the rates of the first @c dimension state variables
+   * (all if 0) are below the given tolerances. The ownership of the event is transferred to
+   * the caller. */
+  virtual ODE::Event *createSteadyStateEvent(double epsilon_abs, double epsilon_rel,
+                                             size_t dimension=0) = 0;
+
+  /** Evaluates the ODEs of the system and their Jacobian at the given state. */
+  virtual void linearize(const Eigen::VectorXd &state, double t,
+                         Eigen::VectorXd &dx, Eigen::MatrixXd &jacobian) = 0;
+};
+
+
+/**
+ * Generates the elements of the Jacobian of an update vector on demand. This allows to
+ * differentiate and compile the Jacobian in several worker processes.
+ */
+class JacobianGenerator : public Eval::ExpressionGenerator
+{
+protected:
+  /** The update vector. */
+  Eigen::VectorXex _updateVector;
+  /** Maps the column index to the state variable. */
+  std::map<size_t, GiNaC::symbol> _variables;
+
+public:
+  /** Constructor.
+   * @param updateVector Specifies the vector of expressions to differentiate.
+   * @param index Specifies the mapping of state variables to their index. */
+  JacobianGenerator(const Eigen::VectorXex &updateVector,
+                    const std::map<GiNaC::symbol, size_t, GiNaC::ex_is_less> &index);
+
+  virtual size_t rows() const;
+  virtual size_t cols() const;
+  virtual GiNaC::ex generate(size_t i, size_t j);
+};
+
+
+
+/**
+ * Generates the structurally non-zero elements of the Jacobian of an update vector. The elements
+ * are generated as a column vector in the order of the compressed column-major storage of the
+ * sparsity pattern (see @c pattern). Hence the compiled vector can be evaluated directly into
+ * the values of a @c Eigen::SparseMatrix with that pattern.
+ */
+class SparseJacobianGenerator : public Eval::ExpressionGenerator
+{
+protected:
+  /** The update vector. */
+  Eigen::VectorXex _updateVector;
+  /** Maps the column index to the state variable. */
+  std::map<size_t, GiNaC::symbol> _variables;
+  /** Row index of the k-th non-zero element. */
+  std::vector<size_t> _rows;
+  /** Column index of the k-th non-zero element. */
+  std::vector<size_t> _cols;
+
+public:
+  /** Constructor, determines the sparsity pattern.
+   * @param updateVector Specifies the vector of expressions to differentiate.
+   * @param index Specifies the mapping of state variables to their index. */
+  SparseJacobianGenerator(const Eigen::VectorXex &updateVector,
+                          const std::map<GiNaC::symbol, size_t, GiNaC::ex_is_less> &index);
+
+  /** Returns the sparsity pattern of the Jacobian, all non-zero elements are 0. */
+  Eigen::SparseMatrix<double> pattern() const;
+
+  virtual size_t rows() const;
+  virtual size_t cols() const;
+  virtual GiNaC::ex generate(size_t i, size_t j);
 };
 
 
@@ -73,17 +149,53 @@ protected:
    */
    bool hasJacobian;
 
+   /**
+    * Holds the interpreter to evaluate the non-zero elements of the sparse Jacobian.
+    */
+   typename SysEngine::Interpreter sparse_jacobian_interpreter;
+
+   /**
+    * The code to evaluate the non-zero elements of the sparse Jacobian.
+    */
+   typename SysEngine::Code sparseJacobianCode;
+
+   /**
+    * Holds the sparsity pattern of the Jacobian.
+    */
+   Eigen::SparseMatrix<double> jacobianPattern;
+
+   /**
+    * If true, the sparse Jacobian was allready compiled.
+    */
+   bool hasSparseJacobian;
+
    /**
     * Holds the optimization level for the generic compiler.
     */
    size_t opt_level;
 
+   /**
+    * Holds the number of worker processes used to compile the system and the Jacobian.
+    */
+   size_t num_processes;
+
 
    /**
     * Holds the update vector with constants folded.
     */
    Eigen::VectorXex updateVector;
 
+   /**
+    * If true, the constants of the update vector were folded.
+    */
+   bool updateVectorFolded;
+
+   /**
+    * Holds the key of the compiled system in the @c CompiledModelCache, empty if the system is
+    * not cached.
+    */
+   std::string cacheKey;
+
 
 public:
   /**
@@ -95,29 +207,38 @@ public:
    *        system. By default, @c OpenMP::getMaxThreads will be used.
    * @param compileJac Specifies if the Jacobian should be compiled immediately. If false, it will
    *        be compiled on demand.
+   * @param num_processes Specifies the number of worker processes used to compile the system and
+   *        its Jacobian. This is only supported by the byte-code engines, see
+   *        @c Eval::bci::ForkCompiler.
    */
 
   GenericSSEinterpreter(Sys &model, size_t opt_level=0,
-                 size_t num_threads=OpenMP::getMaxThreads(), bool compileJac = false)
+                 size_t num_threads=OpenMP::getMaxThreads(), bool compileJac = false,
+                 size_t num_processes=1)
       : sseModel(model), lookup(model.stateIndex), ICs(model), bytecode(num_threads), jacobianCode(num_threads),
-        hasJacobian(false), opt_level(opt_level),
-        updateVector(sseModel.getUpdateVector())
+        hasJacobian(false), sparseJacobianCode(num_threads), hasSparseJacobian(false),
+        opt_level(opt_level), num_processes(num_processes),
+        updateVector(sseModel.getUpdateVector()), updateVectorFolded(false)
 
   {
-
-    // Fold constants and get update vector
-    Trafo::ConstantFolder constants(sseModel);
-    updateVector = ICs.apply(constants.apply(updateVector));
-
-    // Compile expressions
-    typename SysEngine::Compiler compiler(sseModel.stateIndex);
-    compiler.setCode(&this->bytecode);
-    compiler.compileVector(updateVector);
-    compiler.finalize(opt_level);
+    // Skip compilation if the system was compiled before:
+    if (! loadFromCache(num_threads)) {
+      // Fold constants and get update vector
+      this->foldUpdateVector();
+
+      // Compile expressions
+      typename SysEngine::Compiler compiler(sseModel.stateIndex);
+      compiler.setCode(&this->bytecode);
+      Eval::MatrixExpressionGenerator generator(updateVector);
+      compiler.compileGenerated(generator, num_processes);
+      compiler.finalize(opt_level);
+      this->storeInCache();
+    }
 
     // Set bytecode for interpreter
     this->interpreter.setCode(&(this->bytecode));
     this->jacobian_interpreter.setCode(&(this->jacobianCode));
+    this->sparse_jacobian_interpreter.setCode(&(this->sparseJacobianCode));
 
     if (compileJac)
       this->compileJacobian();
@@ -139,7 +260,8 @@ public:
                  size_t num_threads=OpenMP::getMaxThreads(), bool compileJac = false)
       : sseModel(model), lookup(index), ICs(model),
         bytecode(num_threads), jacobianCode(num_threads),
-        hasJacobian(false), opt_level(opt_level)
+        hasJacobian(false), sparseJacobianCode(num_threads), hasSparseJacobian(false),
+        opt_level(opt_level), num_processes(1), updateVectorFolded(true)
 
   {
 
@@ -152,6 +274,7 @@ public:
     // Set bytecode for interpreter
     this->interpreter.setCode(&(this->bytecode));
     this->jacobian_interpreter.setCode(&(this->jacobianCode));
+    this->sparse_jacobian_interpreter.setCode(&(this->sparseJacobianCode));
 
     if (compileJac)
       this->compileJacobian();
@@ -173,13 +296,13 @@ public:
                  size_t opt_level=0,
                  size_t num_threads=OpenMP::getMaxThreads(), bool compileJac = false)
     : sseModel(model), lookup(model.stateIndex), ICs(model), bytecode(num_threads), jacobianCode(num_threads),
-      hasJacobian(false), opt_level(opt_level),
-      updateVector(sseModel.getUpdateVector())
+      hasJacobian(false), sparseJacobianCode(num_threads), hasSparseJacobian(false),
+      opt_level(opt_level), num_processes(1),
+      updateVector(sseModel.getUpdateVector()), updateVectorFolded(false)
   {
 
     // Fold constants and get update vector
-    Trafo::ConstantFolder constants(sseModel);
-    updateVector = ICs.apply(constants.apply(updateVector));
+    this->foldUpdateVector();
 
     // Fold constants from external model
     Trafo::InitialValueFolder extICs(extModel);
@@ -204,6 +327,7 @@ public:
     // Set bytecode for interpreter
     this->interpreter.setCode(&(this->bytecode));
     this->jacobian_interpreter.setCode(&(this->jacobianCode));
+    this->sparse_jacobian_interpreter.setCode(&(this->sparseJacobianCode));
 
     if (compileJac)
       this->compileJacobian();
@@ -230,27 +354,119 @@ public:
   {
     if(hasJacobian) return;
 
-    // Assemble Jacobian
-    Eigen::MatrixXex jacobian(sseModel.getDimension(), sseModel.getDimension());
-    {
-      std::map<GiNaC::symbol, size_t, GiNaC::ex_is_less>::const_iterator it;
-      for(it = sseModel.stateIndex.begin(); it != sseModel.stateIndex.end(); ++it)
-      {
-        for (size_t i=0; i<sseModel.getDimension(); i++)
-          jacobian(i,(*it).second) = updateVector(i).diff((*it).first);
-      }
-    }
+    // The update vector is not folded if the system was loaded from the cache:
+    this->foldUpdateVector();
 
-    // Compile jacobian:
+    // Differentiate and compile jacobian:
+    JacobianGenerator jacobian(updateVector, sseModel.stateIndex);
     typename JacEngine::Compiler jacobian_compiler(lookup);
     jacobian_compiler.setCode(&jacobianCode);
-    jacobian_compiler.compileMatrix(jacobian);
+    jacobian_compiler.compileGenerated(jacobian, num_processes);
     jacobian_compiler.finalize(opt_level);
 
     hasJacobian = true;
+    this->storeInCache();
   }
 
 
+  /**
+   * Determines the sparsity pattern of the Jacobian and compiles its non-zero elements.
+   * If the sparse Jacobian was already compiled, this method does nothing.
+   */
+
+  void compileSparseJacobian()
+
+  {
+    if(hasSparseJacobian) return;
+
+    this->foldUpdateVector();
+
+    // Differentiate and compile non-zero elements only:
+    SparseJacobianGenerator jacobian(updateVector, sseModel.stateIndex);
+    jacobianPattern = jacobian.pattern();
+    typename SysEngine::Compiler jacobian_compiler(lookup);
+    jacobian_compiler.setCode(&sparseJacobianCode);
+    jacobian_compiler.compileGenerated(jacobian, num_processes);
+    jacobian_compiler.finalize(opt_level);
+
+    hasSparseJacobian = true;
+  }
+
+
+protected:
+  /**
+   * Folds all constants in the update vector, if not done yet.
+   */
+  void foldUpdateVector()
+  {
+    if (updateVectorFolded) return;
+
+    Trafo::ConstantFolder constants(sseModel);
+    updateVector = ICs.apply(constants.apply(updateVector));
+    updateVectorFolded = true;
+  }
+
+  /**
+   * Tries to load the compiled system (and Jacobian) from the @c CompiledModelCache.
+   * @returns true on success.
+   */
+  bool loadFromCache(size_t num_threads)
+  {
+    if (! (CodeSerializer<typename SysEngine::Code>::isSerializable() &&
+           CodeSerializer<typename JacEngine::Code>::isSerializable())) {
+      return false;
+    }
+
+    // Identify the compiled system by the model, the analysis and the options of the compiler:
+    std::stringstream analysis;
+    analysis << typeid(Sys).name() << " " << typeid(SysEngine).name() << " "
+             << typeid(JacEngine).name() << " " << opt_level << " " << num_threads << " "
+             << CacheTag<Sys>::get(sseModel);
+    cacheKey = CompiledModelCache::makeKey(sseModel, analysis.str());
+
+    std::string data;
+    if (! CompiledModelCache::get().lookup(cacheKey, data)) {
+      return false;
+    }
+
+    // The code is only replaced if it was read successfully:
+    std::istringstream buffer(data);
+    try {
+      CodeSerializer<typename SysEngine::Code>::deserialize(bytecode, buffer);
+    } catch (Exception &err) {
+      // Invalid entry -> compile system
+      return false;
+    }
+
+    try {
+      if (1 == buffer.get()) {
+        CodeSerializer<typename JacEngine::Code>::deserialize(jacobianCode, buffer);
+        hasJacobian = true;
+      }
+    } catch (Exception &err) {
+      // Invalid Jacobian -> compile on demand
+    }
+
+    return true;
+  }
+
+  /**
+   * Stores the compiled system (and Jacobian if compiled) in the @c CompiledModelCache.
+   */
+  void storeInCache()
+  {
+    if (0 == cacheKey.size()) return;
+
+    std::ostringstream buffer;
+    CodeSerializer<typename SysEngine::Code>::serialize(bytecode, buffer);
+    buffer.put(hasJacobian ? 1 : 0);
+    if (hasJacobian)
+      CodeSerializer<typename JacEngine::Code>::serialize(jacobianCode, buffer);
+    CompiledModelCache::get().store(cacheKey, buffer.str());
+  }
+
+
+public:
   /**
    * Evaluates the joint ODE of the system size expansion.
    */
@@ -291,6 +507,30 @@ public:
   }
 
 
+  /**
+   * Evaluates the Jacobian of the ODEs at the given state into a sparse matrix. The matrix is
+   * (re-) initialized with the sparsity pattern of the Jacobian if its pattern does not match.
+   */
+
+  inline void evaluateJacobian(const Eigen::VectorXd &state, double t,
+                               Eigen::SparseMatrix<double> &jacobian)
+
+  {
+    // ensures that the sparse Jacobian was compiled
+    if (! hasSparseJacobian) {
+      compileSparseJacobian();
+    }
+
+    if ((jacobian.nonZeros() != jacobianPattern.nonZeros()) ||
+        (jacobian.rows() != jacobianPattern.rows()) || (! jacobian.isCompressed())) {
+      jacobian = jacobianPattern;
+    }
+
+    // Evaluate the non-zero elements directly into the storage of the matrix:
+    this->sparse_jacobian_interpreter.run(state.data(), jacobian.valuePtr());
+  }
+
+
   /**
    * Evaluates the Jacobian of the ODEs at the given state.
    */
@@ -308,6 +548,32 @@ public:
       this->jacobian_interpreter.run(state, jac);
   }
 
+  /**
+   * Constructs a steady-state event bound to this interpreter (implements the
+   * @c SSEInterpreterInterface).
+   */
+
+  virtual ODE::Event *createSteadyStateEvent(double epsilon_abs, double epsilon_rel,
+                                             size_t dimension=0)
+
+  {
+    return new ODE::SteadyStateEvent<GenericSSEinterpreter>(
+          *this, epsilon_abs, epsilon_rel, dimension);
+  }
+
+  /**
+   * Evaluates the ODEs and their Jacobian at the given state (implements the
+   * @c SSEInterpreterInterface).
+   */
+
+  virtual void linearize(const Eigen::VectorXd &state, double t,
+                         Eigen::VectorXd &dx, Eigen::MatrixXd &jacobian)
+
+  {
+    this->evaluate(state, t, dx);
+    this->evaluateJacobian(state, t, jacobian);
+  }
+
   /**
    * Evaluates the initial state.
    */
@@ -343,9 +609,11 @@ class SSEinterpreter :
 {
 public:
   SSEinterpreter(Sys &model, size_t opt_level,
-                 size_t num_threads=OpenMP::getMaxThreads(), bool compileJac = false)
+                 size_t num_threads=OpenMP::getMaxThreads(), bool compileJac = false,
+                 size_t num_processes=1)
     : GenericSSEinterpreter<Sys, Eval::bcimp::Engine<Eigen::VectorXd, Eigen::VectorXd>,
-      Eval::bcimp::Engine<Eigen::VectorXd, Eigen::MatrixXd> >(model, opt_level, num_threads, compileJac)
+      Eval::bcimp::Engine<Eigen::VectorXd, Eigen::MatrixXd> >(
+        model, opt_level, num_threads, compileJac, num_processes)
   {
     // Pass...
   }
@@ -14,13 +14,17 @@ namespace Models {
 
 /**
 * Extension of the SteadyStateAnalysis to perform a Parameter scan.
+*
+* As the steady state is determined for many parameter sets, the @c NLEsolve::QuasiNewton solver is
+* used, which reuses the factorization of the Jacobian across iterations.
 */
 
 template <class M,
           class VectorEngine = Eval::bci::Engine<Eigen::VectorXd, Eigen::VectorXd>,
           class MatrixEngine = Eval::bci::Engine<Eigen::VectorXd, Eigen::MatrixXd> >
 class ParameterScan
-        : public SteadyStateAnalysis<M, VectorEngine, MatrixEngine>
+        : public SteadyStateAnalysis<M, VectorEngine, MatrixEngine,
+                                     NLEsolve::QuasiNewton<M, VectorEngine, MatrixEngine> >
 {
 
 protected:
@@ -62,7 +66,8 @@ public:
     * Constructor
     */
     ParameterScan(M &model, size_t iter=100, double epsilon=1.e-9, double t_max=1e9, double dt=1.e-1, size_t opt_level = 0)
-      : SteadyStateAnalysis<M, VectorEngine, MatrixEngine>(model,iter,epsilon,t_max,dt),
+      : SteadyStateAnalysis<M, VectorEngine, MatrixEngine,
+                            NLEsolve::QuasiNewton<M, VectorEngine, MatrixEngine> >(model,iter,epsilon,t_max,dt),
         computeLNA(model.lnaLength()), computeIOS(model.iosLength()),
         index(this->sseModel.stateIndex),
         opt_level(opt_level),
@@ -10,11 +10,15 @@ namespace Models {
 
 /**
 * Performs the Steady State Analysis on a model.
+*
+* The Newton-type solver used by the @c NLEsolve::HybridSolver is given by the template parameter
+* @c Newton.
 */
 
 template <class M,
           class VectorEngine = Eval::bci::Engine<Eigen::VectorXd, Eigen::VectorXd>,
-          class MatrixEngine = Eval::bci::Engine<Eigen::VectorXd, Eigen::MatrixXd> >
+          class MatrixEngine = Eval::bci::Engine<Eigen::VectorXd, Eigen::MatrixXd>,
+          class Newton = NLEsolve::NewtonRaphson<M, VectorEngine, MatrixEngine> >
 class SteadyStateAnalysis
 {
 protected:
@@ -30,7 +34,7 @@ protected:
     /**
      * An instance of a nonlinear solver.
      */
-    NLEsolve::HybridSolver<M, VectorEngine, MatrixEngine> solver;
+    NLEsolve::HybridSolver<M, VectorEngine, MatrixEngine, Newton> solver;
 
     /**
      * Holds maximum the maximum integrate time.
@@ -42,13 +46,36 @@ protected:
      */
     double min_time_step;
 
+    /**
+     * Solves for the LNA covariances, its factorization is reused for the IOS covariances.
+     */
+    NLEsolve::PrecisionSolve lnaSolver;
+
+    /**
+     * Solves for the EMRE and IOS corrections of the means, which share the Jacobian of the REs.
+     */
+    NLEsolve::PrecisionSolve emreSolver;
+
+    /**
+     * Solves for the third moments.
+     */
+    NLEsolve::PrecisionSolve thirdMomentSolver;
+
+    /**
+     * Solves the IOS stage at once, if it is not block triangular.
+     */
+    NLEsolve::PrecisionSolve iosSolver;
+
 public:
 
     /**
     * Constructor
     */
     SteadyStateAnalysis(M &model)
-      : sseModel(model), solver(model), max_time(1e9), min_time_step(1e-1)
+      : sseModel(model), solver(model), max_time(1e9), min_time_step(1e-1),
+        lnaSolver(model.lnaLength()), emreSolver(model.numIndSpecies()),
+        thirdMomentSolver(model.numIndSpecies()*(model.numIndSpecies()+1)*(model.numIndSpecies()+2)/6),
+        iosSolver(model.iosLength())
 
     {
 
@@ -79,7 +106,10 @@ public:
     * Constructor
     */
     SteadyStateAnalysis(M &model, size_t iter, double epsilon, double t_max=1e9, double dt=1e-1)
-      : sseModel(model), solver(model), max_time(t_max), min_time_step(dt)
+      : sseModel(model), solver(model), max_time(t_max), min_time_step(dt),
+        lnaSolver(model.lnaLength()), emreSolver(model.numIndSpecies()),
+        thirdMomentSolver(model.numIndSpecies()*(model.numIndSpecies()+1)*(model.numIndSpecies()+2)/6),
+        iosSolver(model.iosLength())
 
     {
 
@@ -127,6 +157,33 @@ public:
           this->solver.parameters.maxIterations = maxiter;
     }
 
+    /**
+    * Set the strategy to reuse the Jacobian, ignored by the @c NLEsolve::NewtonRaphson solver.
+    */
+    void setStrategy(NLEsolve::QuasiNewtonStrategy strategy)
+
+    {
+          this->solver.setStrategy(strategy);
+    }
+
+    /**
+    * Returns the number of evaluations of the Jacobian during the last steady state search.
+    */
+    size_t getJacobianEvaluations() const
+
+    {
+          return this->solver.getJacobianEvaluations();
+    }
+
+    /**
+    * Returns the number of factorizations of the Jacobian during the last steady state search.
+    */
+    size_t getFactorizations() const
+
+    {
+          return this->solver.getFactorizations();
+    }
+
     /**
      * Solves rate equations for steady state concentrations in @c conc and returns the number
      * of function evalutions.
@@ -163,6 +220,45 @@ public:
 
     }
 
+    /**
+     * Solves the linear system \f$Bx=-A\f$ of the given stage, using the matrix @c B last passed to
+     * the @c linearSolver, and logs the condition estimate and backward error of the solution.
+     */
+    const Eigen::VectorXd &
+    solveLinear(const char *stage, NLEsolve::PrecisionSolve &linearSolver, const Eigen::VectorXd &A)
+
+    {
+        const Eigen::VectorXd &x = linearSolver.solve(-A, solver.parameters.relError);
+
+        bool precise = linearSolver.converged(solver.parameters.relError);
+        Utils::Message message = LOG_MESSAGE(precise ? Utils::Message::INFO : Utils::Message::WARN);
+        message << stage << " steady state: condition estimate " << linearSolver.conditionEstimate()
+                << ", backward error " << linearSolver.residual() << " after "
+                << linearSolver.refinements() << " refinement(s).";
+        if (! precise) message << " The required precision was not reached.";
+        Utils::Logger::get().log(message);
+
+        return x;
+    }
+
+    /**
+     * Returns true if the blocks of @c B above its diagonal blocks of the given sizes vanish.
+     */
+    static bool
+    isBlockLowerTriangular(const Eigen::MatrixXd &B, const size_t *sizes, size_t numBlocks)
+
+    {
+        size_t offset = 0;
+        for (size_t k=0; k<numBlocks; k++) {
+            offset += sizes[k];
+            if (offset > size_t(B.rows())) return false;
+            size_t rest = B.rows()-offset;
+            if ((0 < rest) && (B.block(offset-sizes[k], offset, sizes[k], rest).array() != 0).any())
+                return false;
+        }
+        return offset == size_t(B.rows());
+    }
+
     /**
      * Solves for steady state of the reduced state vector and returns number of function evaluations
      * used.
@@ -195,7 +291,8 @@ public:
         }
 
 
-        x.segment(offset,lnaLength) = NLEsolve::PrecisionSolve::precisionSolve(B, -A, solver.parameters.relError);
+        lnaSolver.factorize(B);
+        x.segment(offset,lnaLength) = solveLinear("LNA", lnaSolver, A);
 
         // substitute LNA
         subs_table.clear();
@@ -300,7 +397,30 @@ public:
             }
         }
 
-        x.tail(sseLength-lnaLength) = NLEsolve::PrecisionSolve::precisionSolve(B,-A,solver.parameters.relError);
+        // The IOS stage is block lower triangular in the EMRE, the third moments, the IOS covariances
+        // and the IOS corrections to the EMRE. If so, the blocks are solved by forward substitution.
+        // The EMRE and its IOS correction share the Jacobian of the REs and the IOS covariances
+        // share the matrix of the LNA covariances, hence these factorizations get reused.
+        size_t blocks[4] = { offset, offset*(offset+1)*(offset+2)/6, lnaLength, offset };
+        if (! isBlockLowerTriangular(B, blocks, 4)) {
+            iosSolver.factorize(B);
+            x.tail(sseLength-lnaLength) = solveLinear("IOS", iosSolver, A);
+            return;
+        }
+
+        NLEsolve::PrecisionSolve *solvers[4] = { &emreSolver, &thirdMomentSolver, &lnaSolver, &emreSolver };
+        const char *stages[4] = { "EMRE", "Third moment", "IOS covariance", "IOS EMRE" };
+        Eigen::VectorXd y(sseLength-lnaLength), rhs;
+        size_t start = 0;
+        for (size_t k=0; k<4; k++) {
+            // the last two blocks reuse the factorizations of the EMRE and LNA if possible
+            if (2 > k) solvers[k]->factorize(B.block(start, start, blocks[k], blocks[k]));
+            else solvers[k]->update(B.block(start, start, blocks[k], blocks[k]));
+            rhs = A.segment(start, blocks[k]) + B.block(start, 0, blocks[k], start)*y.head(start);
+            y.segment(start, blocks[k]) = solveLinear(stages[k], *solvers[k], rhs);
+            start += blocks[k];
+        }
+        x.tail(sseLength-lnaLength) = y;
 
     }
 
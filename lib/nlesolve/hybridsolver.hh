@@ -2,7 +2,9 @@
 #define __INA_NLESOLVE_HYBRIDSOLVER_HH
 
 #include "newtonraphson.hh"
+#include "quasinewton.hh"
 #include "../ode/lsoda.hh"
+#include "../ode/event.hh"
 
 #include "../models/ssebasemodel.hh"
 #include "../models/initialconditions.hh"
@@ -13,13 +15,22 @@ namespace NLEsolve{
 /**
  * A hybrid of the ODE integrator LSODA and the Newton-Raphson method for nonlinear algebraic equations.
  *
+ * If the Newton-Raphson method fails, the system is integrated for a while and the Newton-Raphson
+ * method is tried again. The integration stops early, once the system relaxed to a steady state
+ * (see @c ODE::SteadyStateEvent), i.e. once the rates are smaller than the absolute error of the
+ * Newton-Raphson method.
+ *
+ * The Newton-type solver is given by the template parameter @c Newton, i.e. the
+ * @c NewtonRaphson or @c QuasiNewton solver.
+ *
  * @ingroup nlesolve
  */
 template <class Sys,
           class VectorEngine=Eval::bci::Engine<Eigen::VectorXd>,
-          class MatrixEngine=Eval::bci::Engine<Eigen::VectorXd,Eigen::MatrixXd> >
+          class MatrixEngine=Eval::bci::Engine<Eigen::VectorXd,Eigen::MatrixXd>,
+          class Newton=NewtonRaphson<Sys, VectorEngine, MatrixEngine> >
 class HybridSolver
-    : public NewtonRaphson<Sys, VectorEngine, MatrixEngine>,
+    : public Newton,
       protected ODE::LSODA
 {
 
@@ -45,7 +56,7 @@ public:
    * @param epsilon_abs Specifies the absolute error for the step.
    */
   HybridSolver(Sys &system)
-      : NewtonRaphson<Sys, VectorEngine, MatrixEngine>(system), LSODA(),
+      : Newton(system), LSODA(),
         istate(1)
   {
 
@@ -72,12 +83,34 @@ public:
   };
 
 
-  void ODEStep(Eigen::VectorXd &state, double t, double dt)
+  /**
+   * Integrates the system for the given duration, stops early if a steady state was reached.
+   *
+   * @returns true if the system reached a steady state.
+   */
+  bool ODEStep(Eigen::VectorXd &state, double t, double dt)
   {
+      // Checks the rates of the independent species only:
+      ODE::SteadyStateEvent< HybridSolver<Sys, VectorEngine, MatrixEngine, Newton> > steadyState(
+            *this, this->parameters.absError, 0, getDimension());
 
+      double t_end = t+dt;
       istate = 1;  // force initial call.
-      lsoda(getDimension(), state.data()-1, &t, t+dt, 2, rtolwork, atolwork, 1, &istate, 0, 2);
+      while (t < t_end) {
+        // Perform a single step:
+        lsoda(getDimension(), state.data()-1, &t, t_end, 2, rtolwork, atolwork, 2, &istate, 0, 2);
+        if (0 > istate) { return false; }
+        // Check for steady state:
+        if (0 >= steadyState.evaluate(state, t)) { return true; }
+      }
+
+      return false;
+  }
 
+  /** Evaluates the rates of the system. */
+  inline void evaluate(const Eigen::VectorXd &state, double t, Eigen::VectorXd &rates)
+  {
+      this->LSODAint.run(state, rates);
   }
 
   virtual void evalODE(double t, double state[], double dx[], int nsize)
@@ -98,13 +131,15 @@ public:
   }
 
   /**
-   * Runs the solver.
+   * Runs the solver, counts the evaluations and factorizations of the Jacobian of all Newton
+   * iterations.
    */
   Status
   solve(Eigen::VectorXd &state, double maxTime=1.e9, double dt=0.1, const Models::ParameterSet &parameters=Models::ParameterSet())
   {
 
       if(maxTime<dt) maxTime=dt;
+      this->resetStatistics();
 
       for(double t=0.;t<maxTime; t+=dt, dt*=10)
       {
@@ -112,7 +147,7 @@ public:
           Utils::Message message = LOG_MESSAGE(Utils::Message::INFO);
           message << "Try Newton step ... ";
 
-          Status lcheck = NewtonRaphson<Sys, VectorEngine, MatrixEngine>::solve(state);
+          Status lcheck = Newton::solve(state);
 
           switch(lcheck)
           {
@@ -139,12 +174,17 @@ public:
               Utils::Logger::get().log(message);
 
               if(t==0) {
-                  //#pragma omp critical(ginac)
+                  // GiNaC is not thread-safe (see Models::MultiStartAnalysis):
+#pragma omp critical(ginac)
                   this->setupLSODA(parameters);
               }
 
               // Do ODE step of length dt
-              ODEStep(state,0,dt);
+              if (ODEStep(state,0,dt)) {
+                Utils::Message message = LOG_MESSAGE(Utils::Message::INFO);
+                message << "Integration reached steady state.";
+                Utils::Logger::get().log(message);
+              }
 
           }
 
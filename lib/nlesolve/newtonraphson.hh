@@ -33,6 +33,15 @@ protected:
 
    PrecisionSolve LinSolver;
 
+   /** Holds the state of the last iteration. */
+   Eigen::VectorXd state_old;
+   /** Holds the steepest descent direction. */
+   Eigen::VectorXd nablaf;
+   /** Holds the Newton update. */
+   Eigen::VectorXd dx;
+   /** Holds the right hand side of the linear system. */
+   Eigen::VectorXd rhs;
+
 public:
 
    struct params {
@@ -77,7 +86,8 @@ public:
 
   NewtonRaphson(T &model)
       : NLEsolver<T, VectorEngine, MatrixEngine>(model),
-        LinSolver(model.numIndSpecies()),
+        LinSolver(model.numIndSpecies()), state_old(), nablaf(model.numIndSpecies()),
+        dx(model.numIndSpecies()), rhs(model.numIndSpecies()),
         parameters(model.numIndSpecies())
 
   {
@@ -105,11 +115,6 @@ public:
 
   {
 
-      Eigen::VectorXd state_old;
-
-      Eigen::VectorXd nablaf;
-      Eigen::VectorXd dx;
-
       // Calculate maximum step size heuristic
       const double stpmax=this->parameters.STPMX*std::max(state.head(this->dim).norm(),double(this->dim));
 
@@ -181,28 +186,47 @@ public:
 
   {
 
-      double f,fold;
-
-      double test,temp,den;
-
-      Eigen::VectorXd nablaf;
-      Eigen::VectorXd dx;
-
       // Construct Jacobian matrix
       this->interpreter.run(inState,this->ODEs);
       this->jacobian_interpreter.run(inState,this->JacobianM);
+      this->numJacobians++;
+
+      // Solve JacobianM*dx=-REs to obtain the update vector
+      rhs = -this->ODEs;
+      dx = LinSolver.solve(this->JacobianM, rhs);
+      this->numFactorizations++;
+
+      return searchStep(inState, outState, stpmax);
+
+  }
+
+
+  /**
+   * @brief Performs the linesearch along the update vector @c dx.
+   *
+   * Expects the ODEs and the Jacobian to be evaluated at @c inState.
+   *
+   * @param inState : initial state
+   * @param outState : output state updated on exit
+   * @param stpmax : Maximum number of steps used in linesearch
+   */
+  LineSearchStatus
+  searchStep(const Eigen::VectorXd &inState, Eigen::VectorXd &outState, double stpmax)
+
+  {
+
+      double f,fold;
+
+      double test,temp,den;
 
       // Evaluate objective function f
       f = .5*(this->ODEs.squaredNorm());
       // Calculate steepest descent direction
-      nablaf = this->JacobianM.transpose()*this->ODEs;
+      nablaf.noalias() = this->JacobianM.transpose()*this->ODEs;
 
       // Store also old value of objective function f
       fold = f;
 
-      // Solve JacobianM*dx=-REs to obtain the update vector
-      dx = LinSolver.solve(this->JacobianM, -this->ODEs);
-
       // Perform linesearch
       LineSearchStatus lcheck;
       switch(parameters.linesearch)
@@ -10,6 +10,7 @@
 #include <iostream>
 
 #include "newtonraphson.hh"
+#include "quasinewton.hh"
 #include "hybridsolver.hh"
 #include "precisionsolve.hh"
 
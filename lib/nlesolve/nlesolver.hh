@@ -26,6 +26,15 @@ enum LineSearchStatus {
     RoundOffProblem = -1,
 };
 
+/**
+ * Strategies to reuse the Jacobian (see @c NLEsolver::setStrategy).
+ */
+enum QuasiNewtonStrategy {
+    ChordMethod = 0,       ///< Keeps the Jacobian until the iteration stagnates.
+    ShamanskiiMethod = 1,  ///< Re-evaluates the Jacobian every few iterations.
+    BroydenMethod = 2,     ///< Updates the inverse of the Jacobian by rank-1 updates.
+};
+
 template<class T,
          class VectorEngine=Eval::bci::Engine<Eigen::VectorXd>,
          class MatrixEngine=Eval::bci::Engine<Eigen::VectorXd,Eigen::MatrixXd> >
@@ -42,6 +51,11 @@ protected:
     Eigen::VectorXd ODEs;
     Eigen::MatrixXd JacobianM;
 
+    /** Number of evaluations of the Jacobian since the last call to @c resetStatistics. */
+    size_t numJacobians;
+    /** Number of factorizations of the Jacobian since the last call to @c resetStatistics. */
+    size_t numFactorizations;
+
      /**
      * The bytecode interpreter instance to evaluate the ODEs.
      */
@@ -66,7 +80,8 @@ protected:
 public:
 
      NLEsolver(T &model)
-       : model(model), dim(model.numIndSpecies()), ODEs(dim), JacobianM(dim,dim)
+       : model(model), dim(model.numIndSpecies()), ODEs(dim), JacobianM(dim,dim),
+         numJacobians(0), numFactorizations(0)
      {
        // Pass...
      }
@@ -94,6 +109,41 @@ public:
          return this->iterations;
      }
 
+     /**
+      * Returns the number of evaluations of the Jacobian since the last call to
+      * @c resetStatistics.
+      */
+     size_t getJacobianEvaluations() const
+     {
+         return this->numJacobians;
+     }
+
+     /**
+      * Returns the number of factorizations of the Jacobian since the last call to
+      * @c resetStatistics.
+      */
+     size_t getFactorizations() const
+     {
+         return this->numFactorizations;
+     }
+
+     /**
+      * Resets the number of evaluations and factorizations of the Jacobian.
+      */
+     void resetStatistics()
+     {
+         this->numJacobians = 0; this->numFactorizations = 0;
+     }
+
+     /**
+      * Sets the strategy to reuse the Jacobian. Solvers, that evaluate and factorize the Jacobian
+      * in every iteration (i.e. the @c NewtonRaphson solver), ignore the strategy.
+      */
+     virtual void setStrategy(QuasiNewtonStrategy strategy)
+     {
+         // Pass...
+     }
+
      /**
       * Every solver has to implement its own method...
       */
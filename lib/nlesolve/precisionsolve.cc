@@ -1,31 +1,184 @@
 #include "precisionsolve.hh"
+#include <limits>
 
 using namespace iNA::NLEsolve;
 
 PrecisionSolve::PrecisionSolve(size_t size) :
-    luPP(size), luFP(size,size), x(size)
+    B(size,size), luPP(size), luFP(size,size), qr(size,size), x(size), r(size), dx(size),
+    rhs(size), normB(0), _factorized(false), _method(PARTIAL_PIVOTING_LU), _residual(0), _refinements(0),
+    _condition(-1)
 
 {
     // Pass...
 }
 
-const Eigen::VectorXd &
-PrecisionSolve::solve(const Eigen::MatrixXd &B, const Eigen::VectorXd &A, double epsilon)
+
+void
+PrecisionSolve::factorize(const Eigen::MatrixXd &B)
 
 {
+    this->B = B; r.resize(B.rows());
+    normB = B.cwiseAbs().rowwise().sum().maxCoeff();
 
     // this is fast
     luPP.compute(B);
-    x = luPP.solve(A);
+    _factorized = true;
+    _method = PARTIAL_PIVOTING_LU;
+    _condition = -1;
+}
+
+
+bool
+PrecisionSolve::update(const Eigen::MatrixXd &B, double tolerance)
+
+{
+    // Factorize B if the current factorization does not fit
+    if ((! _factorized) || (B.rows() != this->B.rows()) || (B.cols() != this->B.cols()) ||
+        ((B-this->B).cwiseAbs().rowwise().sum().maxCoeff() > tolerance*normB)) {
+        factorize(B);
+        return false;
+    }
+
+    // Keep the factorization, the refinement accounts for the difference
+    this->B = B;
+    normB = B.cwiseAbs().rowwise().sum().maxCoeff();
+    return true;
+}
+
+
+const Eigen::VectorXd &
+PrecisionSolve::solve(const Eigen::VectorXd &A, double epsilon)
+
+{
+    if (refine(A, epsilon)) return x;
 
-    if(!(B*x).isApprox(A, epsilon))
-    {
-       // this is slower
-      luFP.compute(B);
-      x = luFP.solve(A);
+    // Escalate to full pivoting, this is slower
+    if (PARTIAL_PIVOTING_LU == _method) {
+        luFP.compute(B); _method = FULL_PIVOTING_LU; _condition = -1;
+        if (refine(A, epsilon)) return x;
+    }
+
+    // Escalate to QR, this is even slower
+    if (FULL_PIVOTING_LU == _method) {
+        qr.compute(B); _method = COL_PIVOTING_QR; _condition = -1;
+        refine(A, epsilon);
     }
 
     return x;
+}
+
+
+void
+PrecisionSolve::solve(const Eigen::MatrixXd &A, Eigen::MatrixXd &X, double epsilon)
+
+{
+    X.resize(A.rows(), A.cols());
+    double residual = 0;
+    for (int j=0; j<A.cols(); j++) {
+        rhs = A.col(j);
+        X.col(j) = solve(rhs, epsilon);
+        residual = std::max(residual, _residual);
+    }
+    _residual = residual;
+}
+
+
+const Eigen::VectorXd &
+PrecisionSolve::solve(const Eigen::MatrixXd &B, const Eigen::VectorXd &A, double epsilon)
+
+{
+    factorize(B);
+    return solve(A, epsilon);
+}
+
+
+double
+PrecisionSolve::conditionEstimate()
+
+{
+    if (0 > _condition) {
+        double rcond = 0;
+        switch (_method) {
+        case PARTIAL_PIVOTING_LU: rcond = luPP.rcond(); break;
+        case FULL_PIVOTING_LU: rcond = luFP.rcond(); break;
+        case COL_PIVOTING_QR:
+          // The diagonal of R is ordered by decreasing magnitude:
+          if (0 < qr.rank()) {
+            int n = std::min(qr.matrixR().rows(), qr.matrixR().cols());
+            rcond = std::abs(qr.matrixR()(n-1,n-1))/std::abs(qr.matrixR()(0,0));
+          }
+          break;
+        }
+        _condition = (0 < rcond) ? 1./rcond : std::numeric_limits<double>::infinity();
+    }
+    return _condition;
+}
+
 
+Eigen::VectorXd
+PrecisionSolve::precisionSolve(const Eigen::MatrixXd &B, const Eigen::VectorXd &A, double epsilon)
+
+{
+    PrecisionSolve solver(B.rows());
+    return solver.solve(B, A, epsilon);
 }
 
+
+bool
+PrecisionSolve::refine(const Eigen::VectorXd &A, double epsilon)
+
+{
+    apply(A, x);
+    _refinements = 0;
+    _residual = backwardError(A);
+
+    while ((_residual > epsilon) && (_refinements < maxRefinements)) {
+        apply(r, dx);
+        x += dx;
+        _refinements++;
+
+        // Stop if the refinement stagnates:
+        double residual = backwardError(A);
+        if (! (residual < 0.5*_residual)) {
+            // Undo the last step if it made things worse:
+            if (! (residual <= _residual)) { x -= dx; backwardError(A); }
+            else { _residual = residual; }
+            break;
+        }
+        _residual = residual;
+    }
+
+    return _residual <= epsilon;
+}
+
+
+void
+PrecisionSolve::apply(const Eigen::VectorXd &b, Eigen::VectorXd &y)
+
+{
+    switch (_method) {
+    case PARTIAL_PIVOTING_LU: y = luPP.solve(b); break;
+    case FULL_PIVOTING_LU: y = luFP.solve(b); break;
+    case COL_PIVOTING_QR: y = qr.solve(b); break;
+    }
+}
+
+
+double
+PrecisionSolve::backwardError(const Eigen::VectorXd &A)
+
+{
+    // Accumulate the residual A - Bx in extended precision:
+    for (int i=0; i<B.rows(); i++) {
+        long double sum = A(i);
+        for (int j=0; j<B.cols(); j++) {
+            sum -= (long double)(B(i,j))*(long double)(x(j));
+        }
+        r(i) = double(sum);
+    }
+
+    if (! x.allFinite() || ! r.allFinite()) return std::numeric_limits<double>::infinity();
+    double den = normB*x.lpNorm<Eigen::Infinity>() + A.lpNorm<Eigen::Infinity>();
+    double err = r.lpNorm<Eigen::Infinity>();
+    return (0 < den) ? err/den : err;
+}
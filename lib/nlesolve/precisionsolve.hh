@@ -8,41 +8,117 @@ namespace iNA{
 namespace NLEsolve{
 
 /** Solves a linear system of equations.
- * Simple wrapper about Eigen's LU decomposition without reallocation and internal storage of
- * result vector. */
+ *
+ * The system matrix is factorized once by an LU decomposition with partial pivoting (see
+ * @c factorize), the factorization is then reused for any number of right hand sides (see
+ * @c solve). Each solution is improved by iterative refinement, where the residual is accumulated
+ * in extended precision. Only if the refinement fails to reduce the backward error
+ * \f$\|A-Bx\|_\infty/(\|B\|_\infty\|x\|_\infty+\|A\|_\infty)\f$ below the required precision, the
+ * solver escalates to the LU decomposition with full pivoting and finally to the QR decomposition
+ * with column pivoting. The escalated decomposition is kept for the following right hand sides.
+ *
+ * All decompositions and vectors are allocated once by the constructor. */
 class PrecisionSolve
 {
+public:
+  /** The decompositions used by the solver. */
+  typedef enum {
+    PARTIAL_PIVOTING_LU = 0,  ///< LU decomposition with partial pivoting.
+    FULL_PIVOTING_LU,         ///< LU decomposition with full pivoting.
+    COL_PIVOTING_QR           ///< QR decomposition with column pivoting.
+  } Method;
+
+  /** Maximum number of refinement steps per solution. */
+  static const size_t maxRefinements = 10;
+
+protected:
+  /** Holds a copy of the system matrix. */
+  Eigen::MatrixXd B;
   /** LU decomposition with partial pivoting. */
   Eigen::PartialPivLU<Eigen::MatrixXd> luPP;
   /** LU decomposition with full pivoting. */
   Eigen::FullPivLU<Eigen::MatrixXd> luFP;
+  /** QR decomposition with column pivoting. */
+  Eigen::ColPivHouseholderQR<Eigen::MatrixXd> qr;
   /** Temporary variable for the solution. */
   Eigen::VectorXd x;
+  /** Temporary variable for the residual. */
+  Eigen::VectorXd r;
+  /** Temporary variable for the correction. */
+  Eigen::VectorXd dx;
+  /** Temporary variable for a right hand side. */
+  Eigen::VectorXd rhs;
+  /** Holds the infinity norm of the system matrix. */
+  double normB;
+  /** Is true once a system matrix was factorized. */
+  bool _factorized;
+  /** The decomposition currently used. */
+  Method _method;
+  /** Holds the backward error of the last solution. */
+  double _residual;
+  /** Holds the number of refinement steps of the last solution. */
+  size_t _refinements;
+  /** Holds the condition estimate, computed on demand. */
+  double _condition;
 
 public:
   /** Constructs a solver for a @c size -dimensional system. */
   PrecisionSolve(size_t size);
 
-  /** Solves \f$Bx=A\f$ using the partial pivoted LU decomposition.
+  /** Factorizes the system matrix @c B using the LU decomposition with partial pivoting. */
+  void factorize(const Eigen::MatrixXd &B);
+
+  /** Replaces the system matrix by @c B but keeps the current factorization, if @c B differs from
+   * the factorized matrix by at most @c tolerance relative to its infinity norm. The iterative
+   * refinement then accounts for the difference. Otherwise @c B gets factorized. Returns true if
+   * the factorization was kept. */
+  bool update(const Eigen::MatrixXd &B, double tolerance=1.e-10);
+
+  /** Solves \f$Bx=A\f$ using the factorization of the last call to @c factorize.
+   * @param A Specifies the vector of results.
+   * @param epsilon Specifies the required (relative) precision. */
+  const Eigen::VectorXd &solve(const Eigen::VectorXd &A, double epsilon=1.e-9);
+
+  /** Solves \f$BX=A\f$ for several right hand sides (columns of @c A) using the factorization of
+   * the last call to @c factorize. */
+  void solve(const Eigen::MatrixXd &A, Eigen::MatrixXd &X, double epsilon=1.e-9);
+
+  /** Factorizes @c B and solves \f$Bx=A\f$.
    * @param B Specifies the system matrix.
    * @param A Specifies the vector of results.
-   * @param epsilon Specifies the required (absolute) precision. */
+   * @param epsilon Specifies the required (relative) precision. */
   const Eigen::VectorXd &solve(const Eigen::MatrixXd &B, const Eigen::VectorXd &A, double epsilon=1.e-9);
 
+  /** Returns the decomposition used for the last solution. */
+  inline Method method() const { return _method; }
+
+  /** Returns the backward error of the last solution. */
+  inline double residual() const { return _residual; }
+
+  /** Returns the number of refinement steps of the last solution. */
+  inline size_t refinements() const { return _refinements; }
+
+  /** Returns true if the last solution reached the required precision. */
+  inline bool converged(double epsilon=1.e-9) const { return _residual <= epsilon; }
+
+  /** Returns an estimate of the condition number of the factorized matrix. For the LU
+   * decompositions, this is the reciprocal of their estimate of the reciprocal condition number
+   * (1-norm), for the QR decomposition, the ratio of the largest and smallest diagonal element of R. */
+  double conditionEstimate();
+
   /** Static variant of @c solve. */
-  static inline Eigen::VectorXd
-  precisionSolve(const Eigen::MatrixXd &B, const Eigen::VectorXd &A, double epsilon=1.e-9) {
-      // First, try to solve using LU w partial pivoting, this is fast
-      Eigen::VectorXd x = B.lu().solve(A);
-      // If not precise enougth -> use full pivoting
-      if((B*x).isApprox(A,epsilon)) {
-         // this is rather slow
-         Eigen::FullPivLU<Eigen::MatrixXd> LU(B);
-         x = LU.solve(A);
-      }
-
-      return x;
-  }
+  static Eigen::VectorXd
+  precisionSolve(const Eigen::MatrixXd &B, const Eigen::VectorXd &A, double epsilon=1.e-9);
+
+protected:
+  /** Refines @c x using the current decomposition, returns true on success. */
+  bool refine(const Eigen::VectorXd &A, double epsilon);
+
+  /** Applies the current decomposition to @c b. */
+  void apply(const Eigen::VectorXd &b, Eigen::VectorXd &y);
+
+  /** Computes the backward error of @c x, the residual is stored in @c r. */
+  double backwardError(const Eigen::VectorXd &A);
 };
 
 }}
@@ -0,0 +1,295 @@
+#ifndef __INA_NLESOLVE_QUASINEWTON_HH
+#define __INA_NLESOLVE_QUASINEWTON_HH
+
+#include "newtonraphson.hh"
+
+namespace iNA {
+namespace NLEsolve {
+
+
+/**
+ * Nonlinear algebraic equation solver that reuses the factorization of the Jacobian across
+ * iterations.
+ *
+ * The Newton-Raphson method evaluates and factorizes the Jacobian in every iteration. This solver
+ * keeps the LU factorization of the Jacobian and performs simplified Newton steps with it
+ * \cite kelley1995. Depending on the strategy, the Jacobian is kept until the iteration stagnates
+ * (chord method), re-evaluated every @c jacobianInterval iterations (Shamanskii method) or the
+ * inverse of the Jacobian is updated by the rank-1 updates of Broyden's method. The updates are
+ * stored in product form, hence the factorization is kept.
+ *
+ * A simplified step is accepted if it reduces the norm of the ODEs by at least the factor
+ * @c contraction. Otherwise, the iteration stagnates and the Jacobian is re-evaluated at the
+ * current state. Steps with a fresh Jacobian are exact Newton steps and use the linesearch of the
+ * @c NewtonRaphson solver.
+ *
+ * On success, the Jacobian is evaluated at the solution, such that @c getJacobianM returns the
+ * exact Jacobian at the steady state.
+ *
+ * @ingroup nlesolve
+ */
+template<class T,
+         class VectorEngine=Eval::bci::Engine<Eigen::VectorXd>,
+         class MatrixEngine=Eval::bci::Engine<Eigen::VectorXd,Eigen::MatrixXd> >
+class QuasiNewton
+    : public NewtonRaphson<T, VectorEngine, MatrixEngine>
+{
+
+public:
+
+   struct qnparams {
+       qnparams(size_t dim) : strategy(BroydenMethod), jacobianInterval(5),
+                              maxUpdates(std::min(size_t(20), dim+1)), contraction(0.5) {}
+
+       /**
+        * @brief The strategy to reuse the Jacobian.
+        */
+       QuasiNewtonStrategy strategy;
+
+       /**
+        * @brief Number of iterations between two evaluations of the Jacobian (Shamanskii method).
+        */
+       size_t jacobianInterval;
+
+       /**
+        * @brief Maximum number of rank-1 updates before the Jacobian is re-evaluated (Broyden
+        * method).
+        */
+       size_t maxUpdates;
+
+       /**
+        * @brief Minimum reduction of the norm of the ODEs for a simplified step.
+        */
+       double contraction;
+   };
+
+   qnparams qnParameters;
+
+protected:
+
+   /** LU decomposition of the last evaluated Jacobian with partial pivoting. */
+   Eigen::PartialPivLU<Eigen::MatrixXd> luPP;
+   /** LU decomposition of the last evaluated Jacobian with full pivoting, used if the Jacobian is
+    * ill-conditioned. */
+   Eigen::FullPivLU<Eigen::MatrixXd> luFP;
+   /** If true, the full pivoting decomposition is used. */
+   bool fullPivoting;
+
+   /** If true, the Jacobian was evaluated at the current state. */
+   bool fresh;
+   /** Number of iterations since the last evaluation of the Jacobian. */
+   size_t age;
+
+   /** Holds the steps of the rank-1 updates, one per column. */
+   Eigen::MatrixXd S;
+   /** Holds the vectors of the rank-1 updates, one per column. */
+   Eigen::MatrixXd U;
+   /** Number of rank-1 updates. */
+   size_t numUpdates;
+
+   /** Holds the ODEs at the last state. */
+   Eigen::VectorXd ODEs_old;
+   /** Some temporary vector. */
+   Eigen::VectorXd tmp;
+
+public:
+
+  /**
+   * Constructor...
+   */
+  QuasiNewton(T &model)
+      : NewtonRaphson<T, VectorEngine, MatrixEngine>(model),
+        qnParameters(model.numIndSpecies()),
+        luPP(model.numIndSpecies()), luFP(model.numIndSpecies(), model.numIndSpecies()),
+        fullPivoting(false), fresh(false), age(0), S(), U(), numUpdates(0),
+        ODEs_old(model.numIndSpecies()), tmp(model.numIndSpecies())
+  {
+      // Pass...
+  }
+
+  virtual ~QuasiNewton(){ };
+
+  /** Sets the strategy to reuse the Jacobian. */
+  virtual void setStrategy(QuasiNewtonStrategy strategy)
+  {
+      qnParameters.strategy = strategy;
+  }
+
+  /**
+   * @brief Run the quasi-Newton solver
+   * @param state provides initial condition for the solver which is updated on exist
+   * @return Status of the solver.
+   */
+  virtual Status
+  solve(Eigen::VectorXd &state)
+
+  {
+      S.resize(this->dim, qnParameters.maxUpdates);
+      U.resize(this->dim, qnParameters.maxUpdates);
+
+      // Calculate maximum step size heuristic
+      const double stpmax=this->parameters.STPMX*std::max(state.head(this->dim).norm(),double(this->dim));
+
+      this->interpreter.run(state, this->ODEs);
+      refresh(state);
+
+      // Do quasi-Newton iteration
+      for(this->iterations=1;this->iterations<this->parameters.maxIterations;this->iterations++)
+      {
+
+          this->state_old = state;
+          ODEs_old = this->ODEs;
+
+          // Solve J*dx=-ODEs using the factorization (and updates)
+          this->rhs = -this->ODEs;
+          applyInverse(this->rhs, this->dx);
+
+          if (fresh)
+          {
+              // Exact Newton step with linesearch:
+              LineSearchStatus lcheck = this->searchStep(this->state_old, state, stpmax);
+              switch(lcheck)
+              {
+                case RoundOffProblem:
+                case LineSearchFailed:
+                  state = this->state_old;
+                  return IterationFailed;
+                default: break;
+              }
+          }
+          else
+          {
+              // Simplified step, accepted if the ODEs contract:
+              double norm = this->dx.norm();
+              if (norm > stpmax) this->dx *= (stpmax/norm);
+              state.head(this->dim) = this->state_old.head(this->dim) + this->dx;
+              this->interpreter.run(state, this->ODEs);
+              if (! (this->ODEs.norm() <= qnParameters.contraction*ODEs_old.norm()))
+              {
+                  // Stagnation -> retry with a fresh Jacobian:
+                  state = this->state_old;
+                  this->ODEs = ODEs_old;
+                  refresh(state);
+                  continue;
+              }
+          }
+
+          // Check for negative values
+          if ((state.head(this->dim).array()<0).any())
+          {
+              state = this->state_old;
+              return NegativeValues;
+          }
+
+          // Test for convergence of ODEs
+          if ( maxNorm(this->ODEs) < this->parameters.absError )
+          {
+             return converged(state);
+          }
+
+          // Test for convergence of update
+          double test=0,temp = 0.;
+          for(size_t i=0;i<this->dim;i++)
+          {
+              temp = (std::abs(state(i)-this->state_old(i)))/std::max(state(i),1.);
+              if (temp > test) test = temp;
+          }
+          if (test < this->parameters.relError)
+          {
+              //convergence of dx
+              return converged(state);
+          }
+
+          // Decide how to continue:
+          fresh = false; age++;
+          switch (qnParameters.strategy)
+          {
+            case ChordMethod:
+              break;
+            case ShamanskiiMethod:
+              if (age >= qnParameters.jacobianInterval) refresh(state);
+              break;
+            case BroydenMethod:
+              if (! update(state)) refresh(state);
+              break;
+          }
+
+      } // Next iteration
+
+      return MaxIterationsReached;
+  }
+
+
+protected:
+
+  /**
+   * Evaluates and factorizes the Jacobian at the given state, discards all rank-1 updates.
+   */
+  void refresh(const Eigen::VectorXd &state)
+  {
+      this->jacobian_interpreter.run(state, this->JacobianM);
+      this->numJacobians++;
+
+      // Use full pivoting only if the Jacobian is ill-conditioned:
+      luPP.compute(this->JacobianM);
+      fullPivoting = (luPP.rcond() < std::numeric_limits<double>::epsilon());
+      if (fullPivoting) luFP.compute(this->JacobianM);
+      this->numFactorizations++;
+
+      fresh = true; age = 0; numUpdates = 0;
+  }
+
+  /**
+   * Applies the (approximate) inverse of the Jacobian to @c v.
+   */
+  void applyInverse(const Eigen::VectorXd &v, Eigen::VectorXd &x)
+  {
+      if (fullPivoting) x = luFP.solve(v);
+      else x = luPP.solve(v);
+
+      // Apply rank-1 updates (I + u_j s_j^T) in order:
+      for (size_t j=0; j<numUpdates; j++)
+          x += U.col(j)*S.col(j).dot(x);
+  }
+
+  /**
+   * Performs Broyden's update of the inverse Jacobian for the last step,
+   * \f$H_{k+1} = (I + u_k s_k^T) H_k\f$ with \f$u_k = (s_k - H_k y_k)/(s_k^T H_k y_k)\f$.
+   * Returns false if the update is not possible.
+   */
+  bool update(const Eigen::VectorXd &state)
+  {
+      if (numUpdates >= qnParameters.maxUpdates) return false;
+
+      // y = ODEs - ODEs_old, s = state - state_old:
+      ODEs_old = this->ODEs - ODEs_old;
+      applyInverse(ODEs_old, tmp);
+      S.col(numUpdates) = state.head(this->dim) - this->state_old.head(this->dim);
+      double den = S.col(numUpdates).dot(tmp);
+      if (! (std::abs(den) > std::numeric_limits<double>::epsilon()*S.col(numUpdates).squaredNorm()))
+          return false;
+
+      U.col(numUpdates) = (S.col(numUpdates) - tmp)/den;
+      numUpdates++;
+      return true;
+  }
+
+  /**
+   * Evaluates the exact Jacobian at the solution.
+   */
+  Status converged(const Eigen::VectorXd &state)
+  {
+      if (! fresh) {
+        this->jacobian_interpreter.run(state, this->JacobianM);
+        this->numJacobians++;
+      }
+      return Success;
+  }
+
+};
+
+
+}
+}
+
+#endif // __INA_NLESOLVE_QUASINEWTON_HH
@@ -0,0 +1,38 @@
+#include "bdf.hh"
+
+using namespace iNA::ODE;
+
+/// @cond 0
+const double BDFConstants::minFactor = 0.2;
+const double BDFConstants::maxFactor = 10.0;
+
+const double BDFConstants::gamma[BDFConstants::maxOrder+2] = {
+  0.0, 1.0, 1.5, 1.5+1./3, 1.5+1./3+1./4, 1.5+1./3+1./4+1./5, 1.5+1./3+1./4+1./5+1./6 };
+
+const double BDFConstants::errorConst[BDFConstants::maxOrder+2] = {
+  1.0, 1./2, 1./3, 1./4, 1./5, 1./6, 1./7 };
+
+
+/** Computes the matrix R of the step-size change by factor. */
+static inline Eigen::MatrixXd
+__bdf_compute_R(int order, double factor)
+{
+  Eigen::MatrixXd R(order+1, order+1);
+  R.row(0).setOnes();
+  for (int i=1; i<=order; i++) {
+    R(i,0) = 0;
+    for (int j=1; j<=order; j++) {
+      R(i,j) = R(i-1,j)*(i-1-factor*j)/i;
+    }
+  }
+  return R;
+}
+
+
+void
+BDFConstants::changeStepSize(Eigen::MatrixXd &D, int order, double factor)
+{
+  Eigen::MatrixXd RU = __bdf_compute_R(order, factor)*__bdf_compute_R(order, 1);
+  D.leftCols(order+1) = D.leftCols(order+1)*RU;
+}
+/// @endcond
@@ -0,0 +1,374 @@
+#ifndef __FLUC_ODE_BDF_HH__
+#define __FLUC_ODE_BDF_HH__
+
+#include <cmath>
+#include <limits>
+#include <eigen3/Eigen/Eigen>
+#include "stepper.hh"
+#include "bdflinearsolver.hh"
+#include "exception.hh"
+#include "math.hh"
+
+
+namespace iNA {
+namespace ODE {
+
+
+/**
+ * @cond 0
+ * (excluded from docs)
+ *
+ * Provides the constants and the step-size change of the difference array used in @c BDFStepper.
+ */
+class BDFConstants
+{
+public:
+  /** The maximum order of the method. */
+  static const int maxOrder = 5;
+  /** The maximum number of Newton iterations per step. */
+  static const int maxNewtonIterations = 4;
+  /** Minimum factor of the step-size change. */
+  static const double minFactor;
+  /** Maximum factor of the step-size change. */
+  static const double maxFactor;
+  /** gamma_k = sum_{j=1}^k 1/j. */
+  static const double gamma[maxOrder+2];
+  /** Error constants of the methods. */
+  static const double errorConst[maxOrder+2];
+
+  /** Rescales the differences (columns of D) of the given order for the step-size change by
+   * factor. */
+  static void changeStepSize(Eigen::MatrixXd &D, int order, double factor);
+};
+/// @endcond
+
+
+
+/**
+ * Implements a variable-order (1-5), variable step-size BDF integrator for stiff systems.
+ *
+ * The method is implemented in the quasi-constant step-size form using modified divided
+ * differences as described by Shampine & Reichelt (The MATLAB ODE suite, 1997), similar to
+ * CVODE. The history of the solution is stored as backward differences, which are rescaled on
+ * every change of the step-size. The order and the step-size are selected by estimating the
+ * local error of the current and the neighboring orders.
+ *
+ * The implicit equations are solved by a simplified Newton iteration, the Jacobian is only
+ * re-evaluated if the iteration fails to converge and the iteration matrix is only decomposed if
+ * the step-size changes. The linear systems are solved by the @c LinearSolver, which may be a
+ * @c BDFDenseSolver (default), a @c BDFSparseSolver for large systems with a sparse Jacobian or
+ * a Jacobian-free @c BDFGMRESSolver.
+ *
+ * The stepper takes steps independent of the output interval @c dt and interpolates the
+ * solution at the output times. The history is kept between calls to @c step as long as the
+ * integration continues from the last output, i.e. @c step is called with the state and time
+ * it returned last. Otherwise, the integration is restarted with order 1.
+ *
+ * @ingroup ode
+ */
+template <class Sys, class LinearSolver=BDFDenseSolver<Sys> >
+class BDFStepper
+    : public Stepper, protected BDFConstants
+{
+protected:
+  /** Holds a weak reference to the system. */
+  Sys &system;
+  /** Holds the linear solver. */
+  LinearSolver solver;
+  /** Holds the output interval. */
+  double step_size;
+  /** Holds the maximum absolute error. */
+  double err_abs;
+  /** Holds the maximum relative error. */
+  double err_rel;
+  /** Holds the tolerance of the Newton iteration. */
+  double newton_tol;
+  /** If false, the integration will be restarted at the next step. */
+  bool initialized;
+  /** Holds the current internal time. */
+  double time;
+  /** Holds the current internal step-size. */
+  double h;
+  /** Holds the current order. */
+  int order;
+  /** Holds the number of steps taken with the current step-size and order. */
+  int n_equal_steps;
+  /** If true, the iteration matrix was decomposed for the current step-size. */
+  bool lu_valid;
+  /** Holds the backward differences of the solution, column-wise. */
+  Eigen::MatrixXd D;
+  /** Holds the last output time. */
+  double t_out;
+  /** Holds the last output state. */
+  Eigen::VectorXd y_out;
+  Eigen::VectorXd y_predict; ///< Some temporary state.
+  Eigen::VectorXd y_new;     ///< Some temporary state.
+  Eigen::VectorXd psi;       ///< Some temporary state.
+  Eigen::VectorXd d;         ///< Some temporary state.
+  Eigen::VectorXd dy;        ///< Some temporary state.
+  Eigen::VectorXd f;         ///< Some temporary state.
+  Eigen::VectorXd rhs;       ///< Some temporary state.
+  Eigen::VectorXd scale;     ///< Some temporary state.
+
+public:
+  /**
+   * Constructs a BDF stepper.
+   *
+   * @param system Specifies the system to integrate.
+   * @param dt Specifies the time-step (output interval) of @c step.
+   * @param epsilon_abs Specifies the maximum absolute error.
+   * @param epsilon_rel Specifies the maximum relative error.
+   */
+  BDFStepper(Sys &system, double dt, double epsilon_abs, double epsilon_rel)
+    : system(system), solver(system, _statistics), step_size(dt), err_abs(epsilon_abs), err_rel(epsilon_rel),
+      newton_tol(std::max(10*std::numeric_limits<double>::epsilon()/epsilon_rel,
+                          std::min(0.03, std::sqrt(epsilon_rel)))),
+      initialized(false), time(0), h(dt), order(1), n_equal_steps(0), lu_valid(false),
+      D(system.getDimension(), maxOrder+3), t_out(0), y_out(system.getDimension()),
+      y_predict(system.getDimension()), y_new(system.getDimension()), psi(system.getDimension()),
+      d(system.getDimension()), dy(system.getDimension()), f(system.getDimension()),
+      rhs(system.getDimension()), scale(system.getDimension())
+  {
+    // Pass...
+  }
+
+  /**
+   * Performs the step t -> t+dt.
+   */
+  virtual void step(const Eigen::VectorXd &state, double t, Eigen::VectorXd &delta)
+  {
+    if (! continues(state, t)) {
+      start(state, t);
+    }
+
+    double t_end = t + step_size;
+    while (time < t_end) {
+      _step();
+    }
+
+    interpolate(t_end, y_out); t_out = t_end;
+    delta = y_out - state;
+  }
+
+  /** Restarts the integration at the next step. */
+  virtual void reset()
+  {
+    initialized = false;
+  }
+
+  /** Restarts the integration at the next step. */
+  virtual void parameterChanged()
+  {
+    initialized = false;
+  }
+
+  /** Returns the linear solver. */
+  inline LinearSolver &linearSolver()
+  {
+    return solver;
+  }
+
+  /** Returns the current order of the method. */
+  inline int getOrder() const
+  {
+    return order;
+  }
+
+
+protected:
+  /** Returns true if the integration continues from the last output. */
+  bool continues(const Eigen::VectorXd &state, double t)
+  {
+    if (! initialized) { return false; }
+    if (std::abs(t-t_out) > 10*std::numeric_limits<double>::epsilon()*std::max(1.0, std::abs(t))) {
+      return false;
+    }
+    // Allow for round-off (i.e. state = x + (y_out - x)):
+    for (int i=0; i<state.size(); i++) {
+      if (std::abs(state(i)-y_out(i)) > 1e-6*(err_abs + err_rel*std::abs(y_out(i)))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /** Restarts the integration with order 1 at the given state. */
+  void start(const Eigen::VectorXd &state, double t)
+  {
+    evaluateSystem(system, state, t, f);
+
+    // Initial step-size:
+    scale = (err_abs + err_rel*state.array().abs()).matrix();
+    double d0 = rms(state, scale), d1 = rms(f, scale);
+    h = ((d0 < 1e-5) || (d1 < 1e-5)) ? 1e-6 : 0.01*d0/d1;
+    h = std::min(h, step_size);
+
+    D.setZero();
+    D.col(0) = state; D.col(1) = h*f;
+    time = t; order = 1; n_equal_steps = 0;
+    t_out = t; y_out = state;
+
+    updateJacobian(state, t); lu_valid = false;
+    initialized = true;
+  }
+
+  /** Updates the Jacobian of the linear solver. */
+  inline void updateJacobian(const Eigen::VectorXd &state, double t)
+  {
+    _statistics.startPhase();
+    solver.updateJacobian(state, t);
+    _statistics.stopPhase(StepperStatistics::JACOBIAN);
+  }
+
+  /** Decomposes the iteration matrix of the linear solver. */
+  inline void decompose(double c)
+  {
+    _statistics.startPhase();
+    solver.decompose(c);
+    _statistics.stopPhase(StepperStatistics::DECOMPOSITION);
+  }
+
+  /** Evaluates the interpolation polynomial of the last step at time t. */
+  void interpolate(double t, Eigen::VectorXd &y)
+  {
+    y = D.col(0); double p = 1;
+    for (int j=0; j<order; j++) {
+      p *= (t - (time - j*h))/((j+1)*h);
+      y += p*D.col(j+1);
+    }
+  }
+
+  /** Weighted RMS norm. */
+  static inline double rms(const Eigen::VectorXd &x, const Eigen::VectorXd &scale)
+  {
+    return std::sqrt((x.array()/scale.array()).square().sum()/x.size());
+  }
+
+  /** Solves the implicit equations of the step by a simplified Newton iteration, the solution is
+   * stored in y_new, the sum of all corrections in d. Returns false if the iteration diverges
+   * or a linear system could not be solved. */
+  bool newton(double t_new, double c, int &n_iter)
+  {
+    d.setZero(); y_new = y_predict;
+    double dy_norm_old = -1;
+    for (n_iter=1; n_iter<=maxNewtonIterations; n_iter++) {
+      evaluateSystem(system, y_new, t_new, f);
+      if (! f.allFinite()) { return false; }
+
+      rhs.noalias() = c*f - psi - d;
+      if (! solver.solve(rhs, dy)) { return false; }
+      double dy_norm = rms(dy, scale);
+
+      double rate = -1;
+      if (0 <= dy_norm_old) {
+        rate = dy_norm/dy_norm_old;
+        if ((1 <= rate) ||
+            (std::pow(rate, maxNewtonIterations-n_iter+1)/(1-rate)*dy_norm > newton_tol)) {
+          return false;
+        }
+      }
+
+      y_new += dy; d += dy;
+      if ((0 == dy_norm) || ((0 <= rate) && (rate/(1-rate)*dy_norm < newton_tol))) {
+        return true;
+      }
+      dy_norm_old = dy_norm;
+    }
+    return false;
+  }
+
+  /** Performs one accepted step, selects the step-size and order for the next step. */
+  void _step()
+  {
+    double min_step = 10*std::abs(time)*std::numeric_limits<double>::epsilon();
+    bool jacobian_current = false;
+    int n_iter = 0;
+    double error_norm = 0, safety = 1, t_new = time;
+
+    while (true) {
+      if (h <= min_step) {
+        RuntimeError err;
+        err << __FILE__ << "(" << (unsigned int) __LINE__ << "): " << "Stepsize underflow in BDFStepper.";
+        throw err;
+      }
+
+      t_new = time + h;
+      y_predict = D.leftCols(order+1).rowwise().sum();
+      scale = (err_abs + err_rel*y_predict.array().abs()).matrix();
+      psi.setZero();
+      for (int k=1; k<=order; k++) { psi += gamma[k]*D.col(k); }
+      psi /= gamma[order];
+      double c = h/gamma[order];
+
+      // Solve implicit equations, update Jacobian once if the iteration does not converge:
+      bool converged = false;
+      while (! converged) {
+        if (! lu_valid) { decompose(c); lu_valid = true; }
+        converged = newton(t_new, c, n_iter);
+        if (! converged) {
+          if (jacobian_current) { break; }
+          updateJacobian(y_predict, t_new); lu_valid = false; jacobian_current = true;
+        }
+      }
+
+      if (! converged) {
+        _statistics.reject();
+        h *= 0.5; changeStepSize(D, order, 0.5);
+        n_equal_steps = 0; lu_valid = false;
+        continue;
+      }
+
+      // Estimate error:
+      safety = 0.9*(2*maxNewtonIterations+1)/(2*maxNewtonIterations+n_iter);
+      scale = (err_abs + err_rel*y_new.array().abs()).matrix();
+      error_norm = errorConst[order]*rms(d, scale);
+      if (Math::isNotValue(error_norm) || (1 < error_norm)) {
+        double factor = minFactor;
+        if (! Math::isNotValue(error_norm)) {
+          factor = std::max(minFactor, safety*std::pow(error_norm, -1./(order+1)));
+        }
+        // Step-size changed but Newton converged, keep decomposition:
+        _statistics.reject();
+        h *= factor; changeStepSize(D, order, factor); n_equal_steps = 0;
+        continue;
+      }
+
+      break;
+    }
+
+    // Step accepted, update differences:
+    _statistics.accept(t_new-time);
+    time = t_new; n_equal_steps++;
+    D.col(order+2) = d - D.col(order+1);
+    D.col(order+1) = d;
+    for (int i=order; i>=0; i--) { D.col(i) += D.col(i+1); }
+
+    // Change order and step-size only after order+1 steps with equal step-size:
+    if (n_equal_steps < order+1) { return; }
+
+    double error_m = std::numeric_limits<double>::infinity();
+    double error_p = std::numeric_limits<double>::infinity();
+    if (1 < order) { error_m = errorConst[order-1]*rms(D.col(order), scale); }
+    if (maxOrder > order) { error_p = errorConst[order+1]*rms(D.col(order+2), scale); }
+
+    double factor_m = (0 == error_m) ? maxFactor : std::pow(error_m, -1./order);
+    double factor   = (0 == error_norm) ? maxFactor : std::pow(error_norm, -1./(order+1));
+    double factor_p = (0 == error_p) ? maxFactor : std::pow(error_p, -1./(order+2));
+
+    if ((factor_m > factor) && (factor_m >= factor_p)) {
+      order--; factor = factor_m;
+    } else if (factor_p > factor) {
+      order++; factor = factor_p;
+    }
+
+    factor = std::min(maxFactor, safety*factor);
+    h *= factor; changeStepSize(D, order, factor);
+    n_equal_steps = 0; lu_valid = false;
+  }
+};
+
+
+}
+}
+
+#endif // __FLUC_ODE_BDF_HH__
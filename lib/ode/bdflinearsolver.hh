@@ -0,0 +1,298 @@
+#ifndef __FLUC_ODE_BDFLINEARSOLVER_HH__
+#define __FLUC_ODE_BDFLINEARSOLVER_HH__
+
+#include <cmath>
+#include <limits>
+#include <eigen3/Eigen/Eigen>
+#include "sparseiterationmatrix.hh"
+#include "stepperstatistics.hh"
+
+
+namespace iNA {
+namespace ODE {
+
+
+/**
+ * Solves the linear systems \f$(I - cJ)x = b\f$ of the Newton iteration of the @c BDFStepper
+ * using a dense LU decomposition.
+ *
+ * The system must implement
+ * <tt>evaluateJacobian(const Eigen::VectorXd &state, double t, Eigen::MatrixXd &jac)</tt>.
+ *
+ * A linear solver of the @c BDFStepper is constructed from the system and the statistics of the
+ * stepper. It implements @c updateJacobian, which evaluates the Jacobian at the given state,
+ * @c decompose, which prepares the solution of the linear systems for the given factor \f$c\f$
+ * and @c solve, which returns false if the linear system could not be solved.
+ *
+ * @ingroup ode
+ */
+template <class Sys>
+class BDFDenseSolver
+{
+protected:
+  /** Holds a weak reference to the system. */
+  Sys &system;
+  /** Holds the Jacobian of the system. */
+  Eigen::MatrixXd jacobian;
+  /** Holds the iteration matrix (I - c J). */
+  Eigen::MatrixXd iteration;
+  /** Holds the LU decomposition of the iteration matrix. */
+  Eigen::PartialPivLU<Eigen::MatrixXd> lu;
+
+public:
+  /** Constructor. */
+  BDFDenseSolver(Sys &system, StepperStatistics &)
+    : system(system), jacobian(), iteration(), lu()
+  {
+    // Pass...
+  }
+
+  /** Evaluates the Jacobian at the given state. */
+  inline void updateJacobian(const Eigen::VectorXd &state, double t)
+  {
+    system.evaluateJacobian(state, t, jacobian);
+  }
+
+  /** Assembles and decomposes (I - c J). */
+  inline void decompose(double c)
+  {
+    iteration.noalias() = -c*jacobian;
+    iteration.diagonal().array() += 1;
+    lu.compute(iteration);
+  }
+
+  /** Solves (I - c J) x = rhs. */
+  inline bool solve(const Eigen::VectorXd &rhs, Eigen::VectorXd &x)
+  {
+    x.noalias() = lu.solve(rhs);
+    return true;
+  }
+};
+
+
+
+/**
+ * Solves the linear systems \f$(I - cJ)x = b\f$ of the Newton iteration of the @c BDFStepper
+ * using a sparse LU decomposition (see @c SparseIterationMatrix).
+ *
+ * The system must implement
+ * <tt>evaluateJacobian(const Eigen::VectorXd &state, double t, Eigen::SparseMatrix<double> &jac)</tt>,
+ * like the @c Models::GenericSSEinterpreter does once the sparse Jacobian was compiled.
+ *
+ * @ingroup ode
+ */
+template <class Sys>
+class BDFSparseSolver
+{
+protected:
+  /** Holds a weak reference to the system. */
+  Sys &system;
+  /** Holds the sparse Jacobian of the system. */
+  Eigen::SparseMatrix<double> jacobian;
+  /** Holds the decomposition of (I/c - J). */
+  SparseIterationMatrix iteration;
+  /** Holds the factor c of the last decomposition. */
+  double factor;
+
+public:
+  /** Constructor. */
+  BDFSparseSolver(Sys &system, StepperStatistics &)
+    : system(system), jacobian(), iteration(), factor(1)
+  {
+    // Pass...
+  }
+
+  /** Evaluates the sparse Jacobian at the given state. */
+  inline void updateJacobian(const Eigen::VectorXd &state, double t)
+  {
+    system.evaluateJacobian(state, t, jacobian);
+  }
+
+  /** Decomposes (I/c - J). */
+  inline void decompose(double c)
+  {
+    iteration.compute(jacobian, 1./c); factor = c;
+  }
+
+  /** Solves (I - c J) x = rhs. */
+  inline bool solve(const Eigen::VectorXd &rhs, Eigen::VectorXd &x)
+  {
+    iteration.solve(rhs, x); x /= factor;
+    return true;
+  }
+};
+
+
+
+/**
+ * Solves the linear systems \f$(I - cJ)x = b\f$ of the Newton iteration of the @c BDFStepper
+ * using the restarted GMRES method, without assembling the Jacobian.
+ *
+ * The product of the Jacobian with a vector is approximated by a finite difference of the
+ * right-hand side of the system, \f$Jv \approx (f(y+\sigma v)-f(y))/\sigma\f$. Hence only the
+ * compiled system itself is needed and neither memory nor time is spent on the Jacobian. As the
+ * linear systems are only solved approximately, this solver is suited for very large systems,
+ * where even a sparse LU decomposition becomes too expensive. The evaluations of the system are
+ * counted in the statistics of the stepper.
+ *
+ * If the residual does not drop below the tolerance within the maximum number of restarts or the
+ * iteration breaks down without progress, @c solve returns false and the @c BDFStepper treats the
+ * Newton iteration as not converged.
+ *
+ * @ingroup ode
+ */
+template <class Sys>
+class BDFGMRESSolver
+{
+protected:
+  /** Holds a weak reference to the system. */
+  Sys &system;
+  /** Holds a weak reference to the statistics of the stepper. */
+  StepperStatistics &statistics;
+  /** Holds the state the Jacobian is approximated at. */
+  Eigen::VectorXd state;
+  /** Holds the time the Jacobian is approximated at. */
+  double time;
+  /** Holds the right-hand side of the system at state. */
+  Eigen::VectorXd f0;
+  /** Holds the factor c of the iteration matrix. */
+  double factor;
+  /** Holds the maximum dimension of the Krylov subspace. */
+  size_t krylovDimension;
+  /** Holds the maximum number of restarts. */
+  size_t maxRestarts;
+  /** Holds the relative tolerance of the residual. */
+  double tolerance;
+  /** Holds the orthonormal basis of the Krylov subspace. */
+  Eigen::MatrixXd V;
+  /** Holds the Hessenberg matrix. */
+  Eigen::MatrixXd H;
+  /** Holds the cosines of the Givens rotations. */
+  Eigen::VectorXd cs;
+  /** Holds the sines of the Givens rotations. */
+  Eigen::VectorXd sn;
+  /** Holds the rotated residual. */
+  Eigen::VectorXd g;
+  /** Holds the coefficients of the update in the Krylov basis. */
+  Eigen::VectorXd y;
+  /** Some temporary vector. */
+  Eigen::VectorXd w;
+  /** Some temporary vector. */
+  Eigen::VectorXd tmp;
+  /** Some temporary vector. */
+  Eigen::VectorXd ftmp;
+
+public:
+  /**
+   * Constructor.
+   *
+   * @param system Specifies the system.
+   * @param statistics Specifies the statistics of the stepper, counting the evaluations of the
+   *        system.
+   * @param krylov_dim Specifies the maximum dimension of the Krylov subspace before restart.
+   * @param tol Specifies the relative tolerance of the residual.
+   */
+  BDFGMRESSolver(Sys &system, StepperStatistics &statistics, size_t krylov_dim=30,
+                 double tol=1e-4)
+    : system(system), statistics(statistics), state(system.getDimension()), time(0), f0(system.getDimension()), factor(1),
+      krylovDimension(std::min(krylov_dim, size_t(system.getDimension()))), maxRestarts(10),
+      tolerance(tol), V(system.getDimension(), krylovDimension+1),
+      H(krylovDimension+1, krylovDimension), cs(krylovDimension), sn(krylovDimension),
+      g(krylovDimension+1), y(krylovDimension), w(system.getDimension()), tmp(system.getDimension()),
+      ftmp(system.getDimension())
+  {
+    // Pass...
+  }
+
+  /** Stores the state to approximate the Jacobian at. */
+  inline void updateJacobian(const Eigen::VectorXd &state, double t)
+  {
+    this->state = state; this->time = t;
+    // Part of the Jacobian phase of the stepper, hence counted without timing:
+    system.evaluate(state, t, f0);
+    statistics.count(StepperStatistics::RHS, 1);
+  }
+
+  /** Stores the factor of the iteration matrix, there is nothing to decompose. */
+  inline void decompose(double c)
+  {
+    factor = c;
+  }
+
+  /** Solves (I - c J) x = rhs approximately, returns false if the iteration did not converge. */
+  bool solve(const Eigen::VectorXd &rhs, Eigen::VectorXd &x)
+  {
+    x.setZero(rhs.size());
+    double rhs_norm = rhs.norm();
+    if (0 == rhs_norm) { return true; }
+
+    for (size_t restart=0; restart<=maxRestarts; restart++) {
+      // Residual r = rhs - A x:
+      apply(x, w); w = rhs - w;
+      double beta = w.norm();
+      if (beta <= tolerance*rhs_norm) { return true; }
+
+      V.col(0) = w/beta; g.setZero(); g(0) = beta;
+      size_t k = 0;
+      for (; k<krylovDimension; k++) {
+        // Arnoldi process (modified Gram-Schmidt):
+        apply(V.col(k), w);
+        for (size_t i=0; i<=k; i++) {
+          H(i,k) = V.col(i).dot(w); w -= H(i,k)*V.col(i);
+        }
+        H(k+1,k) = w.norm();
+        if (0 < H(k+1,k)) { V.col(k+1) = w/H(k+1,k); }
+
+        // Apply previous Givens rotations to the new column:
+        for (size_t i=0; i<k; i++) {
+          double h = cs(i)*H(i,k) + sn(i)*H(i+1,k);
+          H(i+1,k) = -sn(i)*H(i,k) + cs(i)*H(i+1,k); H(i,k) = h;
+        }
+        // Determine new rotation:
+        double r = std::sqrt(H(k,k)*H(k,k) + H(k+1,k)*H(k+1,k));
+        if (0 == r) { cs(k) = 1; sn(k) = 0; } else { cs(k) = H(k,k)/r; sn(k) = H(k+1,k)/r; }
+        H(k,k) = r; H(k+1,k) = 0;
+        g(k+1) = -sn(k)*g(k); g(k) = cs(k)*g(k);
+
+        // Breakdown, A V(:,k) lies in the span of the previous basis vectors. The column k is
+        // singular and excluded from the update, g(k) holds the residual:
+        if (0 == r) { break; }
+        if (std::abs(g(k+1)) <= tolerance*rhs_norm) { k++; break; }
+      }
+
+      // Solve upper triangular system and update solution:
+      if (0 < k) {
+        Eigen::VectorBlock<Eigen::VectorXd> yk = y.head(k);
+        yk = g.head(k);
+        H.topLeftCorner(k,k).template triangularView<Eigen::Upper>().solveInPlace(yk);
+        x.noalias() += V.leftCols(k)*yk;
+      }
+      if (std::abs(g(k)) <= tolerance*rhs_norm) { return true; }
+      // A restart would break down at the same place:
+      if (0 == k) { return false; }
+    }
+
+    return false;
+  }
+
+protected:
+  /** Computes (I - c J) v using a finite difference approximation of J v. */
+  template <class Vec>
+  inline void apply(const Vec &v, Eigen::VectorXd &out)
+  {
+    double v_norm = v.norm();
+    if (0 == v_norm) { out.setZero(v.size()); return; }
+    double sigma = std::sqrt(std::numeric_limits<double>::epsilon())*(1+state.norm())/v_norm;
+    tmp.noalias() = state + sigma*v;
+    statistics.startPhase();
+    system.evaluate(tmp, time, ftmp);
+    statistics.stopPhase(StepperStatistics::RHS);
+    out.noalias() = v - (factor/sigma)*(ftmp - f0);
+  }
+};
+
+
+}
+}
+
+#endif // __FLUC_ODE_BDFLINEARSOLVER_HH__
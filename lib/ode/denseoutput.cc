@@ -0,0 +1,171 @@
+#include "denseoutput.hh"
+#include "exception.hh"
+#include <limits>
+#include <cmath>
+#include <algorithm>
+
+using namespace iNA;
+using namespace iNA::ODE;
+
+
+/* ********************************************************************************************* *
+ * Implementation of DenseOutputStepper
+ * ********************************************************************************************* */
+DenseOutputStepper::DenseOutputStepper(double order, double h)
+  : Stepper(), _t0(0), _t1(0), _h(h), _initialStepSize(h), _controller(order)
+{
+  // Pass...
+}
+
+
+void
+DenseOutputStepper::initialize(const Eigen::VectorXd &state, double t)
+{
+  _state0 = state; _state1 = state;
+  _delta.resize(state.size());
+  _t0 = _t1 = t;
+  _h = _initialStepSize;
+  _controller.reset();
+  beginDense(state, t);
+}
+
+
+double
+DenseOutputStepper::advance(double t_max)
+{
+  double h = std::min(_h, t_max-_t1);
+  bool clipped = (h < _h);
+
+  while (true) {
+    // Check step-size:
+    if (h <= std::abs(_t1)*std::numeric_limits<double>::epsilon()) {
+      RuntimeError err;
+      err << __FILE__ << "(" << (unsigned int) __LINE__ << "): "
+          << "Stepsize underflow in DenseOutputStepper.";
+      throw err;
+    }
+
+    double h_new, err = attemptStep(_state1, _t1, h, _delta);
+    if (_controller.accept(err, h, h_new)) {
+      _statistics.accept(h);
+      acceptStep(_state1, _t1, h, _delta);
+      _state0 = _state1; _state1 += _delta;
+      _t0 = _t1; _t1 = (clipped ? t_max : _t1+h);
+      // Keep the proposed step-size if the step was clipped at t_max:
+      if (! clipped || h_new < _h) { _h = h_new; }
+      locateEvents();
+      return _t1;
+    }
+
+    _statistics.reject(); h = h_new; clipped = false;
+  }
+}
+
+
+void
+DenseOutputStepper::interpolate(double t, Eigen::VectorXd &state)
+{
+  if (_t1 <= _t0 || t >= _t1) { state = _state1; return; }
+  interpolateStep((t-_t0)/(_t1-_t0), state);
+}
+
+
+void
+DenseOutputStepper::reset()
+{
+  _h = _initialStepSize;
+  _controller.reset();
+}
+
+
+void
+DenseOutputStepper::locateEvents()
+{
+  if (eventFired()) { return; }
+
+  for (size_t i=0; i<_events.size(); i++) {
+    double value = _events[i]->evaluate(_state1, _t1);
+    if ((0 < _eventValues[i]) && (0 >= value)) {
+      // Locate root of event function by the Illinois method:
+      double ta = _t0, ga = _eventValues[i], tb = _t1, gb = value;
+      double tol = 1e-9*(_t1-_t0) + 4*std::numeric_limits<double>::epsilon()*std::abs(_t1);
+      int side = 0;
+      for (size_t iter=0; (iter<50) && (tol < (tb-ta)); iter++) {
+        double tc = tb - gb*(tb-ta)/(gb-ga);
+        interpolate(tc, _eventState);
+        double gc = _events[i]->evaluate(_eventState, tc);
+        if (0 >= gc) {
+          tb = tc; gb = gc;
+          if (1 == side) { ga /= 2; }
+          side = 1;
+        } else {
+          ta = tc; ga = gc;
+          if (-1 == side) { gb /= 2; }
+          side = -1;
+        }
+      }
+      // Keep the earliest event:
+      if ((! eventFired()) || (tb < _eventTime)) {
+        _firedEvent = i; _eventTime = tb;
+      }
+    }
+    _eventValues[i] = value;
+  }
+}
+
+
+
+/* ********************************************************************************************* *
+ * Implementation of DenseOutputDriver
+ * ********************************************************************************************* */
+DenseOutputDriver::DenseOutputDriver(Stepper &stepper, const IntegrationRange &range)
+  : _stepper(stepper), _dense(dynamic_cast<DenseOutputStepper *>(&stepper)), _range(range),
+    _index(0), _delta(), _fired(false)
+{
+  // Pass...
+}
+
+
+bool
+DenseOutputDriver::start(const Eigen::VectorXd &state)
+{
+  _index = 0;
+  _delta.resize(state.size());
+  _stepper.statistics().reset();
+  if (0 != _dense) {
+    _dense->initialize(state, _range.getStartTime());
+  }
+  _fired = _stepper.startEvents(state, _range.getStartTime());
+  return _fired;
+}
+
+
+bool
+DenseOutputDriver::next(Eigen::VectorXd &state, double &t)
+{
+  double t_now = _range.getStartTime() + _index*_range.getStepSize();
+  _index++;
+  t = _range.getStartTime() + _index*_range.getStepSize();
+  _stepper.statistics().start();
+
+  if (0 == _dense) {
+    _stepper.step(state, t_now, _delta);
+    state += _delta;
+    _fired = _stepper.checkEvents(state, t);
+    _stepper.statistics().stop();
+    return _fired;
+  }
+
+  // Advance until the output time is reached, steps may go beyond the end of the range:
+  while ((_dense->time() < t) && (! _dense->eventFired())) {
+    _dense->advance(std::max(t, _range.getEndTime()));
+  }
+
+  // Stop at the event, if it fired before the output time:
+  if (_dense->eventFired() && (_dense->eventTime() <= t)) {
+    t = _dense->eventTime(); _fired = true;
+  }
+  _dense->interpolate(t, state);
+  _stepper.statistics().stop();
+  return _fired;
+}
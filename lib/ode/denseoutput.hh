@@ -0,0 +1,191 @@
+#ifndef __FLUC_ODE_DENSEOUTPUT_HH__
+#define __FLUC_ODE_DENSEOUTPUT_HH__
+
+#include <eigen3/Eigen/Eigen>
+#include "stepper.hh"
+#include "stepsizecontroller.hh"
+#include "integrationrange.hh"
+
+
+namespace iNA {
+namespace ODE {
+
+
+/**
+ * Base class of all adaptive steppers providing a continuous extension (dense output).
+ *
+ * In contrast to @c Stepper::step, which integrates exactly over the given interval, a dense
+ * output stepper chooses its internal step-size freely (see @c advance) and the state at any
+ * time within the last accepted step is obtained by interpolation (see @c interpolate). Hence the
+ * output grid does not limit the step-size of the integrator. The step-size is selected by a
+ * @c PIStepSizeController.
+ *
+ * Implementations provide a single attempted step (@c attemptStep), the preparation of the
+ * interpolation coefficients once a step was accepted (@c acceptStep) and the interpolation
+ * within the last step (@c interpolateStep).
+ *
+ * After each accepted step, the events of the stepper (see @c Stepper::addEvent) are checked. If
+ * an event function changed its sign within the step, the time of the event is located on the
+ * continuous extension using the Illinois variant of the regula falsi.
+ *
+ * @ingroup ode
+ */
+class DenseOutputStepper
+    : public Stepper
+{
+protected:
+  /** Holds the state at the beginning of the last accepted step. */
+  Eigen::VectorXd _state0;
+  /** Holds the current state, i.e. the state at the end of the last accepted step. */
+  Eigen::VectorXd _state1;
+  /** Holds the update of the current step. */
+  Eigen::VectorXd _delta;
+  /** Holds the time at the beginning of the last accepted step. */
+  double _t0;
+  /** Holds the current time. */
+  double _t1;
+  /** Holds the step-size proposed for the next step. */
+  double _h;
+  /** Holds the initial step-size. */
+  double _initialStepSize;
+  /** The step-size controller. */
+  PIStepSizeController _controller;
+  /** Holds the interpolated state during the location of an event. */
+  Eigen::VectorXd _eventState;
+
+
+public:
+  /**
+   * Constructor.
+   *
+   * @param order Specifies the order of the error estimate of the method.
+   * @param h Specifies the initial step-size.
+   */
+  DenseOutputStepper(double order, double h);
+
+  /**
+   * Starts the continuous integration at the given state and time.
+   */
+  void initialize(const Eigen::VectorXd &state, double t);
+
+  /**
+   * Performs one accepted step with adaptive step-size, the step does not go beyond @c t_max.
+   *
+   * @returns The time at the end of the step.
+   * @throws RuntimeError If the step-size underflows.
+   */
+  double advance(double t_max);
+
+  /**
+   * Evaluates the continuous extension at time @c t, which must be within the last accepted step.
+   */
+  void interpolate(double t, Eigen::VectorXd &state);
+
+  /** Returns the current time. */
+  inline double time() const { return _t1; }
+  /** Returns the current state. */
+  inline const Eigen::VectorXd &state() const { return _state1; }
+
+  /** Resets the step-size controller. */
+  virtual void reset();
+
+
+protected:
+  /** Checks the events at the end of the last accepted step and locates the event time. */
+  void locateEvents();
+
+  /** Prepares the first step, i.e. evaluates the derivative at the initial state. */
+  virtual void beginDense(const Eigen::VectorXd &state, double t) = 0;
+
+  /**
+   * Attempts a single step of size @c h, returns the normalized error estimate of the step.
+   */
+  virtual double attemptStep(const Eigen::VectorXd &state, double t, double h,
+                             Eigen::VectorXd &delta) = 0;
+
+  /**
+   * Prepares the interpolation coefficients of the accepted step @c state -> @c state+delta and
+   * the derivative for the next step.
+   */
+  virtual void acceptStep(const Eigen::VectorXd &state, double t, double h,
+                          const Eigen::VectorXd &delta) = 0;
+
+  /**
+   * Evaluates the continuous extension of the last accepted step at the relative position
+   * @c theta in [0,1].
+   */
+  virtual void interpolateStep(double theta, Eigen::VectorXd &state) = 0;
+};
+
+
+
+/**
+ * Integrates a system over an @c IntegrationRange and returns the states at the output times
+ * \f$t_0 + i\,\Delta t\f$.
+ *
+ * If the stepper provides a continuous extension (see @c DenseOutputStepper), the stepper
+ * chooses its step-size independently of the output grid and the states at the output times are
+ * obtained by interpolation. Otherwise, the stepper is called once for each output interval.
+ *
+ * If an event of the stepper fires (see @c Stepper::addEvent), @c next returns the state at the
+ * time of the event and the integration stops, i.e. @c eventFired returns true.
+ *
+ * The statistics of the stepper (see @c Stepper::statistics) are reset by @c start and the wall
+ * time spent in @c next is accumulated.
+ *
+ * @ingroup ode
+ */
+class DenseOutputDriver
+{
+protected:
+  /** Holds a weak reference to the stepper. */
+  Stepper &_stepper;
+  /** Holds the dense output stepper or 0 if the stepper does not provide dense output. */
+  DenseOutputStepper *_dense;
+  /** Holds the integration range. */
+  IntegrationRange _range;
+  /** Holds the index of the last output time. */
+  size_t _index;
+  /** Holds the update for steppers without dense output. */
+  Eigen::VectorXd _delta;
+  /** If true, an event fired and the integration stopped. */
+  bool _fired;
+
+public:
+  /**
+   * Constructor.
+   *
+   * @param stepper Specifies the stepper to use.
+   * @param range Specifies the integration range and output times.
+   */
+  DenseOutputDriver(Stepper &stepper, const IntegrationRange &range);
+
+  /**
+   * Starts the integration with the given initial state at the start time of the range.
+   *
+   * @returns true if an event fired at the initial state.
+   */
+  bool start(const Eigen::VectorXd &state);
+
+  /**
+   * Integrates to the next output time.
+   *
+   * @param state On entry, the state at the current output time, on exit the state at the next
+   *        output time.
+   * @param t On exit, holds the next output time or the time of the event.
+   * @returns true if an event fired.
+   */
+  bool next(Eigen::VectorXd &state, double &t);
+
+  /** Returns true if an event fired. */
+  inline bool eventFired() const { return _fired; }
+
+  /** Returns true if the stepper provides dense output. */
+  inline bool hasDenseOutput() const { return 0 != _dense; }
+};
+
+
+}
+}
+
+#endif // __FLUC_ODE_DENSEOUTPUT_HH__
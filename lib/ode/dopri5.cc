@@ -43,4 +43,11 @@ const double Dopri5Constants::e5 = -17253.0/339200.0;
 const double Dopri5Constants::e6 = 22.0/525.0;
 const double Dopri5Constants::e7 = -1.0/40.0;
 
+const double Dopri5Constants::d1 = -12715105075.0/11282082432.0;
+const double Dopri5Constants::d3 = 87487479700.0/32700410799.0;
+const double Dopri5Constants::d4 = -10690763975.0/1880347072.0;
+const double Dopri5Constants::d5 = 701980252875.0/199316789632.0;
+const double Dopri5Constants::d6 = -1453857185.0/822651844.0;
+const double Dopri5Constants::d7 = 69997945.0/29380423.0;
+
 /// @endcond
@@ -4,7 +4,7 @@
 #include <limits>
 #include <eigen3/Eigen/Eigen>
 #include "exception.hh"
-#include "stepper.hh"
+#include "denseoutput.hh"
 #include "math.hh"
 
 
@@ -30,6 +30,7 @@ public:
   static const double a61,a62,a63,a64,a65;
   static const double a71,a72,a73,a74,a75,a76;
   static const double  e1, e2, e3, e4, e5, e6, e7;
+  static const double  d1, d3, d4, d5, d6, d7;
 };
 /// @endcond
 
@@ -42,11 +43,15 @@ public:
  * In contrast to the implementation shown in @cite press2007, this implementation uses the maximum
  * norm to estimate the truncation-error of the integration-step.
  *
+ * The stepper also provides the continuous extension of 4th order of the method (see
+ * @c DenseOutputStepper), which reuses the stages of the step and needs no additional
+ * evaluations of the system.
+ *
  * @ingroup ode
  */
 template <class Sys>
 class Dopri5Stepper
-    : public Stepper, protected Dopri5Constants
+    : public DenseOutputStepper, protected Dopri5Constants
 {
 protected:
   /** Holds a weak reference to the system of ODEs. */
@@ -66,6 +71,9 @@ protected:
   Eigen::VectorXd last_diff; ///< Some temporary state.
   Eigen::VectorXd yerr; ///< Some temporary state.
   Eigen::VectorXd temp; ///< Some temporary state.
+  Eigen::VectorXd rcont3; ///< Coefficients of the continuous extension.
+  Eigen::VectorXd rcont4; ///< Coefficients of the continuous extension.
+  Eigen::VectorXd rcont5; ///< Coefficients of the continuous extension.
 
 
 public:
@@ -78,10 +86,12 @@ public:
    * @param epsilon_rel Specifies the relative error for the step.
    */
   Dopri5Stepper(Sys &system, double dt, double epsilon_abs, double epsilon_rel)
-    : system(system), step_size(dt), err_abs(epsilon_abs), err_rel(epsilon_rel),
+    : DenseOutputStepper(5, dt),
+      system(system), step_size(dt), err_abs(epsilon_abs), err_rel(epsilon_rel),
       k1(system.getDimension()), k2(system.getDimension()), k3(system.getDimension()),
       k4(system.getDimension()), k5(system.getDimension()), k6(system.getDimension()),
-      last_diff(system.getDimension()), yerr(system.getDimension()), temp(system.getDimension())
+      last_diff(system.getDimension()), yerr(system.getDimension()), temp(system.getDimension()),
+      rcont3(system.getDimension()), rcont4(system.getDimension()), rcont5(system.getDimension())
   {
     // pass...
   }
@@ -92,16 +102,46 @@ public:
   virtual void step(const Eigen::VectorXd &state, double t, Eigen::VectorXd &delta)
   {
     // A new step: recalculate k1:
-    system.evaluate(state, t, k1);
+    evaluateSystem(system, state, t, k1);
     control(state, t, delta, step_size);
   }
 
 
 protected:
+  /** Evaluates the first derivative for the first step. */
+  virtual void beginDense(const Eigen::VectorXd &state, double t)
+  {
+    evaluateSystem(system, state, t, k1);
+  }
+
+  /** Attempts a single step, the derivative at @c state is held in k1. */
+  virtual double attemptStep(const Eigen::VectorXd &state, double t, double h, Eigen::VectorXd &delta)
+  {
+    return _step(state, t, delta, h);
+  }
+
+  /** Assembles the coefficients of the continuous extension, last_diff becomes k1. */
+  virtual void acceptStep(const Eigen::VectorXd &state, double t, double h, const Eigen::VectorXd &delta)
+  {
+    rcont3.noalias() = h*k1 - delta;
+    rcont4.noalias() = delta - h*last_diff - rcont3;
+    rcont5.noalias() = h*(d1*k1 + d3*k3 + d4*k4 + d5*k5 + d6*k6 + d7*last_diff);
+    k1.noalias() = last_diff;
+  }
+
+  /** Evaluates the continuous extension. */
+  virtual void interpolateStep(double theta, Eigen::VectorXd &state)
+  {
+    double theta1 = 1-theta;
+    state.noalias() = _state0 + theta*(_delta + theta1*(rcont3 + theta*(rcont4 + theta1*rcont5)));
+  }
+
   /**
-   * Implements the step-size control.
+   * Implements the step-size control, a rejected step is performed as two halved steps at the
+   * next level of the recursion.
    */
-  void control(const Eigen::VectorXd &state, double t, Eigen::VectorXd &delta, double dt)
+  void control(const Eigen::VectorXd &state, double t, Eigen::VectorXd &delta, double dt,
+               size_t level=0)
   {
     // Check step-size:
     if (std::abs(dt) <= std::abs(t)*std::numeric_limits<double>::epsilon()) {
@@ -113,10 +153,15 @@ protected:
     // Perform step:
     double err = _step(state, t, delta, dt);
     if (Math::isNotValue<>(err) || 1. < err) {
-      Eigen::VectorXd tmp_delta(this->system.getDimension());
-      control(state, t, delta, dt/2);
-      control(state+delta, t, tmp_delta, dt/2);
-      delta += tmp_delta;
+      _statistics.reject();
+      Eigen::VectorXd &half_state = halfStepWorkspace(level, 0, system.getDimension());
+      Eigen::VectorXd &half_delta = halfStepWorkspace(level, 1, system.getDimension());
+      control(state, t, delta, dt/2, level+1);
+      half_state.noalias() = state + delta;
+      control(half_state, t+dt/2, half_delta, dt/2, level+1);
+      delta += half_delta;
+    } else {
+      _statistics.accept(dt);
     }
 
     // Copy last-diff to k1:
@@ -131,17 +176,24 @@ protected:
   {
     // Reuse k1 from last call...
 
-    system.evaluate(state + dt*(a21*k1), t+c2*dt, k2);
-    system.evaluate(state + dt*(a31*k1 + a32*k2), t+c3*dt, k3);
-    system.evaluate(state + dt*(a41*k1 + a42*k2 + a43*k3), t+c4*dt, k4);
-    system.evaluate(state + dt*(a51*k1 + a52*k2 + a53*k3 + a54*k4), t+c5*dt, k5);
-    system.evaluate(state + dt*(a61*k1 + a62*k2 + a63*k3 + a64*k4 + a65*k5), t+dt, k6);
+    // The stage states are assembled in temp to avoid temporaries:
+    temp.noalias() = state + dt*(a21*k1);
+    evaluateSystem(system, temp, t+c2*dt, k2);
+    temp.noalias() = state + dt*(a31*k1 + a32*k2);
+    evaluateSystem(system, temp, t+c3*dt, k3);
+    temp.noalias() = state + dt*(a41*k1 + a42*k2 + a43*k3);
+    evaluateSystem(system, temp, t+c4*dt, k4);
+    temp.noalias() = state + dt*(a51*k1 + a52*k2 + a53*k3 + a54*k4);
+    evaluateSystem(system, temp, t+c5*dt, k5);
+    temp.noalias() = state + dt*(a61*k1 + a62*k2 + a63*k3 + a64*k4 + a65*k5);
+    evaluateSystem(system, temp, t+dt, k6);
 
     // Calc delta:
     delta.noalias() = dt*(a71*k1 + a72*k2 + a73*k3 + a74*k4 + a75*k5 + a76*k6);
 
     // Evaluate at correct t+dt, this will become k1 if the step was successfull:
-    system.evaluate(state + delta, t+dt, last_diff);
+    temp.noalias() = state + delta;
+    evaluateSystem(system, temp, t+dt, last_diff);
 
     // Calc yerr:
     yerr.noalias() = dt*(e1*k1 + e2*k2 + e3*k3 + e4*k4 + e5*k5 + e6*k6 + e7*last_diff);
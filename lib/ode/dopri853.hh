@@ -5,7 +5,7 @@
 #include <iostream>
 #include <eigen3/Eigen/Eigen>
 #include "exception.hh"
-#include "stepper.hh"
+#include "denseoutput.hh"
 #include "math.hh"
 
 
@@ -47,11 +47,15 @@ public:
  * In contrast to the implementation shown in @cite press2007, this implementation uses the maximum
  * norm to estimate the truncation-error of the integration-step.
  *
+ * The stepper also provides the continuous extension of 7th order of the method (see
+ * @c DenseOutputStepper), which needs three additional evaluations of the system per accepted
+ * step.
+ *
  * @ingroup ode
  */
 template <class Sys>
 class Dopri853Stepper
-    : public Stepper, protected Dopri853Constants
+    : public DenseOutputStepper, protected Dopri853Constants
 {
 protected:
   /** Holds a weak reference to the system of ODEs. */
@@ -74,6 +78,14 @@ protected:
   Eigen::VectorXd k10; ///< Some temporary state.
   Eigen::VectorXd yerr5; ///< Holds the error estimate for the 5th order step.
   Eigen::VectorXd yerr3; ///< Holds the error estimate for the 3rd order step.
+  Eigen::VectorXd knew;  ///< Holds the derivative at the end of the accepted step.
+  Eigen::VectorXd temp;  ///< Holds the state of the current stage.
+  Eigen::VectorXd rcont3; ///< Coefficients of the continuous extension.
+  Eigen::VectorXd rcont4; ///< Coefficients of the continuous extension.
+  Eigen::VectorXd rcont5; ///< Coefficients of the continuous extension.
+  Eigen::VectorXd rcont6; ///< Coefficients of the continuous extension.
+  Eigen::VectorXd rcont7; ///< Coefficients of the continuous extension.
+  Eigen::VectorXd rcont8; ///< Coefficients of the continuous extension.
 
 
 public:
@@ -86,12 +98,16 @@ public:
    * @param epsilon_rel Specifies the maximum relative error.
    */
   Dopri853Stepper(Sys &system, double dt, double epsilon_abs, double epsilon_rel)
-    : system(system), step_size(dt), err_abs(epsilon_abs), err_rel(epsilon_rel),
+    : DenseOutputStepper(8, dt),
+      system(system), step_size(dt), err_abs(epsilon_abs), err_rel(epsilon_rel),
       k1(system.getDimension()), k2(system.getDimension()), k3(system.getDimension()),
       k4(system.getDimension()), k5(system.getDimension()), k6(system.getDimension()),
       k7(system.getDimension()), k8(system.getDimension()), k9(system.getDimension()),
       k10(system.getDimension()),
-      yerr5(system.getDimension()), yerr3(system.getDimension())
+      yerr5(system.getDimension()), yerr3(system.getDimension()), knew(system.getDimension()),
+      temp(system.getDimension()),
+      rcont3(system.getDimension()), rcont4(system.getDimension()), rcont5(system.getDimension()),
+      rcont6(system.getDimension()), rcont7(system.getDimension()), rcont8(system.getDimension())
 
   {
     // Pass...
@@ -108,7 +124,7 @@ public:
   virtual void step(const Eigen::VectorXd &state, double t, Eigen::VectorXd &delta)
   {
     // New step, calculate first derivative k1:
-    system.evaluate(state, t, k1);
+    evaluateSystem(system, state, t, k1);
 
     // Now perform integration:
     control(state, t, delta, step_size);
@@ -116,10 +132,67 @@ public:
 
 
 protected:
+  /** Evaluates the first derivative for the first step. */
+  virtual void beginDense(const Eigen::VectorXd &state, double t)
+  {
+    evaluateSystem(system, state, t, k1);
+  }
+
+  /** Attempts a single step, the derivative at @c state is held in k1. */
+  virtual double attemptStep(const Eigen::VectorXd &state, double t, double h, Eigen::VectorXd &delta)
+  {
+    return _step(state, t, delta, h);
+  }
+
+  /**
+   * Assembles the coefficients of the continuous extension as described in @cite press2007, the
+   * derivative at the end of the step becomes k1.
+   */
+  virtual void acceptStep(const Eigen::VectorXd &state, double t, double h, const Eigen::VectorXd &delta)
+  {
+    temp.noalias() = state + delta;
+    evaluateSystem(system, temp, t+h, knew);
+
+    rcont3.noalias() = h*k1 - delta;
+    rcont4.noalias() = delta - h*knew - rcont3;
+    rcont5.noalias() = d41*k1 + d46*k6 + d47*k7 + d48*k8 + d49*k9 + d410*k10 + d411*k2 + d412*k3;
+    rcont6.noalias() = d51*k1 + d56*k6 + d57*k7 + d58*k8 + d59*k9 + d510*k10 + d511*k2 + d512*k3;
+    rcont7.noalias() = d61*k1 + d66*k6 + d67*k7 + d68*k8 + d69*k9 + d610*k10 + d611*k2 + d612*k3;
+    rcont8.noalias() = d71*k1 + d76*k6 + d77*k7 + d78*k8 + d79*k9 + d710*k10 + d711*k2 + d712*k3;
+
+    // Three additional stages, overwrites k10, k2 & k3:
+    temp.noalias() = state + h*(a141*k1 + a147*k7 + a148*k8 + a149*k9 + a1410*k10 + a1411*k2
+                                + a1412*k3 + a1413*knew);
+    evaluateSystem(system, temp, t+c14*h, k10);
+    temp.noalias() = state + h*(a151*k1 + a156*k6 + a157*k7 + a158*k8 + a1511*k2 + a1512*k3
+                                + a1513*knew + a1514*k10);
+    evaluateSystem(system, temp, t+c15*h, k2);
+    temp.noalias() = state + h*(a161*k1 + a166*k6 + a167*k7 + a168*k8 + a169*k9 + a1613*knew
+                                + a1614*k10 + a1615*k2);
+    evaluateSystem(system, temp, t+c16*h, k3);
+
+    rcont5 = h*(rcont5 + d413*knew + d414*k10 + d415*k2 + d416*k3);
+    rcont6 = h*(rcont6 + d513*knew + d514*k10 + d515*k2 + d516*k3);
+    rcont7 = h*(rcont7 + d613*knew + d614*k10 + d615*k2 + d616*k3);
+    rcont8 = h*(rcont8 + d713*knew + d714*k10 + d715*k2 + d716*k3);
+
+    k1.noalias() = knew;
+  }
+
+  /** Evaluates the continuous extension. */
+  virtual void interpolateStep(double theta, Eigen::VectorXd &state)
+  {
+    double theta1 = 1-theta;
+    state.noalias() = _state0 + theta*(_delta + theta1*(rcont3 + theta*(rcont4 + theta1*(
+                                         rcont5 + theta*(rcont6 + theta1*(rcont7 + theta*rcont8))))));
+  }
+
   /**
-   * Implements the step-size control.
+   * Implements the step-size control, a rejected step is performed as two halved steps at the
+   * next level of the recursion.
    */
-  void control(const Eigen::VectorXd &state, double t, Eigen::VectorXd &delta, double dt)
+  void control(const Eigen::VectorXd &state, double t, Eigen::VectorXd &delta, double dt,
+               size_t level=0)
   {
     // Check step-size:
     if (dt <= t*std::numeric_limits<double>::epsilon()) {
@@ -132,13 +205,18 @@ protected:
     double err = _step(state, t, delta, dt);
 
     if (Math::isNotValue<>(err) || 1. < err) {
-      Eigen::VectorXd tmp_delta(this->system.getDimension());
-      control(state, t, delta, dt/2);
-      control(state+delta, t+dt/2, tmp_delta, dt/2);
-      delta += tmp_delta;
+      _statistics.reject();
+      Eigen::VectorXd &half_state = halfStepWorkspace(level, 0, system.getDimension());
+      Eigen::VectorXd &half_delta = halfStepWorkspace(level, 1, system.getDimension());
+      control(state, t, delta, dt/2, level+1);
+      half_state.noalias() = state + delta;
+      control(half_state, t+dt/2, half_delta, dt/2, level+1);
+      delta += half_delta;
     } else {
+      _statistics.accept(dt);
       // Finally, determine last derivative:
-      system.evaluate(state+delta, t+dt, k1);
+      temp.noalias() = state + delta;
+      evaluateSystem(system, temp, t+dt, k1);
     }
   }
 
@@ -149,25 +227,36 @@ protected:
   inline double _step(const Eigen::VectorXd &state, double t, Eigen::VectorXd &delta, double dt)
   {
     // Do it...
-    system.evaluate(state+dt*(a21*k1), t+c2*dt, k2);
-    system.evaluate(state+dt*(a31*k1+a32*k2), t+c3*dt, k3);
-    system.evaluate(state+dt*(a41*k1+a43*k3), t+c4*dt, k4);
-    system.evaluate(state+dt*(a51*k1+a53*k3+a54*k4), t+c5*dt, k5);
-    system.evaluate(state+dt*(a61*k1+a64*k4+a65*k5), t+c6*dt, k6);
-    system.evaluate(state+dt*(a71*k1+a74*k4+a75*k5+a76*k6), t+c7*dt, k7);
-    system.evaluate(state+dt*(a81*k1+a84*k4+a85*k5+a86*k6+a87*k7), t+c8*dt, k8);
-    system.evaluate(state+dt*(a91*k1+a94*k4+a95*k5+a96*k6+a97*k7+a98*k8), t+c9*dt, k9);
-    system.evaluate(state+dt*(a101*k1+a104*k4+a105*k5+a106*k6+a107*k7+a108*k8+a109*k9), t+c10*dt, k10);
-    system.evaluate(state+dt*(a111*k1+a114*k4+a115*k5+a116*k6+a117*k7+a118*k8+a119*k9+a1110*k10), t+c11*dt, k2);
-    system.evaluate(state+dt*(a121*k1+a124*k4+a125*k5+a126*k6+a127*k7+a128*k8+a129*k9+a1210*k10+a1211*k2), t+dt, k3);
+    temp.noalias() = state + dt*(a21*k1);
+    evaluateSystem(system, temp, t+c2*dt, k2);
+    temp.noalias() = state + dt*(a31*k1+a32*k2);
+    evaluateSystem(system, temp, t+c3*dt, k3);
+    temp.noalias() = state + dt*(a41*k1+a43*k3);
+    evaluateSystem(system, temp, t+c4*dt, k4);
+    temp.noalias() = state + dt*(a51*k1+a53*k3+a54*k4);
+    evaluateSystem(system, temp, t+c5*dt, k5);
+    temp.noalias() = state + dt*(a61*k1+a64*k4+a65*k5);
+    evaluateSystem(system, temp, t+c6*dt, k6);
+    temp.noalias() = state + dt*(a71*k1+a74*k4+a75*k5+a76*k6);
+    evaluateSystem(system, temp, t+c7*dt, k7);
+    temp.noalias() = state + dt*(a81*k1+a84*k4+a85*k5+a86*k6+a87*k7);
+    evaluateSystem(system, temp, t+c8*dt, k8);
+    temp.noalias() = state + dt*(a91*k1+a94*k4+a95*k5+a96*k6+a97*k7+a98*k8);
+    evaluateSystem(system, temp, t+c9*dt, k9);
+    temp.noalias() = state + dt*(a101*k1+a104*k4+a105*k5+a106*k6+a107*k7+a108*k8+a109*k9);
+    evaluateSystem(system, temp, t+c10*dt, k10);
+    temp.noalias() = state + dt*(a111*k1+a114*k4+a115*k5+a116*k6+a117*k7+a118*k8+a119*k9+a1110*k10);
+    evaluateSystem(system, temp, t+c11*dt, k2);
+    temp.noalias() = state + dt*(a121*k1+a124*k4+a125*k5+a126*k6+a127*k7+a128*k8+a129*k9+a1210*k10+a1211*k2);
+    evaluateSystem(system, temp, t+dt, k3);
 
     // Get diff:
     delta.noalias() = dt*(b1*k1 + b6*k6 + b7*k7 + b8*k8 + b9*k9 + b10*k10 + b11*k2 + b12*k3);
 
     // Calculate error:
     double err3=0.0, err5=0.0, sk, deno;
-    yerr5 = delta - dt*(bhh1*k1 + bhh2*k9 + bhh3*k3);
-    yerr3 = dt*(er1*k1 + er6*k6 + er7*k7 + er8*k8 + er9*k9 + er10*k10 + er11*k2 + er12*k3);
+    yerr5.noalias() = delta - dt*(bhh1*k1 + bhh2*k9 + bhh3*k3);
+    yerr3.noalias() = dt*(er1*k1 + er6*k6 + er7*k7 + er8*k8 + er9*k9 + er10*k10 + er11*k2 + er12*k3);
 
     for (size_t i=0; i<system.getDimension(); i++)
     {
@@ -184,8 +273,9 @@ protected:
     if (deno <= 0.0)
       deno=1.0;
 
-    /// @todo Tripple-check if this is actually the max-norm error.
-    return err5*err5/std::sqrt(deno);
+    // Note: yerr3 holds the (5th order) error estimate using the er coefficients, yerr5 the
+    // (3rd order) estimate using bhh, see @cite press2007.
+    return err3*err3/std::sqrt(deno);
   }
 
 
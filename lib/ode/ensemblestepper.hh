@@ -0,0 +1,217 @@
+#ifndef __FLUC_ODE_ENSEMBLESTEPPER_HH__
+#define __FLUC_ODE_ENSEMBLESTEPPER_HH__
+
+#include <vector>
+#include <limits>
+#include <eigen3/Eigen/Eigen>
+#include "dopri5.hh"
+#include "stepsizecontroller.hh"
+#include "math.hh"
+
+
+namespace iNA {
+namespace ODE {
+
+
+/**
+ * Integrates an ensemble of @c K independent systems in lockstep using the Dormand-Prince method
+ * of 5th order (see @c Dopri5Stepper).
+ *
+ * All members of the ensemble share the same system of ODEs but may differ in their parameters
+ * and initial states (i.e. a parameter scan). Each member has its own step-size, chosen by its own
+ * @c PIStepSizeController. Within each iteration, all members attempt a step with their current
+ * step-size and the system is evaluated for the whole ensemble at once. Members that reached the
+ * end of the interval or are inactive are masked, i.e. they attempt a step of size 0 and their
+ * state is not changed.
+ *
+ * The states of the ensemble are stored as a matrix with one row per member, hence the values of
+ * a state variable of all members are stored contiguously (structure-of-arrays). The system must
+ * implement <tt>getDimension()</tt>, <tt>size()</tt> returning the number of members and
+ * <tt>evaluate(const Eigen::MatrixXd &states, const Eigen::VectorXd &t, Eigen::MatrixXd &rates)</tt>
+ * (see @c Models::EnsembleInterpreter).
+ *
+ * If the step-size of a member underflows (i.e. the integration of this member fails), the member
+ * gets deactivated and its state is set to NaN, the integration of the remaining members
+ * continues.
+ *
+ * @ingroup ode
+ */
+template <class Sys>
+class EnsembleStepper
+    : protected Dopri5Constants
+{
+protected:
+  /** Holds a weak reference to the system of ODEs. */
+  Sys &system;
+  /** Holds the number of members. */
+  size_t numMembers;
+  /** Holds the initial step-size. */
+  double step_size;
+  /** Holds the maximum absolute error. */
+  double err_abs;
+  /** Holds the maximum relative error. */
+  double err_rel;
+  /** Holds the proposed step-size of each member. */
+  Eigen::VectorXd _h;
+  /** Holds the step-sizes of the current attempt, 0 for masked members. */
+  Eigen::VectorXd h;
+  /** Holds the current time of each member. */
+  Eigen::VectorXd time;
+  /** Holds the time of the stages. */
+  Eigen::VectorXd tstage;
+  /** If false, the member is deactivated. */
+  std::vector<bool> active;
+  /** If true, the member did not reach the end of the current interval yet. */
+  std::vector<bool> running;
+  /** The step-size controller of each member. */
+  std::vector<PIStepSizeController> controller;
+  Eigen::MatrixXd k1; ///< Some temporary state.
+  Eigen::MatrixXd k2; ///< Some temporary state.
+  Eigen::MatrixXd k3; ///< Some temporary state.
+  Eigen::MatrixXd k4; ///< Some temporary state.
+  Eigen::MatrixXd k5; ///< Some temporary state.
+  Eigen::MatrixXd k6; ///< Some temporary state.
+  Eigen::MatrixXd last_diff; ///< Some temporary state.
+  Eigen::MatrixXd delta; ///< Some temporary state.
+  Eigen::MatrixXd yerr; ///< Some temporary state.
+  Eigen::MatrixXd temp; ///< Some temporary state.
+
+
+public:
+  /**
+   * Constructor.
+   *
+   * @param system Specifies the ensemble of systems to integrate.
+   * @param dt Specifies the initial step-size.
+   * @param epsilon_abs Specifies the absolute error for the step.
+   * @param epsilon_rel Specifies the relative error for the step.
+   */
+  EnsembleStepper(Sys &system, double dt, double epsilon_abs, double epsilon_rel)
+    : system(system), numMembers(system.size()), step_size(dt), err_abs(epsilon_abs),
+      err_rel(epsilon_rel), _h(Eigen::VectorXd::Constant(numMembers, dt)), h(numMembers),
+      time(numMembers), tstage(numMembers), active(numMembers, true), running(numMembers, false),
+      controller(numMembers, PIStepSizeController(5)),
+      k1(numMembers, system.getDimension()), k2(numMembers, system.getDimension()),
+      k3(numMembers, system.getDimension()), k4(numMembers, system.getDimension()),
+      k5(numMembers, system.getDimension()), k6(numMembers, system.getDimension()),
+      last_diff(numMembers, system.getDimension()), delta(numMembers, system.getDimension()),
+      yerr(numMembers, system.getDimension()), temp(numMembers, system.getDimension())
+  {
+    // Pass...
+  }
+
+  /** Returns the number of members. */
+  inline size_t size() const { return numMembers; }
+
+  /** Returns true if the member is active. */
+  inline bool isActive(size_t k) const { return active[k]; }
+
+  /** (De-) Activates a member, the state of an inactive member is not changed. */
+  inline void setActive(size_t k, bool enabled) { active[k] = enabled; }
+
+  /** Returns the step-sizes proposed for the next step of each member. */
+  inline const Eigen::VectorXd &stepSizes() const { return _h; }
+
+  /** Resets the step-sizes and controllers of all members. */
+  void reset()
+  {
+    _h.setConstant(step_size);
+    for (size_t k=0; k<numMembers; k++) { controller[k].reset(); }
+  }
+
+  /**
+   * Integrates all active members from @c t to @c t_end.
+   *
+   * @param states Specifies the states of all members at @c t, one row per member. On exit, holds
+   *        the states at @c t_end.
+   */
+  void step(Eigen::MatrixXd &states, double t, double t_end)
+  {
+    size_t num_running = 0;
+    for (size_t k=0; k<numMembers; k++) {
+      running[k] = active[k]; num_running += (running[k] ? 1 : 0);
+    }
+    time.setConstant(t);
+
+    // Derivatives at the initial states, k1 is kept for each member (first same as last):
+    system.evaluate(states, time, k1);
+
+    while (0 < num_running) {
+      // Assemble step-sizes, masked members do not move:
+      for (size_t k=0; k<numMembers; k++) {
+        h(k) = running[k] ? std::min(_h(k), t_end-time(k)) : 0.0;
+      }
+
+      // Perform a step for all members:
+      _step(states);
+
+      // Decide for each member:
+      for (size_t k=0; k<numMembers; k++) {
+        if (! running[k]) { continue; }
+
+        double h_new, err = error(states, k);
+        if (controller[k].accept(err, h(k), h_new)) {
+          states.row(k) += delta.row(k);
+          k1.row(k) = last_diff.row(k);
+          // Keep the proposed step-size if the step was clipped at t_end:
+          bool clipped = (h(k) < _h(k)), last = (h(k) >= t_end-time(k));
+          if (! clipped || h_new < _h(k)) { _h(k) = h_new; }
+          if (last) { time(k) = t_end; running[k] = false; num_running--; }
+          else { time(k) += h(k); }
+        } else {
+          _h(k) = h_new;
+          // Check step-size, deactivate member on underflow:
+          if (_h(k) <= std::abs(time(k))*std::numeric_limits<double>::epsilon()) {
+            states.row(k).setConstant(std::numeric_limits<double>::quiet_NaN());
+            active[k] = false; running[k] = false; num_running--;
+          }
+        }
+      }
+    }
+  }
+
+
+protected:
+  /** Performs a single step of all members with the step-sizes in @c h. */
+  void _step(const Eigen::MatrixXd &states)
+  {
+    temp.noalias() = states + h.asDiagonal()*(a21*k1);
+    tstage = time + c2*h; system.evaluate(temp, tstage, k2);
+    temp.noalias() = states + h.asDiagonal()*(a31*k1 + a32*k2);
+    tstage = time + c3*h; system.evaluate(temp, tstage, k3);
+    temp.noalias() = states + h.asDiagonal()*(a41*k1 + a42*k2 + a43*k3);
+    tstage = time + c4*h; system.evaluate(temp, tstage, k4);
+    temp.noalias() = states + h.asDiagonal()*(a51*k1 + a52*k2 + a53*k3 + a54*k4);
+    tstage = time + c5*h; system.evaluate(temp, tstage, k5);
+    temp.noalias() = states + h.asDiagonal()*(a61*k1 + a62*k2 + a63*k3 + a64*k4 + a65*k5);
+    tstage = time + h; system.evaluate(temp, tstage, k6);
+
+    delta.noalias() = h.asDiagonal()*(a71*k1 + a72*k2 + a73*k3 + a74*k4 + a75*k5 + a76*k6);
+
+    // Evaluate at t+h, this will become k1 if the step of a member was successful:
+    temp.noalias() = states + delta;
+    system.evaluate(temp, tstage, last_diff);
+
+    yerr.noalias() = h.asDiagonal()*(e1*k1 + e2*k2 + e3*k3 + e4*k4 + e5*k5 + e6*k6 + e7*last_diff);
+  }
+
+  /** Returns the error estimate (maximum norm) of the last step of the given member. */
+  inline double error(const Eigen::MatrixXd &states, size_t k)
+  {
+    double err = 0.0, sk;
+    for (int i=0; i<states.cols(); i++) {
+      if (Math::isNotValue(yerr(k,i))) {
+        return std::numeric_limits<double>::infinity();
+      }
+      sk = err_abs + err_rel*std::max(std::abs(states(k,i)), std::abs(states(k,i)+delta(k,i)));
+      err = std::max(err, std::abs(yerr(k,i))/sk);
+    }
+    return err;
+  }
+};
+
+
+}
+}
+
+#endif // __FLUC_ODE_ENSEMBLESTEPPER_HH__
@@ -0,0 +1,10 @@
+#include "event.hh"
+
+using namespace iNA;
+using namespace iNA::ODE;
+
+
+Event::~Event()
+{
+  // Pass...
+}
@@ -0,0 +1,99 @@
+#ifndef __FLUC_ODE_EVENT_HH__
+#define __FLUC_ODE_EVENT_HH__
+
+#include <cmath>
+#include <algorithm>
+#include <eigen3/Eigen/Eigen>
+
+
+namespace iNA {
+namespace ODE {
+
+
+/**
+ * Base class of all events, that may stop the integration of a system (see
+ * @c Stepper::addEvent).
+ *
+ * An event is defined by a scalar event function \f$g(x,t)\f$. The event fires once the event
+ * function changes from a positive value to a non-positive value.
+ *
+ * @ingroup ode
+ */
+class Event
+{
+public:
+  /** Destructor. */
+  virtual ~Event();
+
+  /** Evaluates the event function at the given state and time. */
+  virtual double evaluate(const Eigen::VectorXd &state, double t) = 0;
+};
+
+
+
+/**
+ * Fires once the system reached a steady state, i.e. once the rates of change of all state
+ * variables are smaller than the given tolerances:
+ * \f[
+ *  |f_i(x,t)| \leq \epsilon_{abs} + \epsilon_{rel}|x_i|\,.
+ * \f]
+ * Optionally, only the first state variables are checked (i.e. the mean of an SSE system).
+ *
+ * The system must implement
+ * <tt>evaluate(const Eigen::VectorXd &state, double t, Eigen::VectorXd &rates)</tt>.
+ *
+ * @ingroup ode
+ */
+template <class Sys>
+class SteadyStateEvent : public Event
+{
+protected:
+  /** Holds a weak reference to the system. */
+  Sys &system;
+  /** Holds the absolute tolerance. */
+  double err_abs;
+  /** Holds the relative tolerance. */
+  double err_rel;
+  /** Holds the number of leading state variables to check, all if 0. */
+  size_t dimension;
+  /** Holds the rates of change. */
+  Eigen::VectorXd rates;
+
+public:
+  /**
+   * Constructor.
+   *
+   * @param system Specifies the system.
+   * @param epsilon_abs Specifies the absolute tolerance of the rates.
+   * @param epsilon_rel Specifies the tolerance of the rates relative to the state.
+   * @param dimension Specifies the number of leading state variables to check, all if 0.
+   */
+  SteadyStateEvent(Sys &system, double epsilon_abs, double epsilon_rel, size_t dimension=0)
+    : system(system), err_abs(epsilon_abs), err_rel(epsilon_rel), dimension(dimension), rates()
+  {
+    // Pass...
+  }
+
+  /** Returns the largest scaled rate minus one. */
+  virtual double evaluate(const Eigen::VectorXd &state, double t)
+  {
+    rates.resize(state.size());
+    system.evaluate(state, t, rates);
+
+    double value = 0;
+    int n = (0 == dimension) ? int(state.size()) : std::min(int(dimension), int(state.size()));
+    for (int i=0; i<n; i++) {
+      double r = std::abs(rates(i))/(err_abs + err_rel*std::abs(state(i)));
+      // NaNs never indicate a steady state:
+      if (! (r == r)) { return 1; }
+      value = std::max(value, r);
+    }
+    return value - 1;
+  }
+};
+
+
+}
+}
+
+#endif // __FLUC_ODE_EVENT_HH__
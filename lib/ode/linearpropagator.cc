@@ -0,0 +1,79 @@
+#include "linearpropagator.hh"
+#include <cmath>
+#include <algorithm>
+
+using namespace iNA;
+using namespace iNA::ODE;
+
+
+LinearPropagator::LinearPropagator()
+  : _propagator(), _offset(), _dt(0)
+{
+  // Pass...
+}
+
+
+void
+LinearPropagator::initialize(const Eigen::MatrixXd &A, const Eigen::VectorXd &b, double dt)
+{
+  size_t n = A.rows();
+
+  // Assemble augmented matrix:
+  Eigen::MatrixXd M = Eigen::MatrixXd::Zero(n+1, n+1);
+  M.topLeftCorner(n, n) = dt*A;
+  M.topRightCorner(n, 1) = dt*b;
+
+  Eigen::MatrixXd expM;
+  exponential(M, expM);
+
+  _propagator = expM.topLeftCorner(n, n);
+  _offset = expM.topRightCorner(n, 1);
+  _dt = dt;
+}
+
+
+void
+LinearPropagator::propagate(const Eigen::VectorXd &y, Eigen::VectorXd &y_new) const
+{
+  y_new = _offset;
+  y_new.noalias() += _propagator*y;
+}
+
+
+void
+LinearPropagator::exponential(const Eigen::MatrixXd &A, Eigen::MatrixXd &expA)
+{
+  // Coefficients of the [13/13] Pade approximant:
+  static const double b[] = {
+    64764752532480000., 32382376266240000., 7771770303897600., 1187353796428800.,
+    129060195264000., 10559470521600., 670442572800., 33522128640., 1323241920., 40840800.,
+    960960., 16380., 182., 1. };
+  // Maximum 1-norm of the scaled matrix:
+  static const double theta13 = 5.371920351148152;
+
+  size_t n = A.rows();
+
+  // Scale A such that ||A/2^s||_1 <= theta13:
+  double norm = A.cwiseAbs().colwise().sum().maxCoeff();
+  int s = 0;
+  if (norm > theta13) {
+    s = int(std::ceil(std::log(norm/theta13)/std::log(2.)));
+  }
+  Eigen::MatrixXd As = A/std::pow(2., s);
+
+  // Evaluate the numerator (V+U) and denominator (V-U) of the approximant:
+  Eigen::MatrixXd I = Eigen::MatrixXd::Identity(n, n);
+  Eigen::MatrixXd A2 = As*As, A4 = A2*A2, A6 = A4*A2;
+  Eigen::MatrixXd tmp = b[13]*A6 + b[11]*A4 + b[9]*A2;
+  Eigen::MatrixXd U = A6*tmp + b[7]*A6 + b[5]*A4 + b[3]*A2 + b[1]*I;
+  U = As*U;
+  tmp = b[12]*A6 + b[10]*A4 + b[8]*A2;
+  Eigen::MatrixXd V = A6*tmp + b[6]*A6 + b[4]*A4 + b[2]*A2 + b[0]*I;
+
+  expA = (V-U).partialPivLu().solve(V+U);
+
+  // Undo scaling by repeated squaring:
+  for (int i=0; i<s; i++) {
+    tmp.noalias() = expA*expA; expA = tmp;
+  }
+}
@@ -0,0 +1,69 @@
+#ifndef __FLUC_ODE_LINEARPROPAGATOR_HH__
+#define __FLUC_ODE_LINEARPROPAGATOR_HH__
+
+#include <eigen3/Eigen/Eigen>
+
+
+namespace iNA {
+namespace ODE {
+
+
+/**
+ * Propagates the solution of a linear system of ODEs with constant coefficients
+ * \f[
+ *  \dot{y} = Ay + b
+ * \f]
+ * exactly over a fixed time step \f$\Delta t\f$.
+ *
+ * The solution is \f$y(t+\Delta t) = e^{A\Delta t}y(t) + \int_0^{\Delta t}e^{As}\,ds\, b\f$. Both
+ * terms are obtained at once from the exponential of the augmented matrix
+ * \f[
+ *  \exp\left(\left(\begin{array}{cc} A & b \\ 0 & 0\end{array}\right)\Delta t\right)
+ *   = \left(\begin{array}{cc} e^{A\Delta t} & \int_0^{\Delta t}e^{As}\,ds\, b \\
+ *      0 & 1\end{array}\right)\,,
+ * \f]
+ * which is computed once by @c initialize. Each step (@c propagate) then costs a single
+ * matrix-vector product, independent of the stiffness of the system.
+ *
+ * @ingroup ode
+ */
+class LinearPropagator
+{
+protected:
+  /** Holds the propagator \f$e^{A\Delta t}\f$. */
+  Eigen::MatrixXd _propagator;
+  /** Holds the inhomogeneous part \f$\int_0^{\Delta t}e^{As}ds\,b\f$. */
+  Eigen::VectorXd _offset;
+  /** Holds the time step. */
+  double _dt;
+
+public:
+  /** Constructor. */
+  LinearPropagator();
+
+  /**
+   * Computes and caches the propagator for the system @c A, @c b and time step @c dt.
+   */
+  void initialize(const Eigen::MatrixXd &A, const Eigen::VectorXd &b, double dt);
+
+  /** Returns the dimension of the system. */
+  inline size_t getDimension() const { return _offset.size(); }
+
+  /** Returns the time step. */
+  inline double getStepSize() const { return _dt; }
+
+  /** Propagates the state @c y by one time step. */
+  void propagate(const Eigen::VectorXd &y, Eigen::VectorXd &y_new) const;
+
+  /**
+   * Computes the matrix exponential of @c A using the scaling and squaring method with a
+   * [13/13] Pade approximant as described in @cite higham2005.
+   */
+  static void exponential(const Eigen::MatrixXd &A, Eigen::MatrixXd &expA);
+};
+
+
+}
+}
+
+#endif // __FLUC_ODE_LINEARPROPAGATOR_HH__
@@ -13,6 +13,7 @@ const double LsodaConstants::ETA = 2.2204460492503131e-16;
 
 LSODA::LSODA()
  : g_nyh(0), g_lenyh(0),
+   band_ml(0), band_mu(0),
    illin(0), init(0), ntrep(0), ixpr(0), //< variables for lsoda()
    lsoda_warning(1)
 
@@ -23,10 +24,17 @@ LSODA::LSODA()
 
     // Set pointer vars to zero
     yh = 0; wm = 0;
-    ewt = 0; savf = 0; acor = 0; ipvt = 0;
+    ewt = 0; savf = 0; acor = 0; ftem = 0; ipvt = 0;
 
 }
 
+void
+LSODA::setBandwidth(int ml, int mu)
+{
+    band_ml = ml;
+    band_mu = mu;
+}
+
 size_t
 LSODA::numFunctionsEvaluations()
 {
@@ -39,6 +47,18 @@ LSODA::numJacobianEvaluations()
     return nje;
 }
 
+size_t
+LSODA::numSteps()
+{
+    return nst;
+}
+
+double
+LSODA::lastStepSize()
+{
+    return hu;
+}
+
 /* Terminate lsoda due to illegal input. */
 void
 LSODA::terminate(int *istate)
@@ -307,6 +327,20 @@ LSODA::lsoda (int neq, double *y, double *t, double tout,
                 jtyp = jt;
                 ml = 0;
                 mu = 0;
+                if (jt > 2) {
+                        ml = band_ml;
+                        mu = band_mu;
+                        if (ml < 0 || ml >= n) {
+                                printf("[lsoda] ml = %d not between 1 and neq\n", ml);
+                                terminate(istate);
+                                return;
+                        }
+                        if (mu < 0 || mu >= n) {
+                                printf("[lsoda] mu = %d not between 1 and neq\n", mu);
+                                terminate(istate);
+                                return;
+                        }
+                }
 
                 /* Next process and check the optional inputs.   */
 
@@ -429,6 +463,8 @@ LSODA::lsoda (int neq, double *y, double *t, double tout,
 
                 acor = new double [1 + nyh];
 
+                ftem = new double [1 + nyh];
+
                 ipvt = new int [1 + nyh];
         }
         /*
@@ -1543,31 +1579,47 @@ LSODA::scaleh (double *rh, double *pdh)
 void
 LSODA::prja (int neq, double *y)
 {
-        int             i, ier, j;
+        int             i, ier, j, jj, mband;
         double          fac, hl0, r, r0, yj;
         /*
         prja is called by stoda to compute and process the matrix
         P = I - h * el[1] * J, where J is an approximation to the Jacobian.
-        Here J is computed by finite differencing.
+        Here J is computed by the user-supplied routine evalJac if
+        miter = 1 or 4, or by finite differencing if miter = 2 or 5.
         J, scaled by -h * el[1], is stored in wm.  Then the norm of J ( the
         matrix norm consistent with the weighted max-norm on vectors given
         by vmnorm ) is computed, and J is overwritten by P.  P is then
         subjected to LU decomposition in preparation for later solution
         of linear systems with p as coefficient matrix.  This is done
-        by dgefa if miter = 2, and by dgbfa if miter = 5.
+        by dgefa if miter = 1 or 2, and by dgbfa if miter = 4 or 5.
         */
         nje++;
         ierpj = 0;
         jcur = 1;
         hl0 = h * el0;
         /*
-        If miter = 2, make n calls to f to approximate J.
+        If miter = 1 or 4, call evalJac and multiply by scalar.
         */
-        if (miter != 2) {
-                printf("[prja] miter != 2\n");
-                return;
+        if (miter == 1 || miter == 4) {
+                for (i = 1; i <= n; i++)
+                        for (j = 1; j <= n; j++)
+                                wm[i][j] = 0.;
+                evalJac(tn, y+1, wm, neq);
+                fac = -hl0;
+                if (miter == 1) {
+                        for (i = 1; i <= n; i++)
+                                for (j = 1; j <= n; j++)
+                                        wm[i][j] *= fac;
+                } else {
+                        for (i = 1; i <= n; i++)
+                                for (j = std::max(1, i - ml); j <= std::min(n, i + mu); j++)
+                                        wm[i][j] *= fac;
+                }
         }
-        if (miter == 2) {
+        /*
+        If miter = 2, make n calls to f to approximate J.
+        */
+        else if (miter == 2) {
                 fac = vmnorm(n, savf, ewt);
                 r0 = 1000. * fabs(h) * ETA * ((double) n) * fac;
                 if (r0 == 0.)
@@ -1583,23 +1635,63 @@ LSODA::prja (int neq, double *y)
                         y[j] = yj;
                 }
                 nfe += n;
-                /*
-                Compute norm of Jacobian.
-                */
-                pdnorm = fnorm(n, wm, ewt) / fabs(hl0);
-                /*
-                Add identity matrix.
-                */
+        }
+        /*
+        If miter = 5, make mband calls to f to approximate J, perturbing
+        all columns at once that do not share a row within the band.
+        */
+        else if (miter == 5) {
+                mband = ml + mu + 1;
                 for (i = 1; i <= n; i++)
-                        wm[i][i] += 1.;
-                /*
-                Do LU decomposition on P.
-                */
-                dgefa(wm, n, ipvt, &ier);
-                if (ier != 0)
-                        ierpj = 1;
+                        for (j = 1; j <= n; j++)
+                                wm[i][j] = 0.;
+                fac = vmnorm(n, savf, ewt);
+                r0 = 1000. * fabs(h) * ETA * ((double) n) * fac;
+                if (r0 == 0.)
+                        r0 = 1.;
+                for (jj = 1; jj <= std::min(mband, n); jj++) {
+                        for (j = jj; j <= n; j += mband) {
+                                yj = y[j];
+                                r = std::max(sqrteta * fabs(yj), r0 / ewt[j]);
+                                acor[j] = yj;
+                                y[j] += r;
+                        }
+                        evalODE(tn, y+1, ftem+1, neq);
+                        for (j = jj; j <= n; j += mband) {
+                                yj = acor[j];
+                                r = y[j] - yj;
+                                y[j] = yj;
+                                fac = -hl0 / r;
+                                for (i = std::max(1, j - mu); i <= std::min(n, j + ml); i++)
+                                        wm[i][j] = (ftem[i] - savf[i]) * fac;
+                        }
+                }
+                nfe += std::min(mband, n);
+        }
+        else {
+                printf("[prja] miter = %d illegal\n", miter);
+                ierpj = 1;
                 return;
         }
+        /*
+        Compute norm of Jacobian.
+        */
+        pdnorm = fnorm(n, wm, ewt) / fabs(hl0);
+        /*
+        Add identity matrix.
+        */
+        for (i = 1; i <= n; i++)
+                wm[i][i] += 1.;
+        /*
+        Do LU decomposition on P.
+        */
+        if (miter == 1 || miter == 2)
+                dgefa(wm, n, ipvt, &ier);
+        else
+                dgbfa(wm, n, ml, mu, ipvt, &ier);
+        if (ier != 0)
+                ierpj = 1;
+        return;
 }				/* end prja   */
 
 
@@ -1788,8 +1880,8 @@ LSODA::solsy (double *y)
 /*
    This routine manages the solution of the linear system arising from
    a chord iteration.  It is called if miter != 0.
-   If miter is 2, it calls dgesl to accomplish this.
-   If miter is 5, it calls dgbsl.
+   If miter is 1 or 2, it calls dgesl to accomplish this.
+   If miter is 4 or 5, it calls dgbsl.
 
    y = the right-hand side vector on input, and the solution vector
        on output.
@@ -1797,12 +1889,12 @@ LSODA::solsy (double *y)
 
 {
         iersl = 0;
-        if (miter != 2) {
-                printf("solsy -- miter != 2\n");
-                return;
-        }
-        if (miter == 2)
+        if (miter == 1 || miter == 2)
                 dgesl(wm, n, ipvt, y, 0);
+        else if (miter == 4 || miter == 5)
+                dgbsl(wm, n, ml, mu, ipvt, y);
+        else
+                printf("solsy -- miter = %d illegal\n", miter);
         return;
 
 }
@@ -2125,10 +2217,11 @@ LSODA::_freevectors(void)
   if(0 != this->ewt)  delete[] this->ewt;
   if(0 != this->savf) delete[] this->savf;
   if(0 != this->acor) delete[] this->acor;
+  if(0 != this->ftem) delete[] this->ftem;
   if(0 != this->ipvt) delete[] this->ipvt;
 
   yh = 0; wm = 0;
-  ewt = 0; savf = 0; acor = 0; ipvt = 0;
+  ewt = 0; savf = 0; acor = 0; ftem = 0; ipvt = 0;
 
 }
 
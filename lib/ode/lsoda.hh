@@ -65,8 +65,13 @@ public:
 */
 
 /** Repack of LSODA c from fortran tanslation
- * @todo convert all printf to exceptions
- * @todo incoorporate analytical Jacobian */
+ *
+ * The Jacobian type @c jt passed to @c lsoda selects how the Jacobian is obtained during the
+ * stiff (BDF) phase: 1 = user supplied full Jacobian (see @c evalJac), 2 = full Jacobian by
+ * finite differences, 4 = user supplied banded Jacobian, 5 = banded Jacobian by finite
+ * differences. The bandwidths of banded Jacobians are set with @c setBandwidth.
+ *
+ * @todo convert all printf to exceptions */
 class LSODA : public LsodaConstants {
 
 public:
@@ -87,7 +92,11 @@ public:
   * anyway. However, it seems not to be crucial as the benchmarks shows.*/
  virtual void evalODE (double x, double y[], double yd[], int n)=0;
 
- /** @todo The same as above. */
+ /** Evaluates the Jacobian at (x, y) into @c jac. Like the working memory of LSODA, the
+  * Jacobian is stored with 1-based indices, i.e. jac[i][j] = df_i/dy_j for i,j = 1,...,n. All
+  * elements are zero on entry. For banded Jacobians (jt = 4), only the elements within the band
+  * need to be set. Note, unlike @c jac, @c y is 0-based (as for @c evalODE).
+  * @todo The same as above. */
  virtual void evalJac (double x, double *y, double **jac, int n)=0;
 
  void f_lsoda (double t, double dt, double y[], int n, double eps);
@@ -97,10 +106,17 @@ public:
              int itol, double *rtol, double *atol,
              int itask, int *istate, int iopt, int jt   );
 
+ /** Sets the lower (ml) and upper (mu) bandwidth of the Jacobian used if jt = 4 or 5. */
+ void setBandwidth(int ml, int mu);
+
  /** Returns the number of function evaluations made during integration. */
  size_t numFunctionsEvaluations();
  /** Returns the number of Jacobian evaluations made during integration. */
  size_t numJacobianEvaluations();
+ /** Returns the number of steps made during integration. */
+ size_t numSteps();
+ /** Returns the step-size of the last successful step. */
+ double lastStepSize();
 
 
 private:
@@ -132,6 +148,8 @@ private:
 /* newly added static variables */
 
  int      ml, mu, imxer;
+ /* bandwidth of the Jacobian as set by setBandwidth() */
+ int      band_ml, band_mu;
  double   sqrteta, *yp1, *yp2;
 
 /* static variables for lsoda() */
@@ -157,7 +175,7 @@ private:
 
 /* static variables for various vectors and the Jacobian. */
 
- double  **yh, **wm, *ewt, *savf, *acor;
+ double  **yh, **wm, *ewt, *savf, *acor, *ftem;
  int     *ipvt;
 
  int lsoda_warning;
@@ -16,6 +16,11 @@ namespace ODE {
 /**
  * Drives the LSODA integrator
  *
+ * By default, the analytic Jacobian provided by the system (i.e. the compiled Jacobian of the
+ * SSE interpreters) is used in the stiff phase of LSODA. This avoids the N additional evaluations
+ * of the ODEs needed to approximate the Jacobian by finite differences. For systems with a banded
+ * Jacobian, @c setBandwidth restricts the evaluation and LU decomposition to the band.
+ *
  * @ingroup ode
  */
 template <class Sys>
@@ -30,10 +35,15 @@ public:
    * @param dt Specifies the default/maximum step-size.
    * @param epsilon_abs Specifies the absolute error for the step.
    * @param epsilon_rel Specifies the relative error for the step.
+   * @param analytic_jacobian If true, the Jacobian of the system is used, otherwise the Jacobian
+   *        is approximated by finite differences.
    */
-  LsodaDriver(Sys &system, double dt, double epsilon_abs, double epsilon_rel)
+  LsodaDriver(Sys &system, double dt, double epsilon_abs, double epsilon_rel,
+              bool analytic_jacobian=true)
       : system(system), step_size(dt), err_abs(epsilon_abs), err_rel(epsilon_rel),
-        ywork(0), atolwork(0), rtolwork(0)
+        jac_type(analytic_jacobian ? 1 : 2), lower_bw(0), upper_bw(0), ywork(0), atolwork(0), rtolwork(0),
+        jac_state(getDimension()), jac_work(getDimension(), getDimension()),
+        last_nfe(0), last_nje(0), last_nst(0)
   {
     istate=1;
     // allocate working memory:
@@ -59,16 +69,19 @@ public:
   /** Performs the step t -> t+dt. */
   virtual void step(const Eigen::VectorXd &state, double t, Eigen::VectorXd &delta) {
     for (size_t i = 1; i <= getDimension(); ++i) { ywork[i] = state[i-1]; }
-    lsoda(getDimension(), ywork, &t, t+step_size, 2, rtolwork, atolwork, 1, &istate, 0, 2);
+    lsoda(getDimension(), ywork, &t, t+step_size, 2, rtolwork, atolwork, 1, &istate, 0, jac_type);
+    updateStatistics();
     for (size_t i = 1; i <= getDimension(); ++i) { delta[i-1] = ywork[i]-state[i-1]; }
   }
 
   virtual void step(Eigen::VectorXd &state, double t) {
-    lsoda(getDimension(), state.data()-1, &t, t+step_size, 2, rtolwork, atolwork, 1, &istate, 0, 2);
+    lsoda(getDimension(), state.data()-1, &t, t+step_size, 2, rtolwork, atolwork, 1, &istate, 0, jac_type);
+    updateStatistics();
   }
 
   virtual void step(Eigen::VectorXd &state, double t_in, double t_out) {
-    lsoda(getDimension(), state.data()-1, &t_in, t_out, 2, rtolwork, atolwork, 1, &istate, 0, 2);
+    lsoda(getDimension(), state.data()-1, &t_in, t_out, 2, rtolwork, atolwork, 1, &istate, 0, jac_type);
+    updateStatistics();
   }
 
   virtual void evalODE(double t, double y[], double yd[], int nsize) {
@@ -76,10 +89,34 @@ public:
   }
 
   virtual void evalJac(double t, double *y, double **jac, int nsize) {
-    // @todo implement.
+    for (int i=0; i<nsize; i++) { jac_state(i) = y[i]; }
+    system.evaluateJacobian(jac_state, t, jac_work);
+
+    // LSODA stores the Jacobian row-wise with 1-based indices:
+    if (1 == jac_type) {
+      for (int i=0; i<nsize; i++) {
+        for (int j=0; j<nsize; j++) { jac[i+1][j+1] = jac_work(i,j); }
+      }
+    } else {
+      for (int i=0; i<nsize; i++) {
+        int first = std::max(0, i-int(lower_bw)), last = std::min(nsize-1, i+int(upper_bw));
+        for (int j=first; j<=last; j++) { jac[i+1][j+1] = jac_work(i,j); }
+      }
+    }
   }
 
 public:
+  /**
+   * Declares the Jacobian of the system as banded with @c lower sub- and @c upper
+   * super-diagonals. Elements outside of the band are ignored.
+   */
+  void setBandwidth(size_t lower, size_t upper) {
+    lower_bw = lower; upper_bw = upper;
+    jac_type = (2 == jac_type || 5 == jac_type) ? 5 : 4;
+    LSODA::setBandwidth(int(lower), int(upper));
+    istate = 1; last_nfe = last_nje = last_nst = 0;
+  }
+
   /** Returns the step-size used to integrate. */
   inline double getStepSize() {
     return this->step_size;
@@ -92,7 +129,8 @@ public:
 
   /** Resets the status. */
   void reset() {
-    istate = 1;
+    // LSODA resets its counters on restart:
+    istate = 1; last_nfe = last_nje = last_nst = 0;
   }
 
   /** Resets the status. */
@@ -100,6 +138,21 @@ public:
     istate = 3;
   }
 
+protected:
+  /**
+   * Surfaces the counters of LSODA in the statistics of the stepper. LSODA decomposes the
+   * iteration matrix once for each evaluation of the Jacobian and does not count rejected steps.
+   */
+  void updateStatistics()
+  {
+    _statistics.count(StepperStatistics::RHS, numFunctionsEvaluations()-last_nfe);
+    _statistics.count(StepperStatistics::JACOBIAN, numJacobianEvaluations()-last_nje);
+    _statistics.count(StepperStatistics::DECOMPOSITION, numJacobianEvaluations()-last_nje);
+    _statistics.countAccepted(numSteps()-last_nst);
+    _statistics.updateStepSize(lastStepSize());
+    last_nfe = numFunctionsEvaluations(); last_nje = numJacobianEvaluations(); last_nst = numSteps();
+  }
+
 protected:
   /** Holds a weak reference to the system of ODEs. */
   Sys &system;
@@ -109,12 +162,28 @@ protected:
   double err_abs;
   /** Holds the maximum relative error. */
   double err_rel;
+  /** Holds the Jacobian type passed to LSODA (1: full, 2: full FD, 4: banded, 5: banded FD). */
+  int jac_type;
+  /** Holds the lower bandwidth of the Jacobian. */
+  size_t lower_bw;
+  /** Holds the upper bandwidth of the Jacobian. */
+  size_t upper_bw;
   /** Allocated working memory for LSODA. */
   double *ywork;
   /** Pointer to the absolute error vector (part of ywork). */
   double *atolwork;
   /** Pointer to the relative error vector (part of ywork). */
   double *rtolwork;
+  /** Holds the state the Jacobian is evaluated at. */
+  Eigen::VectorXd jac_state;
+  /** Holds the Jacobian of the system. */
+  Eigen::MatrixXd jac_work;
+  /** Holds the number of function evaluations reported by LSODA at the last step. */
+  size_t last_nfe;
+  /** Holds the number of Jacobian evaluations reported by LSODA at the last step. */
+  size_t last_nje;
+  /** Holds the number of steps reported by LSODA at the last step. */
+  size_t last_nst;
 };
 
 
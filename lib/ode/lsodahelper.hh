@@ -543,3 +543,150 @@ void dgefa (double **a, int n, int *ipvt, int *info)
                 *info = n;
 
 }
+
+/***********
+ * dgbfa.c *
+ ***********/
+
+void dgbfa (double **a, int n, int ml, int mu, int *ipvt, int *info)
+
+/*
+   Purpose : dgbfa factors a double band matrix by Gaussian elimination.
+
+   This version operates on the same full storage as dgefa, but only
+   touches the elements within the band (including the fill-in due to
+   pivoting). Hence the factorization costs O(n*ml*(ml+mu)) instead of
+   O(n^3) operations.
+
+
+   On Entry :
+
+      a   : double matrix of dimension ( n+1, n+1 ),
+            the 0-th row and column are not used.
+            All elements outside of the band must be zero.
+      n   : the row dimension of a.
+      ml  : number of diagonals below the main diagonal, i.e.
+            a[i][j] = 0 for i-j > ml.
+      mu  : number of diagonals above the main diagonal, i.e.
+            a[i][j] = 0 for j-i > mu.
+
+   On Return :
+
+      a, ipvt, *info : see dgefa.
+
+   BLAS : daxpy, dscal, idamax
+*/
+
+{
+        int             j, k, i, lm, ju;
+        double          t;
+
+        /* Gaussian elimination with partial pivoting.   */
+
+        *info = 0;
+        ju = 0;
+        for (k = 1; k <= n - 1; k++) {
+                /*
+                Find j = pivot index within the band.
+                */
+                lm = std::min(mu, n - k);
+                j = idamax(lm + 1, a[k] + k - 1, 1) + k - 1;
+                ipvt[k] = j;
+                /*
+                Zero pivot implies this row already triangularized.
+                */
+                if (a[k][j] == 0.) {
+                        *info = k;
+                        continue;
+                }
+                /*
+                Track the fill-in due to the interchange.
+                */
+                ju = std::min(std::max(ju, ml + j), n);
+                /*
+                Interchange if necessary.
+                */
+                if (j != k) {
+                        t = a[k][j];
+                        a[k][j] = a[k][k];
+                        a[k][k] = t;
+                }
+                /*
+                Compute multipliers.
+                */
+                t = -1. / a[k][k];
+                dscal(lm, t, a[k] + k, 1);
+                /*
+                Column elimination with row indexing.
+                */
+                for (i = k + 1; i <= ju; i++) {
+                        t = a[i][j];
+                        if (j != k) {
+                                a[i][j] = a[i][k];
+                                a[i][k] = t;
+                        }
+                        daxpy(lm, t, a[k] + k, 1, a[i] + k, 1);
+                }
+        }			/* end k-loop  */
+
+        ipvt[n] = n;
+        if (a[n][n] == 0.)
+                *info = n;
+
+}
+
+/***********
+ * dgbsl.c *
+ ***********/
+
+void dgbsl (double **a, int n, int ml, int mu, int *ipvt, double *b)
+
+/*
+   Purpose : dgbsl solves the linear system a * x = b using the
+   factors computed by dgbfa.
+
+
+   On Entry :
+
+      a    : the output from dgbfa.
+      n    : the row dimension of a.
+      ml   : number of diagonals below the main diagonal.
+      mu   : number of diagonals above the main diagonal.
+      ipvt : the pivot vector from dgbfa.
+      b    : the right hand side vector.
+
+
+   On Return :
+
+      b : the solution vector x.
+
+   BLAS : ddot
+*/
+
+{
+        int             k, j, lm;
+        double          t;
+
+        /*
+        First solve L * y = b.
+        */
+        for (k = 1; k <= n; k++) {
+                lm = std::min(k - 1, ml + mu);
+                t = ddot(lm, a[k] + k - lm - 1, 1, b + k - lm - 1, 1);
+                b[k] = (b[k] - t) / a[k][k];
+        }
+        /*
+        Now solve U * x = y.
+        */
+        for (k = n - 1; k >= 1; k--) {
+                lm = std::min(mu, n - k);
+                b[k] = b[k] + ddot(lm, a[k] + k, 1, b + k, 1);
+                j = ipvt[k];
+                if (j != k) {
+                        t = b[j];
+                        b[j] = b[k];
+                        b[k] = t;
+                }
+        }
+
+}
@@ -9,7 +9,26 @@
  * @c RungeKutta4.
  *
  * There are also some steppers with adaptive step-size control: @c RKF45, @c Dopri5Stepper,
- * @c Dopri853Stepper, @c Rosenbrock3TimeInd and @c Rosenbrock4TimeInd.
+ * @c Dopri853Stepper, @c Rosenbrock3TimeInd and @c Rosenbrock4TimeInd. For large systems with
+ * sparse Jacobians, @c SparseRosenbrock3TimeInd and @c SparseRosenbrock4TimeInd use a sparse LU
+ * decomposition instead. The variable-order @c BDFStepper integrates very stiff and large systems
+ * with a pluggable linear solver (@c BDFDenseSolver, @c BDFSparseSolver or @c BDFGMRESSolver).
+ *
+ * The explicit adaptive steppers @c RKF45, @c Dopri5Stepper and @c Dopri853Stepper also provide
+ * a continuous extension (see @c DenseOutputStepper). The @c DenseOutputDriver uses it to
+ * integrate over an @c IntegrationRange with a step-size independent of the output grid.
+ *
+ * The @c EnsembleStepper integrates many instances of the same system (e.g. for different
+ * parameters) in lockstep, evaluating the system for all instances at once.
+ *
+ * The integration may be stopped by events (see @c Event and @c Stepper::addEvent), i.e. once the
+ * system reached its steady state (@c SteadyStateEvent).
+ *
+ * All steppers count the evaluations of the system, its Jacobian, the decompositions and the
+ * accepted and rejected steps (see @c StepperStatistics and @c Stepper::statistics).
+ *
+ * Linear systems with constant coefficients can be propagated exactly using the matrix
+ * exponential (see @c LinearPropagator).
  *
  * There is also a convenience class (@c ODEModel) that assembles an ODE system from a vector of
  * GiNaC symbols and GiNaC expressions, it also automatically derives the Jacobian from the ODE
@@ -21,7 +40,10 @@
 
 #include "integrationrange.hh"
 #include "odemodel.hh"
+#include "event.hh"
+#include "stepperstatistics.hh"
 #include "stepper.hh"
+#include "denseoutput.hh"
 
 #include "eulerdriver.hh"
 #include "rungekutta4.hh"
@@ -33,5 +55,10 @@
 #include "semiimpliciteuler.hh"
 #include "rosenbrock3.hh"
 #include "rosenbrock4.hh"
+#include "staggeredrosenbrock4.hh"
+#include "sparserosenbrock.hh"
+#include "bdf.hh"
+#include "ensemblestepper.hh"
+#include "linearpropagator.hh"
 
 #endif // ODE_HH
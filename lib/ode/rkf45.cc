@@ -15,7 +15,7 @@ const double RKF45Constants::a51 = 439.0/216.0;
 const double RKF45Constants::a52 = -8.0;
 const double RKF45Constants::a53 = 3680.0/513.0;
 const double RKF45Constants::a54 = -845.0/4104.0;
-const double RKF45Constants::a61 = 8.0/25.0;
+const double RKF45Constants::a61 = -8.0/27.0;
 const double RKF45Constants::a62 = 2.0;
 const double RKF45Constants::a63 = -3544.0/2565.0;
 const double RKF45Constants::a64 = 1859.0/4104.0;
@@ -37,7 +37,7 @@ const double RKF45Constants::b46  = 2.0/55.0;
 const double RKF45Constants::b31  = 25.0/216.0;
 const double RKF45Constants::b32  = 0.0;
 const double RKF45Constants::b33  = 1408.0/2565.0;
-const double RKF45Constants::b34  = 2197.0/4101.0;
+const double RKF45Constants::b34  = 2197.0/4104.0;
 const double RKF45Constants::b35  = -1.0/5.0;
 const double RKF45Constants::b36  = 0.0;
 
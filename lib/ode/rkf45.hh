@@ -6,7 +6,7 @@
 #include <cstdlib>
 #include <cmath>
 #include <vector>
-#include "stepper.hh"
+#include "denseoutput.hh"
 #include "exception.hh"
 #include "math.hh"
 
@@ -55,7 +55,7 @@ public:
  * Which yields the following update-steps for the 4th and 5th order:
  *
  * \f{align}{
- *  \Delta_4 &= \frac{25}{216}k_1 + \frac{1408}{2565}k_3 + \frac{2197}{4101}k_4 - \frac{1}{5}k_5 \\
+ *  \Delta_4 &= \frac{25}{216}k_1 + \frac{1408}{2565}k_3 + \frac{2197}{4104}k_4 - \frac{1}{5}k_5 \\
  *  \Delta_5 &= \frac{16}{135}k_1 + \frac{6656}{12825}k_3 + \frac{28561}{56430}k_4 -
                 \frac{9}{50}k_5 + \frac{2}{55}k_6
  * \f}
@@ -71,11 +71,15 @@ public:
  * where \f$\left|y\right|\f$ is the element wise maximum of \f$\left|y_k\right|\f$ and
  * \f$\left|y_{k+1}\right|\f$.
  *
+ * The continuous extension of the method (see @c DenseOutputStepper) is the cubic Hermite
+ * interpolation between the states and derivatives at both ends of the step. The derivative at
+ * the end of the step is reused as \f$k_1\f$ of the next step.
+ *
  * @ingroup ode
  */
 template <class Sys>
 class RKF45
-    : public Stepper, protected RKF45Constants
+    : public DenseOutputStepper, protected RKF45Constants
 {
 protected:
   /** Holds a weak reference to the ODE system to integrate. */
@@ -92,6 +96,8 @@ protected:
   Eigen::VectorXd k4; ///< Some temporary state.
   Eigen::VectorXd k5; ///< Some temporary state.
   Eigen::VectorXd k6; ///< Some temporary state.
+  Eigen::VectorXd f0; ///< Holds the derivative at the beginning of the last accepted step.
+  Eigen::VectorXd temp; ///< Holds the state of the current stage.
 
 public:
   /**
@@ -103,9 +109,11 @@ public:
    * @param epsilon_rel Specifies the maximum relative error between the 4th and 5th order RK.
    */
   RKF45(Sys &system, double dt, double epsilon_abs, double epsilon_rel)
-    : system(system), step_size(dt), epsilon_abs(epsilon_abs), epsilon_rel(epsilon_rel),
+    : DenseOutputStepper(5, dt),
+      system(system), step_size(dt), epsilon_abs(epsilon_abs), epsilon_rel(epsilon_rel),
       k1(system.getDimension()), k2(system.getDimension()), k3(system.getDimension()),
-      k4(system.getDimension()), k5(system.getDimension()), k6(system.getDimension())
+      k4(system.getDimension()), k5(system.getDimension()), k6(system.getDimension()),
+      f0(system.getDimension()), temp(system.getDimension())
   {
     // Pass
   }
@@ -133,10 +141,40 @@ public:
   }
 
 protected:
+  /** Evaluates the first derivative for the first step. */
+  virtual void beginDense(const Eigen::VectorXd &state, double t)
+  {
+    this->evaluateSystem(this->system, state, t, k1);
+  }
+
+  /** Attempts a single step, the derivative at @c state is held in k1. */
+  virtual double attemptStep(const Eigen::VectorXd &state, double t, double h, Eigen::VectorXd &delta)
+  {
+    return this->single_step(state, t, h, delta);
+  }
+
+  /** Evaluates the derivative at the end of the step, which becomes k1. */
+  virtual void acceptStep(const Eigen::VectorXd &state, double t, double h, const Eigen::VectorXd &delta)
+  {
+    f0.noalias() = k1;
+    temp.noalias() = state + delta;
+    this->evaluateSystem(this->system, temp, t+h, k1);
+  }
+
+  /** Evaluates the cubic Hermite interpolation of the last step. */
+  virtual void interpolateStep(double theta, Eigen::VectorXd &state)
+  {
+    double h = this->_t1 - this->_t0;
+    state.noalias() = this->_state0 + theta*this->_delta + theta*(theta-1)*(
+          (1-2*theta)*this->_delta + (theta-1)*h*f0 + theta*h*k1);
+  }
+
   /**
-   * The actual stepper.
+   * The actual stepper, a rejected step is performed as two halved steps at the next level of the
+   * recursion.
    */
-  void control(const Eigen::VectorXd &state, double time, double dt, Eigen::VectorXd &delta)
+  void control(const Eigen::VectorXd &state, double time, double dt, Eigen::VectorXd &delta,
+               size_t level=0)
   {
     if (dt < time*std::numeric_limits<double>::epsilon())
     {
@@ -144,28 +182,38 @@ protected:
     }
 
     // Make single step and check if error is small:
+    this->evaluateSystem(this->system, state, time, k1);
     double err = this->single_step(state, time, dt, delta);
     if (Math::isNotValue<>(err) || 1. < err)
     {
-      Eigen::VectorXd tmp_delta(this->system.getDimension());
-      this->control(state, time, dt/2., tmp_delta);
-      this->control(state+tmp_delta, time+dt/2., dt/2., delta);
-      delta += tmp_delta;
+      this->_statistics.reject();
+      Eigen::VectorXd &half_state = this->halfStepWorkspace(level, 0, this->system.getDimension());
+      Eigen::VectorXd &half_delta = this->halfStepWorkspace(level, 1, this->system.getDimension());
+      this->control(state, time, dt/2., half_delta, level+1);
+      half_state.noalias() = state + half_delta;
+      this->control(half_state, time+dt/2., dt/2., delta, level+1);
+      delta += half_delta;
+    } else {
+      this->_statistics.accept(dt);
     }
   }
 
 
   /**
-   * Implements a single RKF45 step.
+   * Implements a single RKF45 step, the derivative at @c state must be held in k1.
    */
   inline double single_step(const Eigen::VectorXd &state, double time, double dt, Eigen::VectorXd &delta)
   {
-    this->system.evaluate(state, time, k1);
-    this->system.evaluate(state + dt*(a21*k1), time+dt*c2, k2);
-    this->system.evaluate(state + dt*(a31*k1 + a32*k2), time+dt*c3, k3);
-    this->system.evaluate(state + dt*(a41*k1 + a42*k2 + a43*k3), time+c4*dt, k4);
-    this->system.evaluate(state + dt*(a51*k1 + a52*k2 + a53*k3 + a54*k4), time+dt*c5, k5);
-    this->system.evaluate(state + dt*(a61*k1 + a62*k2 + a63*k3 + a64*k4 + a65*k5), time+dt*c6, k6);
+    temp.noalias() = state + dt*(a21*k1);
+    this->evaluateSystem(this->system, temp, time+dt*c2, k2);
+    temp.noalias() = state + dt*(a31*k1 + a32*k2);
+    this->evaluateSystem(this->system, temp, time+dt*c3, k3);
+    temp.noalias() = state + dt*(a41*k1 + a42*k2 + a43*k3);
+    this->evaluateSystem(this->system, temp, time+c4*dt, k4);
+    temp.noalias() = state + dt*(a51*k1 + a52*k2 + a53*k3 + a54*k4);
+    this->evaluateSystem(this->system, temp, time+dt*c5, k5);
+    temp.noalias() = state + dt*(a61*k1 + a62*k2 + a63*k3 + a64*k4 + a65*k5);
+    this->evaluateSystem(this->system, temp, time+dt*c6, k6);
 
     // Calc delta t -> t+dt
     delta.noalias() = dt*(b41*k1 + b43*k3 + b44*k4 + b45*k5 + b46*k6);
@@ -7,6 +7,7 @@
 #include "exception.hh"
 #include "stepper.hh"
 #include "math.hh"
+#include "stepsizecontroller.hh"
 
 
 
@@ -67,6 +68,11 @@ public:
  * In contrast to the implementation shown in @cite press2007, this implementation uses the maximum
  * norm to estimate the truncation-error of the integration-step.
  *
+ * The step-size control and the reuse of the Jacobian and its decomposition are implemented like
+ * in @c Rosenbrock4TimeInd. As the method has no continuous extension of its own, the state at the
+ * end of an output interval is interpolated within the last internal step by the cubic Hermite
+ * polynomial through the states and derivatives at both ends of the step.
+ *
  * @ingroup ode
  */
 template <class Sys>
@@ -82,7 +88,8 @@ protected:
   const double err_abs;
   /** Holds the max relative error. */
   const double err_rel;
-  /** Holds the jacobian of the system, will be recalculated at each step. */
+  /** Holds the jacobian of the system, will be recalculated at each step. It is allocated on
+   * first use. */
   Eigen::MatrixXd jacobian;
   Eigen::VectorXd tempState;  ///< Some temporary state.
   Eigen::VectorXd tempState2; ///< Some temporary state.
@@ -91,6 +98,38 @@ protected:
   Eigen::VectorXd k3;         ///< Some temporary state.
   Eigen::VectorXd k4;         ///< Some temporary state.
   Eigen::VectorXd yerr;       ///< The error vector.
+  /** Holds the iteration matrix (I/(gamma*dt) - Jacobian), allocated on first use. */
+  Eigen::MatrixXd iteration;
+  /** Holds the LU decomposition of (I/(gamma*dt) - Jacobian) for the current step. */
+  Eigen::PartialPivLU<Eigen::MatrixXd> luJacobian;
+  Eigen::VectorXd current;    ///< The state at the current internal step.
+  Eigen::VectorXd subDelta;   ///< The update of the current internal step.
+  Eigen::VectorXd rates;      ///< The derivative at the beginning of the last attempted step.
+  Eigen::VectorXd state0;     ///< The state at the beginning of the last accepted step.
+  Eigen::VectorXd rates0;     ///< The derivative at the beginning of the last accepted step.
+  Eigen::VectorXd rates1;     ///< The derivative at the current internal step.
+  Eigen::VectorXd output;     ///< The state returned by the last call to @c step.
+  /** Holds the time at the beginning of the last accepted step. */
+  double t0;
+  /** Holds the time of the current internal step. */
+  double t1;
+  /** Holds the time of the last output (see @c Rosenbrock4TimeInd). */
+  double t_output;
+  /** If true, the current internal step and the last output are valid. */
+  bool continued;
+  /** If true, @c rates1 holds the derivative at the current internal step. */
+  bool rates1_valid;
+  /** The step-size controller. */
+  PIStepSizeController controller;
+  /** Holds the current internal step-size, 0 if not initialized. */
+  double h;
+  /** Holds the step-size the current decomposition was computed for, 0 if invalid. */
+  double h_decomposed;
+  /** Holds the number of steps the current Jacobian was used for, -1 if invalid. */
+  int jacobian_age;
+
+  /** Maximum number of steps a Jacobian is reused. */
+  static const int maxJacobianAge = 20;
 
 
 public:
@@ -100,16 +139,19 @@ public:
    * @param system Specifies the ODE system to be integrated. This class need to implement
    *        two methods: @c evaluate, which evaluates the system and @c evaluateJacobian, which
    *        evaluates the Jacobian of the system.
-   * @param dt Specifies the minimum time-step.
+   * @param dt Specifies the time-step (output interval) of @c step.
    * @param err_abs Specifies the max. absolute error.
    * @param err_rel Specifies the max. relative error.
    */
   Rosenbrock3TimeInd(Sys &system, double dt, double err_abs, double err_rel)
-    : system(system), step_size(dt), err_abs(err_abs), err_rel(err_rel),
-      jacobian(system.getDimension(), system.getDimension()),
+    : system(system), step_size(dt), err_abs(err_abs), err_rel(err_rel), jacobian(),
       tempState(system.getDimension()), tempState2(system.getDimension()),
       k1(system.getDimension()), k2(system.getDimension()),
-      k3(system.getDimension()), k4(system.getDimension()), yerr(system.getDimension())
+      k3(system.getDimension()), k4(system.getDimension()), yerr(system.getDimension()),
+      iteration(), luJacobian(), current(system.getDimension()), subDelta(system.getDimension()),
+      rates(system.getDimension()), state0(system.getDimension()), rates0(system.getDimension()),
+      rates1(system.getDimension()), output(system.getDimension()), t0(0), t1(0), t_output(0),
+      continued(false), rates1_valid(false), controller(3), h(0), h_decomposed(0), jacobian_age(-1)
   {
     // Pass...
   }
@@ -131,60 +173,158 @@ public:
   }
 
 
+  /** Resets the internal step-size and the Jacobian. */
+  virtual void reset()
+  {
+    h = 0; h_decomposed = 0; jacobian_age = -1; continued = false;
+    controller.reset();
+  }
+
+  /** Invalidates the Jacobian and the current internal step. */
+  virtual void parameterChanged()
+  {
+    h_decomposed = 0; jacobian_age = -1; continued = false;
+  }
+
+
 protected:
   /**
-   * Implements the step-size control.
-   *
-   * @todo Think of an general stepper function, that returns some information about the
-   *       error made in a integration step. Then, implement a abstract adaptive step-size control.
+   * Implements the step-size control, integrates the system from t to t+dt using internal
+   * steps chosen by the PI controller.
    */
   inline void control(const Eigen::VectorXd &state, double t, Eigen::VectorXd &delta, double dt)
   {
-    if (dt <= t*std::numeric_limits<double>::epsilon()) {
-      RuntimeError err;
-      err << __FILE__ << " at line " << (unsigned int) __LINE__ << ": "
-          << "Step-size unterflow in Rosenbrock3 stepper.";
-      throw err;
+    double t_end = t+dt, h_new = 0;
+    if (0 >= h) { h = dt; }
+
+    // Continue from the current internal step if the integration continues from the last output,
+    // otherwise start at the given state:
+    if (! isContinued(state, t, dt)) {
+      current = state; t0 = t1 = t;
+    }
+
+    while (t1 < t_end) {
+      double h_step = h;
+      if (h_step <= std::abs(t1)*std::numeric_limits<double>::epsilon()) {
+        RuntimeError err;
+        err << __FILE__ << " at line " << (unsigned int) __LINE__ << ": "
+            << "Step-size unterflow in Rosenbrock3 stepper.";
+        throw err;
+      }
+
+      // Update Jacobian and decomposition if needed:
+      bool fresh_jacobian = (0 > jacobian_age) || (maxJacobianAge <= jacobian_age);
+      if (fresh_jacobian) {
+        _statistics.startPhase();
+        updateJacobian(current, t1); jacobian_age = 0; h_decomposed = 0;
+        _statistics.stopPhase(StepperStatistics::JACOBIAN);
+      }
+      if (h_step != h_decomposed) {
+        _statistics.startPhase();
+        decompose(h_step); h_decomposed = h_step;
+        _statistics.stopPhase(StepperStatistics::DECOMPOSITION);
+      }
+
+      double err = _step(current, t1, subDelta, h_step);
+      if (controller.accept(err, h_step, h_new)) {
+        _statistics.accept(h_step);
+        state0 = current; rates0 = rates; current += subDelta; rates1_valid = false;
+        t0 = t1; t1 += h_step; jacobian_age++;
+        // Keep step-size (and decomposition) for small increases:
+        h = ((h_new > h_step) && (h_new < 1.2*h_step)) ? h_step : h_new;
+      } else {
+        _statistics.reject(); h = h_new;
+        // Retry with a fresh Jacobian if the step was made with an outdated one:
+        if (! fresh_jacobian) { jacobian_age = -1; }
+      }
     }
 
-    double err = _step(state, t, delta, dt);
-    if (Math::isNotValue(err) || 1. < err)
-    {
-      Eigen::VectorXd tmp_delta(this->system.getDimension());
-      control(state, t, delta, dt/2);
-      control(state + delta, t+dt/2, tmp_delta, dt/2);
-      delta += tmp_delta;
+    // Interpolate the state at the end of the interval within the last step:
+    if (t1 == t_end) {
+      output = current;
+    } else {
+      if (! rates1_valid) { evaluateSystem(system, current, t1, rates1); rates1_valid = true; }
+      double H = t1-t0, s = (t_end-t0)/H, s2 = s*s, s3 = s2*s;
+      output = (2*s3-3*s2+1)*state0 + (s3-2*s2+s)*H*rates0
+          + (3*s2-2*s3)*current + (s3-s2)*H*rates1;
     }
+
+    delta = output - state;
+    output = state + delta; t_output = t_end; continued = true;
   }
 
 
   /**
-   * The actual singe-step algorithm.
+   * Returns true if the integration continues from the last output, i.e. if the given time and
+   * state match the last output.
    */
-  inline double _step(const Eigen::VectorXd &state, double t, Eigen::VectorXd &delta, double dt)
+  inline bool isContinued(const Eigen::VectorXd &state, double t, double dt)
+  {
+    if ((! continued) || (std::abs(t-t_output) > 1e-8*dt)) { return false; }
+    for (int i=0; i<state.size(); i++) {
+      if (std::abs(state(i)-output(i)) > 1e-3*(err_abs + err_rel*std::abs(output(i)))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+
+  /**
+   * Evaluates the Jacobian at the given state.
+   */
+  virtual void updateJacobian(const Eigen::VectorXd &state, double t)
   {
-    // Evaluate Jacobian at t and compute LU decomposition with partial pivoting from
-    // (I/(h*gamma) - Jacobian):
+    jacobian.resize(system.getDimension(), system.getDimension());
     system.evaluateJacobian(state, t, jacobian);
-    jacobian = ((Eigen::MatrixXd::Identity(system.getDimension(), system.getDimension()) /
-                 (gamma*dt)) - jacobian);
-    Eigen::PartialPivLU<Eigen::MatrixXd> luJacobian(jacobian);
+  }
+
+
+  /**
+   * Computes the LU decomposition of (I/(gamma*dt) - Jacobian) used by all stages of the step.
+   */
+  virtual void decompose(double dt)
+  {
+    // compute LU decomposition with partial pivoting from (I/(h*gamma) - Jacobian), the
+    // iteration matrix is assembled in-place:
+    iteration = -jacobian;
+    iteration.diagonal().array() += 1./(gamma*dt);
+    luJacobian.compute(iteration);
+  }
 
+
+  /**
+   * Solves (I/(gamma*dt) - Jacobian) x = rhs using the decomposition obtained by @c decompose.
+   */
+  virtual void solve(const Eigen::VectorXd &rhs, Eigen::VectorXd &x)
+  {
+    x.noalias() = luJacobian.solve(rhs);
+  }
+
+
+  /**
+   * The actual singe-step algorithm.
+   */
+  inline double _step(const Eigen::VectorXd &state, double t, Eigen::VectorXd &delta, double dt)
+  {
     // compute k1:
-    system.evaluate(state, t, delta);
-    k1 = luJacobian.solve(delta);
+    evaluateSystem(system, state, t, rates);
+    solve(rates, k1);
 
     // compute k2:
-    system.evaluate(state + a21*k1, t+c2*dt, delta);
-    k2 = luJacobian.solve(delta + c21*k1/dt);
+    tempState.noalias() = state + a21*k1;
+    evaluateSystem(system, tempState, t+c2*dt, delta);
+    tempState2 = delta + c21*k1/dt; solve(tempState2, k2);
 
     // compute k3:
-    system.evaluate(state + a31*k1 + a32*k2, t+c3*dt, delta);
-    k3 = luJacobian.solve(delta + (c31*k1 + c32*k2)/dt);
+    tempState.noalias() = state + a31*k1 + a32*k2;
+    evaluateSystem(system, tempState, t+c3*dt, delta);
+    tempState2 = delta + (c31*k1 + c32*k2)/dt; solve(tempState2, k3);
 
     // compute k4:
-    system.evaluate(state + a41*k1 + a42*k2, t+c4*dt, delta);
-    k4 = luJacobian.solve(delta + (c41*k1 + c42*k2 + c43*k3)/dt);
+    tempState.noalias() = state + a41*k1 + a42*k2;
+    evaluateSystem(system, tempState, t+c4*dt, delta);
+    tempState2 = delta + (c41*k1 + c42*k2 + c43*k3)/dt; solve(tempState2, k4);
 
     // Calculate step
     delta.noalias() = b41*k1 + b42*k2 + b43*k3 + b44*k4;
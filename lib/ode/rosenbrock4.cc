@@ -39,3 +39,12 @@ const double Rosenbrock4Constants::c64= 0.1631930543123136e+02;
 const double Rosenbrock4Constants::c65=-0.6058818238834054e+01;
 const double Rosenbrock4Constants::gamma= 0.2500000000000000e+00;
 const double Rosenbrock4Constants::d21= 0.1012623508344586e+02;
+const double Rosenbrock4Constants::d22=-0.7487995877610167e+01;
+const double Rosenbrock4Constants::d23=-0.3480091861555747e+02;
+const double Rosenbrock4Constants::d24=-0.7992771707568823e+01;
+const double Rosenbrock4Constants::d25= 0.1025137723295662e+01;
+const double Rosenbrock4Constants::d31=-0.6762803392801253e+00;
+const double Rosenbrock4Constants::d32= 0.6087714651680015e+01;
+const double Rosenbrock4Constants::d33= 0.1643084320892478e+02;
+const double Rosenbrock4Constants::d34= 0.2476722511418386e+02;
+const double Rosenbrock4Constants::d35=-0.6594389125716872e+01;
@@ -6,6 +6,7 @@
 #include "exception.hh"
 #include "stepper.hh"
 #include "math.hh"
+#include "stepsizecontroller.hh"
 
 
 
@@ -47,6 +48,20 @@ public:
  * In contrast to the implementation shown in @cite press2007, this implementation uses the maximum
  * norm to estimate the truncation-error of the integration-step.
  *
+ * Each call to @c step integrates over the output interval @c dt by as many internal steps as
+ * needed. The internal step-size is chosen by a PI controller (see @c PIStepSizeController) and
+ * is independent of the output interval: The internal steps are not shortened to hit the end of
+ * the interval, instead the state at the end of the interval is obtained from the continuous
+ * extension of the method @cite press2007. The integration continues from the last internal step
+ * if the next call to @c step starts at the returned state. Hence the output grid does not change
+ * the step-size and the decomposition of the iteration matrix is reused as long as the
+ * step-size does not change. Small increases of the step-size are suppressed for this purpose.
+ *
+ * Like in a W-method, the Jacobian is reused for several steps. The coefficients of the method
+ * assume the exact Jacobian, hence a step made with an outdated Jacobian may lose accuracy, which
+ * is detected by the error estimate. The Jacobian is re-evaluated after @c maxJacobianAge steps or
+ * if a step with an outdated Jacobian is rejected.
+ *
  * @ingroup ode
  */
 template<class Sys>
@@ -62,16 +77,47 @@ class Rosenbrock4TimeInd
   double err_abs;
   /** Holds the relative error. */
   double err_rel;
-  /** Will hold the Jacobian of the system. */
+  /** Will hold the Jacobian of the system, allocated on first use. */
   Eigen::MatrixXd jacobian;
   Eigen::VectorXd tempState;    ///< Some temporary state.
   Eigen::VectorXd tempState2;   ///< Some temporary state.
+  Eigen::VectorXd stageState;   ///< The state at which the system is evaluated for a stage.
   Eigen::VectorXd k1;           ///< Some temporary state.
   Eigen::VectorXd k2;           ///< Some temporary state.
   Eigen::VectorXd k3;           ///< Some temporary state.
   Eigen::VectorXd k4;           ///< Some temporary state.
   Eigen::VectorXd k5;           ///< Some temporary state.
   Eigen::VectorXd yerr;         ///< Some temporary vector, holding the error.
+  /** Holds the iteration matrix (I/(gamma*dt) - Jacobian), allocated on first use. */
+  Eigen::MatrixXd iteration;
+  /** Holds the LU decomposition of (I/(gamma*dt) - Jacobian) for the current step. */
+  Eigen::PartialPivLU<Eigen::MatrixXd> luJacobian;
+  Eigen::VectorXd current;      ///< The state at the current internal step.
+  Eigen::VectorXd subDelta;     ///< The update of the current internal step.
+  Eigen::VectorXd state0;       ///< The state at the beginning of the last accepted step.
+  Eigen::VectorXd cont3;        ///< Coefficient of the continuous extension of the last step.
+  Eigen::VectorXd cont4;        ///< Coefficient of the continuous extension of the last step.
+  Eigen::VectorXd output;       ///< The state returned by the last call to @c step.
+  /** Holds the time at the beginning of the last accepted step. */
+  double t0;
+  /** Holds the time of the current internal step. */
+  double t1;
+  /** Holds the time of the last output, the integration continues from the current internal
+   * step, if the next call to @c step starts at this time and at the @c output state. */
+  double t_output;
+  /** If true, the current internal step and the last output are valid. */
+  bool continued;
+  /** The step-size controller. */
+  PIStepSizeController controller;
+  /** Holds the current internal step-size, 0 if not initialized. */
+  double h;
+  /** Holds the step-size the current decomposition was computed for, 0 if invalid. */
+  double h_decomposed;
+  /** Holds the number of steps the current Jacobian was used for, -1 if invalid. */
+  int jacobian_age;
+
+  /** Maximum number of steps a Jacobian is reused. */
+  static const int maxJacobianAge = 20;
 
 
 public:
@@ -81,17 +127,20 @@ public:
    * @param system Specifies the ODE system to be integrated. This class need to implement
    *        two methods: @c evaluate, which evaluates the system and @c evaluateJacobian, which
    *        evaluates the Jacobian of the system.
-   * @param dt Specifies the minimum time-step.
+   * @param dt Specifies the time-step (output interval) of @c step.
    * @param err_abs Specifies the max. absolute error.
    * @param err_rel Specifies the max. relative error.
    */
   Rosenbrock4TimeInd(Sys &system, double dt, double err_abs, double err_rel)
-    : system(system), step_size(dt), err_abs(err_abs), err_rel(err_rel),
-      jacobian(system.getDimension(), system.getDimension()),
+    : system(system), step_size(dt), err_abs(err_abs), err_rel(err_rel), jacobian(),
       tempState(system.getDimension()), tempState2(system.getDimension()),
-      k1(system.getDimension()), k2(system.getDimension()),
+      stageState(system.getDimension()), k1(system.getDimension()), k2(system.getDimension()),
       k3(system.getDimension()), k4(system.getDimension()),
-      yerr(system.getDimension())
+      k5(system.getDimension()), yerr(system.getDimension()), iteration(), luJacobian(),
+      current(system.getDimension()), subDelta(system.getDimension()),
+      state0(system.getDimension()), cont3(system.getDimension()), cont4(system.getDimension()),
+      output(system.getDimension()), t0(0), t1(0), t_output(0), continued(false),
+      controller(4), h(0), h_decomposed(0), jacobian_age(-1)
   {
     // Pass...
   }
@@ -112,66 +161,172 @@ public:
     stepSizeControl(state, t, delta, step_size);
   }
 
+  /** Resets the internal step-size and the Jacobian. */
+  virtual void reset()
+  {
+    h = 0; h_decomposed = 0; jacobian_age = -1; continued = false;
+    controller.reset();
+  }
+
+  /** Invalidates the Jacobian and the current internal step. */
+  virtual void parameterChanged()
+  {
+    h_decomposed = 0; jacobian_age = -1; continued = false;
+  }
+
 
 protected:
   /**
-   * Implements the step-size control.
-   *
-   * @todo Think of an general stepper function, that returns some information about the
-   *       error made in a integration step. Then, implement a abstract adaptive step-size control.
+   * Implements the step-size control, integrates the system from t to t+dt using internal
+   * steps chosen by the PI controller.
    */
   inline void stepSizeControl(const Eigen::VectorXd &state, double t, Eigen::VectorXd &delta,
                               double dt)
   {
-    double err = _step(state, t, delta, dt);
-    if (Math::isNotValue<>(err) || 1. < err)
-    {
-      Eigen::VectorXd tmp_delta(this->system.getDimension());
-      stepSizeControl(state, t, delta, dt/2);
-      stepSizeControl(state+delta, t+dt/2, tmp_delta, dt/2);
-      delta += tmp_delta;
+    double t_end = t+dt, h_new = 0;
+    if (0 >= h) { h = dt; }
+
+    // Continue from the current internal step if the integration continues from the last output,
+    // otherwise start at the given state:
+    if (! isContinued(state, t, dt)) {
+      current = state; t0 = t1 = t;
     }
+
+    while (t1 < t_end) {
+      double h_step = h;
+      if (h_step <= std::abs(t1)*std::numeric_limits<double>::epsilon()) {
+        RuntimeError err;
+        err << __FILE__ << " at line " << (unsigned int) __LINE__ << ": "
+            << "Step-size unterflow in Rosenbrock4 stepper.";
+        throw err;
+      }
+
+      // Update Jacobian and decomposition if needed:
+      bool fresh_jacobian = (0 > jacobian_age) || (maxJacobianAge <= jacobian_age);
+      if (fresh_jacobian) {
+        _statistics.startPhase();
+        updateJacobian(current, t1); jacobian_age = 0; h_decomposed = 0;
+        _statistics.stopPhase(StepperStatistics::JACOBIAN);
+      }
+      if (h_step != h_decomposed) {
+        _statistics.startPhase();
+        decompose(h_step); h_decomposed = h_step;
+        _statistics.stopPhase(StepperStatistics::DECOMPOSITION);
+      }
+
+      double err = _step(current, t1, subDelta, h_step);
+      if (controller.accept(err, h_step, h_new)) {
+        _statistics.accept(h_step);
+        // Store continuous extension of the step:
+        cont3.noalias() = d21*k1 + d22*k2 + d23*k3 + d24*k4 + d25*k5;
+        cont4.noalias() = d31*k1 + d32*k2 + d33*k3 + d34*k4 + d35*k5;
+        state0 = current; current += subDelta;
+        t0 = t1; t1 += h_step; jacobian_age++;
+        // Keep step-size (and decomposition) for small increases:
+        h = ((h_new > h_step) && (h_new < 1.2*h_step)) ? h_step : h_new;
+      } else {
+        _statistics.reject(); h = h_new;
+        // Retry with a fresh Jacobian if the step was made with an outdated one:
+        if (! fresh_jacobian) { jacobian_age = -1; }
+      }
+    }
+
+    // Interpolate the state at the end of the interval within the last step:
+    if (t1 == t_end) {
+      output = current;
+    } else {
+      double s = (t_end-t0)/(t1-t0), s1 = 1-s;
+      output = s1*state0 + s*(current + s1*(cont3 + s*cont4));
+    }
+
+    delta = output - state;
+    output = state + delta; t_output = t_end; continued = true;
   }
 
 
   /**
-   * Actually implements the single Rosenbrock step.
+   * Returns true if the integration continues from the last output, i.e. if the given time and
+   * state match the last output.
    */
-  inline double _step(const Eigen::VectorXd &state, double t, Eigen::VectorXd &delta, double dt)
+  inline bool isContinued(const Eigen::VectorXd &state, double t, double dt)
   {
-    // Evaluate Jacobian at t:
+    if ((! continued) || (std::abs(t-t_output) > 1e-8*dt)) { return false; }
+    for (int i=0; i<state.size(); i++) {
+      if (std::abs(state(i)-output(i)) > 1e-3*(err_abs + err_rel*std::abs(output(i)))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+
+  /**
+   * Evaluates the Jacobian at the given state.
+   */
+  virtual void updateJacobian(const Eigen::VectorXd &state, double t)
+  {
+    jacobian.resize(system.getDimension(), system.getDimension());
     system.evaluateJacobian(state, t, jacobian);
+  }
+
+
+  /**
+   * Computes the LU decomposition of (I/(gamma*dt) - Jacobian) used by all stages of the step.
+   */
+  virtual void decompose(double dt)
+  {
+    // compute LU decomposition with partial pivoting from (I/(h*gamma) - Jacobian), the
+    // iteration matrix is assembled in-place:
+    iteration = -jacobian;
+    iteration.diagonal().array() += 1./(gamma*dt);
+    luJacobian.compute(iteration);
+  }
+
+
+  /**
+   * Solves (I/(gamma*dt) - Jacobian) x = rhs using the decomposition obtained by @c decompose.
+   */
+  virtual void solve(const Eigen::VectorXd &rhs, Eigen::VectorXd &x)
+  {
+    x.noalias() = luJacobian.solve(rhs);
+  }
 
-    // compute LU decomposition with partial pivoting from (I/(h*gamma) - Jacobian):
-    jacobian = ((Eigen::MatrixXd::Identity(system.getDimension(), system.getDimension()) /
-                 (gamma*dt)) - jacobian);
-    Eigen::PartialPivLU<Eigen::MatrixXd> luJacobian(jacobian);
 
+  /**
+   * Actually implements the single Rosenbrock step.
+   */
+  inline double _step(const Eigen::VectorXd &state, double t, Eigen::VectorXd &delta, double dt)
+  {
     // Calc k1:
-    system.evaluate(state, t, delta);
-    k1 = luJacobian.solve(delta);
+    evaluateSystem(system, state, t, delta);
+    solve(delta, k1);
 
     // Calc k2:
-    system.evaluate(state+a21*k1, t+c2*dt, delta);
-    k2 = luJacobian.solve(delta + c21*k1/dt);
+    stageState.noalias() = state + a21*k1;
+    evaluateSystem(system, stageState, t+c2*dt, delta);
+    tempState2 = delta + c21*k1/dt; solve(tempState2, k2);
 
     // Calc k3:
-    system.evaluate(state+a31*k1+a32*k2, t+c3*dt, delta);
-    k3 = luJacobian.solve(delta + (c31*k1 + c32*k2)/dt);
+    stageState.noalias() = state + a31*k1 + a32*k2;
+    evaluateSystem(system, stageState, t+c3*dt, delta);
+    tempState2 = delta + (c31*k1 + c32*k2)/dt; solve(tempState2, k3);
 
     // Calc k4:
-    system.evaluate(state+a41*k1+a42*k2+a43*k3, t+c4*dt, delta);
-    k4 = luJacobian.solve(delta + (c41*k1 + c42*k2 + c43*k3)/dt);
+    stageState.noalias() = state + a41*k1 + a42*k2 + a43*k3;
+    evaluateSystem(system, stageState, t+c4*dt, delta);
+    tempState2 = delta + (c41*k1 + c42*k2 + c43*k3)/dt; solve(tempState2, k4);
 
     // calc k5:
     tempState.noalias() = a51*k1 + a52*k2 + a53*k3 + a54*k4;
-    system.evaluate(state+tempState, t+dt, delta);
-    k5 = luJacobian.solve(delta + (c51*k1 + c52*k2 + c53*k3 + c54*k4)/dt);
+    stageState.noalias() = state + tempState;
+    evaluateSystem(system, stageState, t+dt, delta);
+    tempState2 = delta + (c51*k1 + c52*k2 + c53*k3 + c54*k4)/dt; solve(tempState2, k5);
 
     // calc yerr:
     tempState += k5;
-    system.evaluate(state+tempState, t+dt, delta);
-    yerr = luJacobian.solve(delta + (c61*k1 + c62*k2 + c63*k3 + c64*k4 + c65*k5)/dt);
+    stageState.noalias() = state + tempState;
+    evaluateSystem(system, stageState, t+dt, delta);
+    tempState2 = delta + (c61*k1 + c62*k2 + c63*k3 + c64*k4 + c65*k5)/dt; solve(tempState2, yerr);
     delta = tempState + yerr;
 
     // Return error estimate:
@@ -108,6 +108,9 @@ public:
       err << "Integration failed: NaN occurred during interation; reduce step-size.";
       throw err;
     }
+
+    this->_statistics.count(StepperStatistics::RHS, 4);
+    this->_statistics.accept(this->step_size);
   }
 
   /**
@@ -0,0 +1,94 @@
+#include "sparseiterationmatrix.hh"
+#include "exception.hh"
+
+using namespace iNA;
+using namespace iNA::ODE;
+
+
+SparseIterationMatrix::SparseIterationMatrix()
+  : _matrix(), _jacobianIndex(), _diagonalIndex(), _jacobianNonZeros(-1), _lu(), _analyzed(false)
+{
+  // Pass...
+}
+
+
+void
+SparseIterationMatrix::compute(const Eigen::SparseMatrix<double> &jacobian, double alpha)
+{
+  if ((! _analyzed) || (jacobian.nonZeros() != _jacobianNonZeros) ||
+      (jacobian.rows() != _matrix.rows())) {
+    analyzePattern(jacobian);
+  }
+
+  // Assemble (alpha I - J) into the fixed pattern:
+  double *values = _matrix.valuePtr();
+  for (int k=0; k<_matrix.nonZeros(); k++) { values[k] = 0; }
+  const double *jac_values = jacobian.valuePtr();
+  for (int k=0; k<_jacobianNonZeros; k++) { values[_jacobianIndex[k]] -= jac_values[k]; }
+  for (size_t i=0; i<_diagonalIndex.size(); i++) { values[_diagonalIndex[i]] += alpha; }
+
+  // Numerical factorization only, reusing the symbolic analysis:
+  _lu.factorize(_matrix);
+  if (Eigen::Success != _lu.info()) {
+    NumericError err;
+    err << "Sparse LU decomposition of the iteration matrix failed: " << _lu.lastErrorMessage();
+    throw err;
+  }
+}
+
+
+void
+SparseIterationMatrix::solve(const Eigen::VectorXd &rhs, Eigen::VectorXd &x)
+{
+  x = _lu.solve(rhs);
+}
+
+
+void
+SparseIterationMatrix::reset()
+{
+  _analyzed = false;
+}
+
+
+void
+SparseIterationMatrix::analyzePattern(const Eigen::SparseMatrix<double> &jacobian)
+{
+  int N = jacobian.rows();
+
+  // The pattern of the iteration matrix is the pattern of the Jacobian plus the diagonal:
+  std::vector< Eigen::Triplet<double> > triplets;
+  triplets.reserve(jacobian.nonZeros() + N);
+  for (int j=0; j<jacobian.outerSize(); j++) {
+    for (Eigen::SparseMatrix<double>::InnerIterator it(jacobian, j); it; ++it) {
+      triplets.push_back(Eigen::Triplet<double>(it.row(), it.col(), 1));
+    }
+  }
+  for (int i=0; i<N; i++) {
+    triplets.push_back(Eigen::Triplet<double>(i, i, 1));
+  }
+  _matrix.resize(N, N);
+  _matrix.setFromTriplets(triplets.begin(), triplets.end());
+  _matrix.makeCompressed();
+
+  // Map the elements of the Jacobian and the diagonal to their index in the iteration matrix:
+  const int *outer = _matrix.outerIndexPtr(), *inner = _matrix.innerIndexPtr();
+  _jacobianIndex.resize(jacobian.nonZeros());
+  _diagonalIndex.resize(N);
+  int k = 0;
+  for (int j=0; j<jacobian.outerSize(); j++) {
+    int idx = outer[j];
+    for (Eigen::SparseMatrix<double>::InnerIterator it(jacobian, j); it; ++it, k++) {
+      while (inner[idx] < it.row()) { idx++; }
+      _jacobianIndex[k] = idx;
+    }
+    idx = outer[j];
+    while (inner[idx] < j) { idx++; }
+    _diagonalIndex[j] = idx;
+  }
+  _jacobianNonZeros = jacobian.nonZeros();
+
+  // Symbolic analysis:
+  _lu.analyzePattern(_matrix);
+  _analyzed = true;
+}
@@ -0,0 +1,72 @@
+#ifndef __FLUC_ODE_SPARSEITERATIONMATRIX_HH__
+#define __FLUC_ODE_SPARSEITERATIONMATRIX_HH__
+
+#include <vector>
+#include <eigen3/Eigen/Eigen>
+#include <eigen3/Eigen/Sparse>
+
+
+namespace iNA {
+namespace ODE {
+
+
+/**
+ * Assembles and decomposes the iteration matrix \f$W = \alpha I - J\f$ of (semi-) implicit
+ * methods for a sparse Jacobian \f$J\f$.
+ *
+ * The sparsity pattern of the Jacobian is assumed to be fixed (i.e. it is given by a compiled
+ * pattern like the one of @c Models::GenericSSEinterpreter::evaluateJacobian). Hence the pattern
+ * of \f$W\f$ and the mapping of the Jacobian elements into \f$W\f$ are determined once and the
+ * symbolic analysis (fill-reducing ordering and elimination tree) of the sparse LU decomposition
+ * is reused for all subsequent decompositions. Only the numerical factorization is performed at
+ * each call to @c compute.
+ *
+ * @ingroup ode
+ */
+class SparseIterationMatrix
+{
+protected:
+  /** Holds the iteration matrix (alpha I - J). */
+  Eigen::SparseMatrix<double> _matrix;
+  /** Maps the k-th non-zero element of the Jacobian to its index in the iteration matrix. */
+  std::vector<int> _jacobianIndex;
+  /** Holds the index of the diagonal elements in the iteration matrix. */
+  std::vector<int> _diagonalIndex;
+  /** Holds the number of non-zero elements of the Jacobian the pattern was analyzed for. */
+  int _jacobianNonZeros;
+  /** Holds the sparse LU decomposition. */
+  Eigen::SparseLU< Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int> > _lu;
+  /** If true, the pattern was analyzed. */
+  bool _analyzed;
+
+
+public:
+  /** Constructor. */
+  SparseIterationMatrix();
+
+  /**
+   * Assembles and decomposes (alpha I - J).
+   *
+   * @param jacobian Specifies the Jacobian in compressed column-major storage. The sparsity
+   *        pattern must not change between calls.
+   * @param alpha Specifies the factor of the identity.
+   * @throws NumericError If the iteration matrix is singular.
+   */
+  void compute(const Eigen::SparseMatrix<double> &jacobian, double alpha);
+
+  /** Solves (alpha I - J) x = rhs using the last decomposition. */
+  void solve(const Eigen::VectorXd &rhs, Eigen::VectorXd &x);
+
+  /** Forgets the sparsity pattern, the next call to @c compute will re-analyze the pattern. */
+  void reset();
+
+protected:
+  /** Determines the pattern of the iteration matrix and performs the symbolic analysis. */
+  void analyzePattern(const Eigen::SparseMatrix<double> &jacobian);
+};
+
+
+}
+}
+
+#endif // __FLUC_ODE_SPARSEITERATIONMATRIX_HH__
@@ -0,0 +1,129 @@
+#ifndef __FLUC_ODE_SPARSEROSENBROCK_HH__
+#define __FLUC_ODE_SPARSEROSENBROCK_HH__
+
+#include "rosenbrock3.hh"
+#include "rosenbrock4.hh"
+#include "sparseiterationmatrix.hh"
+
+
+namespace iNA {
+namespace ODE {
+
+
+/**
+ * Implements the Rosenbrock method of 4th order (see @c Rosenbrock4TimeInd) for systems with a
+ * sparse Jacobian.
+ *
+ * Instead of a dense Jacobian and a dense LU decomposition, which requires O(N^3) operations per
+ * step, the Jacobian is evaluated into a @c Eigen::SparseMatrix with a fixed sparsity pattern and
+ * decomposed by a sparse LU decomposition, reusing the symbolic analysis of the pattern (see
+ * @c SparseIterationMatrix).
+ *
+ * Beside the usual system interface, the system needs to implement the method
+ * <tt>evaluateJacobian(const Eigen::VectorXd &state, double t, Eigen::SparseMatrix<double> &jac)</tt>,
+ * like the @c Models::GenericSSEinterpreter does.
+ *
+ * @ingroup ode
+ */
+template<class Sys>
+class SparseRosenbrock4TimeInd
+    : public Rosenbrock4TimeInd<Sys>
+{
+protected:
+  /** Holds the sparse Jacobian of the system. */
+  Eigen::SparseMatrix<double> sparseJacobian;
+  /** Holds the decomposition of the iteration matrix (I/(gamma*dt) - Jacobian). */
+  SparseIterationMatrix iterationMatrix;
+
+public:
+  /**
+   * Constructs a sparse Rosenbrock stepper.
+   *
+   * @param system Specifies the ODE system to be integrated.
+   * @param dt Specifies the minimum time-step.
+   * @param err_abs Specifies the max. absolute error.
+   * @param err_rel Specifies the max. relative error.
+   */
+  SparseRosenbrock4TimeInd(Sys &system, double dt, double err_abs, double err_rel)
+    : Rosenbrock4TimeInd<Sys>(system, dt, err_abs, err_rel), sparseJacobian(), iterationMatrix()
+  {
+    // Pass...
+  }
+
+protected:
+  /** Evaluates the sparse Jacobian. */
+  virtual void updateJacobian(const Eigen::VectorXd &state, double t)
+  {
+    this->system.evaluateJacobian(state, t, sparseJacobian);
+  }
+
+  /** Decomposes (I/(gamma*dt) - Jacobian). */
+  virtual void decompose(double dt)
+  {
+    iterationMatrix.compute(sparseJacobian, 1./(this->gamma*dt));
+  }
+
+  /** Solves (I/(gamma*dt) - Jacobian) x = rhs. */
+  virtual void solve(const Eigen::VectorXd &rhs, Eigen::VectorXd &x)
+  {
+    iterationMatrix.solve(rhs, x);
+  }
+};
+
+
+/**
+ * Implements the Rosenbrock method of 3rd order (see @c Rosenbrock3TimeInd) for systems with a
+ * sparse Jacobian. See @c SparseRosenbrock4TimeInd for details.
+ *
+ * @ingroup ode
+ */
+template<class Sys>
+class SparseRosenbrock3TimeInd
+    : public Rosenbrock3TimeInd<Sys>
+{
+protected:
+  /** Holds the sparse Jacobian of the system. */
+  Eigen::SparseMatrix<double> sparseJacobian;
+  /** Holds the decomposition of the iteration matrix (I/(gamma*dt) - Jacobian). */
+  SparseIterationMatrix iterationMatrix;
+
+public:
+  /**
+   * Constructs a sparse Rosenbrock stepper.
+   *
+   * @param system Specifies the ODE system to be integrated.
+   * @param dt Specifies the minimum time-step.
+   * @param err_abs Specifies the max. absolute error.
+   * @param err_rel Specifies the max. relative error.
+   */
+  SparseRosenbrock3TimeInd(Sys &system, double dt, double err_abs, double err_rel)
+    : Rosenbrock3TimeInd<Sys>(system, dt, err_abs, err_rel), sparseJacobian(), iterationMatrix()
+  {
+    // Pass...
+  }
+
+protected:
+  /** Evaluates the sparse Jacobian. */
+  virtual void updateJacobian(const Eigen::VectorXd &state, double t)
+  {
+    this->system.evaluateJacobian(state, t, sparseJacobian);
+  }
+
+  /** Decomposes (I/(gamma*dt) - Jacobian). */
+  virtual void decompose(double dt)
+  {
+    iterationMatrix.compute(sparseJacobian, 1./(this->gamma*dt));
+  }
+
+  /** Solves (I/(gamma*dt) - Jacobian) x = rhs. */
+  virtual void solve(const Eigen::VectorXd &rhs, Eigen::VectorXd &x)
+  {
+    iterationMatrix.solve(rhs, x);
+  }
+};
+
+
+}
+}
+
+#endif // __FLUC_ODE_SPARSEROSENBROCK_HH__
@@ -0,0 +1,119 @@
+#ifndef __FLUC_ODE_STAGGEREDROSENBROCK4_HH__
+#define __FLUC_ODE_STAGGEREDROSENBROCK4_HH__
+
+#include "rosenbrock4.hh"
+
+
+namespace iNA {
+namespace ODE {
+
+
+/**
+ * Implements the Rosenbrock method of 4th order for ODE systems augmented by forward sensitivity
+ * equations.
+ *
+ * The state of the system is assumed to be of the form \f$(x, s_1, \dots, s_P)\f$, where \f$x\f$ is
+ * the original state of dimension \f$D\f$ and \f$s_k = \partial x/\partial p_k\f$ are the
+ * sensitivities w.r.t. the \f$P\f$ parameters, satisfying
+ * \f[
+ *   \dot{s}_k = J(x)s_k + \frac{\partial f}{\partial p_k}(x)\,.
+ * \f]
+ * The Jacobian of the augmented system is block lower-triangular with the system Jacobian
+ * \f$J\f$ on the diagonal and the coupling blocks
+ * \f$C_k = \partial(J s_k + \partial_{p_k} f)/\partial x\f$ in the first block column.
+ * Instead of decomposing the \f$D(P+1)\times D(P+1)\f$ matrix of the augmented system, this stepper
+ * only decomposes the \f$D\times D\f$ matrix \f$I/(\gamma h)-J\f$ once per step and solves for
+ * the sensitivity stages by a staggered block forward-substitution. The result is identical to
+ * the one obtained by @c Rosenbrock4TimeInd on the augmented system.
+ *
+ * Beside the usual system interface, the system needs to implement the methods
+ * @c getStateDimension, @c numSensitivityParameters, @c evaluateStateJacobian and
+ * @c evaluateSensitivityCoupling, like the @c Models::SensitivityInterpreter does.
+ *
+ * @ingroup ode
+ */
+template<class Sys>
+class StaggeredRosenbrock4
+    : public Rosenbrock4TimeInd<Sys>
+{
+protected:
+  /** Holds the dimension of the original system. */
+  size_t state_dim;
+  /** Holds the number of parameters, the sensitivities are computed for. */
+  size_t num_params;
+  /** Holds the Jacobian of the original system. */
+  Eigen::MatrixXd state_jacobian;
+  /** Holds the coupling blocks of the sensitivity equations stacked row-wise. */
+  Eigen::MatrixXd coupling;
+  /** Holds (I/(gamma*dt) - Jacobian) of the original system. */
+  Eigen::MatrixXd state_iteration;
+  /** Holds the LU decomposition of (I/(gamma*dt) - Jacobian) of the original system. */
+  Eigen::PartialPivLU<Eigen::MatrixXd> luStateJacobian;
+  /** Some temporary state of the dimension of the original system. */
+  Eigen::VectorXd tempBlock;
+
+
+public:
+  /**
+   * Constructs a staggered Rosenbrock stepper.
+   *
+   * @param system Specifies the augmented ODE system to be integrated.
+   * @param dt Specifies the minimum time-step.
+   * @param err_abs Specifies the max. absolute error.
+   * @param err_rel Specifies the max. relative error.
+   */
+  StaggeredRosenbrock4(Sys &system, double dt, double err_abs, double err_rel)
+    : Rosenbrock4TimeInd<Sys>(system, dt, err_abs, err_rel),
+      state_dim(system.getStateDimension()), num_params(system.numSensitivityParameters()),
+      state_jacobian(state_dim, state_dim), coupling(state_dim*num_params, state_dim),
+      tempBlock(state_dim)
+  {
+    // The Jacobian of the augmented system is never assembled:
+    this->jacobian.resize(0,0);
+  }
+
+
+protected:
+  /**
+   * Evaluates the Jacobian of the original system and the coupling blocks.
+   */
+  virtual void updateJacobian(const Eigen::VectorXd &state, double t)
+  {
+    this->system.evaluateStateJacobian(state, t, state_jacobian);
+    this->system.evaluateSensitivityCoupling(state, t, coupling);
+  }
+
+
+  /**
+   * Decomposes (I/(gamma*dt) - Jacobian) of the original system.
+   */
+  virtual void decompose(double dt)
+  {
+    state_iteration = -state_jacobian;
+    state_iteration.diagonal().array() += 1./(this->gamma*dt);
+    luStateJacobian.compute(state_iteration);
+  }
+
+
+  /**
+   * Solves the block lower-triangular system by forward-substitution.
+   */
+  virtual void solve(const Eigen::VectorXd &rhs, Eigen::VectorXd &x)
+  {
+    // Solve for the stage of the original system first:
+    x.head(state_dim) = luStateJacobian.solve(rhs.head(state_dim));
+
+    // then for the stages of the sensitivities, using the same decomposition:
+    for (size_t k=0; k<num_params; k++) {
+      tempBlock.noalias() = rhs.segment(state_dim*(k+1), state_dim)
+          + coupling.block(state_dim*k, 0, state_dim, state_dim)*x.head(state_dim);
+      x.segment(state_dim*(k+1), state_dim) = luStateJacobian.solve(tempBlock);
+    }
+  }
+};
+
+
+}
+}
+
+#endif // __FLUC_ODE_STAGGEREDROSENBROCK4_HH__
@@ -1,2 +1,70 @@
 #include "stepper.hh"
 
+using namespace iNA;
+using namespace iNA::ODE;
+
+
+Stepper::Stepper()
+  : _events(), _eventValues(), _firedEvent(-1), _eventTime(0), _statistics(), _stepDelta(),
+    _halfStepWorkspaces()
+{
+  // Pass...
+}
+
+
+void
+Stepper::addEvent(Event *event)
+{
+  _events.push_back(event);
+  _eventValues.push_back(1);
+}
+
+
+void
+Stepper::clearEvents()
+{
+  _events.clear(); _eventValues.clear(); _firedEvent = -1;
+}
+
+
+bool
+Stepper::startEvents(const Eigen::VectorXd &state, double t)
+{
+  _firedEvent = -1;
+  for (size_t i=0; i<_events.size(); i++) {
+    _eventValues[i] = _events[i]->evaluate(state, t);
+    if ((! eventFired()) && (0 >= _eventValues[i])) {
+      _firedEvent = i; _eventTime = t;
+    }
+  }
+  return eventFired();
+}
+
+
+Eigen::VectorXd &
+Stepper::halfStepWorkspace(size_t level, size_t i, size_t dim)
+{
+  while (_halfStepWorkspaces.size() <= 2*level+i) {
+    _halfStepWorkspaces.push_back(Eigen::VectorXd(dim));
+  }
+
+  Eigen::VectorXd &workspace = _halfStepWorkspaces[2*level+i];
+  if (size_t(workspace.size()) != dim) { workspace.resize(dim); }
+  return workspace;
+}
+
+
+bool
+Stepper::checkEvents(const Eigen::VectorXd &state, double t)
+{
+  if (eventFired()) { return true; }
+
+  for (size_t i=0; i<_events.size(); i++) {
+    double value = _events[i]->evaluate(state, t);
+    if ((! eventFired()) && (0 < _eventValues[i]) && (0 >= value)) {
+      _firedEvent = i; _eventTime = t;
+    }
+    _eventValues[i] = value;
+  }
+  return eventFired();
+}
@@ -1,7 +1,11 @@
 #ifndef __FLUC_ODE_STEPPER_HH__
 #define __FLUC_ODE_STEPPER_HH__
 
+#include <vector>
+#include <deque>
 #include <eigen3/Eigen/Eigen>
+#include "event.hh"
+#include "stepperstatistics.hh"
 
 
 namespace iNA {
@@ -10,12 +14,41 @@ namespace ODE {
 /**
  * Pure virtual class to define the general stepper interface.
  *
+ * A stepper may also hold a list of events (see @c Event), that stop the integration once they
+ * fire. The events are checked after each step by the caller using @c checkEvents. Steppers with a
+ * continuous extension (see @c DenseOutputStepper) locate the time of the event within their
+ * internal steps.
+ *
+ * Each stepper collects some statistics about the work done (see @c StepperStatistics). Therefore,
+ * the steppers evaluate the system and its Jacobian using @c evaluateSystem and
+ * @c evaluateSystemJacobian.
+ *
  * @ingroup ode
  */
 class Stepper
 {
+protected:
+  /** Holds weak references to the events. */
+  std::vector<Event *> _events;
+  /** Holds the values of the event functions at the last check. */
+  std::vector<double> _eventValues;
+  /** Holds the index of the fired event or -1. */
+  int _firedEvent;
+  /** Holds the time, the event fired. */
+  double _eventTime;
+  /** Holds the statistics of the stepper. */
+  StepperStatistics _statistics;
+  /** Holds the increment of @c step(Eigen::VectorXd &, double). */
+  Eigen::VectorXd _stepDelta;
+  /** Holds the workspaces of the halved steps of the step-size controls, two for each level of
+   * the recursion. The deque keeps the references to the workspaces valid while it grows. */
+  std::deque<Eigen::VectorXd> _halfStepWorkspaces;
 
 public:
+  /**
+   * Constructor.
+   */
+  Stepper();
 
    /**
    * Destructor
@@ -35,9 +68,10 @@ public:
    */
   virtual void step(Eigen::VectorXd &state, double t)
   {
-      Eigen::VectorXd delta(state.size());
-      step(state,t,delta);
-      state+=delta;
+      // The increment is held in a workspace, that is only reallocated if the dimension changes:
+      if (_stepDelta.size() != state.size()) { _stepDelta.resize(state.size()); }
+      step(state,t,_stepDelta);
+      state+=_stepDelta;
   }
 
    /**
@@ -56,6 +90,71 @@ public:
       // ...pass by default
    }
 
+  /**
+   * Adds an event to the stepper, the ownership of the event is not transferred.
+   */
+  void addEvent(Event *event);
+
+  /** Removes all events. */
+  void clearEvents();
+
+  /** Returns the number of events. */
+  inline size_t numEvents() const { return _events.size(); }
+
+  /**
+   * Evaluates all event functions at the initial state and resets the fired event. An event,
+   * which function is not positive at the initial state, fires immediately.
+   *
+   * @returns true if an event fired.
+   */
+  bool startEvents(const Eigen::VectorXd &state, double t);
+
+  /**
+   * Checks for events at the end of a step. If the stepper located an event within the last step
+   * already, this method does nothing.
+   *
+   * @returns true if an event fired.
+   */
+  bool checkEvents(const Eigen::VectorXd &state, double t);
+
+  /** Returns true if an event fired. */
+  inline bool eventFired() const { return 0 <= _firedEvent; }
+
+  /** Returns the index of the event that fired or -1. */
+  inline int firedEvent() const { return _firedEvent; }
+
+  /** Returns the time, the event fired. */
+  inline double eventTime() const { return _eventTime; }
+
+  /** Returns the statistics of the stepper. */
+  inline StepperStatistics &statistics() { return _statistics; }
+
+  /** Returns the statistics of the stepper. */
+  inline const StepperStatistics &statistics() const { return _statistics; }
+
+protected:
+  /**
+   * Returns the i-th (0 or 1) workspace of the halved steps at the given level of the recursion
+   * of a step-size control. The workspaces are allocated on the first rejection at that level
+   * and reused afterwards.
+   */
+  Eigen::VectorXd &halfStepWorkspace(size_t level, size_t i, size_t dim);
+
+  /** Evaluates the given system and counts the evaluation. */
+  template <class Sys, class In, class Out>
+  inline void evaluateSystem(Sys &system, const In &state, double t, Out &rates) {
+    _statistics.startPhase();
+    system.evaluate(state, t, rates);
+    _statistics.stopPhase(StepperStatistics::RHS);
+  }
+
+  /** Evaluates the Jacobian of the given system and counts the evaluation. */
+  template <class Sys, class In, class Jac>
+  inline void evaluateSystemJacobian(Sys &system, const In &state, double t, Jac &jacobian) {
+    _statistics.startPhase();
+    system.evaluateJacobian(state, t, jacobian);
+    _statistics.stopPhase(StepperStatistics::JACOBIAN);
+  }
 };
 
 
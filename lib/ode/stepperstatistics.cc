@@ -0,0 +1,95 @@
+#include "stepperstatistics.hh"
+#include "utils/logger.hh"
+#include <sys/time.h>
+#include <sstream>
+
+using namespace iNA;
+using namespace iNA::ODE;
+
+
+StepperStatistics::StepperStatistics()
+  : _timing(false), _phaseStart(0), _start(0)
+{
+  reset();
+}
+
+
+void
+StepperStatistics::reset()
+{
+  for (size_t i=0; i<NUM_PHASES; i++) {
+    _count[i] = 0; _time[i] = 0;
+  }
+  _accepted = _rejected = 0;
+  _minStepSize = _maxStepSize = 0;
+  _totalTime = 0;
+}
+
+
+void
+StepperStatistics::accept(double h)
+{
+  _accepted++;
+  updateStepSize(h);
+}
+
+
+void
+StepperStatistics::updateStepSize(double h)
+{
+  if (0 >= h) { return; }
+  if ((0 == _minStepSize) || (h < _minStepSize)) { _minStepSize = h; }
+  if (h > _maxStepSize) { _maxStepSize = h; }
+}
+
+
+void
+StepperStatistics::start()
+{
+  _start = now();
+}
+
+
+void
+StepperStatistics::stop()
+{
+  _totalTime += now()-_start;
+}
+
+
+std::string
+StepperStatistics::summary() const
+{
+  std::stringstream buffer;
+  buffer << "RHS evaluations: " << _count[RHS]
+         << ", Jacobian evaluations: " << _count[JACOBIAN]
+         << ", LU decompositions: " << _count[DECOMPOSITION]
+         << ", accepted steps: " << _accepted
+         << ", rejected steps: " << _rejected;
+  if (0 < _maxStepSize) {
+    buffer << ", step-size: [" << _minStepSize << ", " << _maxStepSize << "]";
+  }
+  buffer << ", wall time: " << _totalTime << "s";
+  if (_timing) {
+    buffer << " (RHS: " << _time[RHS] << "s, Jacobian: " << _time[JACOBIAN]
+           << "s, LU: " << _time[DECOMPOSITION] << "s)";
+  }
+  return buffer.str();
+}
+
+
+void
+StepperStatistics::log(const std::string &title) const
+{
+  Utils::Message message = LOG_MESSAGE(Utils::Message::INFO);
+  message << title << ": " << summary();
+  Utils::Logger::get().log(message);
+}
+
+
+double
+StepperStatistics::now()
+{
+  struct timeval tv; gettimeofday(&tv, 0);
+  return double(tv.tv_sec) + double(tv.tv_usec)/1e6;
+}
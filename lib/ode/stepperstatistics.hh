@@ -0,0 +1,126 @@
+#ifndef __FLUC_ODE_STEPPERSTATISTICS_HH__
+#define __FLUC_ODE_STEPPERSTATISTICS_HH__
+
+#include <string>
+#include <cstddef>
+
+
+namespace iNA {
+namespace ODE {
+
+
+/**
+ * Collects some statistics about the work done by a @c Stepper.
+ *
+ * The statistics count the evaluations of the system (RHS), its Jacobian and the decompositions
+ * of iteration matrices (phases), the accepted and rejected steps as well as the smallest and
+ * largest accepted step-size. If enabled (see @c setTiming), the wall time spent in each phase is
+ * measured too. The total wall time of the integration is measured by @c start and @c stop.
+ *
+ * @ingroup ode
+ */
+class StepperStatistics
+{
+public:
+  /** Defines the phases of the integration. */
+  typedef enum {
+    RHS = 0,        ///< Evaluation of the system.
+    JACOBIAN,       ///< Evaluation of the Jacobian.
+    DECOMPOSITION,  ///< Decomposition of the iteration matrix.
+    NUM_PHASES
+  } Phase;
+
+protected:
+  /** Holds the number of calls for each phase. */
+  size_t _count[NUM_PHASES];
+  /** Holds the wall time spent in each phase. */
+  double _time[NUM_PHASES];
+  /** Holds the number of accepted steps. */
+  size_t _accepted;
+  /** Holds the number of rejected steps. */
+  size_t _rejected;
+  /** Holds the smallest accepted step-size. */
+  double _minStepSize;
+  /** Holds the largest accepted step-size. */
+  double _maxStepSize;
+  /** Holds the total wall time. */
+  double _totalTime;
+  /** If true, the time of each phase is measured. */
+  bool _timing;
+  /** Holds the start time of the current phase. */
+  double _phaseStart;
+  /** Holds the start time of the integration. */
+  double _start;
+
+public:
+  /** Constructor. */
+  StepperStatistics();
+
+  /** Resets all counters. */
+  void reset();
+
+  /** Enables or disables the measurement of the time spent in each phase. */
+  inline void setTiming(bool enabled) { _timing = enabled; }
+  /** Returns true if the time of each phase is measured. */
+  inline bool isTiming() const { return _timing; }
+
+  /** Marks the start of a phase. */
+  inline void startPhase() {
+    if (_timing) { _phaseStart = now(); }
+  }
+  /** Marks the end of a phase. */
+  inline void stopPhase(Phase phase) {
+    _count[phase]++;
+    if (_timing) { _time[phase] += now()-_phaseStart; }
+  }
+  /** Counts calls of a phase without timing (i.e. reported by LSODA). */
+  inline void count(Phase phase, size_t n) { _count[phase] += n; }
+
+  /** Counts an accepted step of the given size. */
+  void accept(double h);
+  /** Counts a rejected step. */
+  inline void reject() { _rejected++; }
+  /** Counts accepted steps without step-sizes (i.e. reported by LSODA). */
+  inline void countAccepted(size_t n) { _accepted += n; }
+  /** Updates the smallest and largest step-size. */
+  void updateStepSize(double h);
+
+  /** Starts the measurement of the total wall time. */
+  void start();
+  /** Stops the measurement of the total wall time. */
+  void stop();
+
+  /** Returns the number of evaluations of the system. */
+  inline size_t numRHSEvaluations() const { return _count[RHS]; }
+  /** Returns the number of evaluations of the Jacobian. */
+  inline size_t numJacobianEvaluations() const { return _count[JACOBIAN]; }
+  /** Returns the number of decompositions. */
+  inline size_t numDecompositions() const { return _count[DECOMPOSITION]; }
+  /** Returns the number of accepted steps. */
+  inline size_t numAcceptedSteps() const { return _accepted; }
+  /** Returns the number of rejected steps. */
+  inline size_t numRejectedSteps() const { return _rejected; }
+  /** Returns the smallest accepted step-size or 0 if there was none. */
+  inline double minStepSize() const { return _minStepSize; }
+  /** Returns the largest accepted step-size. */
+  inline double maxStepSize() const { return _maxStepSize; }
+  /** Returns the wall time spent in the given phase (if measured). */
+  inline double time(Phase phase) const { return _time[phase]; }
+  /** Returns the total wall time. */
+  inline double totalTime() const { return _totalTime; }
+
+  /** Returns a human readable summary of the statistics. */
+  std::string summary() const;
+
+  /** Logs the statistics with the given title using @c Utils::Logger. */
+  void log(const std::string &title) const;
+
+  /** Returns the current wall time in seconds. */
+  static double now();
+};
+
+
+}
+}
+
+#endif // __FLUC_ODE_STEPPERSTATISTICS_HH__
@@ -0,0 +1,52 @@
+#include "stepsizecontroller.hh"
+#include "math.hh"
+#include <cmath>
+#include <algorithm>
+
+using namespace iNA;
+using namespace iNA::ODE;
+
+
+PIStepSizeController::PIStepSizeController(double order)
+  : _alpha(0.7/order), _beta(0.4/order), _safety(0.9), _minScale(0.2), _maxScale(10.0),
+    _lastError(1e-4), _rejected(false)
+{
+  // Pass...
+}
+
+
+bool
+PIStepSizeController::accept(double err, double h, double &h_new)
+{
+  // Step failed (i.e. overflow) -> reduce step-size drastically:
+  if (Math::isNotValue(err)) {
+    h_new = h*_minScale; _rejected = true;
+    return false;
+  }
+
+  if (err <= 1.0) {
+    double scale = _maxScale;
+    if (0 < err) {
+      scale = _safety*std::pow(err, -_alpha)*std::pow(_lastError, _beta);
+      scale = std::min(_maxScale, std::max(_minScale, scale));
+    }
+    // Do not increase the step-size directly after a rejected step:
+    if (_rejected) { scale = std::min(scale, 1.0); }
+    h_new = h*scale;
+    _lastError = std::max(err, 1e-4);
+    _rejected = false;
+    return true;
+  }
+
+  h_new = h*std::max(_minScale, _safety*std::pow(err, -_alpha));
+  _rejected = true;
+  return false;
+}
+
+
+void
+PIStepSizeController::reset()
+{
+  _lastError = 1e-4;
+  _rejected  = false;
+}
@@ -0,0 +1,69 @@
+#ifndef __FLUC_ODE_STEPSIZECONTROLLER_HH__
+#define __FLUC_ODE_STEPSIZECONTROLLER_HH__
+
+
+namespace iNA {
+namespace ODE {
+
+
+/**
+ * Implements a proportional-integral (PI) step-size controller for embedded methods, as
+ * described in @cite press2007.
+ *
+ * Given the (normalized) error estimate \f$e_n\f$ of a step with step-size \f$h\f$, the
+ * step-size for the next step is chosen as
+ * \f[
+ *  h_{n+1} = s\,h\,e_n^{-\alpha}e_{n-1}^{\beta}\,,
+ * \f]
+ * with \f$\alpha=0.7/k\f$ and \f$\beta=0.4/k\f$ where \f$k\f$ is the order of the error estimate
+ * and \f$s\f$ a safety factor. The change of the step-size is limited and the step-size is not
+ * increased directly after a rejected step.
+ *
+ * @ingroup ode
+ */
+class PIStepSizeController
+{
+protected:
+  /** Exponent of the current error. */
+  double _alpha;
+  /** Exponent of the previous error. */
+  double _beta;
+  /** Safety factor. */
+  double _safety;
+  /** Minimum factor of the step-size change. */
+  double _minScale;
+  /** Maximum factor of the step-size change. */
+  double _maxScale;
+  /** Holds the error of the last accepted step. */
+  double _lastError;
+  /** If true, the last step was rejected. */
+  bool _rejected;
+
+public:
+  /**
+   * Constructor.
+   *
+   * @param order Specifies the order of the error estimate.
+   */
+  PIStepSizeController(double order);
+
+  /**
+   * Decides whether a step with the error estimate @c err is accepted and proposes the
+   * step-size for the next (or repeated) step.
+   *
+   * @param err Specifies the normalized error estimate (accepted if <= 1).
+   * @param h Specifies the step-size of the step.
+   * @param h_new On exit, holds the proposed step-size.
+   * @returns true if the step is accepted.
+   */
+  bool accept(double err, double h, double &h_new);
+
+  /** Resets the controller. */
+  void reset();
+};
+
+
+}
+}
+
+#endif // __FLUC_ODE_STEPSIZECONTROLLER_HH__
@@ -79,6 +79,13 @@ public:
       return Instruction(OR_OP);
     }
 
+    /** Returns the op-code of the instruction. */
+    Type type() const { return _type; }
+    /** Returns the minimum or exact value of the instruction. */
+    const Value &min() const { return _min; }
+    /** Returns the maximum value of the instruction. */
+    const Value &max() const { return _max; }
+
   public:
     /** Evaluates the condition on the given stack. */
     inline void eval(const Value &value, std::vector<bool> &stack) const {
@@ -150,6 +157,12 @@ public:
       _code.push_back(Instruction::createOr());
     }
 
+    /** Returns the number of instructions. */
+    size_t size() const { return _code.size(); }
+
+    /** Returns the i-th instruction. */
+    const Instruction &instruction(size_t i) const { return _code[i]; }
+
     /** Evaluates byte-code and returns result. */
     bool matches(const Value &value, std::vector<bool> &stack) const {
       // evaluate code on stack:
@@ -239,6 +252,16 @@ public:
       return -1;
     }
 
+    /** Returns an iterator pointing to the first transition. */
+    iterator begin() const {
+      return _transitions.begin();
+    }
+
+    /** Returns an iterator pointing right after the last transition. */
+    iterator end() const {
+      return _transitions.end();
+    }
+
     /** Returns true if the state is a final state. */
     bool isFinal() const {
       return _is_final;
@@ -300,6 +323,16 @@ public:
     return 0;
   }
 
+  /** Returns the number of states of the DFA. */
+  size_t numStates() const {
+    return _states.size();
+  }
+
+  /** Returns the state with the given index. */
+  const State &getState(size_t idx) const {
+    return _states[idx];
+  }
+
   /** Returns the current state, if 0 DFA is in an error state. */
   State *getCurrentState() {
     if (0 > _current_state_index) return 0;
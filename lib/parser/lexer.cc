@@ -1,5 +1,6 @@
 #include "lexer.hh"
 #include "exception.hh"
+#include <algorithm>
 
 
 using namespace iNA::Parser;
@@ -151,11 +152,152 @@ TokenRule::onAlphaNum(State *A, State *B)
   cond.addOr();
 }
 
+/* ******************************************************************************************** *
+ * Implementation of LexerDFA:
+ * ******************************************************************************************** */
+LexerDFA::LexerDFA()
+  : _table(256, -1), _final(1, -1)
+{
+  // pass...
+}
+
+std::map<std::string, LexerDFA *> LexerDFA::_cache;
+
+const LexerDFA &
+LexerDFA::get(const std::vector<TokenRule *> &rules)
+{
+  std::string key = signature(rules);
+  LexerDFA *dfa = 0;
+
+#pragma omp critical (ina_lexer_dfa_cache)
+  {
+    std::map<std::string, LexerDFA *>::iterator item = _cache.find(key);
+    if (_cache.end() == item) {
+      dfa = new LexerDFA(); dfa->compile(rules);
+      _cache[key] = dfa;
+    } else {
+      dfa = item->second;
+    }
+  }
+
+  return *dfa;
+}
+
+std::string
+LexerDFA::signature(const std::vector<TokenRule *> &rules)
+{
+  std::stringstream buffer;
+  for (size_t r=0; r<rules.size(); r++) {
+    buffer << "R" << rules[r]->getId();
+    for (size_t s=0; s<rules[r]->numStates(); s++) {
+      const TokenRule::State &state = rules[r]->getState(s);
+      buffer << (state.isFinal() ? "F" : "S");
+      for (TokenRule::State::iterator trans=state.begin(); trans!=state.end(); trans++) {
+        buffer << "T" << trans->next_idx();
+        for (size_t i=0; i<trans->cond().size(); i++) {
+          const TokenRule::Instruction &instr = trans->cond().instruction(i);
+          buffer << " " << int(instr.type()) << "," << int(instr.min()) << "," << int(instr.max());
+        }
+      }
+    }
+  }
+  return buffer.str();
+}
+
+void
+LexerDFA::compile(const std::vector<TokenRule *> &rules)
+{
+  size_t R = rules.size();
+  std::vector<bool> stack; stack.reserve(10);
+
+  // Product construction, each state is a tuple of states of the token rules (-1: error state).
+  std::vector< std::vector<int> > states;
+  std::map<std::vector<int>, int> state_index;
+  std::vector<int> table;
+
+  std::vector<int> initial(R, -1);
+  for (size_t r=0; r<R; r++) {
+    if (0 < rules[r]->numStates()) { initial[r] = 0; }
+  }
+  states.push_back(initial); state_index[initial] = 0;
+
+  std::vector<int> target(R);
+  for (size_t s=0; s<states.size(); s++) {
+    for (size_t c=0; c<256; c++) {
+      bool alive = false;
+      for (size_t r=0; r<R; r++) {
+        int current = states[s][r];
+        target[r] = (0 > current) ? -1 :
+            rules[r]->getState(current).accept(char(c), stack);
+        alive |= (0 <= target[r]);
+      }
+      if (! alive) { table.push_back(-1); continue; }
+
+      std::map<std::vector<int>, int>::iterator item = state_index.find(target);
+      if (state_index.end() == item) {
+        item = state_index.insert(std::make_pair(target, int(states.size()))).first;
+        states.push_back(target);
+      }
+      table.push_back(item->second);
+    }
+  }
+
+  // Matching rule of each state, the first rule in a final state wins:
+  size_t N = states.size();
+  std::vector<int> matching(N, -1);
+  for (size_t s=0; s<N; s++) {
+    for (size_t r=0; r<R; r++) {
+      if ((0 <= states[s][r]) && rules[r]->getState(states[s][r]).isFinal()) {
+        matching[s] = r; break;
+      }
+    }
+  }
+  states.clear(); state_index.clear();
+
+  // Minimization by partition refinement, initially states are distinguished by their token-id.
+  // Classes are numbered in order of their first state, hence the initial state stays in class 0.
+  std::vector<int> cls(N), new_cls(N);
+  std::map<std::vector<int>, int> signatures;
+  std::vector<int> signature(257);
+  for (size_t s=0; s<N; s++) {
+    signature.assign(1, (0 > matching[s]) ? -1 : int(rules[matching[s]]->getId()));
+    cls[s] = signatures.insert(std::make_pair(signature, int(signatures.size()))).first->second;
+  }
+  size_t num_classes = signatures.size(), old_num_classes = 0;
+  while (num_classes != old_num_classes) {
+    signatures.clear(); signature.resize(257);
+    for (size_t s=0; s<N; s++) {
+      signature[0] = cls[s];
+      for (size_t c=0; c<256; c++) {
+        int next = table[(s<<8)+c];
+        signature[c+1] = (0 > next) ? -1 : cls[next];
+      }
+      new_cls[s] = signatures.insert(std::make_pair(signature, int(signatures.size()))).first->second;
+    }
+    std::swap(cls, new_cls);
+    old_num_classes = num_classes; num_classes = signatures.size();
+  }
+
+  // Assemble minimized transition table:
+  _table.assign(num_classes<<8, -1);
+  _final.assign(num_classes, -1);
+  for (size_t s=0; s<N; s++) {
+    _final[cls[s]] = matching[s];
+    for (size_t c=0; c<256; c++) {
+      int next = table[(s<<8)+c];
+      _table[(size_t(cls[s])<<8)+c] = (0 > next) ? -1 : cls[next];
+    }
+  }
+}
+
+
+
 /* ******************************************************************************************** *
  * Implementation of Lexer:
  * ******************************************************************************************** */
 Lexer::Lexer(std::istream &input)
-  : input(input), history(0), reader(), _line_no(1)
+  : input(input), history(0), rules(), reader(0), _modified(true),
+    _input_buffer(BUFFER_SIZE), _input_pos(0), _input_end(0), _line_no(1)
 {
   // Initialize stack of token pointer:
   this->stack.push_back(State(0,false));
@@ -165,9 +307,18 @@ Lexer::Lexer(std::istream &input)
 }
 
 
+Lexer::~Lexer()
+{
+  for (size_t i=0; i<rules.size(); i++) {
+    delete rules[i];
+  }
+}
+
+
 void
 Lexer::addRule(TokenRule *token) {
-  this->reader.addAutomata(token);
+  this->rules.push_back(token);
+  this->_modified = true;
 }
 
 const Token &
@@ -202,6 +353,13 @@ Lexer::currentIndex() const
 }
 
 
+void
+Lexer::setCurrentIndex(size_t idx)
+{
+  this->stack.back().index = idx;
+}
+
+
 void
 Lexer::setTerminal(bool terminal) {
   this->stack.back().is_terminal = terminal;
@@ -286,53 +444,64 @@ Lexer::operator [](size_t idx) const {
 void
 Lexer::parseToken()
 {
-  // Reset NFA:
-  reader.reset();
-  // Clear buffer
-  _buffer.str("");
-
-  // If end of stream -> push back a EOS token
-  if (input.eof()) {
-    history.push_back(Token(Token::END_OF_INPUT, 0, ""));
-    return;
-  }
-
-  input.peek();
-  // Read chars until EOF or NFA does not accept the next char:
-  while ((!input.eof()) && reader.accepts(input.peek()))
-  {
-    char c; input.get(c); input.peek();
-    reader.accept(c);
-    _buffer << c;
+  // Obtain merged token rules if needed:
+  if (_modified) {
+    reader = &LexerDFA::get(rules); _modified = false;
   }
 
-  // If the reader is not in a final state:
-  if (! reader.inFinalState()) {
-    ParserError err(_line_no);
-    err << "@line: " << _line_no
-        << "Lexer: unexpected char: " << (unsigned char)(input.peek());
-    throw err;
-  }
-
-  // Cast DFA to TokenRule...
-  TokenRule *rule = static_cast<TokenRule *>(reader.getMatchingAutomata());
-
-  // Store parsed token in history:
-  Token token = rule->getToken(_buffer.str(), _line_no);
-
-  // If token is NEW_LINE token:
-  if (0 != new_line_token.count(token.getId())) {
-    _line_no++;
-  }
-
-  // If parsed token is ignored -> read another one...
-  if (this->ignored_token.end() != this->ignored_token.find(token.getId())) {
-    this->parseToken();
+  while (true) {
+    // If end of stream -> push back a EOS token
+    if (! fillBuffer()) {
+      history.push_back(Token(Token::END_OF_INPUT, 0, ""));
+      return;
+    }
+
+    // Read chars until EOF or the DFA does not accept the next char:
+    _buffer.clear();
+    int state = 0, next = 0;
+    while (fillBuffer() && (0 <= (next = reader->next(state, _input_buffer[_input_pos])))) {
+      _buffer.push_back(_input_buffer[_input_pos++]);
+      state = next;
+    }
+
+    // If the reader is not in a final state:
+    int rule = reader->matchingRule(state);
+    if (0 > rule) {
+      ParserError err(_line_no);
+      err << "@line: " << _line_no << "Lexer: unexpected char: ";
+      if (fillBuffer()) { err << (unsigned char)(_input_buffer[_input_pos]); }
+      else { err << "end-of-input"; }
+      throw err;
+    }
+
+    // Store parsed token in history:
+    Token token = rules[rule]->getToken(_buffer, _line_no);
+
+    // If token is NEW_LINE token:
+    if (0 != new_line_token.count(token.getId())) {
+      _line_no++;
+    }
+
+    // If parsed token is ignored -> read another one...
+    if (this->ignored_token.end() != this->ignored_token.find(token.getId())) {
+      continue;
+    }
+
+    //std::cerr << "Parsed token " << token.getValue() << std::endl;
+    history.push_back(token);
     return;
   }
+}
 
-  //std::cerr << "Parsed token " << token.getValue() << std::endl;
-  history.push_back(token);
+
+bool
+Lexer::readBlock()
+{
+  _input_pos = _input_end = 0;
+  if (! input.good()) { return false; }
+  input.read(&(_input_buffer[0]), _input_buffer.size());
+  _input_end = input.gcount();
+  return 0 < _input_end;
 }
 
 
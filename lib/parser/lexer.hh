@@ -5,6 +5,7 @@
 #include <vector>
 #include <iostream>
 #include <sstream>
+#include <map>
 
 
 namespace iNA {
@@ -221,9 +222,70 @@ public:
 };
 
 
+/**
+ * Merges the token rules of a @c Lexer into a single minimized DFA, represented by a transition
+ * table with 256 entries per state.
+ *
+ * The states of the merged DFA are the reachable combinations of the states of all token rules
+ * (product construction). A merged state is final if at least one token rule is in a final state,
+ * the first of these rules determines the token. Equivalent states are then merged by partition
+ * refinement. Once compiled, the lexer processes each char by a single table lookup instead of
+ * evaluating the transition conditions of every token rule.
+ *
+ * As the compilation is expensive compared to lexing short inputs, the merged DFAs are obtained
+ * by @c get, which compiles each set of token rules only once and shares the result between all
+ * lexers using the same rules.
+ *
+ * @ingroup parser
+ */
+class LexerDFA
+{
+protected:
+  /** Holds the transition table, 256 entries per state, -1 marks the error state. */
+  std::vector<int> _table;
+  /** Holds for each state the index of the matching token rule or -1 if the state is not final. */
+  std::vector<int> _final;
+
+  /** Holds the compiled DFAs, keyed by the signature of their token rules. */
+  static std::map<std::string, LexerDFA *> _cache;
+
+public:
+  /** Constructs an empty DFA, that accepts nothing. */
+  LexerDFA();
+
+  /** Merges the given token rules, the first rules take precedence. */
+  void compile(const std::vector<TokenRule *> &rules);
+
+  /** Returns the merged DFA of the given token rules. The DFA is compiled once for each set of
+   * token rules, the returned reference stays valid for the lifetime of the process. */
+  static const LexerDFA &get(const std::vector<TokenRule *> &rules);
+
+  /** Returns the number of states. */
+  inline size_t numStates() const { return _final.size(); }
+
+  /** Returns the next state or -1 if the char is not accepted in the given state. The initial
+   * state is 0. */
+  inline int next(int state, char c) const {
+    return _table[(size_t(state)<<8) + (unsigned char)(c)];
+  }
+
+  /** Returns the index of the token rule matching in the given state or -1 if the state is not
+   * final. */
+  inline int matchingRule(int state) const { return _final[state]; }
+
+protected:
+  /** Serializes the states and transitions of the given token rules. Two sets of token rules with
+   * the same signature are merged into the same DFA. */
+  static std::string signature(const std::vector<TokenRule *> &rules);
+};
+
+
 /**
  * Implements a general lexer.
  *
+ * The token rules are merged into a @c LexerDFA once the first token is read, lexers with the same
+ * token rules share this DFA. The input is read in blocks of @c BUFFER_SIZE chars.
+ *
  * @ingroup parser
  */
 class Lexer
@@ -255,6 +317,9 @@ public:
   };
 
 
+  /** Size of the input buffer. */
+  static const size_t BUFFER_SIZE = 4096;
+
 protected:
   /** Holds a weak reference to the input stream. */
   std::istream &input;
@@ -262,8 +327,12 @@ protected:
   std::vector< Token > history;
   /** Holds stack of states. */
   std::list<State> stack;
-  /** The @c NFA to process input. */
-  NFA<char> reader;
+  /** Holds the token rules, in order of their precedence. The lexer owns the rules. */
+  std::vector<TokenRule *> rules;
+  /** The merged token rules, obtained on demand. */
+  const LexerDFA *reader;
+  /** If true, the token rules have changed since the last compilation of the @c reader. */
+  bool _modified;
   /** A set of ignored token. */
   std::set<unsigned> ignored_token;
   /** A set of tokens marking a new-line. */
@@ -271,7 +340,13 @@ protected:
   /** Holds a translation-table Token-ID -> name. Used for debug and exceptions. */
   std::map<unsigned, std::string> token_table;
   /** This buffer collects the chars that are accepted by a token. */
-  std::stringstream _buffer;
+  std::string _buffer;
+  /** Holds a block of the input. */
+  std::vector<char> _input_buffer;
+  /** Position of the next char in the input buffer. */
+  size_t _input_pos;
+  /** Number of valid chars in the input buffer. */
+  size_t _input_end;
   /** Line numer counter. */
   size_t _line_no;
 
@@ -279,6 +354,9 @@ public:
   /** Constructs a general lexer for the given input. */
   Lexer(std::istream &input);
 
+  /** Destructor, also frees the token rules. */
+  ~Lexer();
+
   /** Adds a rule to the lexer, the ownership of the rule is transferred to the lexer. */
   void addRule(TokenRule *token);
 
@@ -292,6 +370,9 @@ public:
   /** Returns the index of the current token. */
   size_t currentIndex() const;
 
+  /** Sets the index of the current token, the token must have been parsed already. */
+  void setCurrentIndex(size_t idx);
+
   /** Sets the current state as terminal. */
   void setTerminal(bool terminal);
 
@@ -326,6 +407,16 @@ public:
 protected:
   /** Parses the next token from input. */
   void parseToken();
+
+  /** Ensures that the input buffer holds at least one char, returns false at the end of the
+   * input. */
+  inline bool fillBuffer() {
+    if (_input_pos < _input_end) { return true; }
+    return readBlock();
+  }
+
+  /** Reads the next block of the input into the buffer, returns false at the end of the input. */
+  bool readBlock();
 };
 
 
@@ -9,12 +9,18 @@ using namespace iNA::Parser;
  * Implementation of ConcreteSyntaxTree:
  * ******************************************************************************************** */
 ConcreteSyntaxTree::ConcreteSyntaxTree()
-  : type(EMPTY_NODE)
+  : type(EMPTY_NODE), index(0), children(), _cache(0), _owns_cache(false)
 {
   // Pass...
 }
 
 
+ConcreteSyntaxTree::~ConcreteSyntaxTree()
+{
+  if (_owns_cache) { delete _cache; }
+}
+
+
 ConcreteSyntaxTree::Type
 ConcreteSyntaxTree::getType() const
 {
@@ -63,7 +69,7 @@ ConcreteSyntaxTree::setMatched(bool matched)
     this->index = 1;
   } else {
     this->index = 0;
-    ConcreteSyntaxTree::asEmptyNode(this->children[0]);
+    ConcreteSyntaxTree::asEmptyNode(*(this->children[0]));
   }
 }
 
@@ -71,20 +77,20 @@ ConcreteSyntaxTree::setMatched(bool matched)
 ConcreteSyntaxTree &
 ConcreteSyntaxTree::operator* ()
 {
-  return this->children[0];
+  return *(this->children[0]);
 }
 
 
 ConcreteSyntaxTree &
 ConcreteSyntaxTree::operator[] (size_t idx)
 {
-  return this->children[idx];
+  return *(this->children[idx]);
 }
 
 
 void
 ConcreteSyntaxTree::addChild() {
-  this->children.push_back(ConcreteSyntaxTree());
+  this->children.push_back(this->cache().allocNode());
 }
 
 void
@@ -98,6 +104,18 @@ ConcreteSyntaxTree::size() const {
 }
 
 
+ParserCache &
+ConcreteSyntaxTree::cache()
+{
+  // If this node is the root of the tree -> create cache
+  if (0 == this->_cache) {
+    this->_cache = new ParserCache();
+    this->_owns_cache = true;
+  }
+  return *(this->_cache);
+}
+
+
 void
 ConcreteSyntaxTree::asEmptyNode(ConcreteSyntaxTree &node)
 {
@@ -118,7 +136,11 @@ void
 ConcreteSyntaxTree::asProdNode(ConcreteSyntaxTree &node, size_t n_children)
 {
   node.type = PRODUCTION_NODE;
+  // Always allocate new child nodes, the old ones may be shared with the cache:
   node.children.resize(n_children);
+  for (size_t i=0; i<n_children; i++) {
+    node.children[i] = node.cache().allocNode();
+  }
   node.index = 0;
 }
 
@@ -127,6 +149,7 @@ ConcreteSyntaxTree::asAltNode(ConcreteSyntaxTree &node)
 {
   node.type = ALTERNATIVE_NODE;
   node.children.resize(1);
+  node.children[0] = node.cache().allocNode();
   node.index = 0;
 }
 
@@ -135,6 +158,7 @@ ConcreteSyntaxTree::asOptNode(ConcreteSyntaxTree &node)
 {
   node.type = ALTERNATIVE_NODE;
   node.children.resize(1);
+  node.children[0] = node.cache().allocNode();
   node.index = 0;
 }
 
@@ -147,18 +171,99 @@ ConcreteSyntaxTree::asListNode(ConcreteSyntaxTree &node)
 }
 
 
+/* ******************************************************************************************** *
+ * Implementation of ParserCache:
+ * ******************************************************************************************** */
+ParserCache::Entry::Entry()
+  : success(false), terminal(false), end(0), type(ConcreteSyntaxTree::EMPTY_NODE), index(0),
+    children(), error(0)
+{
+  // Pass...
+}
+
+
+ParserCache::ParserCache()
+  : _blocks(), _used(BLOCK_SIZE), _entries()
+{
+  // Pass...
+}
+
+
+ParserCache::~ParserCache()
+{
+  for (std::map<std::pair<const Production *, size_t>, Entry>::iterator item=_entries.begin();
+       item!=_entries.end(); item++) {
+    delete item->second.error;
+  }
+  for (size_t i=0; i<_blocks.size(); i++) {
+    delete[] _blocks[i];
+  }
+}
+
+
+ConcreteSyntaxTree *
+ParserCache::allocNode()
+{
+  if (BLOCK_SIZE == _used) {
+    _blocks.push_back(new ConcreteSyntaxTree[BLOCK_SIZE]);
+    _used = 0;
+  }
+  ConcreteSyntaxTree *node = _blocks.back() + (_used++);
+  node->_cache = this;
+  return node;
+}
+
+
+const ParserCache::Entry *
+ParserCache::find(const Production *production, size_t token) const
+{
+  std::map<std::pair<const Production *, size_t>, Entry>::const_iterator item =
+      _entries.find(std::make_pair(production, token));
+  if (_entries.end() == item) { return 0; }
+  return &(item->second);
+}
+
+
+void
+ParserCache::addSuccess(const Production *production, size_t token, size_t end, bool terminal,
+                        const ConcreteSyntaxTree &node)
+{
+  Entry &entry = _entries[std::make_pair(production, token)];
+  entry.success = true; entry.terminal = terminal; entry.end = end;
+  entry.type = node.type; entry.index = node.index; entry.children = node.children;
+}
+
+
+void
+ParserCache::addFailure(const Production *production, size_t token, bool terminal,
+                        const SyntaxError &error)
+{
+  Entry &entry = _entries[std::make_pair(production, token)];
+  entry.success = false; entry.terminal = terminal;
+  entry.error = new SyntaxError(error);
+}
+
+
+void
+ParserCache::restore(const Entry &entry, ConcreteSyntaxTree &node)
+{
+  node.type = entry.type; node.index = entry.index; node.children = entry.children;
+}
+
+
+
 /* ******************************************************************************************** *
  * Implementation of Production:
  * ******************************************************************************************** */
 Production::Production()
-  : elements()
+  : elements(), _memoize(true)
 {
   // Pass...
 }
 
 
 Production::Production(size_t num_prod, ...)
-  : elements()
+  : elements(), _memoize(true)
 {
   va_list args; va_start(args, num_prod);
   for (size_t i=0; i<num_prod; i++)
@@ -170,7 +275,7 @@ Production::Production(size_t num_prod, ...)
 
 
 Production::Production(const std::list<Production *> &elements)
-  : elements(elements)
+  : elements(elements), _memoize(true)
 {
   // Pass...
 }
@@ -192,13 +297,47 @@ Production::parse(Lexer &lexer, ConcreteSyntaxTree &element)
   for (size_t i=0; i<this->elements.size(); i++, iter++)
   {
     // Try to parse production
-    (*iter)->parse(lexer, element[i]);
+    (*iter)->parseMemoized(lexer, element[i]);
   }
 
   // ok, done!
 }
 
 
+void
+Production::parseMemoized(Lexer &lexer, ConcreteSyntaxTree &element)
+{
+  if (! _memoize) {
+    this->parse(lexer, element);
+    return;
+  }
+
+  // If this production was already parsed at the current token -> reuse result
+  ParserCache &cache = element.cache();
+  size_t token = lexer.currentIndex();
+  if (const ParserCache::Entry *entry = cache.find(this, token)) {
+    if (entry->terminal) { lexer.setTerminal(true); }
+    if (! entry->success) { throw SyntaxError(*(entry->error)); }
+    ParserCache::restore(*entry, element);
+    lexer.setCurrentIndex(entry->end);
+    return;
+  }
+
+  // Track whether this production sets the lexer state terminal:
+  bool was_terminal = lexer.isTerminal();
+  lexer.setTerminal(false);
+  try {
+    this->parse(lexer, element);
+  } catch (SyntaxError &err) {
+    cache.addFailure(this, token, lexer.isTerminal(), err);
+    lexer.setTerminal(was_terminal || lexer.isTerminal());
+    throw;
+  }
+  cache.addSuccess(this, token, lexer.currentIndex(), lexer.isTerminal(), element);
+  lexer.setTerminal(was_terminal || lexer.isTerminal());
+}
+
+
 
 /* ******************************************************************************************** *
  * Implementation of TokenProduction:
@@ -206,7 +345,8 @@ Production::parse(Lexer &lexer, ConcreteSyntaxTree &element)
 TokenProduction::TokenProduction(unsigned id, bool is_terminal)
   : Production(), _id(id), _is_terminal(is_terminal)
 {
-  // Pass...
+  // Matching a single token is cheaper than a lookup:
+  _memoize = false;
 }
 
 
@@ -282,7 +422,7 @@ AltProduction::parse(Lexer &lexer, ConcreteSyntaxTree &element)
     {
       // Try to parse this alternative
       lexer.push_state();
-      this->alternatives[i]->parse(lexer, element[0]);
+      this->alternatives[i]->parseMemoized(lexer, element[0]);
       lexer.drop_state();
       // On success store index of alternative
       element.setAltIdx(i);
@@ -321,7 +461,7 @@ AltProduction::parse(Lexer &lexer, ConcreteSyntaxTree &element)
 EmptyProduction::EmptyProduction()
   : Production()
 {
-  // Pass...
+  _memoize = false;
 }
 
 void
@@ -351,7 +491,7 @@ OptionalProduction::parse(Lexer &lexer, ConcreteSyntaxTree &element)
   // First try to parse child-production:
   lexer.push_state();
   try {
-    this->production->parse(lexer, element[0]);
+    this->production->parseMemoized(lexer, element[0]);
     lexer.drop_state();
     element.setMatched(true);
   } catch (SyntaxError &err) {
@@ -382,7 +522,7 @@ ListProduction::parse(Lexer &lexer, ConcreteSyntaxTree &element)
     lexer.push_state();
     try {
       element.addChild();
-      this->_production->parse(lexer, element[idx]);
+      this->_production->parseMemoized(lexer, element[idx]);
       lexer.drop_state(); idx++;
     } catch (SyntaxError &err) {
       lexer.restore_state();
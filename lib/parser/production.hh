@@ -8,6 +8,10 @@
 namespace iNA {
 namespace Parser {
 
+// Forward declarations:
+class Production;
+class ParserCache;
+
 
 /**
  * Implements a concrete syntax tree (CST) node.
@@ -16,6 +20,9 @@ namespace Parser {
  * be seen as the actual parsing result. Each production of a grammar generates a node of the
  * concrete syntax tree. An assembler is then used to build an abstract syntax tree (AST).
  *
+ * The child nodes are allocated from the @c ParserCache of the tree, which is owned by the root
+ * node. Hence, the nodes of a tree are only valid as long as the root node exists.
+ *
  * @ingroup parser
  */
 class ConcreteSyntaxTree
@@ -35,6 +42,9 @@ public:
   /** Constructor of an empty-node. Use one of the factory method to initialize a CST node. */
   ConcreteSyntaxTree();
 
+  /** Destructor, frees the @c ParserCache if the node is the root of the tree. */
+  ~ConcreteSyntaxTree();
+
   /** Returns the type of the node. */
   Type getType() const;
 
@@ -71,6 +81,9 @@ public:
   /** Returns the number of child nodes. */
   size_t size() const;
 
+  /** Returns the cache of the tree, it is created on demand. */
+  ParserCache &cache();
+
 
 public:
   /** Configures the given node as an empty node. */
@@ -107,7 +120,102 @@ protected:
    * child of the optional production if it matched. If the production was an
    * @c AlternativeProduction that generated this node, @c children[0] contains the alternative,
    * that matched. A @c TokenProduction and @c EmptyProduction has no child nodes. */
-  std::vector<ConcreteSyntaxTree> children;
+  std::vector<ConcreteSyntaxTree *> children;
+
+  /** Holds a weak reference to the cache of the tree or 0 if not created yet. */
+  ParserCache *_cache;
+
+  /** If true, this node is the root of the tree and owns the cache. */
+  bool _owns_cache;
+
+private:
+  /** Hidden copy constructor, nodes are shared between trees. */
+  ConcreteSyntaxTree(const ConcreteSyntaxTree &other);
+  /** Hidden assignment operator. */
+  ConcreteSyntaxTree &operator=(const ConcreteSyntaxTree &other);
+
+  friend class ParserCache;
+};
+
+
+
+/**
+ * Holds the nodes of a @c ConcreteSyntaxTree and the results of all productions parsed at a
+ * certain token (packrat parsing).
+ *
+ * The nodes are allocated in blocks of @c BLOCK_SIZE nodes and freed all at once with the
+ * cache. Once a node was parsed successfully, it is not modified anymore. Hence the result of a
+ * production can be reused by sharing the child nodes, if the same production is parsed at the
+ * same token again (i.e. by another alternative). Failures are reused as well, hence each
+ * production is parsed at most once per token.
+ *
+ * @ingroup parser
+ */
+class ParserCache
+{
+public:
+  /** Number of nodes allocated at once. */
+  static const size_t BLOCK_SIZE = 256;
+
+  /** Holds the result of a production parsed at a certain token. */
+  class Entry {
+  public:
+    /** If true, the production matched. */
+    bool success;
+    /** If true, the production left the lexer in a terminal state. */
+    bool terminal;
+    /** The index of the first token following the production. */
+    size_t end;
+    /** The type of the node. */
+    ConcreteSyntaxTree::Type type;
+    /** The index of the node. */
+    size_t index;
+    /** The child nodes. */
+    std::vector<ConcreteSyntaxTree *> children;
+    /** The error, if the production did not match. Owned by the cache. */
+    SyntaxError *error;
+
+  public:
+    /** Constructor. */
+    Entry();
+  };
+
+protected:
+  /** The blocks of nodes. */
+  std::vector<ConcreteSyntaxTree *> _blocks;
+  /** The number of nodes used in the last block. */
+  size_t _used;
+  /** The results of productions, indexed by the production and token index. */
+  std::map<std::pair<const Production *, size_t>, Entry> _entries;
+
+public:
+  /** Constructor. */
+  ParserCache();
+  /** Destructor, frees all nodes. */
+  ~ParserCache();
+
+  /** Allocates a new empty node. */
+  ConcreteSyntaxTree *allocNode();
+
+  /** Returns the result of the production at the given token or 0 if not parsed yet. */
+  const Entry *find(const Production *production, size_t token) const;
+
+  /** Stores the given node as the result of the production at the given token. */
+  void addSuccess(const Production *production, size_t token, size_t end, bool terminal,
+                  const ConcreteSyntaxTree &node);
+
+  /** Stores a copy of the error as the result of the production at the given token. */
+  void addFailure(const Production *production, size_t token, bool terminal,
+                  const SyntaxError &error);
+
+  /** Restores the node from the given entry. */
+  static void restore(const Entry &entry, ConcreteSyntaxTree &node);
+
+private:
+  /** Hidden copy constructor. */
+  ParserCache(const ParserCache &other);
+  /** Hidden assignment operator. */
+  ParserCache &operator=(const ParserCache &other);
 };
 
 
@@ -127,6 +235,8 @@ class Production
 protected:
   /** List of all child productions. */
   std::list<Production *> elements;
+  /** If true, the results of this production are stored in the @c ParserCache. */
+  bool _memoize;
 
 protected:
   /** Hidden constructor. */
@@ -145,6 +255,10 @@ public:
   /** Performs parsing and assembles the CST. If the production is successful, it initializes
    * the given CST element. */
   virtual void parse(Lexer &lexer, ConcreteSyntaxTree &element);
+
+  /** Like @c parse, but reuses the result if this production was already parsed at the current
+   * token. Compound productions parse their child productions using this method. */
+  void parseMemoized(Lexer &lexer, ConcreteSyntaxTree &element);
 };
 
 
@@ -26,7 +26,8 @@ Ast::Model *importModel(std::istream &input);
 Ast::Model *importModel(const std::string &filename);
 
 
-/** Serializes the given @c Ast::Model as SBML-sh into the given stream.
+/** Serializes the given @c Ast::Model as SBML-sh into the given stream. All values are written
+ * with the precision of the stream.
  * @ingroup modelio */
 void exportModel(Ast::Model &model, std::ostream &stream);
 
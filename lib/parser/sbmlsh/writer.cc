@@ -94,6 +94,7 @@ Writer::processUnitDefinitions(Ast::Model &model, std::ostream &output)
 {
   std::list<std::string> units;
   std::stringstream temp;
+  temp.precision(output.precision());
 
   // Process default substance unit first:
   temp.str(""); processUnitDefinition("substance", model.getSubstanceUnit(), temp);
@@ -130,6 +131,7 @@ Writer::processUnitDefinition(const std::string &id, const Ast::Unit &unit, std:
 {
   std::list<std::string> units;
   std::stringstream temp;
+  temp.precision(output.precision());
 
   if (unit.isScaledBaseUnit()) {
     // If the unit can be expressed in terms of a single scaled base unit -> write compact format
@@ -166,6 +168,7 @@ void
 Writer::processScaledUnit(Ast::Unit::BaseUnit unit, double multiplier, int scale, int exponent, std::ostream &output)
 {
   std::list<std::string> modifier; std::stringstream temp;
+  temp.precision(output.precision());
   if (1 != multiplier) { temp << "m=" << multiplier; modifier.push_back(temp.str()); temp.str(""); }
   if (0 != scale) { temp << "s=" << scale; modifier.push_back(temp.str()); temp.str(""); }
   if (1 != exponent) { temp << "e=" << exponent; modifier.push_back(temp.str()); temp.str(""); }
@@ -262,6 +265,7 @@ void
 Writer::processRuleList(Ast::Model &model, std::ostream &output)
 {
   std::list<std::string> rules; std::stringstream temp;
+  temp.precision(output.precision());
 
   // Iterate over variable definitions:
   for (Ast::Model::iterator item=model.begin(); item!=model.end(); item++) {
@@ -311,6 +315,7 @@ void
 Writer::processReaction(Ast::Reaction *reac, const Ast::Model &model, std::ostream &output)
 {
   std::stringstream temp;
+  temp.precision(output.precision());
 
   if (reac->isReversible()) { output << std::endl << " @rr="; }
   else { output << std::endl << " @r="; }
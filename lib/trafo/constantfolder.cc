@@ -77,7 +77,7 @@ GiNaC::ex
 InitialValueFolder::apply(const GiNaC::ex & expr)
 {
   // apply substitutions on expression:
-  return expr.subs(this->getTable());
+  return _substitute(expr);
 }
 
 double
@@ -104,7 +104,7 @@ InitialValueFolder::apply(const Eigen::MatrixXex &vecIn)
 
   for (int i=0; i<vecIn.rows(); i++)
     for (int j=0; j<vecIn.cols(); j++)
-      vecOut(i,j)=vecIn(i,j).subs(this->getTable());
+      vecOut(i,j)=_substitute(vecIn(i,j));
 
   return vecOut;
 }
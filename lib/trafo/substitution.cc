@@ -7,14 +7,14 @@ using namespace iNA::Trafo;
 
 
 Substitution::Substitution()
-  : _substitution_table()
+  : _substitution_table(), _cache(), _cache_valid(false)
 {
   // pass...
 }
 
 
 Substitution::Substitution(const GiNaC::exmap &table)
-  : _substitution_table(table)
+  : _substitution_table(table), _cache(), _cache_valid(false)
 {
   // pass...
 }
@@ -38,6 +38,7 @@ void
 Substitution::_normalize_substitution_table()
 {
   if (0 == _substitution_table.size()) return;
+  _cache_valid = false;
 
   bool can_substitute = true;
   while (can_substitute) {
@@ -71,6 +72,7 @@ Substitution::add(GiNaC::ex lhs, GiNaC::ex rhs, bool normalize)
 {
   // Add substitution
   _substitution_table[lhs] = rhs;
+  _cache_valid = false;
 
   // If normalization is requested:
   if (normalize) {
@@ -85,6 +87,17 @@ Substitution::normalize() {
 }
 
 
+GiNaC::ex
+Substitution::_substitute(const GiNaC::ex &expr)
+{
+  if (! _cache_valid) {
+    _cache.setTable(_substitution_table);
+    _cache_valid = true;
+  }
+  return _cache.apply(expr);
+}
+
+
 const GiNaC::exmap &
 Substitution::getTable() const
 {
@@ -100,7 +113,7 @@ Substitution::act(Ast::VariableDefinition *var)
 
   // then, if there is an inital value defined for the variable.
   if (var->hasValue()) {
-    var->setValue(var->getValue().subs(_substitution_table));
+    var->setValue(_substitute(var->getValue()));
   }
 }
 
@@ -109,7 +122,7 @@ void
 Substitution::act(Ast::Rule *rule)
 {
   // Perform substitutions:
-  rule->setRule(rule->getRule().subs(_substitution_table));
+  rule->setRule(_substitute(rule->getRule()));
 }
 
 
@@ -121,12 +134,12 @@ Substitution::act(Ast::Reaction *reac)
 
   // handle reactants:
   for (Ast::Reaction::iterator item=reac->reactantsBegin(); item!=reac->reactantsEnd(); item++) {
-    item->second = item->second.subs(_substitution_table);
+    item->second = _substitute(item->second);
   }
 
   // handle products:
   for (Ast::Reaction::iterator item=reac->productsBegin(); item!=reac->productsEnd(); item++) {
-    item->second = item->second.subs(_substitution_table);
+    item->second = _substitute(item->second);
   }
 }
 
@@ -138,5 +151,5 @@ Substitution::act(Ast::KineticLaw *law)
   law->traverse(*this);
 
   // perform substitution on the rate law:
-  law->setRateLaw(law->getRateLaw().subs(_substitution_table));
+  law->setRateLaw(_substitute(law->getRateLaw()));
 }
@@ -2,6 +2,7 @@
 #define __INA_TRAFO_SUBSTITUTION_HH__
 
 #include "../ast/ast.hh"
+#include "substitutioncache.hh"
 
 
 namespace iNA {
@@ -12,6 +13,9 @@ namespace Trafo {
  * This operator also allows to normalize the set of substitutions and detects circular
  * substitution rules. For example the substitutions \f$a\rightarrow b\f$ and \f$b\rightarrow c\f$
  * can be normalized to the substitutions \f$a\rightarrow c\f$ and \f$b\rightarrow c\f$.
+ *
+ * The substitutions are memoized by a @c SubstitutionCache, hence sub-expressions shared by
+ * several expressions of the model are processed only once.
  * @ingroup trafo */
 class Substitution:
     public Ast::Operator, public Ast::VariableDefinition::Operator, public Ast::Rule::Operator,
@@ -59,9 +63,18 @@ protected:
   /** Returns true, if the given expression contains any part that can be substituted. */
   bool _has_substitue(GiNaC::ex expr);
 
+  /** Performs the substitutions on the given expression using the cache. */
+  GiNaC::ex _substitute(const GiNaC::ex &expr);
+
 protected:
   /** Holds the normalized substitution table. */
   GiNaC::exmap _substitution_table;
+
+  /** Memoizes the substitutions. */
+  SubstitutionCache _cache;
+
+  /** If false, the cache needs to be updated with the modified substitution table. */
+  bool _cache_valid;
 };
 
 
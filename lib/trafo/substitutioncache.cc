@@ -0,0 +1,156 @@
+#include "substitutioncache.hh"
+
+using namespace iNA;
+using namespace iNA::Trafo;
+
+
+SubstitutionCache::SubstitutionCache()
+  : _tables(), _recursive(true), _cache(), _interned()
+{
+  // Pass...
+}
+
+
+SubstitutionCache::SubstitutionCache(const GiNaC::exmap &table)
+  : _tables(1, table), _recursive(_is_symbolic(table)), _cache(), _interned()
+{
+  // Pass...
+}
+
+
+void
+SubstitutionCache::setTable(const GiNaC::exmap &table)
+{
+  _tables.clear(); _tables.push_back(table);
+  _recursive = _is_symbolic(table);
+  clear();
+}
+
+
+void
+SubstitutionCache::compose(const GiNaC::exmap &table)
+{
+  clear();
+
+  // Nothing to compose with:
+  if (0 == _tables.size()) {
+    _tables.push_back(table); _recursive = _is_symbolic(table);
+    return;
+  }
+
+  // If any substitution replaces a non-symbol, the tables are applied in order:
+  if ((! _recursive) || (! _is_symbolic(table))) {
+    _tables.push_back(table); _recursive = false;
+    return;
+  }
+
+  // Otherwise, compose the tables: first apply the new substitutions on the present ones,
+  GiNaC::exmap &composed = _tables.front();
+  for (GiNaC::exmap::iterator item=composed.begin(); item!=composed.end(); item++) {
+    item->second = item->second.subs(table);
+  }
+  // then add all new substitutions of symbols not substituted yet:
+  for (GiNaC::exmap::const_iterator item=table.begin(); item!=table.end(); item++) {
+    composed.insert(*item);
+  }
+}
+
+
+const GiNaC::exmap &
+SubstitutionCache::getTable() const
+{
+  static GiNaC::exmap empty;
+  if (0 == _tables.size()) { return empty; }
+  return _tables.front();
+}
+
+
+GiNaC::ex
+SubstitutionCache::apply(const GiNaC::ex &expr)
+{
+  if (0 == _tables.size()) { return expr; }
+  if (_recursive) { return _apply_recursive(expr); }
+
+  // Lookup cache:
+  std::map<GiNaC::ex, GiNaC::ex, GiNaC::ex_is_less>::iterator item = _cache.find(expr);
+  if (_cache.end() != item) { return item->second; }
+
+  // Apply substitutions in order:
+  GiNaC::ex result = expr;
+  for (std::vector<GiNaC::exmap>::iterator table=_tables.begin(); table!=_tables.end(); table++) {
+    result = result.subs(*table);
+  }
+  result = intern(result);
+  _cache.insert(std::make_pair(expr, result));
+  return result;
+}
+
+
+GiNaC::ex
+SubstitutionCache::intern(const GiNaC::ex &expr)
+{
+  return *(_interned.insert(expr).first);
+}
+
+
+size_t
+SubstitutionCache::size() const {
+  return _cache.size();
+}
+
+
+void
+SubstitutionCache::clear()
+{
+  _cache.clear();
+  _interned.clear();
+}
+
+
+bool
+SubstitutionCache::_is_symbolic(const GiNaC::exmap &table)
+{
+  for (GiNaC::exmap::const_iterator item=table.begin(); item!=table.end(); item++) {
+    if (! GiNaC::is_a<GiNaC::symbol>(item->first)) { return false; }
+  }
+  return true;
+}
+
+
+GiNaC::ex
+SubstitutionCache::_apply_recursive(const GiNaC::ex &expr)
+{
+  // Leafs: substitute symbols, keep numbers & constants:
+  if (0 == expr.nops()) {
+    if (! GiNaC::is_a<GiNaC::symbol>(expr)) { return expr; }
+    GiNaC::exmap::const_iterator item = _tables.front().find(expr);
+    if (_tables.front().end() == item) { return expr; }
+    return item->second;
+  }
+
+  // Lookup cache:
+  std::map<GiNaC::ex, GiNaC::ex, GiNaC::ex_is_less>::iterator item = _cache.find(expr);
+  if (_cache.end() != item) { return item->second; }
+
+  // Substitute sub-expressions, this re-evaluates the expression if any of them changed:
+  Mapper mapper(*this);
+  GiNaC::ex result = intern(expr.map(mapper));
+  _cache.insert(std::make_pair(expr, result));
+  return result;
+}
+
+
+
+/* ********************************************************************************************* *
+ * Implementation of SubstitutionCache::Mapper
+ * ********************************************************************************************* */
+SubstitutionCache::Mapper::Mapper(SubstitutionCache &cache)
+  : _cache(cache)
+{
+  // Pass...
+}
+
+GiNaC::ex
+SubstitutionCache::Mapper::operator()(const GiNaC::ex &expr) {
+  return _cache._apply_recursive(expr);
+}
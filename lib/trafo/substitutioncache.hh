@@ -0,0 +1,110 @@
+#ifndef __INA_TRAFO_SUBSTITUTIONCACHE_HH__
+#define __INA_TRAFO_SUBSTITUTIONCACHE_HH__
+
+#include <ginac/ginac.h>
+#include <vector>
+#include <map>
+#include <set>
+
+
+namespace iNA {
+namespace Trafo {
+
+
+/**
+ * Memoizes the substitutions of a (chain of) substitution table(s) in expressions.
+ *
+ * The results of the substitutions are cached per (sub-)expression, keyed by the hash-based
+ * ordering @c GiNaC::ex_is_less. If all substitutions replace symbols, the substitution is
+ * performed recursively on the sub-expressions, hence sub-expressions shared between several
+ * expressions (i.e. the rate laws of several reactions) are substituted only once. Moreover, all
+ * results are interned, equal results share a single instance.
+ *
+ * Chained substitutions like @c expr.subs(A).subs(B) are combined into a single composed table
+ * by @c compose, hence only a single pass over the expression is needed.
+ *
+ * @code {.cpp}
+ * Trafo::SubstitutionCache cache(conservation_constants);
+ * cache.compose(folder.getTable());
+ * // equivalent to expr.subs(conservation_constants).subs(folder.getTable()):
+ * GiNaC::ex value = cache.apply(expr);
+ * @endcode
+ *
+ * @note The cache keeps references to all expressions it processed, call @c clear to free them.
+ * @ingroup trafo
+ */
+class SubstitutionCache
+{
+public:
+  /** Constructs an empty cache, that performs no substitutions. */
+  SubstitutionCache();
+
+  /** Constructs a cache performing the given substitutions. */
+  explicit SubstitutionCache(const GiNaC::exmap &table);
+
+  /** Resets the substitutions and clears the cache. */
+  void setTable(const GiNaC::exmap &table);
+
+  /** Appends the given substitutions, these are applied on the results of the present ones.
+   * If all substitutions replace symbols, the tables are composed into a single one. */
+  void compose(const GiNaC::exmap &table);
+
+  /** Returns the (first) substitution table. */
+  const GiNaC::exmap &getTable() const;
+
+  /** Performs all substitutions on the given expression. */
+  GiNaC::ex apply(const GiNaC::ex &expr);
+
+  /** Returns the shared instance of the given expression. */
+  GiNaC::ex intern(const GiNaC::ex &expr);
+
+  /** Returns the number of cached substitutions. */
+  size_t size() const;
+
+  /** Clears the cache but keeps the substitutions. */
+  void clear();
+
+protected:
+  /** Returns true if all substitutions of the table replace symbols. */
+  static bool _is_symbolic(const GiNaC::exmap &table);
+
+  /** Recursively substitutes symbols in the expression using the first table. */
+  GiNaC::ex _apply_recursive(const GiNaC::ex &expr);
+
+protected:
+  /** Map function used to apply the substitution on the sub-expressions. */
+  class Mapper;
+  friend class Mapper;
+
+  /** Map function used to apply the substitution on the sub-expressions. */
+  class Mapper : public GiNaC::map_function {
+  public:
+    /** Constructor. */
+    Mapper(SubstitutionCache &cache);
+    /** Substitutes the given sub-expression. */
+    GiNaC::ex operator()(const GiNaC::ex &expr);
+
+  protected:
+    /** A weak reference to the cache. */
+    SubstitutionCache &_cache;
+  };
+
+protected:
+  /** The chain of substitution tables, applied in order. */
+  std::vector<GiNaC::exmap> _tables;
+
+  /** If true, all substitutions replace symbols and only a single table is present. */
+  bool _recursive;
+
+  /** The cached results of the substitutions. */
+  std::map<GiNaC::ex, GiNaC::ex, GiNaC::ex_is_less> _cache;
+
+  /** The set of interned expressions. */
+  std::set<GiNaC::ex, GiNaC::ex_is_less> _interned;
+};
+
+
+}
+}
+
+#endif // __INA_TRAFO_SUBSTITUTIONCACHE_HH__
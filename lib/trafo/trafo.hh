@@ -68,6 +68,7 @@
 
 #include "assertions.hh"
 #include "substitution.hh"
+#include "substitutioncache.hh"
 #include "constantfolder.hh"
 #include "assignmentruleinliner.hh"
 #include "reversiblereactionconverter.hh"
@@ -113,9 +113,13 @@ Logger::shutdown()
 void
 Logger::log(const Message &message)
 {
-  std::list<MessageHandler *>::iterator it = this->_handlers.begin();
-  for (;it != this->_handlers.end(); it++) {
-    (*it)->handleMessage(message);
+  // Messages may be logged from several OpenMP threads:
+#pragma omp critical(logger)
+  {
+    std::list<MessageHandler *>::iterator it = this->_handlers.begin();
+    for (;it != this->_handlers.end(); it++) {
+      (*it)->handleMessage(message);
+    }
   }
 }
 
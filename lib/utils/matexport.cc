@@ -2,6 +2,7 @@
 #include <config.hh>
 #include <ostream>
 #include <iostream>
+#include <algorithm>
 
 
 using namespace iNA;
@@ -45,6 +46,10 @@ void MatFile::add(const std::string &name, const Eigen::MatrixXd &value) {
   _elements.push_back(new MatFileMatrixElement(name, value));
 }
 
+void MatFile::add(const std::string &name, const MatFileMatrixSource &source) {
+  _elements.push_back(new MatFileMatrixElement(name, source));
+}
+
 void
 MatFile::serialize(std::ostream &stream)
 {
@@ -293,6 +298,51 @@ MatFileValue::allocUTF8(size_t num)
 
 
 
+/* ******************************************************************************************** *
+ * Implementation of the MAT file element for values of a matrix source
+ * ******************************************************************************************** */
+MatFileMatrixSource::~MatFileMatrixSource()
+{
+  // Pass...
+}
+
+
+/* 4MB, like the chunks of the tables of the application. */
+const size_t MatFileSourceValue::blockSize = 4*1024*1024;
+
+MatFileSourceValue::MatFileSourceValue(const MatFileMatrixSource &source)
+  : MatFileElement(miDouble), _source(source)
+{
+  // pass...
+}
+
+size_t
+MatFileSourceValue::dataSize() const {
+  return _source.rows()*_source.cols()*sizeof(double);
+}
+
+void
+MatFileSourceValue::serialize(std::ostream &stream) const
+{
+  // Serialize header!
+  MatFileElement::serialize(stream);
+
+  // Serialize data block-wise, the blocks are column major (Fortran order) like the MAT file:
+  size_t rows = _source.rows(), cols = _source.cols();
+  if ((0 == rows) || (0 == cols)) { return; }
+  size_t block_cols = std::max(size_t(1), blockSize/(rows*sizeof(double)));
+  Eigen::MatrixXd block;
+  for (size_t first=0; first<cols; first+=block_cols) {
+    size_t num = std::min(block_cols, cols-first);
+    _source.getColumns(first, num, block);
+    stream.write((char *)(block.data()), rows*num*sizeof(double));
+  }
+
+  // No padding needed, doubles are 64bit
+}
+
+
+
 /* ******************************************************************************************** *
  * Implementation of generic MAT file matrix element
  * ******************************************************************************************** */
@@ -338,32 +388,46 @@ MatFileComplexElement::serialize(std::ostream &stream) const
  * ******************************************************************************************** */
 MatFileMatrixElement::MatFileMatrixElement(const std::string &name, const Eigen::MatrixXd &values)
   : MatFileComplexElement(mxDoubleClass)
+{
+  addHeader(name, values.rows(), values.cols());
+  MatFileValue *array_data = MatFileValue::allocDouble(values.rows()*values.cols());
+  this->add(array_data);
+
+  // Copy data (column major / Fortran order):
+  size_t idx=0;
+  for (int j=0; j<values.cols(); j++) {
+    for (int i=0; i<values.rows(); i++, idx++) {
+      array_data->dataDouble()[idx] = values(i,j);
+    }
+  }
+}
+
+MatFileMatrixElement::MatFileMatrixElement(const std::string &name, const MatFileMatrixSource &source)
+  : MatFileComplexElement(mxDoubleClass)
+{
+  addHeader(name, source.rows(), source.cols());
+  this->add(new MatFileSourceValue(source));
+}
+
+void
+MatFileMatrixElement::addHeader(const std::string &name, size_t rows, size_t cols)
 {
   // Allocate sub elements:
   MatFileValue *array_flags = MatFileValue::allocUInt32(2);
   MatFileValue *array_dimensions = MatFileValue::allocInt32(2);
   MatFileValue *array_name = MatFileValue::allocInt8(name.size());
-  MatFileValue *array_data = MatFileValue::allocDouble(values.rows()*values.cols());
 
   // Add sub elements:
-  this->add(array_flags); this->add(array_dimensions); this->add(array_name); this->add(array_data);
+  this->add(array_flags); this->add(array_dimensions); this->add(array_name);
 
   // Assemble array flags:
   array_flags->dataUInt32()[0] = uint8_t(_arrayType);
   array_flags->dataUInt32()[1] = 0;
 
   // Assemble dimensions array:
-  array_dimensions->dataInt32()[0] = values.rows();
-  array_dimensions->dataInt32()[1] = values.cols();
+  array_dimensions->dataInt32()[0] = rows;
+  array_dimensions->dataInt32()[1] = cols;
 
   // Copy name:
   memcpy(array_name->dataUTF8(), name.c_str(), name.size());
-
-  // Copy data (column major / Fortran order):
-  size_t idx=0;
-  for (int j=0; j<values.cols(); j++) {
-    for (int i=0; i<values.rows(); i++, idx++) {
-      array_data->dataDouble()[idx] = values(i,j);
-    }
-  }
 }
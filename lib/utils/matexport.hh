@@ -127,6 +127,52 @@ private:
 };
 
 
+/**
+ * Interface of a matrix, that is exported into a MAT file without being copied as a whole (see
+ * @c MatFile::add). The values are requested block of columns by block of columns, while the
+ * file gets serialized.
+ */
+class MatFileMatrixSource
+{
+public:
+  /** Destructor. */
+  virtual ~MatFileMatrixSource();
+
+  /** Returns the number of rows. */
+  virtual size_t rows() const = 0;
+  /** Returns the number of columns. */
+  virtual size_t cols() const = 0;
+  /** Stores the @c num columns starting with column @c first into @c values. */
+  virtual void getColumns(size_t first, size_t num, Eigen::MatrixXd &values) const = 0;
+};
+
+
+/**
+ * A MAT file element holding the double values of a @c MatFileMatrixSource. The values are read
+ * from the source in blocks of about @c blockSize bytes during serialization.
+ * This class is used internal and may not be used directly by the application.
+ */
+class MatFileSourceValue : public MatFileElement
+{
+public:
+  /** Constructor, holds a weak reference to the source. */
+  MatFileSourceValue(const MatFileMatrixSource &source);
+
+  /** Returns the data size of the element. */
+  virtual size_t dataSize() const;
+  /** Serializes the values block-wise into the given stream. */
+  virtual void serialize(std::ostream &stream) const;
+
+public:
+  /** The approximate size of a block of columns in bytes. */
+  static const size_t blockSize;
+
+private:
+  /** Holds a weak reference to the source. */
+  const MatFileMatrixSource &_source;
+};
+
+
 /**
  * Generic MAT file matrix element. Note that Matlab calls everything a "matrix" that
  * is not just a series of numbers or chars.
@@ -174,6 +220,12 @@ class MatFileMatrixElement : public MatFileComplexElement
 public:
   /** Constructor. */
   MatFileMatrixElement(const std::string &name, const Eigen::MatrixXd &values);
+  /** Constructor, the values are read from the given source during serialization. */
+  MatFileMatrixElement(const std::string &name, const MatFileMatrixSource &source);
+
+protected:
+  /** Adds the flags, dimensions and name of the matrix. */
+  void addHeader(const std::string &name, size_t rows, size_t cols);
 };
 
 
@@ -224,6 +276,9 @@ public:
   void add(const std::string &value);
   /** Adds a matrix of double values to the file. */
   void add(const std::string &name, const Eigen::MatrixXd &value);
+  /** Adds a matrix of double values to the file, that is read block-wise from the given source
+   * by @c serialize. Hence the source must exist until the file got serialized. */
+  void add(const std::string &name, const MatFileMatrixSource &source);
 
 private:
   /** Holds the elements of the MAT file. */
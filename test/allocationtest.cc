@@ -0,0 +1,312 @@
+#include "allocationtest.hh"
+#include "ode/dopri5.hh"
+#include "ode/dopri853.hh"
+#include "ode/rkf45.hh"
+#include "ode/rosenbrock4.hh"
+#include "nlesolve/precisionsolve.hh"
+#include "nlesolve/hybridsolver.hh"
+#include "models/REmodel.hh"
+#include "parser/sbml/sbml.hh"
+#include <cstdlib>
+
+using namespace iNA;
+
+
+/*
+ * Counts the heap allocations of the whole test program while enabled. Eigen allocates the
+ * storage of dynamic matrices by malloc, and so does the default operator new of the standard
+ * library. Hence replacing malloc (and its relatives) catches all allocations. With the GNU C
+ * library, the replacement forwards to its internal implementation. Elsewhere, the allocations
+ * are not counted and the tests only check that the code runs.
+ */
+static bool   count_allocations = false;
+static size_t num_allocations   = 0;
+
+#ifdef __GLIBC__
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t n, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+
+void *malloc(size_t size) {
+  if (count_allocations) { num_allocations++; }
+  return __libc_malloc(size);
+}
+
+void *calloc(size_t n, size_t size) {
+  if (count_allocations) { num_allocations++; }
+  return __libc_calloc(n, size);
+}
+
+void *realloc(void *ptr, size_t size) {
+  if (count_allocations) { num_allocations++; }
+  return __libc_realloc(ptr, size);
+}
+}
+static const bool can_count_allocations = true;
+#else
+static const bool can_count_allocations = false;
+#endif
+
+
+/** Starts counting the heap allocations. */
+static void
+startCounting()
+{
+  num_allocations = 0; count_allocations = true;
+}
+
+/** Stops counting the heap allocations and returns their number. */
+static size_t
+stopCounting()
+{
+  count_allocations = false;
+  return num_allocations;
+}
+
+
+/**
+ * A simple damped oscillator with explicit rates and Jacobian, the evaluation itself does not
+ * allocate. Like the interpreters of the models, the system takes the state as a vector, hence
+ * any expression passed as the state would be evaluated into a temporary.
+ */
+class DampedOscillator
+{
+public:
+  inline size_t getDimension() const { return 2; }
+
+  inline void evaluate(const Eigen::VectorXd &state, double t, Eigen::VectorXd &rates) {
+    rates(0) = state(1);
+    rates(1) = -state(0) - 0.1*state(1);
+  }
+
+  inline void evaluateJacobian(const Eigen::VectorXd &state, double t, Eigen::MatrixXd &jacobian) {
+    jacobian(0,0) = 0;  jacobian(0,1) = 1;
+    jacobian(1,0) = -1; jacobian(1,1) = -0.1;
+  }
+};
+
+
+/**
+ * A stiff linear system, the fast component decays at a rate of 1000. The explicit steppers
+ * reject each step of the output interval until the step-size is within their region of
+ * stability.
+ */
+class StiffDecay
+{
+public:
+  inline size_t getDimension() const { return 2; }
+
+  inline void evaluate(const Eigen::VectorXd &state, double t, Eigen::VectorXd &rates) {
+    rates(0) = -1000*state(0) + state(1);
+    rates(1) = -state(1);
+  }
+};
+
+
+/** Performs some steps and returns the number of heap allocations. The first step is not
+ * counted as it initializes the workspaces. */
+static size_t
+countStepAllocations(ODE::Stepper &stepper, Eigen::VectorXd &state, double dt, size_t steps)
+{
+  stepper.step(state, 0);
+
+  startCounting();
+  for (size_t i=1; i<=steps; i++) { stepper.step(state, i*dt); }
+  return stopCounting();
+}
+
+
+/** Compiles the rate equations and their Jacobian of the model for the nonlinear solvers, like
+ * the @c Models::SteadyStateAnalysis. */
+static void
+compileSteadyState(Models::REmodel &model, Eval::bci::Code &codeODE, Eval::bci::Code &codeJac)
+{
+  Trafo::ConstantFolder constants(model);
+  Models::InitialConditions ICs(model);
+
+  Eigen::VectorXex REs = ICs.apply(constants.apply(model.getUpdateVector().head(model.numIndSpecies())));
+  Eigen::MatrixXex Jac = ICs.apply(constants.apply(model.getJacobian()));
+
+  Eval::bci::Engine<Eigen::VectorXd, Eigen::VectorXd>::Compiler compilerA(model.stateIndex);
+  compilerA.setCode(&codeODE);
+  compilerA.compileVector(REs);
+  compilerA.finalize(0);
+
+  Eval::bci::Engine<Eigen::VectorXd, Eigen::MatrixXd>::Compiler compilerB(model.stateIndex);
+  compilerB.setCode(&codeJac);
+  compilerB.compileMatrix(Jac);
+  compilerB.finalize(0);
+}
+
+
+AllocationTest::~AllocationTest()
+{
+  // Pass...
+}
+
+
+void
+AllocationTest::testDopri5()
+{
+  DampedOscillator system; Eigen::VectorXd state(2); state << 1, 0;
+  ODE::Dopri5Stepper<DampedOscillator> stepper(system, 0.1, 1e-6, 1e-6);
+  size_t allocations = countStepAllocations(stepper, state, 0.1, 100);
+  if (can_count_allocations) { UT_ASSERT_EQUAL(allocations, size_t(0)); }
+}
+
+
+void
+AllocationTest::testDopri853()
+{
+  DampedOscillator system; Eigen::VectorXd state(2); state << 1, 0;
+  ODE::Dopri853Stepper<DampedOscillator> stepper(system, 0.1, 1e-6, 1e-6);
+  size_t allocations = countStepAllocations(stepper, state, 0.1, 100);
+  if (can_count_allocations) { UT_ASSERT_EQUAL(allocations, size_t(0)); }
+}
+
+
+void
+AllocationTest::testRKF45()
+{
+  DampedOscillator system; Eigen::VectorXd state(2); state << 1, 0;
+  ODE::RKF45<DampedOscillator> stepper(system, 0.1, 1e-6, 1e-6);
+  size_t allocations = countStepAllocations(stepper, state, 0.1, 100);
+  if (can_count_allocations) { UT_ASSERT_EQUAL(allocations, size_t(0)); }
+}
+
+
+void
+AllocationTest::testRejectedSteps()
+{
+  StiffDecay system;
+  ODE::Dopri5Stepper<StiffDecay> dopri5(system, 0.1, 1e-6, 1e-6);
+  ODE::Dopri853Stepper<StiffDecay> dopri853(system, 0.1, 1e-6, 1e-6);
+  ODE::RKF45<StiffDecay> rkf45(system, 0.1, 1e-6, 1e-6);
+
+  std::vector<ODE::Stepper *> steppers;
+  steppers.push_back(&dopri5); steppers.push_back(&dopri853); steppers.push_back(&rkf45);
+
+  for (size_t k=0; k<steppers.size(); k++) {
+    Eigen::VectorXd state(2); state << 1, 1;
+    size_t allocations = countStepAllocations(*steppers[k], state, 0.1, 100);
+    UT_ASSERT(0 < steppers[k]->statistics().numRejectedSteps());
+    UT_ASSERT(std::abs(state(1) - std::exp(-10.1)) < 1e-5);
+    if (can_count_allocations) { UT_ASSERT_EQUAL(allocations, size_t(0)); }
+  }
+}
+
+
+void
+AllocationTest::testRosenbrock4()
+{
+  DampedOscillator system; Eigen::VectorXd state(2); state << 1, 0;
+  ODE::Rosenbrock4TimeInd<DampedOscillator> stepper(system, 0.1, 1e-6, 1e-6);
+  size_t allocations = countStepAllocations(stepper, state, 0.1, 100);
+  if (can_count_allocations) { UT_ASSERT_EQUAL(allocations, size_t(0)); }
+}
+
+
+void
+AllocationTest::testPrecisionSolve()
+{
+  Eigen::MatrixXd B(3,3); B << 4, 1, 0, 1, 4, 1, 0, 1, 4;
+  Eigen::VectorXd A(3); A << 1, 2, 3;
+  Eigen::VectorXd x(3);
+  NLEsolve::PrecisionSolve solver(3);
+
+  startCounting();
+  for (size_t i=0; i<10; i++) { x = solver.solve(B, A); }
+  size_t allocations = stopCounting();
+
+  if (can_count_allocations) { UT_ASSERT_EQUAL(allocations, size_t(0)); }
+  UT_ASSERT((B*x).isApprox(A, 1e-9));
+}
+
+
+void
+AllocationTest::testNewtonRaphson()
+{
+  Ast::Model sbml_model;
+  Parser::Sbml::importModel(sbml_model, "test/regression-tests/extended_goodwin.xml");
+  Models::REmodel model(sbml_model);
+  Eval::bci::Code codeODE, codeJac;
+  compileSteadyState(model, codeODE, codeJac);
+
+  NLEsolve::NewtonRaphson<Models::REmodel> solver(model);
+  solver.set(codeODE, codeJac);
+
+  Eigen::VectorXd x(model.getDimension()), y(model.getDimension());
+  model.getInitialState(x);
+  double stpmax = solver.parameters.STPMX*std::max(x.norm(), double(x.size()));
+
+  // The first iteration initializes the workspaces:
+  solver.newtonStep(x, y, stpmax);
+
+  startCounting();
+  for (size_t i=0; i<10; i++) {
+    x = y; solver.newtonStep(x, y, stpmax);
+  }
+  size_t allocations = stopCounting();
+
+  if (can_count_allocations) { UT_ASSERT_EQUAL(allocations, size_t(0)); }
+}
+
+
+void
+AllocationTest::testHybridSolver()
+{
+  Ast::Model sbml_model;
+  Parser::Sbml::importModel(sbml_model, "test/regression-tests/extended_goodwin.xml");
+  Models::REmodel model(sbml_model);
+  Eval::bci::Code codeODE, codeJac;
+  compileSteadyState(model, codeODE, codeJac);
+
+  NLEsolve::HybridSolver<Models::REmodel> solver(model);
+  solver.set(codeODE, codeJac);
+  solver.setupLSODA(Models::ParameterSet());
+
+  Eigen::VectorXd x0(model.getDimension()), x(model.getDimension());
+  model.getInitialState(x0);
+
+  // The first integration initializes the workspaces:
+  x = x0; solver.ODEStep(x, 0, 1e-1);
+
+  // LSODA allocates its workspace once per integration, hence a long integration must not
+  // allocate more than a short one:
+  x = x0; startCounting();
+  solver.ODEStep(x, 0, 1e-1);
+  size_t short_run = stopCounting();
+
+  x = x0; startCounting();
+  solver.ODEStep(x, 0, 1e2);
+  size_t long_run = stopCounting();
+
+  if (can_count_allocations) { UT_ASSERT_EQUAL(long_run, short_run); }
+}
+
+
+UnitTest::TestSuite *
+AllocationTest::suite()
+{
+  UnitTest::TestSuite *s = new UnitTest::TestSuite("Tests for allocation-free hot paths.");
+
+  s->addTest(new UnitTest::TestCaller<AllocationTest>(
+               "Dopri5 steps without allocation", &AllocationTest::testDopri5));
+  s->addTest(new UnitTest::TestCaller<AllocationTest>(
+               "Dopri853 steps without allocation", &AllocationTest::testDopri853));
+  s->addTest(new UnitTest::TestCaller<AllocationTest>(
+               "RKF45 steps without allocation", &AllocationTest::testRKF45));
+  s->addTest(new UnitTest::TestCaller<AllocationTest>(
+               "Rejected steps without allocation", &AllocationTest::testRejectedSteps));
+  s->addTest(new UnitTest::TestCaller<AllocationTest>(
+               "Rosenbrock4 steps without allocation", &AllocationTest::testRosenbrock4));
+  s->addTest(new UnitTest::TestCaller<AllocationTest>(
+               "PrecisionSolve without allocation", &AllocationTest::testPrecisionSolve));
+  s->addTest(new UnitTest::TestCaller<AllocationTest>(
+               "Newton-Raphson iteration without allocation", &AllocationTest::testNewtonRaphson));
+  s->addTest(new UnitTest::TestCaller<AllocationTest>(
+               "Hybrid solver steps without allocation", &AllocationTest::testHybridSolver));
+
+  return s;
+}
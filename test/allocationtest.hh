@@ -0,0 +1,32 @@
+#ifndef __INA_TEST_ALLOCATIONTEST_HH__
+#define __INA_TEST_ALLOCATIONTEST_HH__
+
+#include "unittest.hh"
+
+namespace iNA {
+
+/**
+ * Checks that the hot paths of the ODE steppers and the nonlinear solvers do not allocate memory
+ * on the heap once their workspaces are initialized.
+ */
+class AllocationTest : public UnitTest::TestCase
+{
+public:
+  virtual ~AllocationTest();
+
+  void testDopri5();
+  void testDopri853();
+  void testRKF45();
+  void testRejectedSteps();
+  void testRosenbrock4();
+  void testPrecisionSolve();
+  void testNewtonRaphson();
+  void testHybridSolver();
+
+public:
+  static UnitTest::TestSuite *suite();
+};
+
+}
+
+#endif // __INA_TEST_ALLOCATIONTEST_HH__
@@ -0,0 +1,224 @@
+#include "conservationtest.hh"
+#include "models/conservationanalysismixin.hh"
+#include "parser/sbml/sbml.hh"
+#include "parser/sbmlsh/sbmlsh.hh"
+#include <sstream>
+
+using namespace iNA;
+
+
+/** The result of a conservation analysis, the link matrix is given in the original order of the
+ * species. */
+struct ConservationResult
+{
+  size_t rank;
+  Eigen::VectorXi permutation;
+  Eigen::MatrixXd link;
+};
+
+
+/** Exposes both conservation analyses of the mixin. */
+class ConservationTestModel :
+    public Models::BaseModel, public Models::ConservationAnalysisMixin
+{
+public:
+  ConservationTestModel(const Ast::Model &model)
+    : BaseModel(model), ConservationAnalysisMixin((BaseModel &)(*this))
+  {
+    // Pass...
+  }
+
+  /** Returns the full stoichiometric matrix. */
+  const Eigen::MatrixXd &fullStoichiometry() const {
+    return this->stoichiometry;
+  }
+
+  /** Returns the result of the analysis performed by the constructor. */
+  void get(ConservationResult &result)
+  {
+    size_t nspec = this->stoichiometry.rows();
+    result.rank = this->numIndSpecies();
+    result.permutation = this->PermutationVec;
+    result.link = Eigen::MatrixXd::Zero(nspec, result.rank);
+    for (size_t i=0; i<result.rank; i++) {
+      result.link(this->PermutationVec(i), i) = 1;
+    }
+    for (size_t i=0; i<this->numDepSpecies(); i++) {
+      result.link.row(this->PermutationVec(result.rank+i)) = this->link_zero_matrix.row(i);
+    }
+  }
+
+  /** Performs the exact elimination. */
+  bool exact(ConservationResult &result)
+  {
+    if (! this->exactConservationAnalysis()) { return false; }
+    get(result); return true;
+  }
+
+  /** Performs the LU decomposition. */
+  void numeric(ConservationResult &result)
+  {
+    this->numericConservationAnalysis();
+    get(result);
+  }
+};
+
+
+/** Checks that the stoichiometry is reconstructed from the rows of the independent species by
+ * the link matrix. */
+static bool
+isLinkMatrix(const Eigen::MatrixXd &N, const ConservationResult &result)
+{
+  Eigen::MatrixXd reduced(result.rank, N.cols());
+  for (size_t i=0; i<result.rank; i++) {
+    reduced.row(i) = N.row(result.permutation(i));
+  }
+  return (result.link*reduced - N).norm() <= 1e-8*(1+N.norm());
+}
+
+
+
+ConservationTest::~ConservationTest()
+{
+  // Pass...
+}
+
+
+void
+ConservationTest::compareAnalyses(const Ast::Model &model)
+{
+  ConservationTestModel analysis(model);
+  ConservationResult exact, numeric;
+  UT_ASSERT(analysis.exact(exact));
+  analysis.numeric(numeric);
+
+  UT_ASSERT_EQUAL(exact.rank, numeric.rank);
+  UT_ASSERT(isLinkMatrix(analysis.fullStoichiometry(), exact));
+  UT_ASSERT(isLinkMatrix(analysis.fullStoichiometry(), numeric));
+
+  // Both link matrices span the same space, they differ by the choice of the independent species
+  // only. Expressing the numeric one in terms of the independent species of the exact one must
+  // yield the same matrix. If both choose the same species, B is a permutation matrix.
+  if (0 == exact.rank) { return; }
+  Eigen::MatrixXd B(exact.rank, exact.rank);
+  for (size_t i=0; i<exact.rank; i++) {
+    B.row(i) = numeric.link.row(exact.permutation(i));
+  }
+  Eigen::FullPivLU<Eigen::MatrixXd> LU(B);
+  UT_ASSERT(LU.isInvertible());
+  UT_ASSERT(exact.link.isApprox(numeric.link*LU.inverse(), 1e-8));
+}
+
+
+void
+ConservationTest::checkFallback(const Ast::Model &model)
+{
+  ConservationTestModel analysis(model);
+  ConservationResult result, exact, numeric;
+  analysis.get(result);
+
+  UT_ASSERT(! analysis.exact(exact));
+  analysis.numeric(numeric);
+
+  UT_ASSERT_EQUAL(result.rank, numeric.rank);
+  UT_ASSERT(result.permutation == numeric.permutation);
+  UT_ASSERT(result.link == numeric.link);
+  UT_ASSERT(isLinkMatrix(analysis.fullStoichiometry(), result));
+}
+
+
+Ast::Model *
+ConservationTest::chainModel()
+{
+  std::stringstream text;
+
+  text << "@model:3.3.1 = chain \"Chain\"" << std::endl
+       << std::endl
+       << "@compartments" << std::endl
+       << "  cell = 1 \"Cell\"" << std::endl
+       << std::endl
+       << "@species" << std::endl
+       << "  cell: [A] = 1 \"A\"" << std::endl
+       << "  cell: [B] = 0 \"B\"" << std::endl
+       << "  cell: [C] = 0 \"C\"" << std::endl
+       << std::endl
+       << "@reactions" << std::endl
+       << "  @r = r1 \"r1\"" << std::endl
+       << "    A -> B" << std::endl
+       << "    cell*k*A: k=1" << std::endl
+       << "  @r = r2 \"r2\"" << std::endl
+       << "    B -> C" << std::endl
+       << "    cell*k*B: k=1" << std::endl;
+
+  return Parser::Sbmlsh::importModel(text);
+}
+
+
+void
+ConservationTest::testExactVsNumeric()
+{
+  const char *models[] = {
+    "test/regression-tests/enzymekinetics1.xml", "test/regression-tests/coopkinetics1.xml",
+    "test/regression-tests/gene1.xml", "test/regression-tests/extended_goodwin.xml",
+    "test/regression-tests/core_osc.xml", "test/regression-tests/core_phos2.xml", 0 };
+
+  for (size_t i=0; 0 != models[i]; i++) {
+    Ast::Model model;
+    Parser::Sbml::importModel(model, models[i]);
+    compareAnalyses(model);
+  }
+
+  Ast::Model *chain = chainModel();
+  compareAnalyses(*chain);
+  delete chain;
+}
+
+
+void
+ConservationTest::testNonIntegralStoichiometry()
+{
+  Ast::Model *model = chainModel();
+  model->getReaction("r1")->setProductStoichiometry(model->getSpecies("B"), GiNaC::numeric(1,2));
+  checkFallback(*model);
+  delete model;
+}
+
+
+void
+ConservationTest::testOverflow()
+{
+  // A coefficient that does not fit:
+  Ast::Model *model = chainModel();
+  model->getReaction("r1")->setProductStoichiometry(model->getSpecies("B"), 2147483648.0);
+  checkFallback(*model);
+  delete model;
+
+  // Coefficients growing too large during the elimination, the products of the coprime
+  // stoichiometries of A exceed the bound: 40000 A -> 40009 B, 40009 A -> 40000 C
+  model = chainModel();
+  Ast::Reaction *r1 = model->getReaction("r1"), *r2 = model->getReaction("r2");
+  r1->setReactantStoichiometry(model->getSpecies("A"), 40000);
+  r1->setProductStoichiometry(model->getSpecies("B"), 40009);
+  r2->clearReactants();
+  r2->setReactantStoichiometry(model->getSpecies("A"), 40009);
+  r2->setProductStoichiometry(model->getSpecies("C"), 40000);
+  checkFallback(*model);
+  delete model;
+}
+
+
+UnitTest::TestSuite *
+ConservationTest::suite()
+{
+  UnitTest::TestSuite *s = new UnitTest::TestSuite("Tests for the conservation analysis.");
+
+  s->addTest(new UnitTest::TestCaller<ConservationTest>(
+               "Exact elimination vs. LU decomposition", &ConservationTest::testExactVsNumeric));
+  s->addTest(new UnitTest::TestCaller<ConservationTest>(
+               "Fall back for non-integral stoichiometry",
+               &ConservationTest::testNonIntegralStoichiometry));
+  s->addTest(new UnitTest::TestCaller<ConservationTest>(
+               "Fall back on overflow", &ConservationTest::testOverflow));
+
+  return s;
+}
@@ -0,0 +1,38 @@
+#ifndef CONSERVATIONTEST_HH
+#define CONSERVATIONTEST_HH
+
+#include "unittest.hh"
+#include <ast/ast.hh>
+
+
+namespace iNA {
+
+/** Compares the exact conservation analysis with the one using the LU decomposition. */
+class ConservationTest : public UnitTest::TestCase
+{
+public:
+  virtual ~ConservationTest();
+
+  /** Compares the exact elimination with the LU decomposition on the regression-test models. */
+  void testExactVsNumeric();
+  /** Checks the fall back to the LU decomposition for non-integral stoichiometry. */
+  void testNonIntegralStoichiometry();
+  /** Checks the fall back to the LU decomposition if the coefficients grow too large. */
+  void testOverflow();
+
+public:
+  /** Constructs the test-suite. */
+  static UnitTest::TestSuite *suite();
+
+private:
+  /** Compares both analyses of the given model. */
+  void compareAnalyses(const Ast::Model &model);
+  /** Checks that the analysis of the given model falls back to the LU decomposition. */
+  void checkFallback(const Ast::Model &model);
+  /** Constructs a chain A -> B -> C. */
+  Ast::Model *chainModel();
+};
+
+}
+
+#endif // CONSERVATIONTEST_HH
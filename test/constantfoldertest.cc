@@ -91,6 +91,44 @@ ConstantFolderTest::testFolderFilter()
 }
 
 
+void
+ConstantFolderTest::testSubstitutionCache()
+{
+  Trafo::ConstantFolder folder(*_model);
+  Trafo::SubstitutionCache cache(folder.getTable());
+
+  GiNaC::ex E  = _model->getSpecies("E")->getSymbol();
+  GiNaC::ex S  = _model->getSpecies("S")->getSymbol();
+  GiNaC::ex ES = _model->getSpecies("ES")->getSymbol();
+
+  // Cached substitutions must match the plain ones:
+  for (size_t i=0; i<_model->numReactions(); i++) {
+    GiNaC::ex law = _model->getReaction(i)->getKineticLaw()->getRateLaw();
+    UT_ASSERT_EQUAL(cache.apply(law), law.subs(folder.getTable()));
+  }
+
+  // Repeated substitutions are taken from the cache and share their result:
+  GiNaC::ex law = _model->getReaction("veq")->getKineticLaw()->getRateLaw();
+  GiNaC::ex first = cache.apply(law); size_t size = cache.size();
+  UT_ASSERT(GiNaC::are_ex_trivially_equal(first, cache.apply(law)));
+  UT_ASSERT_EQUAL(cache.size(), size);
+
+  // Equal expressions are interned:
+  UT_ASSERT(GiNaC::are_ex_trivially_equal(cache.intern(E*S), cache.intern(S*E)));
+
+  // Composed substitutions must match chained ones:
+  GiNaC::exmap A; A[E] = S+ES;
+  GiNaC::exmap B; B[S] = 2*ES;
+  Trafo::SubstitutionCache composed(A); composed.compose(B);
+  composed.compose(folder.getTable());
+  for (size_t i=0; i<_model->numReactions(); i++) {
+    GiNaC::ex law = _model->getReaction(i)->getKineticLaw()->getRateLaw();
+    UT_ASSERT_EQUAL(composed.apply(law).expand(),
+                    law.subs(A).subs(B).subs(folder.getTable()).expand());
+  }
+}
+
+
 UnitTest::TestSuite *
 ConstantFolderTest::suite()
 {
@@ -102,5 +140,8 @@ ConstantFolderTest::suite()
   s->addTest(new UnitTest::TestCaller<ConstantFolderTest>(
                "const paramter folding", &ConstantFolderTest::testFolderFilter));
 
+  s->addTest(new UnitTest::TestCaller<ConstantFolderTest>(
+               "substitution cache", &ConstantFolderTest::testSubstitutionCache));
+
   return s;
 }
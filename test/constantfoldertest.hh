@@ -21,6 +21,7 @@ public:
 
   void testConstantFolder();
   void testFolderFilter();
+  void testSubstitutionCache();
 
 public:
   static UnitTest::TestSuite *suite();
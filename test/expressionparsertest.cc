@@ -159,6 +159,22 @@ ExpressionParserTest::testParenthesis() {
   UT_ASSERT_EQUAL(expression_1.expand(), expression_2.expand());
 }
 
+void
+ExpressionParserTest::testNestedParenthesis() {
+  Parser::Expr::TableContext ctx; GiNaC::symbol a("a"), b("b");
+  ctx.addSymbol("a", a); ctx.addSymbol("b", b);
+
+  // Test ((...(a^b)...))^2 with 40 levels:
+  std::stringstream buffer;
+  for (size_t i=0; i<40; i++) { buffer << "("; }
+  buffer << "a^b";
+  for (size_t i=0; i<40; i++) { buffer << ")"; }
+  buffer << "^2";
+  GiNaC::ex expr = Parser::Expr::parseExpression(buffer.str(), ctx);
+  UT_ASSERT_EQUAL(expr, GiNaC::pow(GiNaC::pow(a, b), 2));
+}
+
+
 
 UnitTest::TestSuite *
 ExpressionParserTest::suite()
@@ -183,5 +199,8 @@ ExpressionParserTest::suite()
   s->addTest(new UnitTest::TestCaller<ExpressionParserTest>(
                "parenthesis serialization", &ExpressionParserTest::testParenthesis));
 
+  s->addTest(new UnitTest::TestCaller<ExpressionParserTest>(
+               "nested parenthesis", &ExpressionParserTest::testNestedParenthesis));
+
   return s;
 }
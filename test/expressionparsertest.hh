@@ -27,6 +27,9 @@ public:
   /** Test parenthesis in serializations. */
   void testParenthesis();
 
+  /** Tests deeply nested parenthesis, which take exponential time without memoization. */
+  void testNestedParenthesis();
+
 public:
   /** Constructs the test suite. */
   static UnitTest::TestSuite *suite();
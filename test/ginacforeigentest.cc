@@ -1,4 +1,6 @@
 #include "ginacforeigentest.hh"
+#include "models/sparsematrixex.hh"
+#include "models/ssebasemodel.hh"
 
 using namespace iNA;
 
@@ -124,6 +126,74 @@ GinacForEigenTest::testMatrixMatrixMultiplication()
 
 }
 
+void
+GinacForEigenTest::testSparseAssembly()
+{
+    int dim=3, dimCOV=(dim*(dim+1))/2;
+
+    GiNaC::symbol x("x");
+    GiNaC::symbol y("y");
+    GiNaC::symbol z("z");
+
+    // a sparse "Hessian" of the rates, with some structural zeros
+    Models::SparseMatrixEx rates(dim, dimCOV);
+    rates.set(0, 0, 2*x);
+    rates.set(0, 1, y*z);
+    rates.set(1, 2, x-1);
+    rates.set(2, 4, x*y);
+    rates.set(2, 5, 0);
+
+    // check dense round trip, zeros are not stored
+    Eigen::MatrixXex ratesDense = rates.toDense();
+    UT_ASSERT_EQUAL(rates.nonZeros(), size_t(4));
+    for(int i=0;i<dim;i++)
+        for(int j=0;j<dimCOV;j++)
+            UT_ASSERT_EQUAL(ratesDense(i,j), rates(i,j));
+
+    // stoichiometry, with a zero entry to be skipped
+    Eigen::MatrixXd S(2,dim);
+    S << 1, -1,  0,
+         0,  2, -3;
+    Eigen::VectorXex scale(2);
+    scale(0)=x; scale(1)=2;
+
+    // compare sparse product against dense one
+    Models::SparseMatrixEx sparse = Models::SparseMatrixEx::product(S, rates, scale);
+    Eigen::MatrixXex dense = S.cast<GiNaC::ex>()*ratesDense;
+    for(int i=0;i<2;i++)
+        for(int j=0;j<dimCOV;j++)
+            UT_ASSERT_EQUAL(GiNaC::expand(GiNaC::normal(sparse(i,j)-dense(i,j)/scale(i))), GiNaC::ex(0));
+
+    // compare sparse contraction against the dense loop over the covariance
+    Eigen::VectorXex cov(dimCOV);
+    for(int j=0;j<dimCOV;j++)
+        cov(j)=GiNaC::symbol();
+
+    for(int i=0;i<2;i++)
+    {
+        GiNaC::ex denseDelta=0, sparseDelta=0;
+
+        size_t idx=0;
+        for(int j=0;j<dim;j++)
+        {
+            for(int k=0;k<j;k++,idx++)
+                denseDelta += dense(i,idx)*cov(idx)/scale(i);
+            denseDelta += dense(i,idx)*cov(idx)/scale(i)/2;
+            idx++;
+        }
+
+        const Models::SparseMatrixEx::Row &row = sparse.row(i);
+        for(Models::SparseMatrixEx::Row::const_iterator item=row.begin(); item!=row.end(); item++)
+        {
+            size_t j, k; Models::SSEBaseModel::decodeHessianIndex(item->first, j, k);
+            if (k<j) sparseDelta += item->second*cov(item->first);
+            else     sparseDelta += item->second*cov(item->first)/2;
+        }
+
+        UT_ASSERT_EQUAL(GiNaC::expand(GiNaC::normal(sparseDelta-denseDelta)), GiNaC::ex(0));
+    }
+}
+
 
 UnitTest::TestSuite *
 GinacForEigenTest::suite()
@@ -136,5 +206,8 @@ GinacForEigenTest::suite()
   s->addTest(new UnitTest::TestCaller<GinacForEigenTest>("Matrix-Matrix multiplication",
                                                &GinacForEigenTest::testMatrixMatrixMultiplication));
 
+  s->addTest(new UnitTest::TestCaller<GinacForEigenTest>("Sparse assembly",
+                                               &GinacForEigenTest::testSparseAssembly));
+
   return s;
 }
@@ -21,6 +21,7 @@ public:
 public:
   void testMatrixVectorMultiplication();
   void testMatrixMatrixMultiplication();
+  void testSparseAssembly();
 
 public:
   static UnitTest::TestSuite *suite();
@@ -14,6 +14,7 @@
 #include "eval/bcimp/interpreter.hh"
 
 #include "eval/eval.hh"
+#include <sstream>
 
 #if WITH_EXECUTION_ENGINE_LLVM
 #include "eval/jit/engine.hh"
@@ -382,6 +383,99 @@ InterpreterTest::testMatrix()
 }
 
 
+void
+InterpreterTest::testSerialization()
+{
+  GiNaC::symbol a("a"), b("b");
+  Eigen::MatrixXex expr(2,2);
+  expr(0,0) = 4*pow(a,3); expr(0,1) = GiNaC::exp(b)/a;
+  expr(1,0) = 0;          expr(1,1) = 0.5*b + 1;
+
+  // Associate symbol -> index
+  std::map<GiNaC::symbol, size_t , GiNaC::ex_is_less> symbol_table;
+  symbol_table[a] = 0; symbol_table[b] = 1;
+
+  Eigen::VectorXd values(2); values << 1.5, 0.25;
+  Eigen::MatrixXd true_output(2,2), output(2,2);
+
+  Eval::bci::Code code;
+  Eval::bci::Compiler<Eigen::VectorXd, Eigen::MatrixXd> compiler(symbol_table);
+  compiler.setCode(&code);
+  compiler.compileMatrix(expr);
+  compiler.finalize(1);
+  Eval::bci::Interpreter<Eigen::VectorXd, Eigen::MatrixXd> interpreter(&code);
+  interpreter.run(values, true_output);
+
+  // Serialize and read back:
+  std::stringstream buffer;
+  code.serialize(buffer);
+  Eval::bci::Code copy;
+  copy.deserialize(buffer);
+  UT_ASSERT_EQUAL(copy.getCodeSize(), code.getCodeSize());
+  UT_ASSERT_EQUAL(copy.getMinStackSize(), code.getMinStackSize());
+
+  // Values must be bit-exact:
+  Eval::bci::Interpreter<Eigen::VectorXd, Eigen::MatrixXd> copy_interpreter(&copy);
+  output.setZero(); copy_interpreter.run(values, output);
+  for (int i=0; i<output.rows(); i++) {
+    for (int j=0; j<output.cols(); j++) {
+      UT_ASSERT_EQUAL(output(i,j), true_output(i,j));
+    }
+  }
+
+  // Invalid data must be rejected:
+  std::stringstream invalid("no byte-code");
+  UT_ASSERT_THROW(copy.deserialize(invalid), RuntimeError);
+}
+
+
+void
+InterpreterTest::testForkCompiler()
+{
+  GiNaC::symbol a("a"), b("b"), c("c");
+  Eigen::MatrixXex expr(3,3);
+  expr << a*b, pow(b,2), GiNaC::log(c),
+      a+c, 2*a*b*c, 0,
+      GiNaC::exp(a), b/c, a-b;
+
+  // Associate symbol -> index
+  std::map<GiNaC::symbol, size_t , GiNaC::ex_is_less> symbol_table;
+  symbol_table[a] = 0; symbol_table[b] = 1; symbol_table[c] = 2;
+
+  Eigen::VectorXd values(3); values << 1, 2, 3;
+  Eigen::MatrixXd true_output(3,3), output(3,3);
+
+  // Sequential compilation:
+  {
+    Eval::bcimp::Code code(2);
+    Eval::bcimp::Compiler<Eigen::VectorXd, Eigen::MatrixXd> compiler(symbol_table);
+    Eval::bcimp::Interpreter<Eigen::VectorXd, Eigen::MatrixXd> interpreter(&code);
+    compiler.setCode(&code);
+    compiler.compileMatrix(expr);
+    compiler.finalize(1);
+    interpreter.run(values, true_output);
+  }
+
+  // Compilation in 4 worker processes:
+  {
+    Eval::bcimp::Code code(2);
+    Eval::bcimp::Compiler<Eigen::VectorXd, Eigen::MatrixXd> compiler(symbol_table);
+    Eval::bcimp::Interpreter<Eigen::VectorXd, Eigen::MatrixXd> interpreter(&code);
+    Eval::MatrixExpressionGenerator generator(expr);
+    compiler.setCode(&code);
+    compiler.compileGenerated(generator, 4);
+    compiler.finalize(1);
+    output.setZero(); interpreter.run(values, output);
+  }
+
+  for (int i=0; i<output.rows(); i++) {
+    for (int j=0; j<output.cols(); j++) {
+      UT_ASSERT_EQUAL(output(i,j), true_output(i,j));
+    }
+  }
+}
+
+
 void
 InterpreterTest::testFunction()
 {
@@ -615,5 +709,11 @@ InterpreterTest::suite()
   s->addTest(new UnitTest::TestCaller<InterpreterTest>(
                "test complex polynomial (compare)", &InterpreterTest::testComplexPolynomial));
 
+  s->addTest(new UnitTest::TestCaller<InterpreterTest>(
+               "test byte-code serialization", &InterpreterTest::testSerialization));
+
+  s->addTest(new UnitTest::TestCaller<InterpreterTest>(
+               "test parallel compilation", &InterpreterTest::testForkCompiler));
+
   return s;
 }
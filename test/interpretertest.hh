@@ -36,6 +36,9 @@ public:
   void testComplexMatrix();
   void testComplexFunction();
 
+  void testSerialization();
+  void testForkCompiler();
+
 protected:
   /* Helper function to assemble a symbol table from a vector of symbols. */
   void symbolTableFromVector(
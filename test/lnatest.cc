@@ -21,6 +21,50 @@ LNATest::testCoreEnzymeKinetics()
 }
 
 
+void
+LNATest::testSparseJacobian()
+{
+  double err_abs = 1e-8;
+  double err_rel = 1e-6;
+  double final_time = 1.0;
+  size_t N = 10;
+  double dt = final_time/N;
+
+  Ast::Model sbml_model;
+  Parser::Sbml::importModel(sbml_model, "test/regression-tests/enzymekinetics1.xml");
+  Models::LNAmodel model(sbml_model);
+  Models::LNAinterpreter interpreter(model, 1);
+
+  // Compare sparse and dense Jacobian at the initial state:
+  Eigen::VectorXd x(model.getDimension()); model.getInitialState(x);
+  Eigen::MatrixXd dense(model.getDimension(), model.getDimension());
+  Eigen::SparseMatrix<double> sparse;
+  interpreter.evaluateJacobian(x, 0, dense);
+  interpreter.evaluateJacobian(x, 0, sparse);
+  UT_ASSERT(sparse.nonZeros() < dense.rows()*dense.cols());
+  Eigen::MatrixXd sparse_dense(sparse);
+  for (int i=0; i<dense.rows(); i++) {
+    for (int j=0; j<dense.cols(); j++) {
+      UT_ASSERT_NEAR(sparse_dense(i,j), dense(i,j));
+    }
+  }
+
+  // Compare dense and sparse Rosenbrock stepper:
+  ODE::Rosenbrock4TimeInd<Models::LNAinterpreter> dense_stepper(interpreter, dt, err_abs, err_rel);
+  ODE::SparseRosenbrock4TimeInd<Models::LNAinterpreter> sparse_stepper(
+        interpreter, dt, err_abs, err_rel);
+  Eigen::VectorXd x_sparse(x), dx(x.size());
+  double t = 0.0;
+  for (size_t i=0; i<N; i++, t+=dt) {
+    dense_stepper.step(x, t, dx); x += dx;
+    sparse_stepper.step(x_sparse, t, dx); x_sparse += dx;
+  }
+  for (int i=0; i<x.size(); i++) {
+    assertNear(x_sparse(i), x(i), 1e-8*(1+std::abs(x(i))), __FILE__, __LINE__);
+  }
+}
+
+
 void
 LNATest::compareIntegrators(const std::string &file, double final_time)
 {
@@ -78,5 +122,8 @@ LNATest::suite()
   s->addTest(new UnitTest::TestCaller<LNATest>(
                "EnzymeKinetics Model", &LNATest::testCoreEnzymeKinetics));
 
+  s->addTest(new UnitTest::TestCaller<LNATest>(
+               "Sparse Jacobian", &LNATest::testSparseJacobian));
+
   return s;
 }
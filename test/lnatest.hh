@@ -16,6 +16,8 @@ public:
   virtual ~LNATest();
   /** Integrates "regression-tests/core_osc.xml" model. */
   void testCoreEnzymeKinetics();
+  /** Compares the sparse Jacobian and sparse Rosenbrock stepper with the dense ones. */
+  void testSparseJacobian();
 
 public:
   /** Assembles the test suite. */
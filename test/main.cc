@@ -16,7 +16,10 @@
 #include "sbmlshparsertest.hh"
 #include "optionparsertest.hh"
 #include "odetest.hh"
+#include "allocationtest.hh"
 #include "modelcopytest.hh"
+#include "conservationtest.hh"
+#include "tablestoragetest.hh"
 #include "constantfoldertest.hh"
 #include "unitparsertest.hh"
 #include "benchmark.hh"
@@ -97,6 +100,10 @@ int main(int argc, char *argv[])
     runner.addSuite(ConstantFolderTest::suite());
   if (0 == skipped_tests.count("UnitParser"))
     runner.addSuite(UnitParserTest::suite());
+  if (0 == skipped_tests.count("Conservation"))
+    runner.addSuite(ConservationTest::suite());
+  if (0 == skipped_tests.count("TableStorage"))
+    runner.addSuite(TableStorageTest::suite());
   if (0 == skipped_tests.count("RETest"))
     runner.addSuite(RETest::suite());
   if (0 == skipped_tests.count("LNATest"))
@@ -111,6 +118,8 @@ int main(int argc, char *argv[])
     runner.addSuite(SSATest::suite());
   if (0 == skipped_tests.count("ODE"))
     runner.addSuite(ODETest::suite());
+  if (0 == skipped_tests.count("Allocation"))
+    runner.addSuite(AllocationTest::suite());
   if (0 == skipped_tests.count("RNG"))
     runner.addSuite(MersenneTwisterTest::suite());
   if (0 == skipped_tests.count("Benchmark"))
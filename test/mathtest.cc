@@ -1,6 +1,7 @@
 #include "mathtest.hh"
 #include <math.h>
 #include "math.hh"
+#include "nlesolve/precisionsolve.hh"
 
 
 void
@@ -20,12 +21,93 @@ iNA::MathTest::testErf()
 }
 
 
+void
+iNA::MathTest::testPrecisionSolve()
+{
+  // Ill-conditioned Hilbert matrix:
+  size_t N = 8;
+  Eigen::MatrixXd B(N,N);
+  for (size_t i=0; i<N; i++)
+    for (size_t j=0; j<N; j++)
+      B(i,j) = 1./(i+j+1);
+
+  NLEsolve::PrecisionSolve solver(N);
+  solver.factorize(B);
+  UT_ASSERT(1e8 < solver.conditionEstimate());
+
+  // Reuse factorization for several right hand sides:
+  Eigen::MatrixXd A(N,3), X;
+  A.col(0) = B*Eigen::VectorXd::Ones(N);
+  A.col(1) = B.col(0);
+  A.col(2) = Eigen::VectorXd::LinSpaced(N, 1, N);
+  solver.solve(A, X);
+  for (size_t i=0; i<3; i++) {
+    UT_ASSERT(((B*X.col(i)-A.col(i)).lpNorm<Eigen::Infinity>()) <= 1e-9*A.col(i).lpNorm<Eigen::Infinity>());
+  }
+  UT_ASSERT(solver.converged());
+  UT_ASSERT_EQUAL(solver.method(), NLEsolve::PrecisionSolve::PARTIAL_PIVOTING_LU);
+
+  // A slightly perturbed matrix keeps the factorization, the refinement accounts for the
+  // perturbation:
+  Eigen::MatrixXd C = B; C(0,0) *= 1+1e-12;
+  UT_ASSERT(solver.update(C));
+  const Eigen::VectorXd &x = solver.solve(A.col(0));
+  UT_ASSERT(solver.converged());
+  UT_ASSERT(((C*x-A.col(0)).lpNorm<Eigen::Infinity>()) <= 1e-9*A.col(0).lpNorm<Eigen::Infinity>());
+  UT_ASSERT(! solver.update(2*B));
+}
+
+
+void
+iNA::MathTest::testPrecisionSolveEscalation()
+{
+  // The Wilkinson matrix has a pivot growth of 2^(N-1) under partial pivoting, hence the
+  // refinement fails and the solver escalates to full pivoting:
+  size_t N = 100;
+  Eigen::MatrixXd B = Eigen::MatrixXd::Identity(N,N);
+  Eigen::VectorXd A(N);
+  for (size_t i=0; i<N; i++) {
+    for (size_t j=0; j<i; j++)
+      B(i,j) = -1;
+    B(i,N-1) = 1;
+    A(i) = 1./(i+3);
+  }
+
+  NLEsolve::PrecisionSolve solver(N);
+  const Eigen::VectorXd &x = solver.solve(B, A);
+  UT_ASSERT_EQUAL(solver.method(), NLEsolve::PrecisionSolve::FULL_PIVOTING_LU);
+  UT_ASSERT(solver.converged());
+  UT_ASSERT(((B*x-A).lpNorm<Eigen::Infinity>()) <= 1e-9*A.lpNorm<Eigen::Infinity>());
+  UT_ASSERT(N/2 < solver.conditionEstimate() && solver.conditionEstimate() < 1e4);
+
+  // A singular, inconsistent system can not be solved by any decomposition, the solver ends up
+  // with the QR decomposition:
+  Eigen::MatrixXd S(4,4);
+  S << 1, 2, 3, 4,
+       2, 4, 6, 8,
+       1, 0, 1, 0,
+       0, 1, 0, 1;
+  Eigen::VectorXd b = Eigen::VectorXd::Ones(4);
+
+  NLEsolve::PrecisionSolve singular(4);
+  const Eigen::VectorXd &y = singular.solve(S, b);
+  UT_ASSERT_EQUAL(singular.method(), NLEsolve::PrecisionSolve::COL_PIVOTING_QR);
+  UT_ASSERT(! singular.converged());
+  UT_ASSERT(y.allFinite());
+  UT_ASSERT(1e12 < singular.conditionEstimate());
+}
+
+
 iNA::UnitTest::TestSuite *
 iNA::MathTest::suite()
 {
   UnitTest::TestSuite *s = new UnitTest::TestSuite("Tests for mathematical utilities.");
   s->addTest(new UnitTest::TestCaller<MathTest>("erf()",
                                                 &MathTest::testErf));
+  s->addTest(new UnitTest::TestCaller<MathTest>("PrecisionSolve",
+                                                &MathTest::testPrecisionSolve));
+  s->addTest(new UnitTest::TestCaller<MathTest>("PrecisionSolve escalation",
+                                                &MathTest::testPrecisionSolveEscalation));
 
   return s;
 }
@@ -11,6 +11,8 @@ class MathTest : public UnitTest::TestCase
 public:
   virtual ~MathTest(){};
   void testErf();
+  void testPrecisionSolve();
+  void testPrecisionSolveEscalation();
 
 public:
   static UnitTest::TestSuite *suite();
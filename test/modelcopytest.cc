@@ -1,5 +1,9 @@
 #include "modelcopytest.hh"
 #include "parser/sbml/sbml.hh"
+#include "models/REmodel.hh"
+#include "models/optimizedSSA.hh"
+#include <algorithm>
+#include <sstream>
 
 
 using namespace iNA;
@@ -292,6 +296,129 @@ ModelCopyTest::testCoopKinetics1()
 }
 
 
+void
+ModelCopyTest::testSnapshot()
+{
+  Ast::Model model; Parser::Sbml::importModel(model, "test/regression-tests/coopkinetics1.xml");
+
+  // Snapshots share a single copy:
+  Ast::ModelSnapshot a(model);
+  Ast::ModelSnapshot b(a);
+  UT_ASSERT(a.isShared() && b.isShared());
+  UT_ASSERT(&(*a) == &(*b));
+  UT_ASSERT(&(*a) != &model);
+
+  // Modification detaches:
+  Ast::Model &copy = b.modify();
+  UT_ASSERT(! a.isShared() && ! b.isShared());
+  UT_ASSERT(&(*a) != &copy);
+  UT_ASSERT(&(*b) == &copy);
+  UT_ASSERT(&(b.modify()) == &copy);
+  testModelEqual(model, copy);
+
+  // Reset releases the reference:
+  Ast::ModelSnapshot c(a); c.reset();
+  UT_ASSERT(c.isNull() && ! a.isShared());
+}
+
+
+void
+ModelCopyTest::testSnapshotConfigs()
+{
+  Ast::Model model; Parser::Sbml::importModel(model, "test/regression-tests/enzymekinetics1.xml");
+  Ast::ModelSnapshot document(model);
+
+  // Two task configurations on the same revision of the document share its model:
+  Ast::ModelSnapshot config_a(document), config_b(document);
+  UT_ASSERT(&(*config_a) == &(*config_b));
+  UT_ASSERT(&(*config_a) == &(*document));
+
+  // Constructing the analyses from the snapshots does not detach them:
+  Models::REmodel re_model(*config_a);
+  Models::OptimizedSSA ssa(*config_b, 1, 1024, 0, 1);
+  UT_ASSERT(&(*config_a) == &(*config_b));
+  UT_ASSERT_EQUAL(re_model.numSpecies(), config_a->numSpecies());
+  UT_ASSERT_EQUAL(ssa.numSpecies(), config_b->numSpecies());
+
+  // The first configuration changing its model gets a copy, the others still share:
+  GiNaC::ex value = config_a->getParameter("omega")->getValue();
+  config_b.modify().getParameter("omega")->setValue(value+1);
+  UT_ASSERT(&(*config_a) != &(*config_b));
+  UT_ASSERT(&(*config_a) == &(*document));
+  UT_ASSERT(config_a.isShared() && ! config_b.isShared());
+  UT_ASSERT(config_a->getParameter("omega")->getValue().is_equal(value));
+  UT_ASSERT(config_b->getParameter("omega")->getValue().is_equal(value+1));
+}
+
+
+void
+ModelCopyTest::assertIndices(Ast::Model &model, const std::vector<std::string> &ids)
+{
+  // Check the order of parameters:
+  UT_ASSERT_EQUAL(model.numParameters(), ids.size());
+  for (size_t i=0; i<ids.size(); i++) {
+    UT_ASSERT_EQUAL(model.getParameter(i)->getIdentifier(), ids[i]);
+    UT_ASSERT_EQUAL(model.getParameterIdx(model.getParameter(i)), i);
+    UT_ASSERT_EQUAL(model.getParameterIdx(ids[i]), i);
+  }
+
+  // The compartments are not affected:
+  UT_ASSERT_EQUAL(model.numCompartments(), size_t(2));
+  UT_ASSERT_EQUAL(model.getCompartmentIdx("c0"), size_t(0));
+  UT_ASSERT_EQUAL(model.getCompartmentIdx("c1"), size_t(1));
+}
+
+
+void
+ModelCopyTest::testIndexTable()
+{
+  Ast::Model model;
+  std::vector<std::string> ids;
+
+  // Define parameters interleaved with compartments:
+  model.addDefinition(new Ast::Compartment("c0", Ast::Compartment::VOLUME));
+  for (size_t i=0; i<4; i++) {
+    std::stringstream id; id << "p" << i; ids.push_back(id.str());
+    model.addDefinition(new Ast::Parameter(id.str(), Ast::Unit::dimensionless()));
+    if (1 == i) { model.addDefinition(new Ast::Compartment("c1", Ast::Compartment::VOLUME)); }
+  }
+  assertIndices(model, ids);
+
+  // Insert after the first, a middle and the last parameter:
+  model.addDefinition(new Ast::Parameter("a", Ast::Unit::dimensionless()), model.getParameter(0));
+  ids.insert(ids.begin()+1, "a");
+  assertIndices(model, ids);
+  model.addDefinition(new Ast::Parameter("b", Ast::Unit::dimensionless()), model.getParameter("p2"));
+  ids.insert(ids.begin()+4, "b");
+  assertIndices(model, ids);
+  model.addDefinition(new Ast::Parameter("c", Ast::Unit::dimensionless()), model.getParameter("p3"));
+  ids.push_back("c");
+  assertIndices(model, ids);
+
+  // Inserting after a definition that is not a parameter appends:
+  model.addDefinition(new Ast::Parameter("d", Ast::Unit::dimensionless()), model.getCompartment(0));
+  ids.push_back("d");
+  assertIndices(model, ids);
+
+  // Remove the first, a middle and the last parameter:
+  const char *removed[] = {"p0", "b", "d"};
+  for (size_t i=0; i<3; i++) {
+    Ast::Parameter *param = model.getParameter(removed[i]);
+    model.remDefinition(param); delete param;
+    ids.erase(std::find(ids.begin(), ids.end(), std::string(removed[i])));
+    assertIndices(model, ids);
+  }
+
+  // Remove all remaining parameters, starting with the last one:
+  while (0 < ids.size()) {
+    Ast::Parameter *param = model.getParameter(ids.size()-1);
+    model.remDefinition(param); delete param;
+    ids.pop_back();
+    assertIndices(model, ids);
+  }
+}
+
+
 UnitTest::TestSuite *
 ModelCopyTest::suite()
 {
@@ -299,6 +426,12 @@ ModelCopyTest::suite()
 
   s->addTest(new UnitTest::TestCaller<ModelCopyTest>(
                "coopkinetics1.xml", &ModelCopyTest::testCoopKinetics1));
+  s->addTest(new UnitTest::TestCaller<ModelCopyTest>(
+               "Model snapshots", &ModelCopyTest::testSnapshot));
+  s->addTest(new UnitTest::TestCaller<ModelCopyTest>(
+               "Model snapshots of task configurations", &ModelCopyTest::testSnapshotConfigs));
+  s->addTest(new UnitTest::TestCaller<ModelCopyTest>(
+               "Model index table", &ModelCopyTest::testIndexTable));
 
   return s;
 }
@@ -32,6 +32,8 @@ protected:
 
   // Performs the test:
   void testCopy(const std::string &file);
+  // Checks the order and indices of the parameters of the model:
+  void assertIndices(Ast::Model &model, const std::vector<std::string> &ids);
 
 
 public:
@@ -39,6 +41,12 @@ public:
   {};
   /** Tests copying on ./test/regression-tests/coopkinetics1.xml. */
   void testCoopKinetics1();
+  /** Tests sharing and copy-on-write of @c Ast::ModelSnapshot. */
+  void testSnapshot();
+  /** Tests that task configurations share a snapshot until one of them modifies its model. */
+  void testSnapshotConfigs();
+  /** Tests the consistency of the indices of definitions on insertion and removal. */
+  void testIndexTable();
 
 
 public:
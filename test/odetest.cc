@@ -411,6 +411,436 @@ ODETest::testVanDerPolRosenbrock4()
 
 
 
+void
+ODETest::testStiffBDF()
+{
+  double dt = 1e-2;
+  double eps_abs = 1e-5;
+  double eps_rel = 1e-6;
+
+  ODE::BDFStepper<ODE::TimeIndepODEModel> dense(*this->stiff, dt, eps_abs, eps_rel);
+  ODE::BDFStepper<ODE::TimeIndepODEModel, ODE::BDFGMRESSolver<ODE::TimeIndepODEModel> > gmres(
+        *this->stiff, dt, eps_abs, eps_rel);
+
+  std::vector<ODE::Stepper *> steppers;
+  steppers.push_back(&dense); steppers.push_back(&gmres);
+
+  for (size_t k=0; k<steppers.size(); k++) {
+    // Initial states:
+    Eigen::VectorXd state(2); state << 1, 0;
+    Eigen::VectorXd delta(2);
+    for (size_t i=0; i<100; i++) {
+      double x = 2*std::exp(-(i*dt)) - std::exp(-1000*(i*dt));
+      double y = -std::exp(-(i*dt)) + std::exp(-1000*(i*dt));
+
+      // The global error of the multistep method may exceed the local error:
+      assertNear(state(0), x, 10*(eps_abs + std::abs(x*eps_rel)), __FILE__, __LINE__);
+      assertNear(state(1), y, 10*(eps_abs + std::abs(y*eps_rel)), __FILE__, __LINE__);
+
+      // Perform step and update state:
+      steppers[k]->step(state, i*dt, delta); state += delta;
+    }
+  }
+}
+
+
+/** A stiff, non-linear chain x_0 -> x_1 -> ... -> x_(n-1) with rates spanning 4 orders of
+ * magnitude. The Jacobian is lower bidiagonal and also provided in sparse form. */
+class StiffSparseChain
+{
+public:
+  Eigen::VectorXd k;
+
+  StiffSparseChain(size_t n) : k(n) {
+    for (size_t i=0; i<n; i++) { k(i) = std::pow(10., (4.*i)/(n-1)); }
+  }
+
+  size_t getDimension() const { return k.size(); }
+
+  void evaluate(const Eigen::VectorXd &state, double t, Eigen::VectorXd &rates) {
+    rates(0) = 1 - k(0)*state(0) - state(0)*state(0);
+    for (int i=1; i<k.size(); i++) {
+      rates(i) = k(i-1)*state(i-1) - k(i)*state(i) - state(i)*state(i);
+    }
+  }
+
+  void evaluateJacobian(const Eigen::VectorXd &state, double t, Eigen::MatrixXd &jacobian) {
+    jacobian.setZero(k.size(), k.size());
+    for (int i=0; i<k.size(); i++) {
+      jacobian(i,i) = -k(i) - 2*state(i);
+      if (0 < i) { jacobian(i,i-1) = k(i-1); }
+    }
+  }
+
+  void evaluateJacobian(const Eigen::VectorXd &state, double t, Eigen::SparseMatrix<double> &jacobian) {
+    std::vector< Eigen::Triplet<double> > triplets;
+    for (int i=0; i<k.size(); i++) {
+      triplets.push_back(Eigen::Triplet<double>(i, i, -k(i) - 2*state(i)));
+      if (0 < i) { triplets.push_back(Eigen::Triplet<double>(i, i-1, k(i-1))); }
+    }
+    jacobian.resize(k.size(), k.size());
+    jacobian.setFromTriplets(triplets.begin(), triplets.end());
+  }
+};
+
+
+void
+ODETest::testStiffBDFSolvers()
+{
+  size_t N = 100, dim = 20;
+  double dt = 1e-1;
+  double eps_abs = 1e-8;
+  double eps_rel = 1e-6;
+
+  StiffSparseChain system(dim);
+  // Reference solution using Rosenbrock4 with tight tolerances:
+  ODE::Rosenbrock4TimeInd<StiffSparseChain> reference(system, dt, 1e-12, 1e-10);
+  ODE::BDFStepper<StiffSparseChain> dense(system, dt, eps_abs, eps_rel);
+  ODE::BDFStepper<StiffSparseChain, ODE::BDFSparseSolver<StiffSparseChain> > sparse(
+        system, dt, eps_abs, eps_rel);
+  ODE::BDFStepper<StiffSparseChain, ODE::BDFGMRESSolver<StiffSparseChain> > gmres(
+        system, dt, eps_abs, eps_rel);
+
+  std::vector<ODE::Stepper *> steppers;
+  steppers.push_back(&dense); steppers.push_back(&sparse); steppers.push_back(&gmres);
+  std::vector<Eigen::VectorXd> states(steppers.size(), Eigen::VectorXd::Zero(dim));
+  Eigen::VectorXd x(Eigen::VectorXd::Zero(dim));
+
+  for (size_t i=0; i<N; i++) {
+    static_cast<ODE::Stepper &>(reference).step(x, i*dt);
+    for (size_t k=0; k<steppers.size(); k++) {
+      steppers[k]->step(states[k], i*dt);
+      // The global error of the multistep method may exceed the local error:
+      for (size_t j=0; j<dim; j++) {
+        assertNear(states[k](j), x(j), 10*(eps_abs + std::abs(x(j)*eps_rel)), __FILE__, __LINE__);
+      }
+    }
+  }
+
+  // The system is stiff, hence few Jacobians are needed for many steps:
+  UT_ASSERT(0 < sparse.statistics().numJacobianEvaluations());
+  UT_ASSERT(sparse.statistics().numJacobianEvaluations() < sparse.statistics().numAcceptedSteps());
+  // The products of the Jacobian-free solver are counted as evaluations of the system:
+  UT_ASSERT(gmres.statistics().numRHSEvaluations() > gmres.statistics().numAcceptedSteps()
+            + sparse.statistics().numRHSEvaluations());
+}
+
+
+/** The linear system dx/dt = lambda x. */
+class LinearDecay
+{
+public:
+  double lambda;
+  size_t dim;
+
+  LinearDecay(double lambda, size_t dim) : lambda(lambda), dim(dim) { }
+
+  size_t getDimension() const { return dim; }
+
+  void evaluate(const Eigen::VectorXd &state, double t, Eigen::VectorXd &rates) {
+    rates = lambda*state;
+  }
+};
+
+
+void
+ODETest::testGMRESBreakdown()
+{
+  size_t dim = 5;
+  Eigen::VectorXd state(Eigen::VectorXd::Ones(dim)), rhs(dim), x(dim);
+  for (size_t i=0; i<dim; i++) { rhs(i) = i+1; }
+
+  // (I - c J) = 2 I:
+  ODE::StepperStatistics statistics;
+  LinearDecay decay(-1, dim);
+  ODE::BDFGMRESSolver<LinearDecay> solver(decay, statistics);
+  solver.updateJacobian(state, 0); solver.decompose(1);
+  UT_ASSERT(solver.solve(rhs, x));
+  for (size_t i=0; i<dim; i++) {
+    assertNear(x(i), rhs(i)/2, 1e-6, __FILE__, __LINE__);
+  }
+  UT_ASSERT(1 < statistics.numRHSEvaluations());
+
+  // (I - c J) = 0, the iteration breaks down at the first step. At the origin and along a unit
+  // vector, the finite difference of the system is exact:
+  LinearDecay growth(1, dim);
+  ODE::BDFGMRESSolver<LinearDecay> singular(growth, statistics);
+  singular.updateJacobian(Eigen::VectorXd::Zero(dim), 0); singular.decompose(1);
+  rhs = Eigen::VectorXd::Unit(dim, 2);
+  UT_ASSERT(! singular.solve(rhs, x));
+  UT_ASSERT(x.allFinite());
+}
+
+
+void
+ODETest::testDenseOutput()
+{
+  // Integrate harmonic oscillator over a fine output grid:
+  ODE::IntegrationRange range(0, 10, 1000);
+  double eps_abs = 1e-8;
+  double eps_rel = 1e-8;
+
+  ODE::RKF45<ODE::TimeIndepODEModel> rkf45(*this->harm, range.getStepSize(), eps_abs, eps_rel);
+  ODE::Dopri5Stepper<ODE::TimeIndepODEModel> dopri5(*this->harm, range.getStepSize(), eps_abs, eps_rel);
+  ODE::Dopri853Stepper<ODE::TimeIndepODEModel> dopri853(*this->harm, range.getStepSize(), eps_abs, eps_rel);
+
+  std::vector<ODE::Stepper *> steppers;
+  steppers.push_back(&rkf45); steppers.push_back(&dopri5); steppers.push_back(&dopri853);
+
+  for (size_t k=0; k<steppers.size(); k++) {
+    ODE::DenseOutputDriver driver(*steppers[k], range);
+    UT_ASSERT(driver.hasDenseOutput());
+
+    Eigen::VectorXd state(2); state << 1, 0;
+    double t = range.getStartTime();
+    driver.start(state);
+    for (size_t i=0; i<range.getSteps(); i++) {
+      driver.next(state, t);
+      assertNear(t, (i+1)*range.getStepSize(), 1e-12, __FILE__, __LINE__);
+      assertNear(state(0), cos(t), 1e-5, __FILE__, __LINE__);
+      assertNear(state(1), -sin(t), 1e-5, __FILE__, __LINE__);
+    }
+  }
+}
+
+
+/** An ensemble of harmonic oscillators with different frequencies. */
+class HarmonicEnsemble
+{
+public:
+  Eigen::VectorXd omega;
+
+  HarmonicEnsemble(size_t K) : omega(K) {
+    for (size_t k=0; k<K; k++) { omega(k) = 1+k; }
+  }
+
+  size_t size() const { return omega.size(); }
+  size_t getDimension() const { return 2; }
+
+  void evaluate(const Eigen::MatrixXd &states, const Eigen::VectorXd &t, Eigen::MatrixXd &rates) {
+    rates.resize(states.rows(), 2);
+    rates.col(0) = states.col(1);
+    rates.col(1) = -(omega.array().square()*states.col(0).array()).matrix();
+  }
+};
+
+
+void
+ODETest::testEnsemble()
+{
+  size_t K = 8;
+  double dt = 1e-1;
+  double eps_abs = 1e-8;
+  double eps_rel = 1e-8;
+
+  HarmonicEnsemble system(K);
+  ODE::EnsembleStepper<HarmonicEnsemble> stepper(system, dt, eps_abs, eps_rel);
+  // Mask one member:
+  stepper.setActive(3, false);
+
+  Eigen::MatrixXd states(K, 2);
+  states.col(0).setOnes(); states.col(1).setZero();
+
+  for (size_t i=0; i<100; i++) {
+    double t = (i+1)*dt;
+    stepper.step(states, i*dt, t);
+    for (size_t k=0; k<K; k++) {
+      if (3 == k) {
+        assertNear(states(k,0), 1., 0., __FILE__, __LINE__);
+      } else {
+        assertNear(states(k,0), std::cos(system.omega(k)*t), 1e-6, __FILE__, __LINE__);
+      }
+    }
+  }
+}
+
+/** Fires once the first component of the state crosses zero. */
+class ZeroCrossingEvent : public ODE::Event
+{
+public:
+  virtual double evaluate(const Eigen::VectorXd &state, double t) { return state(0); }
+};
+
+
+void
+ODETest::testEvents()
+{
+  double eps_abs = 1e-8;
+  double eps_rel = 1e-8;
+
+  { // Locate zero crossing of the harmonic oscillator at t=pi/2 on the continuous extension:
+    ODE::IntegrationRange range(0, 10, 100);
+    ODE::Dopri5Stepper<ODE::TimeIndepODEModel> stepper(*this->harm, range.getStepSize(), eps_abs, eps_rel);
+    ZeroCrossingEvent event; stepper.addEvent(&event);
+    ODE::DenseOutputDriver driver(stepper, range);
+
+    Eigen::VectorXd state(2); state << 1, 0;
+    double t = range.getStartTime();
+    UT_ASSERT(! driver.start(state));
+    for (size_t i=0; (i<range.getSteps()) && (! driver.eventFired()); i++) {
+      driver.next(state, t);
+    }
+    UT_ASSERT(driver.eventFired());
+    UT_ASSERT_EQUAL(stepper.firedEvent(), 0);
+    assertNear(t, M_PI/2, 1e-7, __FILE__, __LINE__);
+    assertNear(state(0), 0., 1e-7, __FILE__, __LINE__);
+  }
+
+  { // Stop at the steady state of the stiff system, checked at the end of each step:
+    ODE::IntegrationRange range(0, 100, 1000);
+    ODE::Rosenbrock4TimeInd<ODE::TimeIndepODEModel> stepper(*this->stiff, range.getStepSize(), eps_abs, eps_rel);
+    ODE::SteadyStateEvent<ODE::TimeIndepODEModel> event(*this->stiff, 1e-4, 0);
+    stepper.addEvent(&event);
+    ODE::DenseOutputDriver driver(stepper, range);
+
+    Eigen::VectorXd state(2); state << 1, 0;
+    double t = range.getStartTime();
+    driver.start(state);
+    for (size_t i=0; (i<range.getSteps()) && (! driver.eventFired()); i++) {
+      driver.next(state, t);
+    }
+    UT_ASSERT(driver.eventFired());
+    // The slow mode decays like exp(-t) with rate 2exp(-t) < 1e-4, hence t ~ 9.9:
+    UT_ASSERT(t < 11);
+    assertNear(state(0), 2*std::exp(-t), 1e-5, __FILE__, __LINE__);
+  }
+}
+
+
+void
+ODETest::testStatistics()
+{
+  double eps_abs = 1e-8;
+  double eps_rel = 1e-8;
+  ODE::IntegrationRange range(0, 10, 100);
+
+  { // Explicit stepper: 6 evaluations per attempted step + 1 for the first step.
+    ODE::Dopri5Stepper<ODE::TimeIndepODEModel> stepper(*this->harm, range.getStepSize(), eps_abs, eps_rel);
+    ODE::DenseOutputDriver driver(stepper, range);
+    Eigen::VectorXd state(2); state << 1, 0;
+    double t = range.getStartTime();
+    driver.start(state);
+    for (size_t i=0; i<range.getSteps(); i++) { driver.next(state, t); }
+
+    const ODE::StepperStatistics &stats = stepper.statistics();
+    size_t steps = stats.numAcceptedSteps() + stats.numRejectedSteps();
+    UT_ASSERT(0 < stats.numAcceptedSteps());
+    UT_ASSERT_EQUAL(stats.numRHSEvaluations(), 6*steps+1);
+    UT_ASSERT_EQUAL(stats.numJacobianEvaluations(), size_t(0));
+    UT_ASSERT(stats.minStepSize() <= stats.maxStepSize());
+  }
+
+  { // Implicit stepper: Jacobian and decompositions are counted.
+    ODE::Rosenbrock4TimeInd<ODE::TimeIndepODEModel> stepper(*this->stiff, range.getStepSize(), eps_abs, eps_rel);
+    ODE::DenseOutputDriver driver(stepper, range);
+    Eigen::VectorXd state(2); state << 1, 0;
+    double t = range.getStartTime();
+    driver.start(state);
+    for (size_t i=0; i<range.getSteps(); i++) { driver.next(state, t); }
+
+    const ODE::StepperStatistics &stats = stepper.statistics();
+    UT_ASSERT(0 < stats.numAcceptedSteps());
+    UT_ASSERT(0 < stats.numJacobianEvaluations());
+    UT_ASSERT(stats.numJacobianEvaluations() <= stats.numDecompositions());
+  }
+}
+
+
+/** The stiff Robertson problem. */
+class Robertson
+{
+public:
+  size_t getDimension() const { return 3; }
+
+  void evaluate(const Eigen::VectorXd &state, double t, Eigen::VectorXd &rates) {
+    rates(0) = -0.04*state(0) + 1e4*state(1)*state(2);
+    rates(2) = 3e7*state(1)*state(1);
+    rates(1) = -rates(0) - rates(2);
+  }
+
+  void evaluateJacobian(const Eigen::VectorXd &state, double t, Eigen::MatrixXd &jacobian) {
+    jacobian(0,0) = -0.04; jacobian(0,1) = 1e4*state(2); jacobian(0,2) = 1e4*state(1);
+    jacobian(2,0) = 0;     jacobian(2,1) = 6e7*state(1); jacobian(2,2) = 0;
+    jacobian.row(1) = -jacobian.row(0) - jacobian.row(2);
+  }
+};
+
+
+/** Integrates the Robertson problem over [0, 100] using the given number of output intervals. */
+template <class Stepper>
+static void
+integrateRobertson(size_t N, Eigen::VectorXd &state, ODE::StepperStatistics &stats)
+{
+  Robertson system; double dt = 100./N;
+  Stepper stepper(system, dt, 1e-8, 1e-6);
+  state.resize(3); state << 1, 0, 0;
+  for (size_t i=0; i<N; i++) { static_cast<ODE::Stepper &>(stepper).step(state, i*dt); }
+  stats = stepper.statistics();
+}
+
+
+void
+ODETest::testRosenbrockOutputGrid()
+{
+  Eigen::VectorXd coarse, fine;
+  ODE::StepperStatistics coarse_stats, fine_stats;
+
+  // The output grid must neither change the internal steps nor the decompositions:
+  integrateRobertson< ODE::Rosenbrock4TimeInd<Robertson> >(1, coarse, coarse_stats);
+  integrateRobertson< ODE::Rosenbrock4TimeInd<Robertson> >(10000, fine, fine_stats);
+  for (int i=0; i<3; i++) {
+    assertNear(fine(i), coarse(i), 1e-6*std::abs(coarse(i))+1e-9, __FILE__, __LINE__);
+  }
+  UT_ASSERT(fine_stats.numDecompositions() <= 1.1*coarse_stats.numDecompositions());
+  UT_ASSERT(fine_stats.numAcceptedSteps() <= 1.1*coarse_stats.numAcceptedSteps());
+  UT_ASSERT(fine_stats.numDecompositions() < 10000/5);
+  // The Jacobian is reused for several steps:
+  UT_ASSERT(10*fine_stats.numJacobianEvaluations() < fine_stats.numAcceptedSteps());
+  UT_ASSERT(fine_stats.numJacobianEvaluations() <= fine_stats.numDecompositions());
+
+  integrateRobertson< ODE::Rosenbrock3TimeInd<Robertson> >(1, coarse, coarse_stats);
+  integrateRobertson< ODE::Rosenbrock3TimeInd<Robertson> >(10000, fine, fine_stats);
+  for (int i=0; i<3; i++) {
+    assertNear(fine(i), coarse(i), 1e-5*std::abs(coarse(i))+1e-7, __FILE__, __LINE__);
+  }
+  UT_ASSERT(fine_stats.numDecompositions() <= 1.1*coarse_stats.numDecompositions());
+  UT_ASSERT(fine_stats.numAcceptedSteps() <= 1.1*coarse_stats.numAcceptedSteps());
+  UT_ASSERT(fine_stats.numDecompositions() < 10000/5);
+  UT_ASSERT(10*fine_stats.numJacobianEvaluations() < fine_stats.numAcceptedSteps());
+  UT_ASSERT(fine_stats.numJacobianEvaluations() <= fine_stats.numDecompositions());
+}
+
+
+void
+ODETest::testLinearPropagator()
+{
+  // Harmonic oscillator with constant force: y' = A y + b, y(t) = R(t)(y0 + A^-1 b) - A^-1 b
+  Eigen::MatrixXd A(2,2); A << 0, 1, -1, 0;
+  Eigen::VectorXd b(2); b << 1, 2;
+  Eigen::VectorXd y(2), y_new(2); y << 1, 0;
+
+  ODE::LinearPropagator propagator;
+  propagator.initialize(A, b, 0.1);
+  for (size_t i=0; i<100; i++) {
+    propagator.propagate(y, y_new); y = y_new;
+  }
+
+  double t = 10;
+  Eigen::VectorXd y_inf = A.inverse()*b, y0(2); y0 << 1, 0;
+  Eigen::MatrixXd R(2,2); R << std::cos(t), std::sin(t), -std::sin(t), std::cos(t);
+  Eigen::VectorXd exact = R*(y0+y_inf) - y_inf;
+  assertNear(y(0), exact(0), 1e-12, __FILE__, __LINE__);
+  assertNear(y(1), exact(1), 1e-12, __FILE__, __LINE__);
+
+  // Stiff diagonal system:
+  Eigen::MatrixXd S(2,2), expS; S << -1000, 0, 0, -1;
+  ODE::LinearPropagator::exponential(S, expS);
+  assertNear(expS(0,0), 0., 1e-12, __FILE__, __LINE__);
+  assertNear(expS(1,1), std::exp(-1.), 1e-12, __FILE__, __LINE__);
+  assertNear(expS(0,1), 0., 1e-12, __FILE__, __LINE__);
+}
+
+
 UnitTest::TestSuite *
 ODETest::suite()
 {
@@ -446,6 +876,15 @@ ODETest::suite()
   s->addTest(new UnitTest::TestCaller<ODETest>(
                "Test Rosenbrock4 (stiff)", &ODETest::testStiffRosenbrock45));
 
+  s->addTest(new UnitTest::TestCaller<ODETest>(
+               "Test BDF (stiff)", &ODETest::testStiffBDF));
+
+  s->addTest(new UnitTest::TestCaller<ODETest>(
+               "Test BDF linear solvers (stiff)", &ODETest::testStiffBDFSolvers));
+
+  s->addTest(new UnitTest::TestCaller<ODETest>(
+               "Test GMRES breakdown", &ODETest::testGMRESBreakdown));
+
   s->addTest(new UnitTest::TestCaller<ODETest>(
                "Test RKF45 (van der Pol)", &ODETest::testVanDerPolRKF45));
 
@@ -461,5 +900,23 @@ ODETest::suite()
   s->addTest(new UnitTest::TestCaller<ODETest>(
                "Test Rosenbrock4 (van der Pol)", &ODETest::testVanDerPolRosenbrock4));
 
+  s->addTest(new UnitTest::TestCaller<ODETest>(
+               "Test dense output (harmonic)", &ODETest::testDenseOutput));
+
+  s->addTest(new UnitTest::TestCaller<ODETest>(
+               "Test ensemble (harmonic)", &ODETest::testEnsemble));
+
+  s->addTest(new UnitTest::TestCaller<ODETest>(
+               "Test events", &ODETest::testEvents));
+
+  s->addTest(new UnitTest::TestCaller<ODETest>(
+               "Test stepper statistics", &ODETest::testStatistics));
+
+  s->addTest(new UnitTest::TestCaller<ODETest>(
+               "Test Rosenbrock output grid", &ODETest::testRosenbrockOutputGrid));
+
+  s->addTest(new UnitTest::TestCaller<ODETest>(
+               "Test linear propagator", &ODETest::testLinearPropagator));
+
   return s;
 }
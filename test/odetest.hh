@@ -45,6 +45,9 @@ public:
   void testStiffDopri853();
   void testStiffRosenbrock34();
   void testStiffRosenbrock45();
+  void testStiffBDF();
+  void testStiffBDFSolvers();
+  void testGMRESBreakdown();
 
   void testVanDerPolRKF45();
   void testVanDerPolDopri5();
@@ -52,6 +55,18 @@ public:
   void testVanDerPolRosenbrock3();
   void testVanDerPolRosenbrock4();
 
+  void testDenseOutput();
+
+  void testEnsemble();
+
+  void testEvents();
+
+  void testStatistics();
+
+  void testRosenbrockOutputGrid();
+
+  void testLinearPropagator();
+
 public:
   /**
    * Constructs the test case.
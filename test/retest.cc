@@ -1,8 +1,11 @@
 #include "retest.hh"
 #include <models/REmodel.hh>
 #include <models/sseinterpreter.hh>
+#include <models/sensitivityinterpreter.hh>
 #include <parser/sbml/sbml.hh>
 #include <ode/lsodadriver.hh>
+#include <ode/rosenbrock4.hh>
+#include <ode/staggeredrosenbrock4.hh>
 
 
 using namespace iNA;
@@ -39,6 +42,220 @@ RETest::testEnzymeKineticsJIT()
 }
 
 
+void
+RETest::testLsodaJacobian()
+{
+  double err_abs = 1e-10;
+  double err_rel = 1e-8;
+  double final_time = 10.0;
+  size_t N = 100;
+  double dt=final_time/N;
+
+  // Read doc and check for errors:
+  Ast::Model sbml_model;
+  Parser::Sbml::importModel(sbml_model, "test/regression-tests/enzymekinetics1.xml");
+  Models::REmodel model(sbml_model);
+  Models::REinterpreter interpreter(model, 0);
+  size_t dim = model.getDimension();
+
+  // Integrate using the analytic Jacobian and finite differences:
+  ODE::LsodaDriver<Models::REinterpreter> analytic(interpreter, dt, err_abs, err_rel, true);
+  ODE::LsodaDriver<Models::REinterpreter> finite(interpreter, dt, err_abs, err_rel, false);
+
+  Eigen::VectorXd x(dim); model.getInitialState(x);
+  Eigen::VectorXd x_finite(x);
+
+  double t = 0.0;
+  for(size_t i=0; i<N; i++, t+=dt) {
+    analytic.step(x, t, t+dt);
+    finite.step(x_finite, t, t+dt);
+  }
+
+  for (size_t i=0; i<dim; i++) {
+    assertNear(x(i), x_finite(i), 1e-5*std::abs(x_finite(i))+1e-8, __FILE__, __LINE__);
+  }
+}
+
+
+/** A stiff linear chain x_0 -> x_1 -> ... -> x_(n-1) with rates spanning 4 orders of magnitude and
+ * a constant influx into x_0. The Jacobian has a single sub-diagonal. */
+class StiffChain
+{
+public:
+  Eigen::VectorXd k;
+
+  StiffChain(size_t n) : k(n) {
+    for (size_t i=0; i<n; i++) { k(i) = std::pow(10., (4.*i)/(n-1)); }
+  }
+
+  size_t getDimension() const { return k.size(); }
+
+  void evaluate(const double *state, double t, double *rates) {
+    rates[0] = 1 - k(0)*state[0];
+    for (int i=1; i<k.size(); i++) { rates[i] = k(i-1)*state[i-1] - k(i)*state[i]; }
+  }
+
+  void evaluateJacobian(const Eigen::VectorXd &state, double t, Eigen::MatrixXd &jacobian) {
+    jacobian.setZero(k.size(), k.size());
+    jacobian(0,0) = -k(0);
+    for (int i=1; i<k.size(); i++) { jacobian(i,i-1) = k(i-1); jacobian(i,i) = -k(i); }
+  }
+};
+
+
+void
+RETest::testLsodaBandedJacobian()
+{
+  double err_abs = 1e-10;
+  double err_rel = 1e-8;
+  double final_time = 100.0;
+  size_t N = 100, dim = 40;
+  double dt=final_time/N;
+
+  StiffChain system(dim);
+
+  // Integrate using the full and banded analytic Jacobian and finite differences:
+  ODE::LsodaDriver<StiffChain> analytic(system, dt, err_abs, err_rel, true);
+  ODE::LsodaDriver<StiffChain> banded(system, dt, err_abs, err_rel, true);
+  banded.setBandwidth(1, 0);
+  ODE::LsodaDriver<StiffChain> finite(system, dt, err_abs, err_rel, false);
+  ODE::LsodaDriver<StiffChain> banded_finite(system, dt, err_abs, err_rel, false);
+  banded_finite.setBandwidth(1, 0);
+
+  Eigen::VectorXd x(dim); x.setZero();
+  Eigen::VectorXd x_banded(x), x_finite(x), x_banded_finite(x);
+
+  double t = 0.0;
+  for(size_t i=0; i<N; i++, t+=dt) {
+    analytic.step(x, t, t+dt);
+    banded.step(x_banded, t, t+dt);
+    finite.step(x_finite, t, t+dt);
+    banded_finite.step(x_banded_finite, t, t+dt);
+  }
+
+  // At steady state, x_i = 1/k_i:
+  for (size_t i=0; i<dim; i++) {
+    assertNear(x(i), 1./system.k(i), 1e-4/system.k(i), __FILE__, __LINE__);
+    assertNear(x(i), x_banded(i), 1e-5*std::abs(x(i))+1e-8, __FILE__, __LINE__);
+    assertNear(x(i), x_finite(i), 1e-5*std::abs(x(i))+1e-8, __FILE__, __LINE__);
+    assertNear(x(i), x_banded_finite(i), 1e-5*std::abs(x(i))+1e-8, __FILE__, __LINE__);
+  }
+
+  // The system is stiff, hence LSODA must have switched to BDF and evaluated the Jacobian:
+  size_t nje_finite = finite.statistics().numJacobianEvaluations();
+  size_t nje_banded = banded_finite.statistics().numJacobianEvaluations();
+  UT_ASSERT(0 < banded.statistics().numJacobianEvaluations());
+  UT_ASSERT(0 < nje_finite);
+  UT_ASSERT(0 < nje_banded);
+
+  // Each Jacobian costs dim evaluations of the ODEs using full finite differences but only
+  // ml+mu+1 = 2 if the band is used:
+  size_t rhs_finite = finite.statistics().numRHSEvaluations();
+  size_t rhs_banded = banded_finite.statistics().numRHSEvaluations();
+  UT_ASSERT(rhs_banded + ((dim-2)*std::min(nje_finite, nje_banded))/2 < rhs_finite);
+}
+
+
+void
+RETest::testGene1Sensitivities()
+{
+  double err_abs = 1e-10;
+  double err_rel = 1e-8;
+  double final_time = 1.0;
+  size_t N = 100;
+  double dt=final_time/N;
+
+  // Read doc and check for errors:
+  Ast::Model sbml_model;
+  Parser::Sbml::importModel(sbml_model, "test/regression-tests/gene1.xml");
+  std::vector<std::string> params(1, "k0");
+
+  // Integrate RE model augmented by the sensitivity equations:
+  Models::RESensitivityModel model(sbml_model, params);
+  Models::RESensitivityInterpreter interpreter(model, 0);
+  ODE::StaggeredRosenbrock4<Models::RESensitivityInterpreter> stepper(interpreter, dt, err_abs, err_rel);
+  Eigen::VectorXd x(model.getDimension()); model.getInitialState(x);
+  Eigen::VectorXd dx(model.getDimension());
+  for(size_t i=0; i<N; i++) {
+    stepper.step(x, i*dt, dx); x += dx;
+  }
+  Eigen::MatrixXd sensitivities; model.fullSensitivities(x, sensitivities);
+
+  // Compare with central finite differences:
+  double k0 = Eigen::ex2double(sbml_model.getParameter("k0")->getValue());
+  double h  = 1e-4*k0;
+  Eigen::VectorXd values[2];
+  for (size_t s=0; s<2; s++) {
+    sbml_model.getParameter("k0")->setValue(k0 + (2*double(s)-1)*h);
+    Models::REmodel remodel(sbml_model);
+    Models::REinterpreter reinterpreter(remodel, 0);
+    ODE::Rosenbrock4TimeInd<Models::REinterpreter> restepper(reinterpreter, dt, err_abs, err_rel);
+    Eigen::VectorXd y(remodel.getDimension()); remodel.getInitialState(y);
+    Eigen::VectorXd dy(remodel.getDimension());
+    for(size_t i=0; i<N; i++) {
+      restepper.step(y, i*dt, dy); y += dy;
+    }
+    remodel.fullState(y, values[s]);
+  }
+
+  Eigen::VectorXd fd = (values[1]-values[0])/(2*h);
+  for (int i=0; i<fd.size(); i++) {
+    assertNear(sensitivities(i,0), fd(i), 1e-4*(1e-6+std::abs(fd(i))), __FILE__, __LINE__);
+  }
+}
+
+
+void
+RETest::testCompiledModelCache()
+{
+  Ast::Model sbml_model;
+  Parser::Sbml::importModel(sbml_model, "test/regression-tests/enzymekinetics1.xml");
+  Models::CompiledModelCache::get().clear();
+
+  // Compile model and its Jacobian:
+  Models::REmodel model(sbml_model);
+  Models::REinterpreter interpreter(model, 1, 1, true);
+  Eigen::VectorXd x(model.getDimension()); model.getInitialState(x);
+  Eigen::VectorXd dx(model.getDimension());
+  Eigen::MatrixXd jac(model.getDimension(), model.getDimension());
+  interpreter.evaluate(x, 0, dx);
+  interpreter.evaluateJacobian(x, 0, jac);
+
+  // Load from cache:
+  Models::REmodel cached_model(sbml_model);
+  Models::REinterpreter cached_interpreter(cached_model, 1, 1);
+  Eigen::VectorXd cached_dx(model.getDimension());
+  Eigen::MatrixXd cached_jac(model.getDimension(), model.getDimension());
+  cached_interpreter.evaluate(x, 0, cached_dx);
+  cached_interpreter.evaluateJacobian(x, 0, cached_jac);
+
+  for (int i=0; i<dx.size(); i++) {
+    UT_ASSERT_EQUAL(cached_dx(i), dx(i));
+    for (int j=0; j<dx.size(); j++)
+      UT_ASSERT_EQUAL(cached_jac(i,j), jac(i,j));
+  }
+
+  // The first interpreter missed, the second one was loaded from the cache:
+  UT_ASSERT_EQUAL(Models::CompiledModelCache::get().numMisses(), size_t(1));
+  UT_ASSERT_EQUAL(Models::CompiledModelCache::get().numHits(), size_t(1));
+
+  // A modified model must not be taken from the cache:
+  sbml_model.getReaction("input")->getKineticLaw()->getParameter("v")->setValue(3.6e-05);
+  Models::REmodel modified_model(sbml_model);
+  Models::REinterpreter modified_interpreter(modified_model, 1, 1);
+  Eigen::VectorXd modified_dx(model.getDimension());
+  modified_interpreter.evaluate(x, 0, modified_dx);
+  UT_ASSERT(modified_dx != dx);
+  UT_ASSERT_EQUAL(Models::CompiledModelCache::get().numMisses(), size_t(2));
+  UT_ASSERT_EQUAL(Models::CompiledModelCache::get().numHits(), size_t(1));
+
+  // Models differing only in the last digits of a value must not share a key:
+  std::string key = Models::CompiledModelCache::makeKey(sbml_model, "RE");
+  sbml_model.getReaction("input")->getKineticLaw()->getParameter("v")->setValue(3.6e-05*(1+1e-9));
+  UT_ASSERT(key != Models::CompiledModelCache::makeKey(sbml_model, "RE"));
+}
+
+
 UnitTest::TestSuite *
 RETest::suite()
 {
@@ -50,6 +267,18 @@ RETest::suite()
   s->addTest(new UnitTest::TestCaller<RETest>(
                "EnzymeKinetics Model (JIT)", &RETest::testEnzymeKineticsJIT));
 
+  s->addTest(new UnitTest::TestCaller<RETest>(
+               "LSODA with analytic Jacobian", &RETest::testLsodaJacobian));
+
+  s->addTest(new UnitTest::TestCaller<RETest>(
+               "LSODA with banded Jacobian", &RETest::testLsodaBandedJacobian));
+
+  s->addTest(new UnitTest::TestCaller<RETest>(
+               "Gene1 Model sensitivities", &RETest::testGene1Sensitivities));
+
+  s->addTest(new UnitTest::TestCaller<RETest>(
+               "Compiled model cache", &RETest::testCompiledModelCache));
+
   return s;
 }
 
@@ -17,6 +17,14 @@ public:
   void testEnzymeKineticsBCI();
   /** Using JIT compiler. */
   void testEnzymeKineticsJIT();
+  /** Compares LSODA using the analytic Jacobian with finite differences. */
+  void testLsodaJacobian();
+  /** Compares LSODA using the banded Jacobian with the full one on a stiff banded system. */
+  void testLsodaBandedJacobian();
+  /** Compares forward sensitivities with finite differences. */
+  void testGene1Sensitivities();
+  /** Compares a compiled model with the one loaded from the cache. */
+  void testCompiledModelCache();
 
 public:
   /** Constructs the test-suite. */
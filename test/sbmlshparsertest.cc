@@ -1,6 +1,7 @@
 #include "sbmlshparsertest.hh"
 
 #include <sstream>
+#include <fstream>
 #include "parser/sbmlsh/lexer.hh"
 #include "parser/sbmlsh/parser.hh"
 #include <ast/model.hh>
@@ -9,6 +10,70 @@ using namespace iNA;
 using namespace iNA::Parser;
 
 
+/**
+ * Lexes the input with the token rules of the SBML-sh lexer, but runs each rule separately as the
+ * lexer did before the rules were merged into a single DFA. Serves as a reference for the merged
+ * DFA.
+ */
+class ReferenceLexer : public Sbmlsh::Lexer
+{
+public:
+  ReferenceLexer(std::istream &input)
+    : Sbmlsh::Lexer(input)
+  {
+    // Pass...
+  }
+
+  /** Returns the merged DFA of the token rules. */
+  const LexerDFA &dfa() const
+  {
+    return LexerDFA::get(rules);
+  }
+
+  /** Reads all tokens of the input, the last one is the END_OF_INPUT token. */
+  void tokenize(std::vector<Token> &tokens)
+  {
+    std::vector<int> states(rules.size()), next(rules.size());
+    std::vector<bool> stack;
+    size_t line = 1;
+
+    input.peek();
+    while (! input.eof()) {
+      for (size_t r=0; r<rules.size(); r++) {
+        states[r] = (0 < rules[r]->numStates()) ? 0 : -1;
+      }
+
+      // Read chars while any rule accepts the next char:
+      std::string value;
+      while (! input.eof()) {
+        char c = input.peek(); bool accepted = false;
+        for (size_t r=0; r<rules.size(); r++) {
+          next[r] = (0 > states[r]) ? -1 : rules[r]->getState(states[r]).accept(c, stack);
+          accepted |= (0 <= next[r]);
+        }
+        if (! accepted) { break; }
+        states.swap(next);
+        input.get(); input.peek(); value.push_back(c);
+      }
+
+      // The first rule in a final state matches:
+      int match = -1;
+      for (size_t r=0; (r<rules.size()) && (0 > match); r++) {
+        if ((0 <= states[r]) && rules[r]->getState(states[r]).isFinal()) { match = r; }
+      }
+      if (0 > match) { break; }
+
+      Token token = rules[match]->getToken(value, line);
+      if (0 != new_line_token.count(token.getId())) { line++; }
+      if (0 == ignored_token.count(token.getId())) { tokens.push_back(token); }
+    }
+
+    tokens.push_back(Token(Token::END_OF_INPUT, 0, ""));
+  }
+};
+
+
+
 void
 SBMLSHParserTest::testLexerIdentifier()
 {
@@ -284,6 +349,35 @@ SBMLSHParserTest::testVarDefOrder()
 }
 
 
+void
+SBMLSHParserTest::testLexerDFA()
+{
+  const char *files[] = {"doc/sbmlmodels/2stateGene.sbmlsh", "doc/sbmlmodels/bundschuh_test.sbmlsh"};
+
+  for (size_t i=0; i<2; i++) {
+    std::ifstream reference_input(files[i]), input(files[i]);
+    UT_ASSERT(reference_input.is_open() && input.is_open());
+
+    std::vector<Token> tokens;
+    ReferenceLexer reference(reference_input);
+    reference.tokenize(tokens);
+    UT_ASSERT(1 < tokens.size());
+
+    // Lexers with the same token rules share the DFA:
+    ReferenceLexer other(input);
+    UT_ASSERT(&reference.dfa() == &other.dfa());
+
+    // Compare token streams:
+    Sbmlsh::Lexer lexer(input);
+    for (size_t j=0; j<tokens.size(); j++, lexer.next()) {
+      UT_ASSERT_EQUAL(lexer.current().getId(), tokens[j].getId());
+      UT_ASSERT_EQUAL(lexer.current().getValue(), tokens[j].getValue());
+      UT_ASSERT_EQUAL(lexer.current().getLine(), tokens[j].getLine());
+    }
+  }
+}
+
+
 UnitTest::TestSuite *
 SBMLSHParserTest::suite()
 {
@@ -301,6 +395,8 @@ SBMLSHParserTest::suite()
                "Lexer: exp. Float", &SBMLSHParserTest::testLexerExpFloat));
   s->addTest(new UnitTest::TestCaller<SBMLSHParserTest>(
                "Lexer: Keywords", &SBMLSHParserTest::testLexerKeywords));
+  s->addTest(new UnitTest::TestCaller<SBMLSHParserTest>(
+               "Lexer: DFA", &SBMLSHParserTest::testLexerDFA));
   s->addTest(new UnitTest::TestCaller<SBMLSHParserTest>(
                "Parser: ModelDefinition", &SBMLSHParserTest::testParserModelDefinition));
   s->addTest(new UnitTest::TestCaller<SBMLSHParserTest>(
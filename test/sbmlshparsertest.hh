@@ -22,6 +22,8 @@ public:
   void testLexerExpFloat();
   /** Tests lexical analysis of some keywords. */
   void testLexerKeywords();
+  /** Tests the merged DFA of the lexer against its token rules on the example models. */
+  void testLexerDFA();
   /** Tests parsing of model-definitions. */
   void testParserModelDefinition();
   /** Tests parsing of unit-definitions. */
@@ -2,6 +2,8 @@
 #include <models/IOSmodel.hh>
 #include <parser/sbml/sbml.hh>
 #include <models/sseparamscan.hh>
+#include <models/sseinterpreter.hh>
+#include <models/ensembleinterpreter.hh>
 
 using namespace iNA;
 
@@ -75,6 +77,58 @@ SSEParamScanTest::testGene1() {
 }
 
 
+void
+SSEParamScanTest::testEnsembleInterpreter() {
+  compareEnsemble("test/regression-tests/gene1.xml", 0);
+  compareEnsemble("test/regression-tests/core_osc.xml", 0);
+  compareEnsemble("test/regression-tests/core_osc.xml", 1);
+}
+
+
+void
+SSEParamScanTest::compareEnsemble(const std::string &filename, size_t opt_level) {
+  Ast::Model sbml_model;
+  Parser::Sbml::importModel(sbml_model, filename);
+  UT_ASSERT(0 < sbml_model.numParameters());
+
+  // Vary the first global parameter over the members of the ensemble:
+  size_t K=5;
+  std::string id = sbml_model.getParameter(size_t(0))->getIdentifier();
+  std::vector<Models::ParameterSet> parameters(K);
+  for (size_t k=0; k<K; k++) {
+    parameters[k][id] = 1+0.25*k;
+  }
+
+  // Evaluate the batch-compiled update vector for all members at once:
+  Models::REmodel model(sbml_model);
+  Models::EnsembleInterpreter<Models::REmodel> ensemble(model, parameters, opt_level);
+  Eigen::MatrixXd states, rates;
+  ensemble.getInitialState(states);
+  for (size_t j=0; j<ensemble.getDimension(); j++) {
+    states.col(j) *= 1+0.1*(j+1);
+  }
+  ensemble.evaluate(states, Eigen::VectorXd::Zero(K), rates);
+
+  // Compare each member against the scalar byte-code interpreter of the modified model:
+  for (size_t k=0; k<K; k++) {
+    Ast::Model member_sbml;
+    Parser::Sbml::importModel(member_sbml, filename);
+    member_sbml.getParameter(id)->setValue(parameters[k][id]);
+    Models::REmodel member(member_sbml);
+    Models::REinterpreter interpreter(member, opt_level, 1);
+
+    Eigen::VectorXd state = states.row(k).transpose();
+    Eigen::VectorXd dx(member.getDimension());
+    interpreter.evaluate(state, 0, dx);
+
+    UT_ASSERT_EQUAL(size_t(dx.size()), ensemble.getDimension());
+    for (int i=0; i<dx.size(); i++) {
+      assertNear(rates(k,i), dx(i), 1e-10*(1+std::abs(dx(i))), __FILE__, __LINE__);
+    }
+  }
+}
+
+
 UnitTest::TestSuite *
 SSEParamScanTest::suite() {
   UnitTest::TestSuite *s = new UnitTest::TestSuite("SSE Parameter Scan Tests");
@@ -85,5 +139,8 @@ SSEParamScanTest::suite() {
   s->addTest(new UnitTest::TestCaller<SSEParamScanTest>(
                "Gene Model 1 (RE)", &SSEParamScanTest::testGene1));
 
+  s->addTest(new UnitTest::TestCaller<SSEParamScanTest>(
+               "Ensemble interpreter (RE)", &SSEParamScanTest::testEnsembleInterpreter));
+
   return s;
 }
@@ -2,6 +2,7 @@
 #define SSEPARAMSCANTEST_HH
 
 #include "unittest.hh"
+#include <string>
 
 namespace iNA {
 
@@ -12,6 +13,12 @@ public:
 
   void testEnzymeKinetics();
   void testGene1();
+  void testEnsembleInterpreter();
+
+protected:
+  /** Compares the batched evaluation of the given model for an ensemble of parameter sets
+   * against the scalar byte-code interpreter. */
+  void compareEnsemble(const std::string &filename, size_t opt_level);
 
 public:
   static UnitTest::TestSuite *suite();
@@ -4,6 +4,7 @@
 #include <models/IOSmodel.hh>
 #include <models/sseinterpreter.hh>
 #include <models/steadystateanalysis.hh>
+#include <models/multistartanalysis.hh>
 #include <eval/jit/engine.hh>
 #include <parser/sbml/sbml.hh>
 
@@ -58,6 +59,106 @@ SteadyStateTest::testEnzymeKineticsIOS() {
   analysis.calcSteadyState(state);
 }
 
+void
+SteadyStateTest::testQuasiNewton() {
+  // Read doc and check for errors:
+  Ast::Model sbml_model;
+  Parser::Sbml::importModel(sbml_model, "test/regression-tests/extended_goodwin.xml");
+  // Construct RE model
+  Models::REmodel model(sbml_model);
+
+  // Reference solution by the Newton-Raphson method:
+  Eigen::VectorXd reference(model.getDimension());
+  Models::SteadyStateAnalysis<Models::REmodel> analysis(model);
+  analysis.setMaxIterations(1000);
+  // The strategy is ignored by the Newton-Raphson solver:
+  analysis.setStrategy(NLEsolve::BroydenMethod);
+  analysis.calcSteadyState(reference);
+  // The Newton-Raphson method evaluates and factorizes the Jacobian in every iteration:
+  UT_ASSERT(0 < analysis.getJacobianEvaluations());
+  UT_ASSERT_EQUAL(analysis.getFactorizations(), analysis.getJacobianEvaluations());
+
+  // Check all strategies of the quasi-Newton solver:
+  NLEsolve::QuasiNewtonStrategy strategies[3] = {
+    NLEsolve::ChordMethod, NLEsolve::ShamanskiiMethod, NLEsolve::BroydenMethod };
+  for (size_t i=0; i<3; i++) {
+    Eigen::VectorXd state(model.getDimension());
+    Models::SteadyStateAnalysis<
+        Models::REmodel, Eval::bci::Engine<Eigen::VectorXd, Eigen::VectorXd>,
+        Eval::bci::Engine<Eigen::VectorXd, Eigen::MatrixXd>,
+        NLEsolve::QuasiNewton<Models::REmodel> > qnAnalysis(model);
+    qnAnalysis.setMaxIterations(1000);
+    qnAnalysis.setStrategy(strategies[i]);
+    qnAnalysis.calcSteadyState(state);
+    UT_ASSERT(((state-reference).array().abs() <= 1e-6*(1+reference.array().abs())).all());
+    // The Jacobian and its factorization are reused:
+    UT_ASSERT(qnAnalysis.getJacobianEvaluations() < analysis.getJacobianEvaluations());
+    UT_ASSERT(qnAnalysis.getFactorizations() < analysis.getFactorizations());
+  }
+}
+
+void
+SteadyStateTest::testMultiStart() {
+  // Read doc and check for errors:
+  Ast::Model sbml_model;
+  Parser::Sbml::importModel(sbml_model, "test/regression-tests/extended_goodwin.xml");
+  // Construct RE model
+  Models::REmodel model(sbml_model);
+
+  // Reference solution from the initial conditions:
+  Eigen::VectorXd reference(model.getDimension());
+  Models::SteadyStateAnalysis<Models::REmodel> analysis(model);
+  analysis.setMaxIterations(1000);
+  analysis.calcSteadyState(reference);
+
+  // Search from several starts, the reference must be found and be stable:
+  std::vector<Models::SteadyStateRoot> roots;
+  Models::MultiStartAnalysis<Models::REmodel> multiStart(model, 1000);
+  multiStart.calcSteadyStates(roots, 16);
+  UT_ASSERT(0 < roots.size());
+
+  bool found = false;
+  size_t N = model.numIndSpecies();
+  for (size_t i=0; i<roots.size(); i++) {
+    Eigen::VectorXd delta = roots[i].state - reference.head(N);
+    if (delta.lpNorm<Eigen::Infinity>() <= 1e-6*(1+reference.head(N).lpNorm<Eigen::Infinity>())) {
+      found = true; UT_ASSERT(roots[i].stable);
+    }
+  }
+  UT_ASSERT(found);
+}
+
+void
+SteadyStateTest::testMultiStable() {
+  // Read doc and check for errors:
+  Ast::Model sbml_model;
+  Parser::Sbml::importModel(sbml_model, "test/regression-tests/schloegl.xml");
+  // Construct RE model
+  Models::REmodel model(sbml_model);
+  UT_ASSERT_EQUAL(model.numIndSpecies(), size_t(1));
+
+  // The rate equation of the Schloegl model dX/dt = -(X-1)(X-2)(X-3) has the stable steady
+  // states X=1 and X=3 and the unstable one X=2:
+  std::vector<Models::SteadyStateRoot> roots;
+  Models::MultiStartAnalysis<Models::REmodel> multiStart(model, 1000);
+  multiStart.calcSteadyStates(roots, 32);
+
+  size_t num_stable = 0; bool low = false, high = false;
+  for (size_t i=0; i<roots.size(); i++) {
+    double x = roots[i].state(0);
+    if (std::abs(x-2) <= 1e-6) {
+      // The unstable steady state is only found if the Newton iteration converged to it:
+      UT_ASSERT(! roots[i].stable);
+      continue;
+    }
+    UT_ASSERT(roots[i].stable); num_stable++;
+    if (std::abs(x-1) <= 1e-6) { low = true; }
+    if (std::abs(x-3) <= 1e-6) { high = true; }
+  }
+  UT_ASSERT_EQUAL(num_stable, size_t(2));
+  UT_ASSERT(low && high);
+}
+
 
 UnitTest::TestSuite *
 SteadyStateTest::suite() {
@@ -72,5 +173,14 @@ SteadyStateTest::suite() {
   s->addTest(new UnitTest::TestCaller<SteadyStateTest>(
                "EnzymeKinetics Model (IOS)", &SteadyStateTest::testEnzymeKineticsIOS));
 
+  s->addTest(new UnitTest::TestCaller<SteadyStateTest>(
+               "Quasi-Newton solver (RE)", &SteadyStateTest::testQuasiNewton));
+
+  s->addTest(new UnitTest::TestCaller<SteadyStateTest>(
+               "Multi-start search (RE)", &SteadyStateTest::testMultiStart));
+
+  s->addTest(new UnitTest::TestCaller<SteadyStateTest>(
+               "Multi-start search, bistable (RE)", &SteadyStateTest::testMultiStable));
+
   return s;
 }
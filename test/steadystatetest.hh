@@ -15,6 +15,9 @@ public:
   void testEnzymeKineticsRE();
   void testEnzymeKineticsLNA();
   void testEnzymeKineticsIOS();
+  void testQuasiNewton();
+  void testMultiStart();
+  void testMultiStable();
 
 public:
   static UnitTest::TestSuite *suite();
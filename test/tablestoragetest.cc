@@ -0,0 +1,204 @@
+#include "tablestoragetest.hh"
+#include "../app/models/timeseries.hh"
+#include <sstream>
+
+using namespace iNA;
+
+
+/* A chunk holds 4MB, hence a chunk of a table with 1024 columns holds 512 rows. */
+static const size_t COLUMNS = 1024;
+static const size_t ROWS    = 1300;
+
+/** The value stored at the i-th row and j-th column. */
+static double
+tableValue(size_t i, size_t j)
+{
+  return double(i*COLUMNS + j);
+}
+
+/** Fills the storage row by row, like the tasks do. */
+static void
+fillStorage(TableStorage &storage)
+{
+  Eigen::VectorXd row(storage.columns());
+  for (size_t i=0; i<storage.rows(); i++) {
+    for (size_t j=0; j<storage.columns(); j++) { row(j) = tableValue(i,j); }
+    storage.setRow(i, row);
+  }
+}
+
+/** Returns true if the matrix holds the values of a filled table. */
+static bool
+isTableData(const Eigen::MatrixXd &values)
+{
+  if ((ROWS != size_t(values.rows())) || (COLUMNS != size_t(values.cols()))) { return false; }
+  for (size_t i=0; i<ROWS; i++) {
+    for (size_t j=0; j<COLUMNS; j++) {
+      if (tableValue(i,j) != values(i,j)) { return false; }
+    }
+  }
+  return true;
+}
+
+
+
+TableStorageTest::~TableStorageTest()
+{
+  // Pass...
+}
+
+
+void
+TableStorageTest::setUp()
+{
+  _memory_limit = TableStorage::memoryLimit();
+  TableStorage::setMemoryLimit(0);
+}
+
+
+void
+TableStorageTest::tearDown()
+{
+  TableStorage::setMemoryLimit(_memory_limit);
+}
+
+
+void
+TableStorageTest::testChunking()
+{
+  TableStorage storage(ROWS, COLUMNS);
+  UT_ASSERT_EQUAL(storage.chunkRows(), size_t(512));
+  UT_ASSERT_EQUAL(storage.numChunks(), size_t(3));
+
+  // Unwritten chunks read as zero:
+  const TableStorage &values = storage;
+  UT_ASSERT_EQUAL(values.value(ROWS-1, COLUMNS-1), 0.0);
+
+  // Incomplete chunks are kept in memory:
+  Eigen::VectorXd row(COLUMNS);
+  for (size_t j=0; j<COLUMNS; j++) { row(j) = tableValue(600, j); }
+  storage.setRow(600, row);
+  UT_ASSERT(! storage.isSpilled(1));
+  UT_ASSERT_EQUAL(values.value(600, 17), tableValue(600, 17));
+  UT_ASSERT_EQUAL(values.value(599, 17), 0.0);
+  UT_ASSERT_EQUAL(values.value(0, 17), 0.0);
+}
+
+
+void
+TableStorageTest::testSpill()
+{
+  TableStorage storage(ROWS, COLUMNS);
+  fillStorage(storage);
+
+  // Every chunk got completed, hence spilled:
+  for (size_t c=0; c<storage.numChunks(); c++) {
+    UT_ASSERT(storage.isSpilled(c));
+  }
+
+  // Read back from the mapped file:
+  const TableStorage &values = storage;
+  UT_ASSERT_EQUAL(values.value(0, 0), tableValue(0, 0));
+  UT_ASSERT_EQUAL(values.value(511, COLUMNS-1), tableValue(511, COLUMNS-1));
+  UT_ASSERT_EQUAL(values.value(512, 3), tableValue(512, 3));
+  UT_ASSERT_EQUAL(values.value(ROWS-1, COLUMNS-1), tableValue(ROWS-1, COLUMNS-1));
+
+  Eigen::VectorXd row; storage.getRow(1000, row);
+  UT_ASSERT_EQUAL(size_t(row.size()), COLUMNS);
+  UT_ASSERT_EQUAL(row(5), tableValue(1000, 5));
+
+  std::vector<size_t> columns(2); columns[0] = 7; columns[1] = COLUMNS-1;
+  Eigen::MatrixXd selected; storage.getColumns(columns, selected);
+  UT_ASSERT_EQUAL(size_t(selected.rows()), ROWS);
+  for (size_t i=0; i<ROWS; i++) {
+    UT_ASSERT_EQUAL(selected(i,0), tableValue(i, 7));
+    UT_ASSERT_EQUAL(selected(i,1), tableValue(i, COLUMNS-1));
+  }
+
+  // Writes to spilled chunks go to the mapped file:
+  storage.value(3, 3) = -1;
+  UT_ASSERT_EQUAL(values.value(3, 3), -1.0);
+  storage.value(3, 3) = tableValue(3, 3);
+
+  // Copies keep spilled chunks on disk:
+  TableStorage copy(storage);
+  UT_ASSERT(copy.isSpilled(0));
+  UT_ASSERT_EQUAL(static_cast<const TableStorage &>(copy).value(700, 9), tableValue(700, 9));
+}
+
+
+void
+TableStorageTest::testDense()
+{
+  Table table(COLUMNS, ROWS);
+  Eigen::VectorXd row(COLUMNS);
+  for (size_t i=0; i<ROWS; i++) {
+    for (size_t j=0; j<COLUMNS; j++) { row(j) = tableValue(i,j); }
+    table.append(row);
+  }
+
+  // Copies share the storage, reading does not detach it:
+  const Table copy(table);
+  UT_ASSERT_EQUAL(copy(ROWS-1, 2), tableValue(ROWS-1, 2));
+  UT_ASSERT(isTableData(copy.toMatrix()));
+  UT_ASSERT_EQUAL(copy.getColumn(5)(1200), tableValue(1200, 5));
+
+  // The dense matrix gathers all chunks:
+  UT_ASSERT(isTableData(table.matrix()));
+  table.matrix()(0,0) = -1;
+  UT_ASSERT_EQUAL(static_cast<const Table &>(table)(0,0), -1.0);
+  UT_ASSERT_EQUAL(table.toMatrix()(0,0), -1.0);
+
+  // The copy is not affected by the modification:
+  UT_ASSERT(isTableData(copy.toMatrix()));
+
+  // Same for the storage itself:
+  TableStorage storage(ROWS, COLUMNS);
+  fillStorage(storage);
+  UT_ASSERT(storage.isSpilled(0));
+  UT_ASSERT(isTableData(storage.dense()));
+  UT_ASSERT_EQUAL(storage.numChunks(), size_t(1));
+  UT_ASSERT(! storage.isSpilled(0));
+}
+
+
+void
+TableStorageTest::testMatExport()
+{
+  Table table(COLUMNS, ROWS);
+  Eigen::VectorXd row(COLUMNS);
+  for (size_t i=0; i<ROWS; i++) {
+    for (size_t j=0; j<COLUMNS; j++) { row(j) = tableValue(i,j); }
+    table.append(row);
+  }
+
+  // The table is read in several blocks of columns:
+  UT_ASSERT(COLUMNS*ROWS*sizeof(double) > 2*Utils::MatFileSourceValue::blockSize);
+
+  // Block-wise export must yield the same file as the export of the dense matrix:
+  std::stringstream dense, blockwise;
+  Utils::MatFile dense_file; dense_file.add("result", table.toMatrix());
+  dense_file.serialize(dense);
+  TableMatrixSource source(table);
+  Utils::MatFile blockwise_file; blockwise_file.add("result", source);
+  blockwise_file.serialize(blockwise);
+  UT_ASSERT(dense.str() == blockwise.str());
+}
+
+
+UnitTest::TestSuite *
+TableStorageTest::suite()
+{
+  UnitTest::TestSuite *s = new UnitTest::TestSuite("Tests for the table storage.");
+
+  s->addTest(new UnitTest::TestCaller<TableStorageTest>(
+               "Chunking", &TableStorageTest::testChunking));
+  s->addTest(new UnitTest::TestCaller<TableStorageTest>(
+               "Spill and read back", &TableStorageTest::testSpill));
+  s->addTest(new UnitTest::TestCaller<TableStorageTest>(
+               "Dense matrix after spill", &TableStorageTest::testDense));
+  s->addTest(new UnitTest::TestCaller<TableStorageTest>(
+               "Block-wise MAT export", &TableStorageTest::testMatExport));
+
+  return s;
+}
@@ -0,0 +1,40 @@
+#ifndef __INA_TEST_TABLESTORAGETEST_HH__
+#define __INA_TEST_TABLESTORAGETEST_HH__
+
+#include "unittest.hh"
+
+namespace iNA {
+
+/**
+ * Checks the chunked, disk-backed storage of the tables of the application.
+ */
+class TableStorageTest : public UnitTest::TestCase
+{
+public:
+  virtual ~TableStorageTest();
+
+  /** Sets a small memory limit, hence every completed chunk gets spilled. */
+  virtual void setUp();
+  /** Restores the memory limit. */
+  virtual void tearDown();
+
+  /** Checks the division into chunks and their allocation on the first write. */
+  void testChunking();
+  /** Checks that completed chunks get spilled and are read back from the mapped file. */
+  void testSpill();
+  /** Checks the dense matrix and the copy of the data after a spill. */
+  void testDense();
+  /** Checks that the block-wise MAT export equals the export of the dense matrix. */
+  void testMatExport();
+
+public:
+  static UnitTest::TestSuite *suite();
+
+private:
+  /** Holds the memory limit of the storage during the test. */
+  size_t _memory_limit;
+};
+
+}
+
+#endif // __INA_TEST_TABLESTORAGETEST_HH__